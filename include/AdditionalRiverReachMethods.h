@@ -53,6 +53,8 @@ public:
 	void updateAdditionalRiverReachProperties(const RegularRiverReachProperties& regularRiverReachProperties, const GeometricalChannelBehaviour* geometricalChannelBehaviour, const RegularRiverReachMethods& regularRiverReachMethods);
 	void performTypeSpecificActions(RiverReachProperties& riverReachProperties, const RegularRiverReachMethods& regularRiverReachMethods);
 
+	inline bool isEmpty() const { return constitutingAdditionalRiverReachMethodTypes.empty(); }
+
 	AdditionalRiverReachMethods& operator = (const AdditionalRiverReachMethods& newAdditionalRiverReachMethods)
 	{
 		if (this != &newAdditionalRiverReachMethods) {
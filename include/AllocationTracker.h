@@ -0,0 +1,81 @@
+/*
+ * AllocationTracker.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef ALLOCATIONTRACKER_H_
+#define ALLOCATIONTRACKER_H_
+
+#include <cstddef>
+
+namespace SedFlow {
+
+// Counts the heap allocations of the complete process. If sedFlow is built with SEDFLOWALLOCATIONTRACKING (e.g. make ALLOCATIONTRACKING=1),
+// the global operator new and operator delete are replaced by versions, which count the allocations, the allocated bytes and the deallocations
+// before forwarding to malloc and free. The counters are shared by all threads and updated atomically.
+// The StageProfiler takes snapshots at the borders of the stages and time steps and reports the differences in its summary.
+// Without SEDFLOWALLOCATIONTRACKING nothing is counted, all snapshots are zero and the assertions do not check anything.
+class AllocationTracker {
+public:
+	struct Snapshot {
+		long long allocations;
+		long long bytes;
+		long long deallocations;
+		Snapshot(): allocations(0), bytes(0), deallocations(0) {}
+	};
+
+private:
+	static volatile long long allocations;
+	static volatile long long bytes;
+	static volatile long long deallocations;
+
+	static void throwAllocationErrorMessage(long long numberOfAllocations, long long numberOfBytes, long long maximumNumberOfAllocations, const char* context);
+
+public:
+	static inline bool isAvailable()
+	{
+#if defined SEDFLOWALLOCATIONTRACKING
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// Called by the replaced operator new and operator delete.
+	static void countAllocation(std::size_t size);
+	static void countDeallocation();
+
+	static Snapshot takeSnapshot();
+
+	// Intended for tests, e.g. for ensuring that time steps in a steady state do not allocate:
+	//   AllocationTracker::Snapshot beforeTimeStep = AllocationTracker::takeSnapshot();
+	//   sedFlow.performTimeStep();
+	//   AllocationTracker::assertNoAllocationsSince(beforeTimeStep, "steady state time step");
+	// Throws an error message including the context, if more allocations than allowed have happened since the snapshot.
+	static void assertNoAllocationsSince(const Snapshot& snapshot, const char* context);
+	static void assertAtMostAllocationsSince(const Snapshot& snapshot, long long maximumNumberOfAllocations, const char* context);
+};
+
+}
+
+#endif /* ALLOCATIONTRACKER_H_ */
@@ -0,0 +1,87 @@
+/*
+ * AsynchronousOutputWriter.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef ASYNCHRONOUSOUTPUTWRITER_H_
+#define ASYNCHRONOUSOUTPUTWRITER_H_
+
+#include <vector>
+#include <string>
+
+namespace SedFlow {
+
+class OutputMethodType;
+
+// Background thread, which formats and writes the output lines of the OutputMethodTypes, while the solver continues with the next time steps.
+// The solver hands over snapshots of the output values through a bounded queue of preallocated buffers. Handing over a snapshot swaps
+// its buffer with the one of the queue slot, so that no values are copied and no memory is allocated once all buffers have been used.
+// If the queue is full, the solver waits for the background thread (backpressure). Snapshots are written in the order of hand over.
+// The background thread is woken up for each handed over snapshot, when the writer is stopped, and when the solver waits for all snapshots to be written.
+// The queue is shared by all OutputMethodTypes of an OutputMethods object and may be filled from several threads at once.
+class AsynchronousOutputWriter {
+private:
+	struct ThreadingPrimitives;
+	ThreadingPrimitives* threadingPrimitives;
+
+	std::vector< std::vector<double> > queuedSnapshots;
+	std::vector<OutputMethodType*> queuedTargets;
+	int indexOfFirstQueuedSnapshot;
+	int numberOfQueuedSnapshots;
+	std::vector<double> snapshotInProgress;
+	bool writingSnapshot;
+	bool threadRunning;
+	bool stopRequested;
+
+	bool errorOccurred;
+	std::string errorMessage;
+
+	void runBackgroundThread();
+	static void runBackgroundThreadOf(AsynchronousOutputWriter* writer) { writer->runBackgroundThread(); }
+	friend struct ThreadingPrimitives;
+
+	// The writer owns a thread. Thus it is neither copyable nor assignable.
+	AsynchronousOutputWriter(const AsynchronousOutputWriter&);
+	AsynchronousOutputWriter& operator = (const AsynchronousOutputWriter&);
+
+public:
+	AsynchronousOutputWriter(int queueLength);
+	virtual ~AsynchronousOutputWriter();
+
+	inline int getQueueLength() const { return queuedSnapshots.size(); }
+
+	void start();
+	// Writes all queued snapshots and ends the background thread.
+	void stop();
+
+	// Queues the snapshot for target->writeSnapshot(...). The content of snapshot is undefined afterwards.
+	// Throws, if writing a previous snapshot failed.
+	void enqueue(OutputMethodType* target, std::vector<double>& snapshot);
+	// Blocks until all queued snapshots have been written. Does not throw, so that it may be used during error handling.
+	void waitUntilDrained();
+	void throwIfErrorOccurred() const;
+};
+
+}
+
+#endif /* ASYNCHRONOUSOUTPUTWRITER_H_ */
@@ -48,7 +48,7 @@ public:
 
 	static double calculateFroude(double meanFlowDepth, double flowVelocity, double gravityAcceleration);
 	static double calculateFroude(const RiverReachProperties& riverReachProperties);
-	static double calculateMaximumFlowDepthForGivenFroudeAndDischarge(double froudeNumber, double discharge, double gravityAcceleration, const ChannelGeometry* channelGeometry, double expectedFlowDepth, double accuracyForTerminatingIteration, int maximumNumberOfIterations, const NumericRootFinder< std::binder2nd< BasicCalculations_EquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero > >* numericRootFinder);
+	static double calculateMaximumFlowDepthForGivenFroudeAndDischarge(double froudeNumber, double discharge, double gravityAcceleration, const ChannelGeometry* channelGeometry, double expectedFlowDepth, double accuracyForTerminatingIteration, int maximumNumberOfIterations, const NumericRootFinder< std::binder2nd< BasicCalculations_EquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero > >* numericRootFinder, const RiverReachProperties* riverReachProperties = NULL);
 	static double calculateFlowVelocityForGivenFroudeAndMeanFlowDepth(double froudeNumber, double meanFlowDepth, double gravityAcceleration);
 	static std::vector<double> calculateDimensionlessShearStress(const RegularRiverReachProperties& regularRiverReachProperties);
 	static double calculateDimensionlessShearStress(double diameter, const RegularRiverReachProperties& regularRiverReachProperties);
@@ -68,6 +68,7 @@ public:
 		previousLowerBracketValue = previousUpperBracketValue = signum(function(expectedValue));
 		for(int i = 1; i <= maximumNumberOfIterations; ++i)
 		{
+			RootFinderDiagnostics::countBracketExpansion();
 			lowerBracket = previousLowerBracket * 0.5;
 			upperBracket = previousUpperBracket * 2.0;
 			lowerBracketValue = signum(function(lowerBracket));
@@ -115,6 +116,7 @@ public:
 		double previousBracketValue (signum(function(boundary)));
 		for(int i = 1; i <= maximumNumberOfIterations; ++i)
 		{
+			RootFinderDiagnostics::countBracketExpansion();
 			currentBracket = previousBracket * factor;
 			currentBracketValue = signum(function(currentBracket));
 			if(currentBracketValue != previousBracketValue)
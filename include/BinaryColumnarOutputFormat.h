@@ -0,0 +1,79 @@
+/*
+ * BinaryColumnarOutputFormat.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef BINARYCOLUMNAROUTPUTFORMAT_H_
+#define BINARYCOLUMNAROUTPUTFORMAT_H_
+
+#include <string>
+#include <vector>
+#include <istream>
+
+namespace SedFlow {
+
+// Encoding of the binary columnar output files written by OutputRegularRiverReachPropertiesBinary.
+// All numbers are stored little-endian independent of the machine, strings as uint32 length followed by the characters.
+//
+// Header:
+//   char[8]  magicNumber "SEDFLOWB"
+//   uint32   formatVersion
+//   int32    precisionForOutput (used for conversions to text)
+//   uint32   numberOfRowsPerChunk
+//   strings  propertyNames (uint32 count followed by the strings)
+//   strings  cellLabels (e.g. Reach12, UpstreamMarginAtReach3, DownstreamMargin)
+//   int32s   userCellIDs of the non margin reaches (uint32 count followed by the values)
+//   strings  grainTypeNames
+//   doubles  fractionalGrainDiameters [m] (uint32 count followed by the values)
+//   uint32   numberOfStrataLayers
+//   strings  columnNames (the first column is ElapsedSeconds)
+//
+// Chunks (until the end of the file):
+//   char[4]  chunkMarker "CHNK"
+//   uint32   numberOfRows (at most numberOfRowsPerChunk)
+//   double   values[numberOfColumns][numberOfRows] (column by column)
+class BinaryColumnarOutputFormat {
+public:
+	static const char magicNumber[8];
+	static const char chunkMarker[4];
+	static const unsigned int formatVersion;
+
+	static void appendUnsignedInt(std::vector<char>& target, unsigned int value);
+	static void appendInt(std::vector<char>& target, int value);
+	static void appendDouble(std::vector<char>& target, double value);
+	static void appendString(std::vector<char>& target, const std::string& value);
+	static void appendStrings(std::vector<char>& target, const std::vector<std::string>& values);
+
+	// The read methods return false, if the end of the stream has been reached before the value was complete.
+	static bool readUnsignedInt(std::istream& source, unsigned int& value);
+	static bool readInt(std::istream& source, int& value);
+	static bool readDouble(std::istream& source, double& value);
+	static bool readString(std::istream& source, std::string& value);
+	static bool readStrings(std::istream& source, std::vector<std::string>& values);
+
+	static double decodeDouble(const char* bytes);
+};
+
+}
+
+#endif /* BINARYCOLUMNAROUTPUTFORMAT_H_ */
@@ -0,0 +1,89 @@
+/*
+ * BinaryColumnarOutputReader.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef BINARYCOLUMNAROUTPUTREADER_H_
+#define BINARYCOLUMNAROUTPUTREADER_H_
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+namespace SedFlow {
+
+// Reads the files written by OutputRegularRiverReachPropertiesBinary (see BinaryColumnarOutputFormat for the layout).
+// The header is read on construction, the values chunk by chunk. An incomplete chunk at the end of the file,
+// e.g. after an aborted simulation, is treated as end of file.
+class BinaryColumnarOutputReader {
+private:
+	std::ifstream iFileStream;
+	std::string fileName;
+
+	int precisionForOutput;
+	int numberOfRowsPerChunk;
+	std::vector<std::string> propertyNames;
+	std::vector<std::string> cellLabels;
+	std::vector<int> userCellIDs;
+	std::vector<std::string> grainTypeNames;
+	std::vector<double> fractionalGrainDiameters;
+	int numberOfStrataLayers;
+	std::vector<std::string> columnNames;
+
+	std::streampos beginOfChunks;
+	std::vector<char> chunkBuffer;
+
+	void throwCorruptFileError() const;
+
+	// The reader is neither copyable nor assignable.
+	BinaryColumnarOutputReader(const BinaryColumnarOutputReader&);
+	BinaryColumnarOutputReader& operator = (const BinaryColumnarOutputReader&);
+
+public:
+	BinaryColumnarOutputReader(const std::string& fileName);
+	virtual ~BinaryColumnarOutputReader(){}
+
+	inline int getPrecisionForOutput() const { return precisionForOutput; }
+	inline int getNumberOfRowsPerChunk() const { return numberOfRowsPerChunk; }
+	inline const std::vector<std::string>& getPropertyNames() const { return propertyNames; }
+	inline const std::vector<std::string>& getCellLabels() const { return cellLabels; }
+	inline const std::vector<int>& getUserCellIDs() const { return userCellIDs; }
+	inline const std::vector<std::string>& getGrainTypeNames() const { return grainTypeNames; }
+	inline const std::vector<double>& getFractionalGrainDiameters() const { return fractionalGrainDiameters; }
+	inline int getNumberOfStrataLayers() const { return numberOfStrataLayers; }
+	inline const std::vector<std::string>& getColumnNames() const { return columnNames; }
+	inline int getNumberOfColumns() const { return columnNames.size(); }
+	// Returns -1, if there is no column with the given name.
+	int getColumnIndex(const std::string& columnName) const;
+
+	// Reads the next chunk into columns[columnIndex][rowIndex]. Returns false at the end of the file.
+	bool readNextChunk(std::vector< std::vector<double> >& columns);
+	// Restarts reading with the first chunk.
+	void rewind();
+	// Reads all rows of a single column starting from the first chunk.
+	std::vector<double> readWholeColumn(int columnIndex);
+};
+
+}
+
+#endif /* BINARYCOLUMNAROUTPUTREADER_H_ */
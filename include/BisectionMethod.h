@@ -73,6 +73,7 @@ public:
 
 		for(int i = 1; i <= maximumNumberOfIterations; ++i)
 		{
+			RootFinderDiagnostics::countIteration();
 			mid = 0.5 * (firstBracket + secondBracket);
 			fmid = function(mid);
 
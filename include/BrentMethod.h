@@ -72,6 +72,7 @@ public:
 
 		for(int i = 1; i <= maximumNumberOfIterations; ++i)
 		{
+			RootFinderDiagnostics::countIteration();
 			//TODO Implement method
 			if( fb == 0.0 || fabs((a-b)) <= errorTolerance ){return b;}
 		}
@@ -0,0 +1,77 @@
+/*
+ * BufferedOutputFileStream.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef BUFFEREDOUTPUTFILESTREAM_H_
+#define BUFFEREDOUTPUTFILESTREAM_H_
+
+#include <fstream>
+#include <vector>
+#include <ctime>
+
+#include "CombinerVariables.h"
+
+namespace SedFlow {
+
+// Output file stream, which is kept open for the whole simulation run behind a large user space buffer.
+// Instead of reopening and closing the file for each output line, the output methods report completed lines
+// and the stream is flushed according to its flush policy: After a given number of lines, after a given
+// number of wall clock seconds (with a resolution of one second) or only when it is closed.
+class BufferedOutputFileStream: public std::ofstream {
+private:
+	std::vector<char> buffer;
+
+	CombinerVariables::TypesOfOutputFlushPolicy flushPolicy;
+	int numberOfLinesBetweenFlushes;
+	double wallSecondsBetweenFlushes;
+
+	int numberOfLinesSinceLastFlush;
+	std::time_t timeOfLastFlush;
+
+	static const std::size_t bufferSize;
+
+	// The stream is neither copyable nor assignable.
+	BufferedOutputFileStream(const BufferedOutputFileStream&);
+	BufferedOutputFileStream& operator = (const BufferedOutputFileStream&);
+
+public:
+	BufferedOutputFileStream();
+	// The buffer is a member of this class. Thus the file has to be closed before the buffer is destroyed.
+	virtual ~BufferedOutputFileStream();
+
+	void setFlushPolicy(CombinerVariables::TypesOfOutputFlushPolicy flushPolicy, int numberOfLinesBetweenFlushes, double wallSecondsBetweenFlushes);
+
+	void openAndTruncate(const char* fileName, bool binaryMode = false);
+	// Used when a simulation is continued from a checkpoint.
+	void openForAppending(const char* fileName, bool binaryMode = false);
+	// Opens an existing binary file for writing at the end, while earlier parts of the file (e.g. a header) can still be overwritten using seekp.
+	void openForUpdating(const char* fileName);
+	// Has to be called after each completed output line. Flushes the stream if this is due according to the flush policy and returns whether it has been flushed.
+	bool lineCompleted();
+	void flushNow();
+};
+
+}
+
+#endif /* BUFFEREDOUTPUTFILESTREAM_H_ */
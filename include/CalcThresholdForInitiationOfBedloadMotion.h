@@ -39,6 +39,8 @@ public:
 	virtual ConstructionVariables createConstructionVariables()const = 0;
 
 	virtual double calculate (const RegularRiverReachProperties& regularRiverReachProperties) const = 0;
+	// Variant for callers knowing the reach. Realisations with per reach state (e.g. random streams) overwrite it.
+	virtual double calculate (const RegularRiverReachProperties& regularRiverReachProperties, int cellID) const;
 };
 
 }
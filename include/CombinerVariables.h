@@ -100,10 +100,18 @@ public:
 	static TypesOfChangeRateModifiers stringToTypeOfChangeRateModifiers (std::string string);
 	static std::string typeOfChangeRateModifiersToString (TypesOfChangeRateModifiers typeOfChangeRateModifiers);
 
-	enum TypesOfOutputMethod {OutputVerbatimTranslationOfConstructionVariablesToXML, OutputRegularRiverReachProperties, OutputRegularRiverReachPropertiesForVisualInterpretation, OutputAccumulatedBedloadTransport, OutputSimulationSetup};
+	enum TypesOfOutputMethod {OutputVerbatimTranslationOfConstructionVariablesToXML, OutputRegularRiverReachProperties, OutputRegularRiverReachPropertiesForVisualInterpretation, OutputAccumulatedBedloadTransport, OutputSimulationSetup, OutputRegularRiverReachPropertiesBinary, OutputBinaryCheckpoint, OutputSharedMemoryMonitor, OutputRegularRiverReachPropertiesNetCDF, OutputRegularRiverReachPropertiesDeltaEncoded};
 	static TypesOfOutputMethod stringToTypeOfOutputMethod (std::string string);
 	static std::string typeOfOutputMethodToString (TypesOfOutputMethod typeOfOutputMethod);
 
+	enum TypesOfOutputFlushPolicy {FlushEveryNumberOfLines, FlushAfterWallSeconds, FlushOnlyOnFinalise};
+	static TypesOfOutputFlushPolicy stringToTypeOfOutputFlushPolicy (std::string string);
+	static std::string typeOfOutputFlushPolicyToString (TypesOfOutputFlushPolicy typeOfOutputFlushPolicy);
+
+	enum TypesOfOutputAggregation {InstantaneousValue, IntervalMean, IntervalMinimum, IntervalMaximum, IntervalTimeIntegral, IntervalTimeOfMaximum};
+	static TypesOfOutputAggregation stringToTypeOfOutputAggregation (std::string string);
+	static std::string typeOfOutputAggregationToString (TypesOfOutputAggregation typeOfOutputAggregation);
+
 	enum TypesOfChannelGeometry {InfinitelyDeepRectangularChannel, InfinitelyDeepVShapedChannel};
 	static TypesOfChannelGeometry stringToTypeOfChannelGeometry (std::string string);
 	static std::string typeOfChannelGeometryToString (TypesOfChannelGeometry typeOfChannelGeometry);
@@ -181,6 +189,10 @@ private:
 	static std::map< std::string, TypesOfChangeRateModifiers> createMapForTypesOfChangeRateModifiers();
 	static std::map< std::string, TypesOfOutputMethod> mapForTypesOfOutputMethod;
 	static std::map< std::string, TypesOfOutputMethod> createMapForTypesOfOutputMethod();
+	static std::map< std::string, TypesOfOutputFlushPolicy> mapForTypesOfOutputFlushPolicy;
+	static std::map< std::string, TypesOfOutputFlushPolicy> createMapForTypesOfOutputFlushPolicy();
+	static std::map< std::string, TypesOfOutputAggregation> mapForTypesOfOutputAggregation;
+	static std::map< std::string, TypesOfOutputAggregation> createMapForTypesOfOutputAggregation();
 	static std::map< std::string, TypesOfChannelGeometry> mapForTypesOfChannelGeometry;
 	static std::map< std::string, TypesOfChannelGeometry> createMapForTypesOfChannelGeometry();
 	static std::map< std::string, TypesOfGeometricalChannelBehaviour> mapForTypesOfGeometricalChannelBehaviour;
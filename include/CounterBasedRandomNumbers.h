@@ -0,0 +1,48 @@
+/*
+ * CounterBasedRandomNumbers.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#ifndef COUNTERBASEDRANDOMNUMBERS_H_
+#define COUNTERBASEDRANDOMNUMBERS_H_
+
+namespace SedFlow {
+
+// Random numbers which are a pure function of a seed, a stream (e.g. a reach) and a counter within this stream.
+// In contrast to rand() there is no hidden global state. Thus the results neither depend on the order in which
+// the reaches are treated nor on the number of threads.
+class CounterBasedRandomNumbers {
+private:
+	static unsigned long long mix(unsigned long long value);
+
+public:
+	CounterBasedRandomNumbers(){}
+	virtual ~CounterBasedRandomNumbers(){}
+
+	// Returns a uniformly distributed number within the open interval (0,1).
+	static double uniformWithinOpenUnitInterval(int seed, int streamID, double streamKey, unsigned long long counter);
+
+};
+
+}
+
+#endif /* COUNTERBASEDRANDOMNUMBERS_H_ */
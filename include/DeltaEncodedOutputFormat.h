@@ -0,0 +1,80 @@
+/*
+ * DeltaEncodedOutputFormat.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef DELTAENCODEDOUTPUTFORMAT_H_
+#define DELTAENCODEDOUTPUTFORMAT_H_
+
+#include <vector>
+
+namespace SedFlow {
+
+// Layout of the delta encoded output files written by OutputRegularRiverReachPropertiesDeltaEncoded.
+// The values of each property in each reach are split into layers: One layer for properties with a single value,
+// one layer with all fractions of all grain types for other grains properties and one such layer per stratum for the strata.
+// Each record contains only the layers, which have changed by more than the changeTolerance since they have been written the last time.
+// All numbers are encoded as in BinaryColumnarOutputFormat (little-endian, strings as uint32 length followed by the characters).
+//
+// Header:
+//   char[8]  magicNumber "SEDFLOWD"
+//   uint32   formatVersion
+//   int32    precisionForOutput (used for conversions to text)
+//   double   changeTolerance
+//   uint32   outputTimeStepLength (0 or 1)
+//   strings  propertyNames (uint32 count followed by the strings)
+//   uint32s  kindsOfProperties (see KindsOfProperty, uint32 count followed by the values)
+//   strings  cellLabels (e.g. Reach12, UpstreamMarginAtReach3, DownstreamMargin)
+//   int32s   userCellIDs of the non margin reaches (uint32 count followed by the values)
+//   strings  grainTypeNames
+//   doubles  fractionalGrainDiameters [m] (uint32 count followed by the values)
+//
+// Records (until the end of the file), the items are numbered as propertyIndex * numberOfCells + cellIndex:
+//   char[4]  recordMarker "RCRD"
+//   double   elapsedSeconds
+//   double   timeStepLength (only if outputTimeStepLength)
+//   uint32   number of layer count changes, each as uint32 itemIndex and uint32 numberOfLayers (added layers are appended at the bottom)
+//   uint32   number of layer shifts, each as uint32 itemIndex and int32 shift (layer i takes the former layer i-shift, if it exists, and keeps its content otherwise)
+//   uint32   number of changed layers, each as uint32 itemIndex, uint32 layerIndex, uint32 version and the double values of the layer
+// The changes are applied in this order. The version of a layer counts how often it has been written and moves with the layer on shifts.
+class DeltaEncodedOutputFormat {
+public:
+	enum KindsOfProperty {SingleValue = 0, SingleGrains = 1, Strata = 2};
+
+	// The state of a property in a reach as reconstructed from the records. Layers, which have not been written yet, are empty.
+	struct Item {
+		std::vector< std::vector<double> > layers;
+		std::vector<unsigned int> versions;
+	};
+
+	static const char magicNumber[8];
+	static const char recordMarker[4];
+	static const unsigned int formatVersion;
+
+	static void resizeLayers(Item& item, unsigned int numberOfLayers);
+	static void shiftLayers(Item& item, int shift);
+};
+
+}
+
+#endif /* DELTAENCODEDOUTPUTFORMAT_H_ */
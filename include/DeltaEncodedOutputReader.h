@@ -0,0 +1,97 @@
+/*
+ * DeltaEncodedOutputReader.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef DELTAENCODEDOUTPUTREADER_H_
+#define DELTAENCODEDOUTPUTREADER_H_
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "DeltaEncodedOutputFormat.h"
+
+namespace SedFlow {
+
+// Reads the files written by OutputRegularRiverReachPropertiesDeltaEncoded (see DeltaEncodedOutputFormat for the layout)
+// and reconstructs the complete state of all layers record by record. The header is read on construction.
+// An incomplete record at the end of the file, e.g. after an aborted simulation, is treated as end of file.
+class DeltaEncodedOutputReader {
+private:
+	std::ifstream iFileStream;
+	std::string fileName;
+
+	int precisionForOutput;
+	double changeTolerance;
+	bool outputTimeStepLength;
+	std::vector<std::string> propertyNames;
+	std::vector<DeltaEncodedOutputFormat::KindsOfProperty> kindsOfProperties;
+	std::vector<std::string> cellLabels;
+	std::vector<int> userCellIDs;
+	std::vector<std::string> grainTypeNames;
+	std::vector<double> fractionalGrainDiameters;
+
+	std::streampos beginOfRecords;
+	std::vector<DeltaEncodedOutputFormat::Item> items;
+	double elapsedSeconds;
+	double timeStepLength;
+	int numberOfLayersInLastRecord;
+
+	void throwCorruptFileError() const;
+
+	// The reader is neither copyable nor assignable.
+	DeltaEncodedOutputReader(const DeltaEncodedOutputReader&);
+	DeltaEncodedOutputReader& operator = (const DeltaEncodedOutputReader&);
+
+public:
+	DeltaEncodedOutputReader(const std::string& fileName);
+	virtual ~DeltaEncodedOutputReader(){}
+
+	inline int getPrecisionForOutput() const { return precisionForOutput; }
+	inline double getChangeTolerance() const { return changeTolerance; }
+	inline bool getOutputTimeStepLength() const { return outputTimeStepLength; }
+	inline const std::vector<std::string>& getPropertyNames() const { return propertyNames; }
+	inline const std::vector<DeltaEncodedOutputFormat::KindsOfProperty>& getKindsOfProperties() const { return kindsOfProperties; }
+	inline const std::vector<std::string>& getCellLabels() const { return cellLabels; }
+	inline const std::vector<int>& getUserCellIDs() const { return userCellIDs; }
+	inline const std::vector<std::string>& getGrainTypeNames() const { return grainTypeNames; }
+	inline const std::vector<double>& getFractionalGrainDiameters() const { return fractionalGrainDiameters; }
+	int getNumberOfValuesPerLayer(int propertyIndex) const;
+
+	// Reads the next record and applies it to the reconstructed state. Returns false at the end of the file.
+	bool readNextRecord();
+	// Restarts reading with the first record and clears the reconstructed state.
+	void rewind();
+
+	inline double getElapsedSeconds() const { return elapsedSeconds; }
+	inline double getTimeStepLength() const { return timeStepLength; }
+	// The number of layers contained in the record read last.
+	inline int getNumberOfLayersInLastRecord() const { return numberOfLayersInLastRecord; }
+	inline const std::vector<DeltaEncodedOutputFormat::Item>& getItems() const { return items; }
+	inline const DeltaEncodedOutputFormat::Item& getItem(int propertyIndex, int cellIndex) const { return items.at( (propertyIndex * cellLabels.size()) + cellIndex ); }
+};
+
+}
+
+#endif /* DELTAENCODEDOUTPUTREADER_H_ */
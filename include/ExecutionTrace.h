@@ -0,0 +1,78 @@
+/*
+ * ExecutionTrace.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef EXECUTIONTRACE_H_
+#define EXECUTIONTRACE_H_
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+namespace SedFlow {
+
+// Records the begin and end times of code sections per thread and writes them as Chrome Trace Event JSON,
+// which can be viewed e.g. with chrome://tracing or https://ui.perfetto.dev to find load imbalances within the parallel regions.
+// The events are stored in buffers preallocated for each thread. Thus recording does neither allocate memory nor synchronise the threads.
+// Events exceeding the capacity of a buffer are dropped and counted. The events are delivered by the StageProfiler.
+class ExecutionTrace {
+private:
+	struct Event {
+		const char* name;
+		const char* category;
+		double beginTime;
+		double endTime;
+	};
+
+	static bool enabled;
+	static std::string traceFileName;
+	static double referenceTime;
+	static std::vector< std::vector<Event> > eventsPerThread;
+	static std::vector<long> droppedEventsPerThread;
+
+public:
+	static const int defaultCapacityPerThread;
+
+	// The times of the events are given relative to the referenceTime.
+	static void enable(const std::string& traceFileName, int numberOfThreads, double referenceTime, int capacityPerThread = defaultCapacityPerThread);
+	static inline bool isEnabled() { return enabled; }
+
+	// The name and category have to persist until the trace file has been written.
+	static inline void record(int thread, const char* name, const char* category, double beginTime, double endTime)
+	{
+		std::vector<Event>& events = eventsPerThread[thread];
+		if( events.size() < events.capacity() )
+		{
+			Event event = {name, category, beginTime, endTime};
+			events.push_back(event);
+		}
+		else { ++(droppedEventsPerThread[thread]); }
+	}
+
+	static void writeTraceFile(std::ostream& messageStream);
+};
+
+}
+
+#endif /* EXECUTIONTRACE_H_ */
@@ -78,6 +78,7 @@ public:
 
 		for(int i = 1; i <= maximumNumberOfIterations; ++i)
 		{
+			RootFinderDiagnostics::countIteration();
 			currentGuess = firstBracket + ((secondBracket - firstBracket) * ( fFirst / (fFirst - fSecond) ));
 			fCurrentGuess = function(currentGuess);
 
@@ -72,6 +72,7 @@ protected:
 	double getHydraulicRadiusForActiveWidth(double maximumFlowDepth, double activeWidth, const RiverReachProperties& riverReachProperties) const;
 
 	double getStartingFlowDepthForIteration(const RiverReachProperties& riverReachProperties) const;
+	void addEverTreatedCellIDsToConstructionVariables(ConstructionVariables& target) const;
 	std::pair<double,double> getFlowDepthAndVelocityEnsuringMinimumHydraulicSlope(std::pair<double,double> previouslyCalculatedFlowDepthAndVelocity, double discharge, double minimumFlowDepth, double gravityAcceleration, const RiverReachProperties& riverReachProperties)const;
 
 public:
@@ -85,6 +86,9 @@ public:
 
 	virtual ConstructionVariables createConstructionVariables()const = 0;
 
+	// The reaches already treated start their iterations from the previous flow depth. Restored e.g. when restarting from a checkpoint.
+	void setEverTreatedCellIDs(const std::vector<int>& everTreatedCellIDs);
+
 	virtual PowerLawRelation dischargeAsPowerLawFunctionOfWaterVolumeInReach(const RiverReachProperties& riverReachProperties) const = 0;
 
 	std::pair<double,double> calculateDischargeAndFlowVelocityUsingFlowDepthAsInputBasedOnDarcyWeisbachFrictionFactor(double flowDepth, const RiverReachProperties& riverReachProperties, double darcyWeisbachFrictionFactor) const;
@@ -99,9 +103,9 @@ public:
 	inline std::pair<double,double> calculateDischargeAndFlowVelocityUsingFlowDepthAsInput(const RiverReachProperties& riverReachProperties) const { return calculateDischargeAndFlowVelocityUsingFlowDepthAsInput(riverReachProperties.regularRiverReachProperties.maximumWaterdepth, riverReachProperties); }
 	inline std::pair<double,double> calculateDischargeAndFlowDepthUsingFlowVelocityAsInput(const RiverReachProperties& riverReachProperties) const { return calculateDischargeAndFlowDepthUsingFlowVelocityAsInput(riverReachProperties.regularRiverReachProperties.flowVelocity, riverReachProperties); }
 
-	inline void calculateAndUpdateFlowDepthAndFlowVelocityUsingDischargeAsInput(RiverReachProperties& riverReachProperties) const { std::pair<double,double> result = calculateFlowDepthAndFlowVelocityUsingDischargeAsInput(riverReachProperties); riverReachProperties.regularRiverReachProperties.maximumWaterdepth = result.first; riverReachProperties.regularRiverReachProperties.flowVelocity = result.second; }
-	inline void calculateAndUpdateDischargeAndFlowVelocityUsingFlowDepthAsInput(RiverReachProperties& riverReachProperties) const { std::pair<double,double> result = calculateDischargeAndFlowVelocityUsingFlowDepthAsInput(riverReachProperties); riverReachProperties.regularRiverReachProperties.discharge = result.first; riverReachProperties.regularRiverReachProperties.flowVelocity = result.second; }
-	inline void calculateAndUpdateDischargeAndFlowDepthUsingFlowVelocityAsInput(RiverReachProperties& riverReachProperties) const { std::pair<double,double> result = calculateDischargeAndFlowDepthUsingFlowVelocityAsInput(riverReachProperties); riverReachProperties.regularRiverReachProperties.discharge = result.first; riverReachProperties.regularRiverReachProperties.maximumWaterdepth = result.second; }
+	inline void calculateAndUpdateFlowDepthAndFlowVelocityUsingDischargeAsInput(RiverReachProperties& riverReachProperties) const { std::pair<double,double> result = calculateFlowDepthAndFlowVelocityUsingDischargeAsInput(riverReachProperties); riverReachProperties.regularRiverReachProperties.maximumWaterdepth = result.first; riverReachProperties.regularRiverReachProperties.flowVelocity = result.second; riverReachProperties.markAsModified(); }
+	inline void calculateAndUpdateDischargeAndFlowVelocityUsingFlowDepthAsInput(RiverReachProperties& riverReachProperties) const { std::pair<double,double> result = calculateDischargeAndFlowVelocityUsingFlowDepthAsInput(riverReachProperties); riverReachProperties.regularRiverReachProperties.discharge = result.first; riverReachProperties.regularRiverReachProperties.flowVelocity = result.second; riverReachProperties.markAsModified(); }
+	inline void calculateAndUpdateDischargeAndFlowDepthUsingFlowVelocityAsInput(RiverReachProperties& riverReachProperties) const { std::pair<double,double> result = calculateDischargeAndFlowDepthUsingFlowVelocityAsInput(riverReachProperties); riverReachProperties.regularRiverReachProperties.discharge = result.first; riverReachProperties.regularRiverReachProperties.maximumWaterdepth = result.second; riverReachProperties.markAsModified(); }
 
 	virtual double returnCurrentDarcyWeisbachFrictionFactorFBasedOnFlowDepth(double flowDepth, const RiverReachProperties& riverReachProperties) const = 0;
 	virtual PowerLawRelation darcyWeisbachFrictionFactorFAsPowerLawFunctionOfFlowDepth(const RiverReachProperties& riverReachProperties) const = 0;
@@ -34,7 +34,8 @@ namespace SedFlow {
 
 class InputPropertyTimeSeriesLinearlyInterpolated: public ChangeRateModifiersType {
 private:
-	std::map<int, std::vector<TimeSeries> > timeSeriesInputsByCellID;
+	// Indexed by the cellID. Each reach only accesses its own time series, which keep track of the current point in time by their cursors.
+	std::vector< std::vector<TimeSeries> > timeSeriesInputsByCellID;
 	bool ensureModificationAgainstOtherChangeRateModifiers;
 	std::vector<TimeSeries> createSingleTimeSeriesVectorCopy()const;
 	const OverallMethods& overallMethods;
@@ -0,0 +1,110 @@
+/*
+ * NetCDFClassicFormat.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef NETCDFCLASSICFORMAT_H_
+#define NETCDFCLASSICFORMAT_H_
+
+#include <string>
+#include <vector>
+#include <istream>
+
+namespace SedFlow {
+
+// Description and encoding of files in the NetCDF-3 classic format (CDF-1), as written by OutputRegularRiverReachPropertiesNetCDF
+// and read by NetCDFClassicReader. All numbers are stored big-endian, names as uint32 length followed by the characters padded to four bytes.
+//
+// Header:
+//   char[4]  magicNumber "CDF\x01"
+//   uint32   numberOfRecords (length of the unlimited record dimension)
+//   dimensions          (tag 0x0A, uint32 count, each as name and uint32 length, which is zero for the record dimension)
+//   global attributes   (tag 0x0C, uint32 count, each as name, uint32 type, uint32 number of values and the padded values)
+//   variables           (tag 0x0B, uint32 count, each as name, uint32 number of dimensions, uint32 dimensionIDs, attributes,
+//                        uint32 type, uint32 vsize (padded size of the variable or of one record of it) and uint32 begin (offset in the file))
+//   Empty lists are written as two zero uint32.
+// Data:
+//   The values of the fixed size variables one after the other, each padded to four bytes.
+//   Followed by the records, each of which contains the values of all record variables for one entry of the record dimension.
+class NetCDFClassicFormat {
+public:
+	enum NetCDFTypes {NCByte = 1, NCChar = 2, NCShort = 3, NCInt = 4, NCFloat = 5, NCDouble = 6};
+
+	struct Dimension {
+		std::string name;
+		unsigned int length; // Zero for the record dimension.
+	};
+
+	struct Attribute {
+		std::string name;
+		NetCDFTypes type;
+		std::string text; // Used for NCChar.
+		std::vector<double> values; // Used for all numeric types.
+	};
+
+	struct Variable {
+		std::string name;
+		std::vector<int> dimensionIDs; // For record variables the record dimension has to be the first one.
+		std::vector<Attribute> attributes;
+		NetCDFTypes type;
+		unsigned int vsize; // Set by calculateLayout.
+		unsigned int begin; // Set by calculateLayout.
+	};
+
+	std::vector<Dimension> dimensions;
+	std::vector<Attribute> globalAttributes;
+	std::vector<Variable> variables;
+
+	// Sets vsize and begin of all variables. The fixed size variables are placed directly after the header in the order of the variables.
+	void calculateLayout();
+
+	bool isRecordVariable(int variableIndex) const;
+	// The number of values of a fixed size variable or of one record of a record variable.
+	unsigned int getNumberOfValues(int variableIndex) const;
+	unsigned int getRecordSize() const;
+	unsigned int getBeginOfRecords() const;
+	unsigned int getHeaderSize() const;
+
+	void appendHeader(std::vector<char>& target, unsigned int numberOfRecords) const;
+	// Returns false, if the end of the stream has been reached before the header was complete. Throws, if the stream does not contain a classic NetCDF file.
+	bool readHeader(std::istream& source, unsigned int& numberOfRecords);
+
+	static const char magicNumber[4];
+	static const unsigned int offsetOfNumberOfRecords;
+	static int getSizeOfType(NetCDFTypes type);
+
+	static void appendUnsignedInt(std::vector<char>& target, unsigned int value);
+	static void appendInt(std::vector<char>& target, int value);
+	static void appendDouble(std::vector<char>& target, double value);
+	static void appendName(std::vector<char>& target, const std::string& name);
+	static void appendValue(std::vector<char>& target, NetCDFTypes type, double value);
+	static void appendPadding(std::vector<char>& target);
+	static double decodeValue(const char* bytes, NetCDFTypes type);
+
+	static bool readUnsignedInt(std::istream& source, unsigned int& value);
+	static bool readName(std::istream& source, std::string& name);
+};
+
+}
+
+#endif /* NETCDFCLASSICFORMAT_H_ */
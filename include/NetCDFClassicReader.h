@@ -0,0 +1,77 @@
+/*
+ * NetCDFClassicReader.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef NETCDFCLASSICREADER_H_
+#define NETCDFCLASSICREADER_H_
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "NetCDFClassicFormat.h"
+
+namespace SedFlow {
+
+// Minimal reader for files in the NetCDF-3 classic format (see NetCDFClassicFormat), as written by OutputRegularRiverReachPropertiesNetCDF.
+// The header is read on construction. The number of records is limited to the complete records present in the file,
+// so that files of running or aborted simulations can be read as well.
+class NetCDFClassicReader {
+private:
+	std::ifstream iFileStream;
+	std::string fileName;
+
+	NetCDFClassicFormat format;
+	unsigned int numberOfRecords;
+	std::vector<char> valueBuffer;
+
+	void readValues(int variableIndex, std::streamoff offset, std::vector<double>& values);
+	void throwInvalidVariableError(const std::string& variableName) const;
+
+	// The reader is neither copyable nor assignable.
+	NetCDFClassicReader(const NetCDFClassicReader&);
+	NetCDFClassicReader& operator = (const NetCDFClassicReader&);
+
+public:
+	NetCDFClassicReader(const std::string& fileName);
+	virtual ~NetCDFClassicReader(){}
+
+	inline const NetCDFClassicFormat& getFormat() const { return format; }
+	inline unsigned int getNumberOfRecords() const { return numberOfRecords; }
+	// Returns -1, if there is no variable with the given name.
+	int getVariableIndex(const std::string& variableName) const;
+	// Returns NULL, if there is no such attribute. An empty variable name refers to the global attributes.
+	const NetCDFClassicFormat::Attribute* getAttribute(const std::string& variableName, const std::string& attributeName) const;
+
+	// Reads all values of a fixed size variable.
+	std::vector<double> readVariable(const std::string& variableName);
+	// Reads a fixed size variable of type char. Each entry of the last dimension forms a string.
+	std::vector<std::string> readTextVariable(const std::string& variableName);
+	// Reads the values of a record variable for a single record.
+	std::vector<double> readRecord(const std::string& variableName, unsigned int recordIndex);
+};
+
+}
+
+#endif /* NETCDFCLASSICREADER_H_ */
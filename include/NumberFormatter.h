@@ -0,0 +1,70 @@
+/*
+ * NumberFormatter.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef NUMBERFORMATTER_H_
+#define NUMBERFORMATTER_H_
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace SedFlow {
+
+// Composes output lines in a reusable buffer and formats doubles in the same way as an std::ostream with std::scientific and the given precision,
+// i.e. like printf("%.*e"). For precisions up to maximumPrecisionForFastPath the digits are calculated directly from a single scaling by a power of ten.
+// Values, which are too close to a rounding tie to be decided this way, as well as infinite and NaN values are formatted by snprintf.
+class NumberFormatter {
+private:
+	int precision;
+	char fallbackFormat[16];
+	std::string line;
+
+	static const int maximumPrecisionForFastPath = 14;
+	static const int maximumPowerOfTen = 22;
+	static const std::vector<long double> powersOfTen;
+	static std::vector<long double> createPowersOfTen();
+
+	void appendScientificUsingSnprintf(double value);
+	void appendDigitsAndExponent(double roundedDigits, int exponent);
+
+public:
+	explicit NumberFormatter(int precision = 6);
+	virtual ~NumberFormatter(){}
+
+	void setPrecision(int precision);
+	inline int getPrecision() const { return precision; }
+
+	inline void clear() { line.clear(); }
+	inline void append(char character) { line.push_back(character); }
+	inline void append(const char* text) { line.append(text); }
+	void appendScientific(double value);
+
+	inline const std::string& getLine() const { return line; }
+	inline void writeLineTo(std::ostream& target) const { target.write(line.data(), line.size()); }
+};
+
+}
+
+#endif /* NUMBERFORMATTER_H_ */
@@ -26,6 +26,7 @@
 #define NUMERICROOTFINDER_H_
 
 #include "ConstructionVariables.h"
+#include "RootFinderDiagnostics.h"
 
 namespace SedFlow {
 
@@ -26,6 +26,8 @@
 #define OUTPUTACCUMULATEDBEDLOADTRANSPORT_H_
 
 #include "OutputMethodType.h"
+#include "BufferedOutputFileStream.h"
+#include "NumberFormatter.h"
 
 #include <string>
 #include <fstream>
@@ -35,31 +37,30 @@ namespace SedFlow {
 
 class OutputAccumulatedBedloadTransport: public OutputMethodType {
 private:
-	std::vector<Grains> accumulatedBedloadTransport;
+	// The accumulated volumes are stored as a contiguous array [reach][grain type][fraction] with the grain types in the order of typesOfGrainsOrderForOutput.
+	// The erosion of each time step is added in place, so that no Grains objects are created during the simulation.
+	std::vector<double> accumulatedBedloadTransport;
+	int numberOfFractions;
+	int numberOfValuesPerReach;
+	Grains grainsTemplate; // Only used for the conversion from and to ConstructionVariables.
 	bool outputDetailedFractional;
 
-	std::ofstream overallVolumeOFileStream;
-	std::ofstream detailedFractionalOFileStream;
+	BufferedOutputFileStream overallVolumeOFileStream;
+	BufferedOutputFileStream detailedFractionalOFileStream;
+	NumberFormatter overallVolumeLineFormatter;
+	NumberFormatter detailedFractionalLineFormatter;
 	std::string overallVolumeOutputFileAsString;
 	char* overallVolumeOutputFile;
 	std::string detailedFractionalOutputFileAsString;
 	char* detailedFractionalOutputFile;
 
 	bool outputIncludingPoreVolume;
-	CombinerVariables::TypesOfRegularRiverReachProperties ABTIncrementProperty;
 
 	std::vector<int> userCellIDsForOutput;
 
 	std::vector<const RegularRiverReachProperties*> cellPointersForOutput;
 	std::vector<CombinerVariables::TypesOfGrains> typesOfGrainsOrderForOutput;
 
-	std::vector<Grains>::iterator currentABT;
-	std::vector<Grains>::const_iterator currentConstABT;
-	std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrainsIterator;
-	const GrainType* currentGrainTypePointer;
-	std::vector<double> currentFractionalAbundances;
-	std::vector<double>::const_iterator currentFractionIterator;
-
 	std::vector<double> fractionalGrainDiameters;
 	std::vector<double>::const_iterator fractionalGrainDiametersBegin;
 	std::vector<double>::const_iterator fractionalGrainDiametersEnd;
@@ -73,9 +74,15 @@ public:
 	ConstructionVariables createConstructionVariables()const;
 
 	void initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	std::vector<std::string> getAppendedOutputFiles() const;
 	void update(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
 	void forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
 	void finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void flushOutput();
+
+	// Used for copies and for simulations continued from a checkpoint, which go on with the accumulated values so far.
+	void setAccumulatedBedloadTransport(const std::vector<Grains>& accumulatedBedloadTransport);
 };
 
 }
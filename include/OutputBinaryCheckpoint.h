@@ -0,0 +1,96 @@
+/*
+ * OutputBinaryCheckpoint.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef OUTPUTBINARYCHECKPOINT_H_
+#define OUTPUTBINARYCHECKPOINT_H_
+
+#include "OutputMethodType.h"
+
+#include <string>
+#include <vector>
+#include <istream>
+
+#include "ConstructionVariables.h"
+
+namespace SedFlow {
+
+// Writes the complete simulation state as checkpoint, from which the simulation can be continued with "sedFlow --restart checkpointFile".
+// The content is the same as for OutputVerbatimTranslationOfConstructionVariablesToXML. Each checkpoint still builds the complete tree
+// of ConstructionVariables (i.e. a copy of the whole state) and restarts use the builders of this tree. Building the tree is the larger part
+// of the cost of a checkpoint. Only the text is replaced by a binary encoding, so that the doubles are kept exactly and no text has to be formatted or parsed.
+// The checkpoint is first written into a temporary file, which replaces the previous checkpoint only once it is complete.
+//
+// Encoding (all numbers little-endian, strings as uint32 length followed by the characters, see BinaryColumnarOutputFormat):
+//   char[8]  magicNumber "SEDFLOWC"
+//   uint32   formatVersion
+//   object   sedFlow
+// with each object consisting of
+//   string   interfaceOrCombinerType
+//   string   realisationType
+//   uint32 number of labelledDoubles followed by the entries (string label, uint32 count, doubles)
+//   uint32 number of labelledInts followed by the entries (string label, uint32 count, int32s)
+//   uint32 number of labelledBools followed by the entries (string label, uint32 count, one byte each)
+//   uint32 number of labelledObjects followed by the entries (string label, uint32 count, objects)
+//   uint32 number of labelledStrings followed by the entries (string label, strings)
+class OutputBinaryCheckpoint: public OutputMethodType {
+private:
+	std::string outputFile;
+	bool checkpointIsDue;
+	std::vector<char> byteBuffer;
+
+	void writeCheckpoint(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	static void writeFileAtomically(const std::string& fileName, const std::vector<char>& content);
+
+public:
+	OutputBinaryCheckpoint(std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods);
+	virtual ~OutputBinaryCheckpoint(){}
+
+	OutputMethodType* createOutputMethodTypePointerCopy() const;
+
+	ConstructionVariables createConstructionVariables()const;
+
+	void initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes){}
+	void update(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes){}
+	void writeOutputLineIfScheduled(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes); //Overwrites the pre-implemented function of base class. Only marks the checkpoint as due.
+	void writeDeferredOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes); //Writes the checkpoint once all other output methods are done with the current time step.
+	void forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes){} //EMPTY as the state after an error is not worth a restart.
+	void finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes){}
+
+	static const char magicNumber[8];
+	static const unsigned int formatVersion;
+
+	static void appendConstructionVariables(std::vector<char>& target, const ConstructionVariables& constructionVariables);
+	// Returns false, if the end of the stream has been reached before the object was complete.
+	static bool readConstructionVariables(std::istream& source, ConstructionVariables& constructionVariables);
+
+	static ConstructionVariables readCheckpointFile(const char* checkpointFile);
+	// The files of the output methods, which append to their files, are cut back to their sizes at the time of the checkpoint,
+	// so that lines written after the checkpoint and before the interruption of the simulation are not repeated.
+	static void truncateAppendedOutputFilesToCheckpoint(const ConstructionVariables& sedFlowConstructionVariables);
+};
+
+}
+
+#endif /* OUTPUTBINARYCHECKPOINT_H_ */
@@ -37,6 +37,8 @@
 
 namespace SedFlow {
 
+class AsynchronousOutputWriter;
+
 class OutputMethodType {
 protected:
 	CombinerVariables::TypesOfOutputMethod typeOfOutputMethod;
@@ -61,6 +63,16 @@ protected:
 	double timeOfLastOutput;
 	std::vector<double> remainingTimesForOutputInReverseOrder;
 
+	// Flush policy for output methods, which keep their files open during the simulation (see BufferedOutputFileStream).
+	CombinerVariables::TypesOfOutputFlushPolicy flushPolicy;
+	int numberOfLinesBetweenFlushes;
+	double wallSecondsBetweenFlushes;
+
+	void addFlushPolicyToConstructionVariables(ConstructionVariables& target) const;
+
+	// Set by OutputMethods for asynchronous output. NULL for synchronous output.
+	AsynchronousOutputWriter* asynchronousOutputWriter;
+
 public:
 	OutputMethodType(std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods);
 	virtual ~OutputMethodType(){}
@@ -74,10 +86,23 @@ public:
 	virtual void writeOutputLineIfScheduled(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes); //Pre-Implemented
 	virtual void forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes) = 0;
 	virtual void finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes) = 0;
+	virtual void flushOutput(){} //Pre-Implemented for output methods without open files.
+	virtual void writeSnapshot(const std::vector<double>&){} //Pre-Implemented for output methods without asynchronous output. Called by the AsynchronousOutputWriter.
+	virtual void writeDeferredOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes){} //Pre-Implemented. Called serially after all output methods have written their lines of the current time step.
+	virtual void continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes){ initialiseOutput(allConstitutingOutputMethodTypes); } //Pre-Implemented for output methods, which do not append to their files. Called instead of initialiseOutput, when a simulation is restarted from a checkpoint.
+	virtual std::vector<std::string> getAppendedOutputFiles() const { return std::vector<std::string>(); } //Pre-Implemented for output methods, which do not append to their files.
+
+	inline void setAsynchronousOutputWriter(AsynchronousOutputWriter* asynchronousOutputWriter) { this->asynchronousOutputWriter = asynchronousOutputWriter; }
+
+	void setFlushPolicy(CombinerVariables::TypesOfOutputFlushPolicy flushPolicy, int numberOfLinesBetweenFlushes, double wallSecondsBetweenFlushes);
+	inline void copyFlushPolicy(const OutputMethodType& toCopy) { setFlushPolicy(toCopy.flushPolicy, toCopy.numberOfLinesBetweenFlushes, toCopy.wallSecondsBetweenFlushes); }
 
 	inline std::string getTypeOfOutputMethodAsString() const { return CombinerVariables::typeOfOutputMethodToString(typeOfOutputMethod); }
 	inline CombinerVariables::TypesOfOutputMethod getTypeOfOutputMethod() const { return typeOfOutputMethod; }
 
+	inline double getTimeOfLastOutput() const { return timeOfLastOutput; }
+	void setTimeOfLastOutput(double timeOfLastOutput);
+
 	static bool isDueToWriteLine(double elapsedSeconds, double& timeOfLastOutput, double outputInterval, std::vector<double>& remainingTimesForOutputInReverseOrder);
 	static bool isDueToWriteLineWithoutUpdatingParameters(double elapsedSeconds, double timeOfLastOutput, double outputInterval, const std::vector<double>& remainingTimesForOutputInReverseOrder);
 };
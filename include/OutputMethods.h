@@ -26,6 +26,7 @@
 #define OUTPUTMETHODS_H_
 
 #include "OutputMethodType.h"
+#include "AsynchronousOutputWriter.h"
 #include "RiverSystemProperties.h"
 #include "OverallParameters.h"
 #include "ConstructionVariables.h"
@@ -36,25 +37,38 @@ class OutputMethods {
 private:
 	std::vector<OutputMethodType*> constitutingOutputMethodTypes;
 
+	// With asynchronous output the output lines are formatted and written by a background thread, which is shared by all constituting output methods.
+	bool asynchronousOutput;
+	int asynchronousOutputQueueLength;
+	AsynchronousOutputWriter* asynchronousOutputWriter;
+	void createAsynchronousOutputWriterIfNeeded();
+	void deleteAsynchronousOutputWriter();
+
 	static std::vector<OutputMethodType*> forConstructorsCheckAndCopySingleOutputMethodTypes (const std::vector<OutputMethodType*>& singleOutputMethodTypes);
 
 public:
-	OutputMethods(){}
-	OutputMethods(const std::vector<OutputMethodType*>& singleOutputMethodTypes);
+	OutputMethods(): asynchronousOutput(false), asynchronousOutputQueueLength(16), asynchronousOutputWriter(NULL) {}
+	OutputMethods(const std::vector<OutputMethodType*>& singleOutputMethodTypes, bool asynchronousOutput = false, int asynchronousOutputQueueLength = 16);
 	OutputMethods(const OutputMethods& toCopy);
 	virtual ~OutputMethods();
 
 	ConstructionVariables createConstructionVariables()const;
 
 	void initialiseOutput()const;
+	// Replaces initialiseOutput, when a simulation is restarted from a checkpoint: The output methods append to their existing files.
+	void continueOutput()const;
 	void update();
 	void writeOutputLineIfScheduled();
 	void forcedWriteOutputLine()const;
 	void finaliseOutput()const;
+	void flushOutput()const;
+
+	void setTimesOfLastOutput(const std::vector<double>& timesOfLastOutput);
 
 	OutputMethods& operator = (const OutputMethods& newOutputMethods)
 	{
 		if (this != &newOutputMethods) {
+			this->deleteAsynchronousOutputWriter();
 			while(!(this->constitutingOutputMethodTypes.empty()))
 			{
 				delete this->constitutingOutputMethodTypes.back();
@@ -62,6 +76,9 @@ public:
 			}
 
 			this->constitutingOutputMethodTypes = OutputMethods::forConstructorsCheckAndCopySingleOutputMethodTypes( newOutputMethods.constitutingOutputMethodTypes );
+			this->asynchronousOutput = newOutputMethods.asynchronousOutput;
+			this->asynchronousOutputQueueLength = newOutputMethods.asynchronousOutputQueueLength;
+			this->createAsynchronousOutputWriterIfNeeded();
 			}
 			return *this;
 	}
@@ -26,6 +26,8 @@
 #define OUTPUTREGULARRIVERREACHPROPERTIES_H_
 
 #include "OutputMethodType.h"
+#include "BufferedOutputFileStream.h"
+#include "NumberFormatter.h"
 
 #include <fstream>
 #include <sstream>
@@ -33,18 +35,19 @@
 namespace SedFlow {
 
 class OutputRegularRiverReachProperties: public OutputMethodType {
-private:
-	std::ofstream oFileStream;
+protected:
+	BufferedOutputFileStream oFileStream;
 	std::ostringstream oStringStream;
 	std::string outputFileAsString;
 	char* outputFile;
 
 	std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput;
+	std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput;
 	std::vector<int> userCellIDsForOutput;
-	bool printUpstreamMargins;
-	bool printDownstreamMargin;
 	bool outputTimeStepLength;
 	bool outputInitialValues;
+	bool printUpstreamMargins;
+	bool printDownstreamMargin;
 
 	bool useSecondaryOutputInterval;
 	double primaryOutputInterval;
@@ -58,10 +61,36 @@ private:
 	std::vector<std::string> cellIDLabels;
 	std::vector<CombinerVariables::TypesOfGrains> typesOfGrainsOrderForOutput;
 
-	void appendGrainstoOStringStream(const Grains& toPrint);
-	std::string printGrains(const Grains& toPrint);
-	std::string printStrata(const std::vector<Grains>& toPrint);
-	std::string printGrainsProperty(const RegularRiverReachProperties* cellPointer, CombinerVariables::TypesOfRegularRiverReachProperties typeOfProperty);
+	std::vector<double> fractionalGrainDiameters;
+	std::vector<double>::const_iterator fractionalGrainDiametersBegin;
+	std::vector<double>::const_iterator fractionalGrainDiametersEnd;
+
+	// The values of an output line are collected in a snapshot first, which is written either directly or by the AsynchronousOutputWriter.
+	// The snapshot contains the ElapsedSeconds, the optional time step length and the values of all properties and reaches in the order of the header.
+	std::vector<double> currentSnapshot;
+	std::vector<int> snapshotBeginsOfProperties;
+	void collectCurrentSnapshot();
+	void appendPropertyValues(std::vector<double>& target, CombinerVariables::TypesOfRegularRiverReachProperties propertyType, double poreVolumeFactor);
+	void appendGrainsValues(std::vector<double>& target, const Grains& toAppend, double multiplicationFactor);
+	NumberFormatter lineFormatter;
+
+	// Properties, which are not output as InstantaneousValue, are aggregated over each output interval. The accumulators are updated in each call of update()
+	// and are stored as flat arrays containing all columns of the aggregated properties in the order of the snapshot.
+	// The time integral assigns the values at the end of a time step to the complete time step, which matches the explicit application of the change rates.
+	std::vector<int> aggregatedPropertyIndices;
+	std::vector<int> numberOfColumnsOfAggregatedProperties;
+	bool aggregationStarted;
+	double aggregationStartTime;
+	double timeOfLastAggregation;
+	std::vector<double> minimumValues;
+	std::vector<double> maximumValues;
+	std::vector<double> timeIntegrals;
+	std::vector<double> timesOfMaximum;
+	// Only the aggregated properties are collected in each time step. Their values are stored in the same order as the accumulators.
+	std::vector<double> currentAggregatedValues;
+	void updateAggregation(); // Starts the aggregation, if it has not been started yet.
+	void insertAggregatedValuesIntoCurrentSnapshotAndRestartAggregation();
+	std::string getPropertyLabelForOutput(int propertyIndex) const;
 
 	std::vector<const RegularRiverReachProperties*>::const_iterator currentCellPointerIterator;
 	std::vector<Grains>::const_iterator currentGrainsIterator;
@@ -70,12 +99,8 @@ private:
 	std::vector<double> currentFractionalAbundances;
 	std::vector<double>::const_iterator currentFractionIterator;
 
-	std::vector<double> fractionalGrainDiameters;
-	std::vector<double>::const_iterator fractionalGrainDiametersBegin;
-	std::vector<double>::const_iterator fractionalGrainDiametersEnd;
-
 public:
-	OutputRegularRiverReachProperties(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods);
+	OutputRegularRiverReachProperties(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods);
 	virtual ~OutputRegularRiverReachProperties();
 
 	OutputMethodType* createOutputMethodTypePointerCopy() const;
@@ -83,9 +108,17 @@ public:
 	ConstructionVariables createConstructionVariables()const;
 
 	void initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	std::vector<std::string> getAppendedOutputFiles() const;
 	void update(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
 	void forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
 	void finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void flushOutput();
+	void writeSnapshot(const std::vector<double>& snapshot);
+
+	// Used for copies and for simulations continued from a checkpoint, which go on with the current output interval. Empty, if the aggregation has not been started yet.
+	std::vector<double> getAggregationState() const;
+	void setAggregationState(const std::vector<double>& aggregationState);
 };
 
 }
@@ -0,0 +1,66 @@
+/*
+ * OutputRegularRiverReachPropertiesBinary.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef OUTPUTREGULARRIVERREACHPROPERTIESBINARY_H_
+#define OUTPUTREGULARRIVERREACHPROPERTIESBINARY_H_
+
+#include "OutputRegularRiverReachProperties.h"
+
+namespace SedFlow {
+
+// Writes the same reaches and properties as OutputRegularRiverReachProperties, but as little-endian doubles in fixed-width columns
+// with a self-describing header (see BinaryColumnarOutputFormat). The rows are collected in chunks of numberOfRowsPerChunk lines,
+// which are written column by column. The files can be read with BinaryColumnarOutputReader or converted to text with BinaryOutputConverter.
+class OutputRegularRiverReachPropertiesBinary: public OutputRegularRiverReachProperties {
+private:
+	int numberOfRowsPerChunk;
+	int numberOfStrataLayers;
+	std::vector<std::string> columnNames;
+
+	std::vector<double> chunkValues;
+	int numberOfRowsInCurrentChunk;
+	std::vector<char> byteBuffer;
+
+	void createColumnNames();
+	void writeCurrentChunk();
+
+public:
+	OutputRegularRiverReachPropertiesBinary(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, int numberOfRowsPerChunk, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods);
+	virtual ~OutputRegularRiverReachPropertiesBinary(){}
+
+	OutputMethodType* createOutputMethodTypePointerCopy() const;
+
+	ConstructionVariables createConstructionVariables()const;
+
+	void initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void flushOutput();
+	void writeSnapshot(const std::vector<double>& snapshot);
+};
+
+}
+
+#endif /* OUTPUTREGULARRIVERREACHPROPERTIESBINARY_H_ */
@@ -0,0 +1,72 @@
+/*
+ * OutputRegularRiverReachPropertiesDeltaEncoded.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef OUTPUTREGULARRIVERREACHPROPERTIESDELTAENCODED_H_
+#define OUTPUTREGULARRIVERREACHPROPERTIESDELTAENCODED_H_
+
+#include "OutputRegularRiverReachProperties.h"
+#include "DeltaEncodedOutputFormat.h"
+
+namespace SedFlow {
+
+// Writes the same reaches and properties as OutputRegularRiverReachProperties, but each output line contains only the layers
+// (single values, grains or single strata), which have changed by more than the changeTolerance since they have been written the last time
+// (see DeltaEncodedOutputFormat). Shifts of the strata due to the stratigraphy update are detected, so that the shifted strata need not be written again.
+// As the deeper strata hardly change, this is mainly intended for the strata, which cannot be written by the other binary outputs.
+// The files can be read with DeltaEncodedOutputReader or converted to text with DeltaEncodedOutputReconstruction.
+class OutputRegularRiverReachPropertiesDeltaEncoded: public OutputRegularRiverReachProperties {
+private:
+	double changeTolerance;
+	std::vector<DeltaEncodedOutputFormat::KindsOfProperty> kindsOfProperties;
+	int numberOfValuesPerGrains;
+
+	// The state of the layers as reconstructed by a reader of the file written so far.
+	std::vector<DeltaEncodedOutputFormat::Item> writtenItems;
+	std::vector<char> byteBuffer;
+	std::vector<char> layerCountChangesBuffer;
+	std::vector<char> shiftsBuffer;
+	std::vector<char> changedLayersBuffer;
+	std::vector<const double*> beginsOfNewLayers;
+
+	bool layerMatches(const std::vector<double>& writtenLayer, const double* newLayer, int numberOfValuesPerLayer) const;
+	int countMatchingLayers(const DeltaEncodedOutputFormat::Item& item, int shift, int numberOfValuesPerLayer) const;
+
+public:
+	OutputRegularRiverReachPropertiesDeltaEncoded(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, double changeTolerance, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods);
+	virtual ~OutputRegularRiverReachPropertiesDeltaEncoded(){}
+
+	OutputMethodType* createOutputMethodTypePointerCopy() const;
+
+	ConstructionVariables createConstructionVariables()const;
+
+	void initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void writeSnapshot(const std::vector<double>& snapshot);
+};
+
+}
+
+#endif /* OUTPUTREGULARRIVERREACHPROPERTIESDELTAENCODED_H_ */
@@ -26,6 +26,8 @@
 #define OUTPUTREGULARRIVERREACHPROPERTIESFORVISUALINTERPRETATION_H_
 
 #include "OutputMethodType.h"
+#include "BufferedOutputFileStream.h"
+#include "NumberFormatter.h"
 
 #include <fstream>
 #include <sstream>
@@ -34,7 +36,7 @@ namespace SedFlow {
 
 class OutputRegularRiverReachPropertiesForVisualInterpretation: public OutputMethodType {
 private:
-	std::ofstream oFileStream;
+	BufferedOutputFileStream oFileStream;
 	std::ostringstream oStringStream;
 	std::string outputFileAsString;
 	char* outputFile;
@@ -59,10 +61,11 @@ private:
 	std::vector<std::string> cellIDLabels;
 	std::vector<CombinerVariables::TypesOfGrains> typesOfGrainsOrderForOutput;
 
-	void appendGrainstoOStringStream(const Grains& toPrint);
-	std::string printGrains(const Grains& toPrint);
-	std::string printStrata(const std::vector<Grains>& toPrint);
-	std::string printGrainsProperty(const RegularRiverReachProperties* cellPointer, CombinerVariables::TypesOfRegularRiverReachProperties typeOfProperty);
+	// The output lines are composed in the lineFormatter and written to the oFileStream as a whole.
+	NumberFormatter lineFormatter;
+	void appendGrainsToLine(const Grains& toPrint, double multiplicationFactor);
+	void appendStrataToLine(const std::vector<Grains>& toPrint, double multiplicationFactor);
+	void appendGrainsPropertyToLine(const RegularRiverReachProperties* cellPointer, CombinerVariables::TypesOfRegularRiverReachProperties typeOfProperty);
 
 	std::vector<const RegularRiverReachProperties*>::const_iterator currentCellPointerIterator;
 	std::vector<Grains>::const_iterator currentGrainsIterator;
@@ -84,9 +87,12 @@ public:
 	ConstructionVariables createConstructionVariables()const;
 
 	void initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	std::vector<std::string> getAppendedOutputFiles() const;
 	void update(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
 	void forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
 	void finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void flushOutput();
 };
 
 }
@@ -0,0 +1,67 @@
+/*
+ * OutputRegularRiverReachPropertiesNetCDF.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef OUTPUTREGULARRIVERREACHPROPERTIESNETCDF_H_
+#define OUTPUTREGULARRIVERREACHPROPERTIESNETCDF_H_
+
+#include "OutputRegularRiverReachProperties.h"
+#include "NetCDFClassicFormat.h"
+
+namespace SedFlow {
+
+// Writes the same reaches and properties as OutputRegularRiverReachProperties into a file in the NetCDF-3 classic format (see NetCDFClassicFormat),
+// which can be opened by the common NetCDF tools without any conversion. The file has an unlimited time dimension and the dimensions reach, grainType and fraction.
+// The reach metadata (user cell IDs, labels, lengths and initial elevations), the grain type names and the fractional grain diameters are stored as fixed size variables.
+// Each output line is appended as one record containing the time, the optional time step length and one variable per property.
+// The number of records in the header is updated whenever the file is flushed. The files can be read with NetCDFClassicReader or printed with NetCDFOutputDump.
+class OutputRegularRiverReachPropertiesNetCDF: public OutputRegularRiverReachProperties {
+private:
+	NetCDFClassicFormat format;
+	int numberOfValuesPerRecord;
+	unsigned int numberOfRecords;
+	std::vector<char> byteBuffer;
+
+	void createFormat();
+	void appendFixedSizeVariables();
+	void updateNumberOfRecordsInFile();
+
+public:
+	OutputRegularRiverReachPropertiesNetCDF(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods);
+	virtual ~OutputRegularRiverReachPropertiesNetCDF(){}
+
+	OutputMethodType* createOutputMethodTypePointerCopy() const;
+
+	ConstructionVariables createConstructionVariables()const;
+
+	void initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void flushOutput();
+	void writeSnapshot(const std::vector<double>& snapshot);
+};
+
+}
+
+#endif /* OUTPUTREGULARRIVERREACHPROPERTIESNETCDF_H_ */
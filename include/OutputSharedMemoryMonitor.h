@@ -0,0 +1,73 @@
+/*
+ * OutputSharedMemoryMonitor.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef OUTPUTSHAREDMEMORYMONITOR_H_
+#define OUTPUTSHAREDMEMORYMONITOR_H_
+
+#include "OutputMethodType.h"
+#include "SharedMemoryRingBuffer.h"
+
+#include <string>
+#include <vector>
+
+namespace SedFlow {
+
+// Publishes selected per-reach properties every numberOfTimeStepsBetweenPublications time steps into a SharedMemoryRingBuffer,
+// so that a running simulation can be watched (e.g. with the SharedMemoryMonitorViewer) without any file output.
+// The name of the shared memory segment is given as the only output file. The output interval and the explicit times for output are not used.
+// Only properties, which are a single value per reach, can be published.
+class OutputSharedMemoryMonitor: public OutputMethodType {
+private:
+	std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput;
+	std::vector<int> userCellIDsForOutput;
+	std::vector<const RegularRiverReachProperties*> cellPointersForOutput;
+
+	int numberOfTimeStepsBetweenPublications;
+	int numberOfTimeStepsSinceLastPublication;
+	int numberOfSlots;
+
+	SharedMemoryRingBuffer ringBuffer;
+	std::vector<double> currentValues;
+
+	void publishCurrentValues();
+
+public:
+	OutputSharedMemoryMonitor(const std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>& regularRiverReachPropertiesForOutput, std::vector<int> userCellIDsForOutput, int numberOfTimeStepsBetweenPublications, int numberOfSlots, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods);
+	virtual ~OutputSharedMemoryMonitor(){}
+
+	OutputMethodType* createOutputMethodTypePointerCopy() const;
+
+	ConstructionVariables createConstructionVariables()const;
+
+	void initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void update(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes){}
+	void writeOutputLineIfScheduled(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes); //Overwrites the pre-implemented function of base class. Counts the time steps instead of the elapsed seconds.
+	void forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+	void finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes);
+};
+
+}
+
+#endif /* OUTPUTSHAREDMEMORYMONITOR_H_ */
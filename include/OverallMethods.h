@@ -44,6 +44,12 @@ public:
 
 	ConstructionVariables createConstructionVariables()const;
 
+	// The following methods recalculate the respective slope only if the reach or one of its immediate neighbours has been marked as modified since the last calculation.
+	// In debug builds a slope, which is not recalculated, is compared with a recalculation and an error is thrown if they differ.
+	void updateBedslope(RiverReachProperties& riverReachProperties) const;
+	void updateWaterEnergyslope(RiverReachProperties& riverReachProperties) const;
+	void updateSedimentEnergyslope(RiverReachProperties& riverReachProperties) const;
+
 	CalcGradient* bedSlopeCalculationMethod;
 	CalcGradient* waterEnergySlopeCalculationMethod;
 	CalcGradient* sedimentEnergySlopeCalculationMethod;
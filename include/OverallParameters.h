@@ -51,10 +51,6 @@ private:
 	double courantFriedrichsLewyNumber;
 	double timeStepThresholdForTerminatingSimulation;
 	double timeStepFactor;
-#if defined TIMESTEPANALYSIS
-	int numberOfTimeStepOutputs;
-	int maximumNumberOfTimeStepOutputs;
-#endif
 
 
 public:
@@ -94,10 +90,6 @@ public:
 	inline double getCourantFriedrichsLewyNumber() const { return courantFriedrichsLewyNumber; }
 	inline double getTimeStepThresholdForTerminatingSimulation() const { return timeStepThresholdForTerminatingSimulation; }
 	inline double getTimeStepFactor() const { return timeStepFactor; }
-	#if defined TIMESTEPANALYSIS
-	inline bool incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum() const { return ((++((const_cast<OverallParameters*>(this))->numberOfTimeStepOutputs)) >= this->maximumNumberOfTimeStepOutputs); }
-	inline int getMaximumNumberOfTimeStepOutputs() const { return maximumNumberOfTimeStepOutputs; }
-	#endif
 };
 
 }
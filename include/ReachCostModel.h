@@ -0,0 +1,94 @@
+/*
+ * ReachCostModel.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#ifndef REACHCOSTMODEL_H_
+#define REACHCOSTMODEL_H_
+
+#include <vector>
+
+#if defined SEDFLOWPARALLEL
+#include <omp.h>
+#endif
+
+namespace SedFlow {
+
+// Keeps track of the computational cost of the single items (e.g. reaches) of a per-reach loop.
+// In parallel mode the items are handed out to the threads in the order of decreasing cost learned from the previous time steps,
+// so that combined with dynamic scheduling expensive reaches (sills, bedrock, many root finder iterations) do not end up at the end of a loop.
+// In serial mode the natural order of the items is kept, as some of the loops depend on it.
+class ReachCostModel {
+private:
+	std::vector<double> smoothedCosts;
+	std::vector<double> costsOfCurrentTimeStep;
+	std::vector<int> processingOrder;
+	static const double weightOfCurrentTimeStep;
+
+public:
+	ReachCostModel(){}
+	virtual ~ReachCostModel(){}
+
+	// Has to be called once per time step before the loops. Adapts the model to the given number of items if necessary.
+	void updateProcessingOrder(int numberOfItems);
+	// For loops, which might run before the first call of updateProcessingOrder (e.g. during the initialisation).
+	void adaptToNumberOfItems(int numberOfItems);
+
+	inline int getNumberOfItems() const { return processingOrder.size(); }
+	inline int getIndexForForwardLoop(int position) const
+	{
+#if defined SEDFLOWPARALLEL
+		return processingOrder[position];
+#else
+		return position;
+#endif
+	}
+	inline int getIndexForBackwardLoop(int position) const
+	{
+#if defined SEDFLOWPARALLEL
+		return processingOrder[position];
+#else
+		return ( processingOrder.size() - 1 - position );
+#endif
+	}
+
+	inline double startMeasurement() const
+	{
+#if defined SEDFLOWPARALLEL
+		return omp_get_wtime();
+#else
+		return 0.0;
+#endif
+	}
+	// Each item is treated by a single thread within a loop. Thus no synchronisation is needed.
+#if defined SEDFLOWPARALLEL
+	inline void addMeasuredCost(int index, double startTime) { costsOfCurrentTimeStep[index] += omp_get_wtime() - startTime; }
+#else
+	inline void addMeasuredCost(int, double) {}
+#endif
+
+	inline const std::vector<double>& getSmoothedCosts() const { return smoothedCosts; }
+};
+
+}
+
+#endif /* REACHCOSTMODEL_H_ */
@@ -35,6 +35,7 @@
 #include "Grains.h"
 #include "RiverReachMethods.h"
 #include "ConstructionVariables.h"
+#include "ReachCostModel.h"
 
 namespace SedFlow {
 
@@ -45,6 +46,27 @@ private:
 	FlowMethods flowMethods;
 	ChangeRateModifiers changeRateModifiers;
 
+	// Schedule for calculateAndHandDownChanges: The river system is split into branches, i.e. unbranched chains of reaches between confluences.
+	// Branches of the same topological level do not depend on each other and may thus be treated in parallel.
+	int numberOfCellsInBranchSchedule;
+	std::vector< std::vector<int> > cellIDsPerBranch;
+	std::vector< std::vector<int> > joiningUpstreamCellIDsPerBranch;
+	std::vector< std::vector<int> > branchIDsPerTopologicalLevel;
+
+	void determineBranchSchedule(const RiverSystemProperties& parameters);
+
+	// Schedule for the deterministic mode (SEDFLOWDETERMINISTIC): The riverReachMethods grouped by their distance to the downstream margin.
+	// Treating these groups from downstream to upstream reproduces the serial backward loop, as only neighbouring reaches depend on each other.
+	int numberOfRiverReachMethodsInDownstreamDistanceSchedule;
+	std::vector< std::vector<int> > riverReachMethodsIDsPerDownstreamDistance;
+
+	void determineDownstreamDistanceSchedule(const RiverSystemProperties& parameters);
+	void updateBedSlopeAndOtherParameters(int riverReachMethodsID, const OverallMethods& overallMethods);
+
+	// Costs of the per-reach loops over the cells and over the riverReachMethods. They determine the order in which the reaches are handed out to the threads.
+	ReachCostModel costModelForCells;
+	ReachCostModel costModelForRiverReachMethods;
+
 public:
 	RegularRiverSystemMethods(std::vector<RiverReachMethods> riverReachMethods, FlowMethods flowMethods, ChangeRateModifiers changeRateModifiers);
 	virtual ~RegularRiverSystemMethods();
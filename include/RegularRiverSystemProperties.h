@@ -52,6 +52,9 @@ public:
 	std::vector<RiverReachProperties> cellProperties;
 
 	void setRegularCellParameters (const RegularRiverReachProperties& newParameters, int cellID);
+	// The margin cells are not part of the cellProperties in the ConstructionVariables, but are derived from their neighbours.
+	// Their current properties may be restored afterwards, e.g. when restarting from a checkpoint.
+	void setRegularPropertiesOfMarginCells (const std::vector<RegularRiverReachProperties>& newParameters);
 	std::vector<double> extractSingleRegularParameter (CombinerVariables::TypesOfRegularRiverReachProperties parameter) const;
 	void setSingleRegularParameter (CombinerVariables::TypesOfRegularRiverReachProperties parameter, const std::vector<double>& newValues);
 
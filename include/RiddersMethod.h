@@ -80,6 +80,7 @@ public:
 
 		for(int i = 1; i <= maximumNumberOfIterations; ++i)
 		{
+			RootFinderDiagnostics::countIteration();
 			mid = 0.5 * (firstBracket + secondBracket);
 			fMid = function(mid);
 			rootExpression = sqrt( ((fMid * fMid) - (fFirst * fSecond)) );
@@ -52,6 +52,14 @@ private:
 	const std::map<int,int>* mapFromRealCellIDtoUserCellID;
 	OverallParameters* overallParameters;
 
+	// Counters for skipping gradient recalculations: Each slope remembers the sum of the modification counters of this reach and its immediate neighbours it has been calculated for.
+	unsigned long modificationCounter;
+	unsigned long bedslopeBasedOnModificationCount;
+	unsigned long waterEnergyslopeBasedOnModificationCount;
+	unsigned long sedimentEnergyslopeBasedOnModificationCount;
+
+	inline void resetModificationCounters() { modificationCounter = 1; bedslopeBasedOnModificationCount = 0; waterEnergyslopeBasedOnModificationCount = 0; sedimentEnergyslopeBasedOnModificationCount = 0; }
+
 public:
 	RiverReachProperties(int cellID, RegularRiverReachProperties regularRiverReachProperties, AdditionalRiverReachProperties additionalRiverPropertiesAndMethods, const StrataSorting* strataSorting, const GeometricalChannelBehaviour* geometricalChannelBehaviour, const SillProperties* sillProperties, OverallParameters* overallParameters);
 	RiverReachProperties(int cellID,
@@ -92,6 +100,19 @@ public:
 	inline bool isUpstreamMargin() const { return upstreamMarginCell; }
 	inline bool isDownstreamMargin() const { return downstreamMarginCell; }
 
+	// Has to be called whenever the elevation, the water level or any other slope relevant property of this reach has been changed.
+	inline void markAsModified() { ++modificationCounter; }
+	unsigned long getNeighbourhoodModificationCount() const;
+
+	inline bool bedslopeNeedsUpdate() const { return ( bedslopeBasedOnModificationCount != getNeighbourhoodModificationCount() ); }
+	inline bool waterEnergyslopeNeedsUpdate() const { return ( waterEnergyslopeBasedOnModificationCount != getNeighbourhoodModificationCount() ); }
+	inline bool sedimentEnergyslopeNeedsUpdate() const { return ( sedimentEnergyslopeBasedOnModificationCount != getNeighbourhoodModificationCount() ); }
+	inline void setBedslopeBasedOnModificationCount(unsigned long neighbourhoodModificationCount) { bedslopeBasedOnModificationCount = neighbourhoodModificationCount; }
+	inline void setWaterEnergyslopeBasedOnModificationCount(unsigned long neighbourhoodModificationCount) { waterEnergyslopeBasedOnModificationCount = neighbourhoodModificationCount; }
+	inline void setSedimentEnergyslopeBasedOnModificationCount(unsigned long neighbourhoodModificationCount) { sedimentEnergyslopeBasedOnModificationCount = neighbourhoodModificationCount; }
+	inline void invalidateWaterEnergyslope() { waterEnergyslopeBasedOnModificationCount = 0; }
+	inline void invalidateSedimentEnergyslope() { sedimentEnergyslopeBasedOnModificationCount = 0; }
+
 	friend bool operator < (const RiverReachProperties& riverReachProperties1, const RiverReachProperties& riverReachProperties2)
 	{
 		return (riverReachProperties1.cellID < riverReachProperties2.cellID);
@@ -116,6 +137,7 @@ public:
 			delete this->sillProperties;
 			this->sillProperties = toBeAssigned.sillProperties->createSillPropertiesPointerCopy();
 			this->overallParameters = toBeAssigned.overallParameters;
+			this->resetModificationCounters();
 		}
 		return *this;
 	}
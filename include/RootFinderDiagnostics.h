@@ -0,0 +1,161 @@
+/*
+ * RootFinderDiagnostics.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef ROOTFINDERDIAGNOSTICS_H_
+#define ROOTFINDERDIAGNOSTICS_H_
+
+#include <vector>
+#include <map>
+#include <string>
+#include <utility>
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <math.h>
+
+#include "ConstructionVariables.h"
+
+namespace SedFlow {
+
+class RiverReachProperties;
+
+// Collects convergence statistics of the numeric root finders per call site and records the exact inputs of failed root searches.
+// The implementations of NumericRootFinder count their iterations and the bracket searches of BasicCalculations count their expansions
+// into counters of the current thread. The call sites take a snapshot of these counters before the search and hand the difference
+// together with the final residual to completeSolve. Each thread adds to its own statistics, which are summed up only for the summary.
+// If a search throws, the call site hands its inputs to recordFailure, which writes them together with a table of function values
+// to the replay file, so that the failure may be reproduced and accuracyForTerminatingIteration and maximumNumberOfIterations may be tuned.
+// As long as the diagnostics are not enabled, the only cost of a count is the check of a static flag.
+class RootFinderDiagnostics {
+public:
+	enum CallSites {FlowDepthForGivenDischarge, FlowDepthForGivenFroudeNumber, FlowDepthForMinimumHydraulicSlope, NumberOfCallSites};
+
+	struct Counters {
+		long iterations;
+		long bracketExpansions;
+		Counters(): iterations(0), bracketExpansions(0) {}
+	};
+
+	typedef std::vector< std::pair<std::string,std::string> > Parameters;
+
+private:
+	struct ThreadCounters {
+		Counters counters;
+		// Keeps the counters of different threads apart, so that they do not share cache lines.
+		char padding[64 - sizeof(Counters)];
+	};
+
+	struct ReachStatistics {
+		long calls;
+		long iterations;
+		long maximumIterations;
+		double maximumResidual;
+		ReachStatistics(): calls(0), iterations(0), maximumIterations(0), maximumResidual(0.0) {}
+	};
+
+	struct CallSiteStatistics {
+		long calls;
+		long failures;
+		int maximumNumberOfIterations;
+		double sumOfResiduals;
+		double maximumResidual;
+		// The index is the number of iterations or bracket expansions respectively.
+		std::vector<long> iterationHistogram;
+		std::vector<long> bracketExpansionHistogram;
+		// The keys are the user cell IDs. The reach ID -1 stands for searches without specific reach.
+		std::map<int,ReachStatistics> reaches;
+		CallSiteStatistics(): calls(0), failures(0), maximumNumberOfIterations(0), sumOfResiduals(0.0), maximumResidual(0.0) {}
+	};
+
+	struct ThreadStatistics {
+		CallSiteStatistics callSites[NumberOfCallSites];
+		// Keeps the statistics of different threads at least a cache line apart, as each solve writes to them.
+		char padding[64];
+	};
+
+	static bool enabled;
+	static std::vector<ThreadCounters> countersPerThread;
+	static std::vector<ThreadStatistics> statisticsPerThread;
+	static std::string replayFileName;
+	static std::ofstream replayFile;
+	static long numberOfRecordedFailures;
+	static const int numberOfSampledFunctionValues;
+
+	static int getThread();
+	static int getUserCellID(const RiverReachProperties* riverReachProperties);
+	static void countIterationInternally();
+	static void countBracketExpansionInternally();
+	static Counters getCountersInternally();
+	static void completeSolveInternally(CallSites callSite, const RiverReachProperties* riverReachProperties, const Counters& startCounters, double residual, int maximumNumberOfIterations);
+	static void writeFailure(CallSites callSite, const RiverReachProperties* riverReachProperties, const char* errorMessage, const std::string& typeOfNumericRootFinder, double expectedValue, std::pair<double,double> brackets, double accuracyForTerminatingIteration, int maximumNumberOfIterations, const Parameters& parameters, const std::vector< std::pair<double,double> >& sampledFunctionValues);
+	static std::vector<double> getSamplingPositions(double expectedValue, std::pair<double,double> brackets);
+	static std::vector<long> sumUpHistograms(CallSites callSite, bool iterations);
+	static long getPercentile(const std::vector<long>& histogram, double percentileRank);
+	static double getMean(const std::vector<long>& histogram);
+
+public:
+	// If a replay file name is given, the inputs of all failed root searches are written into it.
+	static void enable(const std::string& replayFileName = std::string());
+	static inline bool isEnabled() { return enabled; }
+
+	// Called by the root finders and bracket searches once per iteration or expansion respectively.
+	static inline void countIteration() { if(enabled) { countIterationInternally(); } }
+	static inline void countBracketExpansion() { if(enabled) { countBracketExpansionInternally(); } }
+
+	// Called by the call sites before starting the bracket search.
+	static inline Counters startSolve() { return ( enabled ? getCountersInternally() : Counters() ); }
+	// Called by the call sites after a successful root search. The residual is evaluated only while the diagnostics are enabled.
+	template <typename UnaryFunction> static inline void completeSolve(CallSites callSite, const RiverReachProperties* riverReachProperties, const Counters& startCounters, const UnaryFunction& function, double root, int maximumNumberOfIterations)
+		{ if(enabled) { completeSolveInternally(callSite, riverReachProperties, startCounters, fabs(function(root)), maximumNumberOfIterations); } }
+
+	// Called by the call sites, if the bracket search or the root finder throws. The brackets are NaN, if the bracket search failed.
+	// The function is sampled within the brackets or around the expected value respectively for the replay file.
+	template <typename UnaryFunction, typename NumericRootFinderType> static void recordFailure(CallSites callSite, const RiverReachProperties* riverReachProperties, const char* errorMessage, const UnaryFunction& function, const NumericRootFinderType* numericRootFinder, double expectedValue, std::pair<double,double> brackets, double accuracyForTerminatingIteration, int maximumNumberOfIterations, const Parameters& parameters)
+	{
+		if(!enabled) { return; }
+		std::vector<double> samplingPositions = getSamplingPositions(expectedValue, brackets);
+		std::vector< std::pair<double,double> > sampledFunctionValues;
+		sampledFunctionValues.reserve(samplingPositions.size());
+		for(std::vector<double>::const_iterator currentPosition = samplingPositions.begin(); currentPosition < samplingPositions.end(); ++currentPosition)
+		{
+			double functionValue;
+			try { functionValue = function(*currentPosition); }
+			catch(...) { functionValue = std::numeric_limits<double>::quiet_NaN(); }
+			sampledFunctionValues.push_back( std::make_pair(*currentPosition, functionValue) );
+		}
+		writeFailure(callSite, riverReachProperties, errorMessage, numericRootFinder->createConstructionVariables().realisationType, expectedValue, brackets, accuracyForTerminatingIteration, maximumNumberOfIterations, parameters, sampledFunctionValues);
+	}
+
+	static void addParameter(Parameters& parameters, const std::string& name, double value);
+	// Adds the realisation type and all labelled doubles of the construction variables, e.g. of a ChannelGeometry.
+	static void addParameters(Parameters& parameters, const std::string& prefix, const ConstructionVariables& constructionVariables);
+
+	static const char* callSiteToString(CallSites callSite);
+	static void printSummary(std::ostream& outputStream, int numberOfReportedReaches = 5);
+};
+
+}
+
+#endif /* ROOTFINDERDIAGNOSTICS_H_ */
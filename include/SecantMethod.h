@@ -79,6 +79,7 @@ public:
 
 		for(int i = 1; i <= maximumNumberOfIterations; ++i)
 		{
+			RootFinderDiagnostics::countIteration();
 			delta = (firstBracket - currentGuess) * (fCurrentGuess / (fCurrentGuess - fFirst));
 			firstBracket = currentGuess;
 			fFirst = fCurrentGuess;
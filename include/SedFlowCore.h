@@ -29,8 +29,12 @@
 #define SEDFLOWCORE_H_
 
 #include "SedFlowHeaders.h"
+#include "StageProfiler.h"
+#include "TimeStepConstraintDiagnostics.h"
+#include "RootFinderDiagnostics.h"
 
 #include <vector>
+#include <string>
 
 namespace SedFlow {
 
@@ -42,13 +46,17 @@ private:
 	RiverSystemMethods* riverSystemMethods;
 	OutputMethods* outputMethods;
 
+	// With a setupCacheFolder the input reader takes the river system converted from the spreadsheets from the SetupCache if possible and stores it there otherwise.
+	static ConstructionVariables readInputXMLFile(const char* inputXMLfile, const std::string& setupCacheFolder);
 
 public:
-	static inline int runSimulation(const char* inputXMLfile)
+	// With restartFromCheckpoint the inputFile is a checkpoint written by OutputBinaryCheckpoint instead of an input XML file.
+	// The setupCacheFolder is only used for input XML files.
+	static inline int runSimulation(const char* inputFile, bool restartFromCheckpoint = false, const std::string& setupCacheFolder = std::string())
 	{
 		try
 		{
-			SedFlowCore sedFlow = initialise(inputXMLfile);
+			SedFlowCore sedFlow = initialise(inputFile, restartFromCheckpoint, setupCacheFolder);
 
 			try
 			{
@@ -59,8 +67,18 @@ public:
 					sedFlow.performTimeStep();
 				}
 				sedFlow.checkForInfiniteOrNaNTimeSteps();
+				StageProfiler::finish(std::cout);
+				TimeStepConstraintDiagnostics::printSummary(std::cout);
+				RootFinderDiagnostics::printSummary(std::cout);
 
 			} catch (...) {
+				// The diagnostics are printed first, as they are of particular interest for aborted simulations.
+				StageProfiler::finish(std::cout);
+				TimeStepConstraintDiagnostics::printSummary(std::cout);
+				RootFinderDiagnostics::printSummary(std::cout);
+				// The output files are kept open behind large buffers. Thus everything written so far is flushed first,
+				// so that it is not lost, if writing the final output line fails as well.
+				sedFlow.outputMethods->flushOutput();
 				sedFlow.outputMethods->forcedWriteOutputLine();
 				sedFlow.finish();
 				throw; }
@@ -75,47 +93,64 @@ public:
 		return 0;
 	}
 
-	SedFlowCore(const char* inputXMLfile);
+	// When restarting from a checkpoint, the output files are cut back to their sizes at the time of the checkpoint.
+	SedFlowCore(const char* inputFile, bool restartFromCheckpoint = false, const std::string& setupCacheFolder = std::string());
 
-	static inline SedFlowCore initialise(const char* inputXMLfile)
+	static inline SedFlowCore initialise(const char* inputFile, bool restartFromCheckpoint = false, const std::string& setupCacheFolder = std::string())
 	{
-		SedFlowCore sedFlow = SedFlowCore(inputXMLfile);
+		SedFlowCore sedFlow = SedFlowCore(inputFile, restartFromCheckpoint, setupCacheFolder);
 
-		RegularRiverReachProperties& downstreamMarginProperties = (sedFlow.riverSystemProperties->regularRiverSystemProperties.cellProperties.back()).regularRiverReachProperties;
-		downstreamMarginProperties.waterEnergyslope = downstreamMarginProperties.bedslope;
+		if(restartFromCheckpoint)
+		{
+			// The checkpoint has been written at the end of a time step. Thus all properties and accumulated outputs are up to date already.
+			sedFlow.outputMethods->continueOutput();
+		}
+		else
+		{
+			RegularRiverReachProperties& downstreamMarginProperties = (sedFlow.riverSystemProperties->regularRiverSystemProperties.cellProperties.back()).regularRiverReachProperties;
+			downstreamMarginProperties.waterEnergyslope = downstreamMarginProperties.bedslope;
 
-		if (sedFlow.overallParameters->updateRegularPropertiesAfterInitialisation) { sedFlow.riverSystemMethods->updateRegularProperties(); }
-		if (sedFlow.overallParameters->updateAdditionalRiverReachPropertiesAfterInitialisation) { sedFlow.riverSystemMethods->updateAdditionalRiverReachProperties(); }
-		if (sedFlow.overallParameters->updateOutputMethodsAfterInitialisation) { sedFlow.outputMethods->update(); }
-		sedFlow.outputMethods->initialiseOutput();
+			if (sedFlow.overallParameters->updateRegularPropertiesAfterInitialisation) { sedFlow.riverSystemMethods->updateRegularProperties(); }
+			if (sedFlow.overallParameters->updateAdditionalRiverReachPropertiesAfterInitialisation) { sedFlow.riverSystemMethods->updateAdditionalRiverReachProperties(); }
+			if (sedFlow.overallParameters->updateOutputMethodsAfterInitialisation) { sedFlow.outputMethods->update(); }
+			sedFlow.outputMethods->initialiseOutput();
+		}
 		return sedFlow;
 	}
 
 	inline void performTimeStep()
 	{
+		StageProfiler::beginStage(StageProfiler::CalculateAndModifyChangeRates);
 		riverSystemMethods->calculateAndModifyChangeRates();
 			/*
 			 * More complex succession of function calls
 			 */
+		StageProfiler::beginStage(StageProfiler::CalculateTimeStep);
 		overallParameters->currentTimeStepLengthInSeconds = riverSystemMethods->calculateTimeStep() * overallParameters->getTimeStepFactor();
 			/* i.e.
 			 * riverSystem.flowMethods.getExtremeChangeRates()
 			 * riverSystem.flowMethods.calculateTimeStep()
 			 */
+		TimeStepConstraintDiagnostics::completeTimeStep(overallParameters->currentTimeStepLengthInSeconds, overallParameters->elapsedSeconds);
+		StageProfiler::beginStage(StageProfiler::CalculateAndHandDownChanges);
 		riverSystemMethods->calculateAndHandDownChanges();
 			/* i.e.
 			 * riverSystem.flowMethods.calculateAndHandDownChanges()
 			 * riverSystem.flowMethods.handDownChanges()
 			 */
+		StageProfiler::beginStage(StageProfiler::PerformAdditionalReachActions);
 		riverSystemMethods->performAdditionalReachActions();
+		StageProfiler::beginStage(StageProfiler::PerformAdditionalRiverSystemActions);
 		riverSystemMethods->performAdditionalRiverSystemActions();
 			/* i.e.
 			 * riverSystem.parameters.additionalCellParameters.typeSpecificActions()
 			 */
+		StageProfiler::beginStage(StageProfiler::ApplyChanges);
 		riverSystemMethods->applyChanges();
 			/* i.e.
 			 * riverSystem.flowMethods.applyChanges()
 			 */
+		StageProfiler::beginStage(StageProfiler::UpdateRegularProperties);
 		riverSystemMethods->updateRegularProperties();
 			/* i.e.
 			 * riverSystem.updateBedSlopes();
@@ -125,6 +160,7 @@ public:
 			 * riverSystem.updateTaus();
 			 * riverSystem.updateActiveWidths();
 			 */
+		StageProfiler::beginStage(StageProfiler::UpdateAdditionalRiverReachProperties);
 		riverSystemMethods->updateAdditionalRiverReachProperties();
 			/* i.e.
 			 * riverSystem.parameters.additionalCellParameters.update()
@@ -132,9 +168,10 @@ public:
 
 		overallParameters->elapsedSeconds += overallParameters->currentTimeStepLengthInSeconds;
 
+		StageProfiler::beginStage(StageProfiler::Output);
 		outputMethods->update();
 		outputMethods->writeOutputLineIfScheduled();
-
+		StageProfiler::completeTimeStep(overallParameters->elapsedSeconds);
 	}
 
 	inline void finish()
@@ -90,10 +90,15 @@
 #include "NoHiding.h"
 #include "NumericRootFinder.h"
 #include "OutputAccumulatedBedloadTransport.h"
+#include "OutputBinaryCheckpoint.h"
 #include "OutputMethods.h"
 #include "OutputMethodType.h"
 #include "OutputRegularRiverReachProperties.h"
+#include "OutputRegularRiverReachPropertiesBinary.h"
+#include "OutputRegularRiverReachPropertiesNetCDF.h"
+#include "OutputRegularRiverReachPropertiesDeltaEncoded.h"
 #include "OutputRegularRiverReachPropertiesForVisualInterpretation.h"
+#include "OutputSharedMemoryMonitor.h"
 #include "OutputSimulationSetup.h"
 #include "OutputVerbatimTranslationOfConstructionVariablesToXML.h"
 #include "OverallMethods.h"
@@ -138,6 +143,7 @@
 #include "SedimentFlowMethods.h"
 #include "SedimentFlowTypeMethods.h"
 #include "SetActiveWidthEqualFlowWidth.h"
+#include "SetupCache.h"
 #include "SillProperties.h"
 #include "SimpleDownstreamTwoCellGradient.h"
 #include "SimpleDownstreamTwoCellGradientWithCenteredValues.h"
@@ -0,0 +1,74 @@
+/*
+ * SetupCache.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#ifndef SETUPCACHE_H_
+#define SETUPCACHE_H_
+
+#include <string>
+
+#include "ConstructionVariables.h"
+
+namespace SedFlow {
+
+// Cache of the river systems converted from the spreadsheets, which is used with "sedFlow --setupCache cacheFolder inputFile".
+// Each river system is stored in its own file within the cache folder, which is named after a hash of all files within the folders
+// LongitudinalProfile, DischargeAndOtherInputs and GrainSizeDistributions and of those parts of the input XML file, which are used
+// for the conversion of the spreadsheets. Thus repeated starts of the same set-up skip the conversion of the spreadsheets,
+// while e.g. changes of the parameters of the bedload transport equations within a calibration still use the cached river system.
+// As the river systems contain absolute paths, the path of the set-up is part of the hash as well.
+// The file Output/ReachIDExplanations.txt, which is written while the spreadsheets are converted, is restored from the cache.
+//
+// Encoding (see OutputBinaryCheckpoint for the encoding of the ConstructionVariables):
+//   char[8]  magicNumber "SEDFLOWS"
+//   uint32   formatVersion
+//   uint32   lower and uint32 upper half of the key
+//   string   content of Output/ReachIDExplanations.txt
+//   object   river system as provided by the input reader
+class SetupCache {
+private:
+	static std::string cacheFolder;
+
+	static std::string getCacheFileName(unsigned long long key);
+	static std::string getReachIDExplanationsFileName(std::string path);
+
+public:
+	static const char magicNumber[8];
+	// The build of sedFlow is not part of the key. Thus the formatVersion has to be increased
+	// with each change of the input readers or of the builders, which alters the cached river systems.
+	static const unsigned int formatVersion;
+
+	// An empty cacheFolder disables the cache.
+	static void setCacheFolder(const std::string& cacheFolder);
+	static inline bool isEnabled() { return !(cacheFolder.empty()); }
+
+	// The relevantInputXML contains those parts of the input XML file, which are used for the conversion of the spreadsheets.
+	static unsigned long long calculateKey(const std::string& relevantInputXML, std::string path);
+	// Returns false, if there is no valid entry for the key.
+	static bool load(unsigned long long key, const std::string& path, ConstructionVariables& riverSystem);
+	static void store(unsigned long long key, const std::string& path, const ConstructionVariables& riverSystem);
+};
+
+}
+
+#endif /* SETUPCACHE_H_ */
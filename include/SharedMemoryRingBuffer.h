@@ -0,0 +1,121 @@
+/*
+ * SharedMemoryRingBuffer.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef SHAREDMEMORYRINGBUFFER_H_
+#define SHAREDMEMORYRINGBUFFER_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace SedFlow {
+
+// Ring buffer of per-reach values in a named shared memory segment (POSIX shm_open on Linux, named file mapping on Windows).
+// A single writer (OutputSharedMemoryMonitor) publishes records, while any number of readers (e.g. the SharedMemoryMonitorViewer)
+// may attach and read them. The writer never waits for the readers: Each slot is protected by a sequence lock, i.e. its sequence
+// number is odd while the slot is written. A reader copies the slot and retries, if the sequence number was odd or has changed.
+//
+// Layout (native byte order, as writer and readers run on the same machine):
+//   char[8]  magicNumber "SEDFLOWM" (written last, once the segment is complete)
+//   uint32   formatVersion
+//   uint32   headerSize (offset of the first slot in bytes)
+//   uint32   numberOfReaches
+//   uint32   numberOfProperties
+//   uint32   numberOfSlots
+//   uint32   slotSize (in bytes)
+//   uint64   latestRecordNumber (records are numbered starting with 1, zero if nothing has been published yet)
+//   uint32   writerState (1 while the simulation is running, 2 after the simulation has finished)
+//   uint32   padding
+//   int32    userCellIDs[numberOfReaches]
+//   char     propertyNames[numberOfProperties][lengthOfPropertyNames] (zero terminated)
+// followed by numberOfSlots slots, of which record n is stored in slot (n-1) % numberOfSlots:
+//   uint64   sequenceNumber
+//   uint64   recordNumber
+//   double   elapsedSeconds
+//   double   timeStepLengthInSeconds
+//   double   values[numberOfProperties][numberOfReaches]
+class SharedMemoryRingBuffer {
+private:
+	struct PlatformHandle;
+	PlatformHandle* platformHandle;
+
+	std::string name;
+	bool isWriter;
+	char* mappedMemory;
+	std::size_t mappedSize;
+
+	int numberOfReaches;
+	int numberOfProperties;
+	int numberOfSlots;
+	std::size_t headerSize;
+	std::size_t slotSize;
+	std::vector<int> userCellIDs;
+	std::vector<std::string> propertyNames;
+
+	static std::size_t calculateHeaderSize(int numberOfReaches, int numberOfProperties);
+	static std::size_t calculateSlotSize(int numberOfReaches, int numberOfProperties);
+	char* getSlot(unsigned long long recordNumber) const;
+
+	// The buffer owns a mapping. Thus it is neither copyable nor assignable.
+	SharedMemoryRingBuffer(const SharedMemoryRingBuffer&);
+	SharedMemoryRingBuffer& operator = (const SharedMemoryRingBuffer&);
+
+public:
+	SharedMemoryRingBuffer();
+	virtual ~SharedMemoryRingBuffer();
+
+	// Creates the segment for writing. An existing segment of the same name is replaced.
+	void create(const std::string& name, const std::vector<std::string>& propertyNames, const std::vector<int>& userCellIDs, int numberOfSlots);
+	// Attaches to an existing segment for reading. Throws, if there is no complete segment of the current format version.
+	void attach(const std::string& name);
+	// Unmaps the segment. If this is the writer, the name of the segment is removed as well, while attached readers may still read it.
+	void detach();
+	inline bool isAttached() const { return ( mappedMemory != NULL ); }
+
+	// The values are ordered as values[property][reach].
+	void publish(double elapsedSeconds, double timeStepLengthInSeconds, const std::vector<double>& values);
+	void markWriterFinished();
+
+	unsigned long long getLatestRecordNumber() const;
+	bool writerHasFinished() const;
+	// Returns false, if the record has already been overwritten by a newer one or has not yet been published.
+	bool readRecord(unsigned long long recordNumber, double& elapsedSeconds, double& timeStepLengthInSeconds, std::vector<double>& values) const;
+
+	inline int getNumberOfReaches() const { return numberOfReaches; }
+	inline int getNumberOfProperties() const { return numberOfProperties; }
+	inline int getNumberOfSlots() const { return numberOfSlots; }
+	inline const std::vector<int>& getUserCellIDs() const { return userCellIDs; }
+	inline const std::vector<std::string>& getPropertyNames() const { return propertyNames; }
+
+	static const char magicNumber[8];
+	static const unsigned int formatVersion;
+	static const int lengthOfPropertyNames;
+	// Converts the name into the form needed by the platform: With a leading slash for POSIX and in the session namespace "Local\" on Windows.
+	static std::string getPlatformName(const std::string& name);
+};
+
+}
+
+#endif /* SHAREDMEMORYRINGBUFFER_H_ */
@@ -0,0 +1,134 @@
+/*
+ * StageProfiler.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef STAGEPROFILER_H_
+#define STAGEPROFILER_H_
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+
+#include "CombinerVariables.h"
+#include "AllocationTracker.h"
+
+namespace SedFlow {
+
+// Measures the wall clock and CPU time of the stages of SedFlowCore::performTimeStep. Within each stage the time is further split
+// into sections, which correspond to the implementations of FlowTypeMethods, AdditionalRiverReachMethodType, AdditionalRiverSystemMethodType
+// and OutputMethodType. The sections are measured within the parallel regions as well. Thus each thread adds to its own accumulators,
+// which are summed up only for the reports. The state is static, as the sections are spread over the complete method hierarchy.
+// The same measurements are handed to the ExecutionTrace, if a trace has been requested.
+// If sedFlow is built with the AllocationTracker, the heap allocations are counted per stage and per time step as well.
+// As long as neither profiling nor tracing is active, the only cost of a measurement is the check of a static flag.
+class StageProfiler {
+public:
+	enum Stages {CalculateAndModifyChangeRates, CalculateTimeStep, CalculateAndHandDownChanges, PerformAdditionalReachActions, PerformAdditionalRiverSystemActions, ApplyChanges, UpdateRegularProperties, UpdateAdditionalRiverReachProperties, Output, NumberOfStages};
+
+private:
+	// Profiling or tracing has been requested.
+	static bool enabled;
+	// Profiling or tracing is active for the current time step.
+	static bool measuring;
+	static bool profiling;
+	static bool tracing;
+	static long firstTracedTimeStep;
+	static long endOfTracedTimeSteps;
+	static int currentStage;
+	static double startWallTimeOfCurrentStage;
+	static double startCPUTimeOfCurrentStage;
+	static double startWallTimeOfProfiling;
+	static double wallTimeOfLastCompletedTimeStep;
+
+	static int firstSectionForFlowMethods;
+	static int firstSectionForAdditionalRiverReachMethods;
+	static int firstSectionForAdditionalRiverSystemMethods;
+	static int firstSectionForOutputMethods;
+	static std::vector<std::string> sectionNames;
+
+	static std::vector<double> wallSecondsPerStage;
+	static std::vector<double> cpuSecondsPerStage;
+	// Per thread and per stage times number of sections.
+	static std::vector< std::vector<double> > wallSecondsPerThreadAndSection;
+	static std::vector< std::vector<long> > callsPerThreadAndSection;
+	static long numberOfCompletedTimeSteps;
+
+	static AllocationTracker::Snapshot allocationsAtStartOfCurrentStage;
+	static AllocationTracker::Snapshot allocationsAtLastCompletedTimeStep;
+	static std::vector<long long> allocationsPerStage;
+	static std::vector<long long> bytesPerStage;
+	static long long maximumAllocationsPerTimeStep;
+	static long long maximumBytesPerTimeStep;
+	static long numberOfTimeStepsWithoutAllocations;
+
+	static std::ofstream csvFile;
+	static int csvInterval;
+	static std::vector<double> wallSecondsPerStageAtLastCSVLine;
+	static std::vector<double> cpuSecondsPerStageAtLastCSVLine;
+	static std::vector<double> wallSecondsPerSectionAtLastCSVLine;
+	static std::vector<long> callsPerSectionAtLastCSVLine;
+
+	static double currentWallTime();
+	static double currentCPUTime();
+	static void switchStage(int stage);
+	static void addToSection(int section, double startTime);
+	static void initialise();
+	static void updateTracing();
+	static void writeCSVLine(double elapsedSeconds);
+	static void printAllocationSummary(std::ostream& outputStream);
+	static std::vector<double> sumOverThreads(const std::vector< std::vector<double> >& perThreadValues);
+	static std::vector<long> sumOverThreads(const std::vector< std::vector<long> >& perThreadValues);
+
+public:
+	// Has to be called before the simulation starts. With a csvFileName, the times of the last csvInterval time steps are appended to the file every csvInterval time steps.
+	static void enable(const std::string& csvFileName = std::string(), int csvInterval = 0);
+	// Has to be called before the simulation starts as well. Records the numberOfTimeSteps time steps starting with the (zero-based) firstTimeStep into the ExecutionTrace,
+	// which is written to the traceFileName at the end of the simulation.
+	static void enableTracing(const std::string& traceFileName, long firstTimeStep, long numberOfTimeSteps);
+	static inline bool isEnabled() { return enabled; }
+
+	// Closes the previous stage, if there is any.
+	static inline void beginStage(Stages stage) { if(measuring) { switchStage(stage); } }
+	// Closes the last stage of the time step.
+	static inline void completeTimeStep(double elapsedSeconds) { if(enabled) { completeTimeStepInternally(elapsedSeconds); } }
+	static void completeTimeStepInternally(double elapsedSeconds);
+
+	static inline int getSectionForFlowMethods(CombinerVariables::TypesOfFlowMethods typeOfFlowMethods) { return firstSectionForFlowMethods + typeOfFlowMethods; }
+	static inline int getSectionForAdditionalRiverReachMethods(CombinerVariables::TypesOfAdditionalRiverReachPropertyAndMethod typeOfAdditionalRiverReachPropertyAndMethod) { return firstSectionForAdditionalRiverReachMethods + typeOfAdditionalRiverReachPropertyAndMethod; }
+	static inline int getSectionForAdditionalRiverSystemMethods(CombinerVariables::TypesOfAdditionalRiverSystemPropertyAndMethod typeOfAdditionalRiverSystemPropertyAndMethod) { return firstSectionForAdditionalRiverSystemMethods + typeOfAdditionalRiverSystemPropertyAndMethod; }
+	static inline int getSectionForOutputMethods(CombinerVariables::TypesOfOutputMethod typeOfOutputMethod) { return firstSectionForOutputMethods + typeOfOutputMethod; }
+
+	// May be called by any thread. The section is attributed to the current stage.
+	static inline double startSection() { return ( measuring ? currentWallTime() : 0.0 ); }
+	static inline void finishSection(int section, double startTime) { if(measuring) { addToSection(section, startTime); } }
+
+	// Prints the summary of the profiling and writes the trace file, if requested.
+	static void finish(std::ostream& outputStream);
+	static void printSummary(std::ostream& outputStream);
+};
+
+}
+
+#endif /* STAGEPROFILER_H_ */
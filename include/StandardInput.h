@@ -97,6 +97,24 @@ public:
 	}
 };
 
+// Columns of a LongitudinalProfile spreadsheet of a single branch.
+class LongitudinalProfileForStandardInput {
+public:
+	std::vector<std::string> kilometersAsString;
+	std::vector<double> kilometers;
+	std::vector<double> elevations;
+	std::vector<double> channelWidths;
+	std::vector<double> alluviumThicknesses;
+	bool bedrockRoughnessGiven;
+	std::vector<double> bedrockRoughnessEquivalentRepresentativeGrainDiameters;
+	std::vector<std::string> strataGrainSizeDistributions;
+	std::vector<std::string> surfaceLayerGrainSizeDistributions;
+
+	LongitudinalProfileForStandardInput():
+		bedrockRoughnessGiven(false)
+	{}
+};
+
 class RiverSystemInformation {
 public:
 	std::vector<RiverBranchForStandardInput> riverBranches;
@@ -108,6 +126,11 @@ public:
 class StandardOutputCharacteristics {
 public:
 	bool forVisualInterpretation;
+	bool binaryOutput;
+	bool netCDFOutput;
+	bool deltaEncodedOutput;
+	int numberOfRowsPerChunk;
+	double changeTolerance;
 	std::vector<double> explicitTimesForOutput;
 	double outputInterval;
 	int precisionForOutput;
@@ -122,6 +145,10 @@ public:
 	std::string referenceProperty;
 	double thresholdToBeExceeded;
 	double secondaryOutputInterval;
+	std::string flushPolicy;
+	int numberOfLinesBetweenFlushes;
+	double wallSecondsBetweenFlushes;
+	std::string aggregationForOutput;
 };
 
 
@@ -133,6 +160,11 @@ private:
 	ConstructionVariables createRiverSystemMethods(pugi::xml_node rootNode, std::string path, const RiverSystemInformation& riverSystemInformation)const;
 	ConstructionVariables createOutputMethods(pugi::xml_node rootNode, std::string path, const RiverSystemInformation& riverSystemInformation)const;
 
+	// The parts of the input XML file, which are used by createRiverSystemPropertiesAndRiverSystemInformation. They form the key of the SetupCache.
+	static std::string collectInputXMLForRiverSystemProperties(pugi::xml_node rootNode);
+	static ConstructionVariables convertRiverSystemInformationIntoConstructionVariables(const RiverSystemInformation& riverSystemInformation);
+	static RiverSystemInformation convertConstructionVariablesIntoRiverSystemInformation(const ConstructionVariables& constructionVariables);
+
 	static ConstructionVariables createReturnBedslope();
 	static ConstructionVariables createSimpleDownstreamTwoCellGradient(CombinerVariables::TypesOfRegularRiverReachProperties propertyOfInterest);
 	static bool addCalcGradientToConstructionVariables(ConstructionVariables& target, pugi::xml_node rootNode, std::string name, bool isSedimentEnergySlope, const ConstructionVariables& flowResistance, CombinerVariables::TypesOfFlowMethods typeOfWaterFlowMethods, const ConstructionVariables& defaultValue);
@@ -143,8 +175,9 @@ private:
 	static bool addCalcThresholdForInitiationOfBedloadMotionToConstructionVariables(ConstructionVariables& target, pugi::xml_node rootNode, std::string name);
 	static bool addCalcHidingFactorsToConstructionVariables(ConstructionVariables& target, pugi::xml_node rootNode, std::string name);
 	static ConstructionVariables createRiverReachMethodsWithCertainCellID (pugi::xml_node riverSystemMethodsNode, int cellID, bool nonFractional, const std::map<int,ConstructionVariables>& mapFromCellIDToInstantaneousSedimentInputs);
-	static std::vector<ConstructionVariables> createDischargeTimeSeriesFromSpreadsheets (std::string path, const RiverSystemInformation& riverSystemInformation);
-	static std::vector<ConstructionVariables> createSedimentInputTimeSeriesFromSpreadsheets (std::string path, const RiverSystemInformation& riverSystemInformation, bool inputUpperBoundaryInsteadOfMeanGrainDiameter, bool useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters, double lowerDiameterBoundaryForFinestFractionInCM, double poreVolumeFraction);
+	// With streamingTimeSeriesInput only the first window of each time series is read. The TimeSeries reads the remaining entries during the simulation.
+	static std::vector<ConstructionVariables> createDischargeTimeSeriesFromSpreadsheets (std::string path, const RiverSystemInformation& riverSystemInformation, bool streamingTimeSeriesInput, int numberOfEntriesPerStreamingWindow);
+	static std::vector<ConstructionVariables> createSedimentInputTimeSeriesFromSpreadsheets (std::string path, const RiverSystemInformation& riverSystemInformation, bool inputUpperBoundaryInsteadOfMeanGrainDiameter, bool useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters, double lowerDiameterBoundaryForFinestFractionInCM, double poreVolumeFraction, bool streamingTimeSeriesInput, int numberOfEntriesPerStreamingWindow);
 	static bool addCalcTauToConstructionVariables(ConstructionVariables& target, pugi::xml_node rootNode, std::string name, CombinerVariables::TypesOfTauCalculationMethod defaultValue);
 	static bool addCalcBedloadVelocityToConstructionVariables(ConstructionVariables& target, pugi::xml_node rootNode, std::string name);
 	static bool addEstimateThicknessOfMovingSedimentLayerToConstructionVariables(ConstructionVariables& target, pugi::xml_node rootNode, std::string name);
@@ -154,6 +187,12 @@ private:
 	static ConstructionVariables createSingleRegularOutputMethod(pugi::xml_node rootNode, const std::string& outputPath, const std::string& defaultFileName, const RiverSystemInformation& riverSystemInformation, const StandardOutputCharacteristics& standardOutputCharacteristics, bool useDefaultPropertyForOutput, const std::string& defaultPropertyForOutput);
 	static ConstructionVariables createSingleOutputAccumulatedBedloadTransport(pugi::xml_node rootNode, const std::string& outputPath, const std::string& defaultFileName, const RiverSystemInformation& riverSystemInformation, const StandardOutputCharacteristics& standardOutputCharacteristics);
 	static std::pair<ConstructionVariables,std::pair<bool,int> > createStrataSortingWITHBoolUseInitialGrainSizesForConstantLayerThicknessANDNumberOfLayers (pugi::xml_node riverSystemMethodsNode, bool thicknessInputsIncludingPoreVolume, double poreVolumeFraction);
+	static std::string createBranchFileName(const std::string& folder, int branchID, const char* suffix);
+	static double readInitialDischargeFromSpreadsheet(const std::string& fileName);
+	static LongitudinalProfileForStandardInput createLongitudinalProfileFromSpreadsheet(const std::string& fileName, bool thicknessInputsIncludingPoreVolume, double poreVolumeFraction);
+	// Exceptions must not leave a parallel loop. Thus the error messages of the single items are collected and the first one is thrown afterwards.
+	static const char* createErrorMessageCopy(const char* errorMessage);
+	static void throwFirstErrorMessage(const std::vector<const char*>& errorMessages);
 	static std::map<int,ConstructionVariables> createMapFromCellIDToInstantaneousSedimentInputsFromSpreadsheet (std::string path, const RiverSystemInformation& riverSystemInformation, bool inputUpperBoundaryInsteadOfMeanGrainDiameter, bool useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters, double lowerDiameterBoundaryForFinestFractionInCM, double poreVolumeFraction);
 
 	static bool addDoubleToConstructionVariables(ConstructionVariables& target, pugi::xml_node rootNode, std::string name, double defaultValue);
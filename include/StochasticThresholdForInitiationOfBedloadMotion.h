@@ -42,7 +42,9 @@ private:
 
 	bool correctionForBedloadWeightAtSteepCounterSlopes;
 
-	std::map<double,std::vector<double> > mapFromWidthToValues;
+	// In the deterministic mode (SEDFLOWDETERMINISTIC) the values are kept per reach and active width, as the object is shared by all reaches
+	// and these may be treated in parallel. Otherwise all reaches with the same active width share their values, which are stored with the cellID -1.
+	std::map<std::pair<int,double>,std::vector<double> > mapFromCellIDAndWidthToValues;
 	/*
 	 * Content of values:
 	 * 0: Current discharge
@@ -51,6 +53,7 @@ private:
 	 * 3: current value
 	 * 4: previous value
 	 * 5: prePrevioust value
+	 * 6: number of random numbers drawn so far (i.e. counter within the random stream, only used in the deterministic mode)
 	 * */
 
 	std::vector<double> widthsForSpecialValues;
@@ -58,19 +61,33 @@ private:
 	std::vector<double> betaSpecialValues;
 	std::map<double,std::pair<double,double> > mapFromWidthToSpecialValues;
 
-	double calculateNotConst (const RegularRiverReachProperties& regularRiverReachProperties);
+	double calculateNotConst (const RegularRiverReachProperties& regularRiverReachProperties, int cellID);
+
+	#if !defined SEDFLOWDETERMINISTIC
+	// Position within the sequence of rand() since the last call of srand(), which is shared by all objects of this class.
+	static double numberOfDrawnRandomNumbers;
+	#endif
 
 
 public:
 	StochasticThresholdForInitiationOfBedloadMotion(double minimumThresholdValue, double miu, double beta, int seed, double weightForCurrent, double weightForPrevious, double weightForPrePrevious, bool correctionForBedloadWeightAtSteepCounterSlopes, std::vector<double> widthsForSpecialValues, std::vector<double> miuSpecialValues, std::vector<double> betaSpecialValues);
-	StochasticThresholdForInitiationOfBedloadMotion(double minimumThresholdValue, double miu, double beta, int seed, double weightForCurrent, double weightForPrevious, double weightForPrePrevious, bool correctionForBedloadWeightAtSteepCounterSlopes, std::map<double,std::vector<double> > mapFromWidthToValues, std::vector<double> widthsForSpecialValues, std::vector<double> miuSpecialValues, std::vector<double> betaSpecialValues, std::map<double,std::pair<double,double> > mapFromWidthToSpecialValues);
+	StochasticThresholdForInitiationOfBedloadMotion(double minimumThresholdValue, double miu, double beta, int seed, double weightForCurrent, double weightForPrevious, double weightForPrePrevious, bool correctionForBedloadWeightAtSteepCounterSlopes, std::map<std::pair<int,double>,std::vector<double> > mapFromCellIDAndWidthToValues, std::vector<double> widthsForSpecialValues, std::vector<double> miuSpecialValues, std::vector<double> betaSpecialValues, std::map<double,std::pair<double,double> > mapFromWidthToSpecialValues);
 	virtual ~StochasticThresholdForInitiationOfBedloadMotion();
 
 	CalcThresholdForInitiationOfBedloadMotion* createCalcThresholdForInitiationOfBedloadMotionPointerCopy() const; //This method HAS TO BE implemented.
 
 	ConstructionVariables createConstructionVariables()const;
 
+	// Not available in the deterministic mode, which needs the cellID.
 	double calculate (const RegularRiverReachProperties& regularRiverReachProperties) const;
+	double calculate (const RegularRiverReachProperties& regularRiverReachProperties, int cellID) const;
+
+	// Restores the values per reach and active width (see createConstructionVariables). In the deterministic mode
+	// a simulation continued from a checkpoint thereby draws the same random numbers.
+	void setValuesForCellIDsAndWidths(const std::vector<int>& cellIDs, const std::vector<double>& activeWidths, const std::vector<double>& valuesOneAfterAnother);
+	// Outside the deterministic mode the sequence of rand() is reseeded and the given number of random numbers is drawn and discarded.
+	// Thus a simulation continued from a checkpoint draws the same random numbers. In the deterministic mode nothing needs to be done.
+	void setNumberOfDrawnRandomNumbers(double numberOfDrawnRandomNumbers);
 
 };
 
@@ -0,0 +1,84 @@
+/*
+ * StreamingTimeSeriesSource.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#ifndef STREAMINGTIMESERIESSOURCE_H_
+#define STREAMINGTIMESERIESSOURCE_H_
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "TimeSeriesEntry.h"
+#include "Grains.h"
+#include "ConstructionVariables.h"
+
+namespace SedFlow {
+
+class TabDelimitedSpreadsheetStream;
+
+// Reads the entries of a TimeSeries window by window from a tab delimited spreadsheet instead of loading the whole series at the start.
+// Each entry is the value column multiplied by the valueFactor. If a grainsBase is given, the entries are Grains scaled by this value.
+// The spreadsheet has to be sorted by the elapsed seconds. Only the position of the next unread row is kept, so that copies of a source
+// (e.g. within createChangeRateModifiersTypePointerCopy) open their own reader and continue at the same position.
+class StreamingTimeSeriesSource {
+private:
+	std::string fileName;
+	std::string elapsedSecondsColumn;
+	std::string valueColumn;
+	double valueFactor;
+	bool grainsValues;
+	Grains grainsBase;
+	int numberOfEntriesPerWindow;
+	// Negative while no row has been read, i.e. the reading starts directly after the header.
+	std::streamoff offsetOfNextRow;
+	bool exhausted;
+
+	TabDelimitedSpreadsheetStream* spreadsheetStream;
+	int elapsedSecondsColumnIndex;
+	int valueColumnIndex;
+
+	void openSpreadsheetStream();
+
+public:
+	StreamingTimeSeriesSource(const std::string& fileName, const std::string& elapsedSecondsColumn, const std::string& valueColumn, double valueFactor, int numberOfEntriesPerWindow);
+	StreamingTimeSeriesSource(const std::string& fileName, const std::string& elapsedSecondsColumn, const std::string& valueColumn, double valueFactor, const Grains& grainsBase, int numberOfEntriesPerWindow);
+	StreamingTimeSeriesSource(const StreamingTimeSeriesSource& toCopy);
+	virtual ~StreamingTimeSeriesSource();
+
+	StreamingTimeSeriesSource& operator = (const StreamingTimeSeriesSource& toBeAssigned);
+
+	// Opens the spreadsheet if necessary without modifying the reading position.
+	const std::vector<std::string>& getHeaderEntries();
+
+	// Appends up to numberOfEntriesPerWindow entries to the target. Throws if the elapsed seconds are decreasing.
+	void appendNextWindow(std::vector<TimeSeriesEntry>& target);
+	inline bool isExhausted() const { return exhausted; }
+
+	inline void setOffsetOfNextRow(std::streamoff offsetOfNextRow) { this->offsetOfNextRow = offsetOfNextRow; }
+	void addToConstructionVariables(ConstructionVariables& target) const;
+};
+
+}
+
+#endif /* STREAMINGTIMESERIESSOURCE_H_ */
@@ -64,6 +64,8 @@ public:
 	static bool fileExists(const char* const fileName);
 	static bool fileExists(const std::string& fileName);
 	static std::map<std::string,std::vector<std::string> > tabDelimitedSpreadsheetFileToStringMap(const std::string& tabDelimitedSpreadsheetFileName);
+	// Returns the sorted names of the regular files within the folder. The result is empty, if the folder does not exist.
+	static std::vector<std::string> listFilesInFolder(std::string folder);
 
 	static std::vector<std::string> splitString(const std::string& inputString, char delim);
 
@@ -75,6 +77,7 @@ public:
 	static std::string boolTo_String(bool inputBool);
 	static std::string boolTo_STRING(bool inputBool);
 
+	static double stringToDouble(std::string inputString);
 	static std::vector<double> stringVectorToDoubleVector(std::vector<std::string> inputStringVector);
 	static std::vector<int> stringVectorToIntVector(std::vector<std::string> inputStringVector);
 	static std::vector<bool> stringVectorToBoolVector(std::vector<std::string> inputStringVector);
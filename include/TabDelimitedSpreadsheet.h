@@ -0,0 +1,94 @@
+/*
+ * TabDelimitedSpreadsheet.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef TABDELIMITEDSPREADSHEET_H_
+#define TABDELIMITEDSPREADSHEET_H_
+
+#include <string>
+#include <map>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace SedFlow {
+
+// Read only view on a tab delimited spreadsheet file, which is mapped into memory instead of being copied.
+// The rules are the same as for StringTools::tabDelimitedSpreadsheetFileToStringMap: '\r' and '\n' end a row and empty rows are skipped.
+// Adjacent tabs count as a single delimiter and leading and trailing tabs are ignored. The first row contains the column headers and
+// all other rows with fewer entries than the header are skipped. Only the beginnings of the accepted rows are stored. The columns are
+// extracted on request and numeric columns are parsed directly from the mapped file without creating a string for each cell.
+class TabDelimitedSpreadsheet {
+private:
+	struct MappedFile;
+	MappedFile* mappedFile;
+	const char* fileBegin;
+	const char* fileEnd;
+
+	std::vector<std::string> headerEntries;
+	std::vector<const char*> rowBegins;
+
+	const char* findRowEnd(const char* rowBegin) const;
+	std::vector<int> getColumnIndices(const std::string& header) const;
+	// Parses plain decimal numbers, which are exactly converted by a single multiplication or division by a power of ten.
+	// Returns false for all other entries, which are converted by StringTools::stringToDouble instead.
+	static bool parseDoubleDirectly(const char* fieldBegin, const char* fieldEnd, double& result);
+#if defined _DEBUG || defined DEBUG
+	// Compares the direct and the stream conversion for entries, which are prone to double rounding.
+	static void checkDirectParsing();
+#endif
+
+	// The spreadsheet owns the memory mapping. Thus it is neither copyable nor assignable.
+	TabDelimitedSpreadsheet(const TabDelimitedSpreadsheet&);
+	TabDelimitedSpreadsheet& operator = (const TabDelimitedSpreadsheet&);
+
+public:
+	explicit TabDelimitedSpreadsheet(const std::string& tabDelimitedSpreadsheetFileName);
+	virtual ~TabDelimitedSpreadsheet();
+
+	inline const std::vector<std::string>& getHeaderEntries() const { return headerEntries; }
+	inline int getNumberOfRows() const { return rowBegins.size(); }
+	bool hasColumn(const std::string& header) const;
+
+	// If several columns share the same header, their values are interleaved row by row.
+	std::vector<double> getDoubleColumn(const std::string& header) const;
+	std::vector<std::string> getStringColumn(const std::string& header) const;
+	std::map<std::string,std::vector<std::string> > toStringMap() const;
+
+	// The row and field rules, which are shared with TabDelimitedSpreadsheetStream.
+	static inline bool isRowDelimiter(char character) { return ( character == '\n' || character == '\r' ); }
+	static void splitRow(const char* rowBegin, const char* rowEnd, std::vector<std::string>& fields);
+	static int countFields(const char* rowBegin, const char* rowEnd);
+	// A row consisting of tabs only counts as single empty entry.
+	static inline bool isAcceptedRow(int numberOfFields, int numberOfHeaderEntries) { return ( numberOfHeaderEntries > 0 && std::max(numberOfFields,1) >= numberOfHeaderEntries ); }
+	// The fields of a row are the maximal sequences of characters other than tabs. A missing field results in an empty range.
+	// The search stops at the first row delimiter, thus rowEnd may also be the end of the file.
+	static void locateField(const char* rowBegin, const char* rowEnd, int fieldIndex, const char*& fieldBegin, const char*& fieldEnd);
+	// In debug builds each direct conversion is compared with the stream conversion.
+	static double parseDouble(const char* fieldBegin, const char* fieldEnd);
+};
+
+}
+
+#endif /* TABDELIMITEDSPREADSHEET_H_ */
@@ -0,0 +1,82 @@
+/*
+ * TabDelimitedSpreadsheetStream.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#ifndef TABDELIMITEDSPREADSHEETSTREAM_H_
+#define TABDELIMITEDSPREADSHEETSTREAM_H_
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+namespace SedFlow {
+
+// Sequential reader for tab delimited spreadsheets, which keeps only the current row in memory.
+// The rules for rows, fields and numbers are the same as for TabDelimitedSpreadsheet and rows with fewer entries than the header are skipped.
+// The byte offset of the next row may be stored and used to continue reading later on, even with another reader for the same file.
+class TabDelimitedSpreadsheetStream {
+private:
+	std::string fileName;
+	std::ifstream fileStream;
+	std::vector<std::string> headerEntries;
+
+	// The file is read up to the next '\n'. Embedded '\r' delimit further rows within this line.
+	std::string currentLine;
+	std::streamoff offsetOfCurrentLine;
+	std::streamoff offsetOfNextLine;
+	// Position of the next unread row within the current line. Beyond the end of the line if the line has been completely read.
+	std::string::size_type positionInCurrentLine;
+	const char* currentRowBegin;
+	const char* currentRowEnd;
+
+	bool readNextLine();
+	bool readNextNonEmptyRow();
+
+	// The reader owns the file stream. Thus it is neither copyable nor assignable.
+	TabDelimitedSpreadsheetStream(const TabDelimitedSpreadsheetStream&);
+	TabDelimitedSpreadsheetStream& operator = (const TabDelimitedSpreadsheetStream&);
+
+public:
+	explicit TabDelimitedSpreadsheetStream(const std::string& tabDelimitedSpreadsheetFileName);
+	virtual ~TabDelimitedSpreadsheetStream();
+
+	inline const std::string& getFileName() const { return fileName; }
+	inline const std::vector<std::string>& getHeaderEntries() const { return headerEntries; }
+	bool hasColumn(const std::string& header) const;
+	// Returns the index of the first column with the given header and throws if there is none.
+	int getColumnIndex(const std::string& header) const;
+
+	// Moves to the next row with at least as many entries as the header. Returns false at the end of the file.
+	bool readNextRow();
+	// Field of the current row, i.e. of the row found by the last successful call of readNextRow.
+	std::string getString(int columnIndex) const;
+	double getDouble(int columnIndex) const;
+
+	std::streamoff getOffsetOfNextRow() const;
+	// The offset has to be obtained by getOffsetOfNextRow for the same file.
+	void seekToOffset(std::streamoff offset);
+};
+
+}
+
+#endif /* TABDELIMITEDSPREADSHEETSTREAM_H_ */
@@ -30,6 +30,7 @@
 #include "TimeSeriesEntry.h"
 #include "CombinerVariables.h"
 #include "RegularRiverSystemProperties.h"
+#include "StreamingTimeSeriesSource.h"
 
 namespace SedFlow {
 
@@ -38,13 +39,22 @@ private:
 	int cellID;
 	int userCellID;
 	bool margin;
+	// Optional source for the entries beyond the last buffered entry. NULL if all entries are contained in actualTimeSeries.
+	StreamingTimeSeriesSource* streamingSource;
+	// Index of the last entry not later than the current point in time. The entries before it are not needed anymore.
+	std::vector<TimeSeriesEntry>::size_type cursor;
+
+	void readStreamingWindowsBeyond(double elapsedSeconds);
 
 public:
-	TimeSeries(){}
+	TimeSeries():streamingSource(NULL),cursor(0){}
 	TimeSeries(int userCellID, bool margin, CombinerVariables::TypesOfRegularRiverReachProperties property, const std::vector<TimeSeriesEntry>& timeSeries, const RegularRiverSystemProperties& regularRiverSystemProperties);
 	TimeSeries(int userCellID, bool margin, CombinerVariables::TypesOfRegularRiverReachProperties property, const std::vector<TimeSeriesEntry>& timeSeries, bool surplusInsteadOfAbsoluteValues, bool finalInsteadOfInitialAdding, const RegularRiverSystemProperties& regularRiverSystemProperties);
+	TimeSeries(const TimeSeries& toCopy);
 	virtual ~TimeSeries();
 
+	TimeSeries& operator = (const TimeSeries& toBeAssigned);
+
 	CombinerVariables::TypesOfRegularRiverReachProperties property;
 	std::vector<TimeSeriesEntry> actualTimeSeries;
 	bool surplusInsteadOfAbsoluteValues;
@@ -55,6 +65,22 @@ public:
 	inline int getCellID() const { return this->cellID; }
 	void setCellID(int cellID, const RegularRiverSystemProperties& regularRiverSystemProperties);
 
+	// The entries read from the source are appended to actualTimeSeries, which therefore has to be sorted already.
+	void setStreamingSource(const StreamingTimeSeriesSource& streamingSource);
+	inline bool isStreamed() const { return ( streamingSource != NULL ); }
+
+	// Moves the cursor forward to the last entry not later than elapsedSeconds, which has to be non-decreasing from call to call.
+	// Returns false if there is no later entry, i.e. if the time series cannot be used for interpolation anymore.
+	inline bool advanceCursorTo(double elapsedSeconds)
+	{
+		if( streamingSource != NULL ) { readStreamingWindowsBeyond(elapsedSeconds); }
+		while( (cursor + 1) < actualTimeSeries.size() && actualTimeSeries[cursor+1].elapsedSeconds <= elapsedSeconds ) { ++cursor; }
+		return ( (cursor + 1) < actualTimeSeries.size() );
+	}
+	// The following two methods may only be called after advanceCursorTo returned true.
+	inline const TimeSeriesEntry& getEntryAtCursor() const { return actualTimeSeries[cursor]; }
+	inline const TimeSeriesEntry& getEntryAfterCursor() const { return actualTimeSeries[cursor+1]; }
+
 	friend bool operator < (const TimeSeries& timeSeries1, const TimeSeries& timeSeries2)
 	{
 		return (timeSeries1.cellID < timeSeries2.cellID);
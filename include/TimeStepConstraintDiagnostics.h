@@ -0,0 +1,89 @@
+/*
+ * TimeStepConstraintDiagnostics.h
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#ifndef TIMESTEPCONSTRAINTDIAGNOSTICS_H_
+#define TIMESTEPCONSTRAINTDIAGNOSTICS_H_
+
+#include <vector>
+#include <map>
+#include <iostream>
+
+namespace SedFlow {
+
+class RiverReachProperties;
+
+// Records for each time step, which constraint and which reach determined the time step length.
+// The implementations of FlowTypeMethods::calculateTimeStep propose each of their candidate time steps. Each thread keeps only its shortest candidate,
+// so that no synchronisation is needed within the parallel loops. After the calculation of the time step the shortest candidate of all threads
+// is added to the histograms of constraints and reaches, which are reported at the end of the simulation.
+// As long as the diagnostics are not enabled, the only cost of a proposal is the check of a static flag.
+class TimeStepConstraintDiagnostics {
+public:
+	enum Constraints {WaterCourantFriedrichsLewy, WaterNotEmptyingCell, WaterMaximumTimeStep, SedimentCourantFriedrichsLewy, SedimentActiveLayerErosion, SedimentBedSlopeChange, Unconstrained, NumberOfConstraints};
+
+private:
+	struct Candidate {
+		double timeStep;
+		int constraint;
+		const RiverReachProperties* riverReachProperties;
+		// Keeps the candidates of different threads apart, so that they do not share cache lines.
+		char padding[64 - sizeof(double) - sizeof(int) - sizeof(const RiverReachProperties*)];
+	};
+
+	static bool enabled;
+	static double thresholdForPrintingTimeSteps;
+	static const int maximumNumberOfPrintedTimeSteps;
+	static int numberOfPrintedTimeSteps;
+	static std::vector<Candidate> shortestCandidatePerThread;
+	static long numberOfTimeSteps;
+	static std::vector<long> timeStepsPerConstraint;
+	static std::vector<double> secondsPerConstraint;
+	// The keys are the user cell IDs. The reach ID -1 stands for time steps without limiting reach.
+	static std::map< int, std::vector<long> > timeStepsPerReachAndConstraint;
+
+	static void resetCandidates();
+	static void proposeInternally(double timeStep, Constraints constraint, const RiverReachProperties* riverReachProperties);
+	static void completeTimeStepInternally(double timeStepLength, double elapsedSeconds);
+	static int getUserCellID(const RiverReachProperties* riverReachProperties);
+
+public:
+	// With a positive thresholdForPrintingTimeSteps, each time step shorter than the threshold is printed together with its constraint and reach.
+	static void enable(double thresholdForPrintingTimeSteps = 0.0);
+	static inline bool isEnabled() { return enabled; }
+
+	// May be called by any thread. The riverReachProperties may be NULL for constraints not related to a specific reach.
+	static inline void propose(double timeStep, Constraints constraint, const RiverReachProperties* riverReachProperties)
+		{ if(enabled) { proposeInternally(timeStep, constraint, riverReachProperties); } }
+	// Has to be called once per time step after the calculation of the time step.
+	static inline void completeTimeStep(double timeStepLength, double elapsedSeconds)
+		{ if(enabled) { completeTimeStepInternally(timeStepLength, elapsedSeconds); } }
+
+	static const char* constraintToString(Constraints constraint);
+	static void printSummary(std::ostream& outputStream, int numberOfReportedReaches = 10);
+};
+
+}
+
+#endif /* TIMESTEPCONSTRAINTDIAGNOSTICS_H_ */
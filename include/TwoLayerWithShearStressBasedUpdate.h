@@ -64,6 +64,9 @@ public:
 	StrataSorting* createStrataSortingPointerCopy() const;
 
 	ConstructionVariables createConstructionVariables()const;
+
+	// Restores the sublayer compositions and the break up conditions remembered for each reach, e.g. when restarting from a checkpoint.
+	void setStoredSublayerData(const std::vector<int>& cellIDsOfSublayerCompositions, const std::vector<Grains>& sublayerCompositions, const std::vector<int>& cellIDsOfBaseDataForSublayerInfluence, const std::vector<double>& baseDataForSublayerInfluenceOneAfterAnother);
 };
 
 }
@@ -23,6 +23,7 @@
  */
 
 #include "AdditionalRiverReachMethods.h"
+#include "StageProfiler.h"
 
 #include <algorithm>
 
@@ -83,13 +84,21 @@ AdditionalRiverReachMethods::~AdditionalRiverReachMethods()
 void AdditionalRiverReachMethods::updateAdditionalRiverReachProperties(const RegularRiverReachProperties& regularRiverReachProperties, const GeometricalChannelBehaviour* geometricalChannelBehaviour, const RegularRiverReachMethods& regularRiverReachMethods)
 {
 	for(std::vector<AdditionalRiverReachMethodType*>::iterator currentAdditionalRiverReachMethodTypePointer = constitutingAdditionalRiverReachMethodTypes.begin(); currentAdditionalRiverReachMethodTypePointer < constitutingAdditionalRiverReachMethodTypes.end(); ++currentAdditionalRiverReachMethodTypePointer)
-			{ (*(*currentAdditionalRiverReachMethodTypePointer)).updateAdditionalRiverReachProperty(regularRiverReachProperties, geometricalChannelBehaviour, regularRiverReachMethods); }
+		{
+			double startTime = StageProfiler::startSection();
+			(*(*currentAdditionalRiverReachMethodTypePointer)).updateAdditionalRiverReachProperty(regularRiverReachProperties, geometricalChannelBehaviour, regularRiverReachMethods);
+			StageProfiler::finishSection(StageProfiler::getSectionForAdditionalRiverReachMethods((*currentAdditionalRiverReachMethodTypePointer)->getTypeOfAdditionalRiverReachPropertyAndMethod()), startTime);
+		}
 }
 
 void AdditionalRiverReachMethods::performTypeSpecificActions(RiverReachProperties& riverReachProperties, const RegularRiverReachMethods& regularRiverReachMethods)
 {
 	for(std::vector<AdditionalRiverReachMethodType*>::iterator currentAdditionalRiverReachMethodTypePointer = constitutingAdditionalRiverReachMethodTypes.begin(); currentAdditionalRiverReachMethodTypePointer < constitutingAdditionalRiverReachMethodTypes.end(); ++currentAdditionalRiverReachMethodTypePointer)
-			{ (*(*currentAdditionalRiverReachMethodTypePointer)).typeSpecificAction(riverReachProperties, regularRiverReachMethods); }
+		{
+			double startTime = StageProfiler::startSection();
+			(*(*currentAdditionalRiverReachMethodTypePointer)).typeSpecificAction(riverReachProperties, regularRiverReachMethods);
+			StageProfiler::finishSection(StageProfiler::getSectionForAdditionalRiverReachMethods((*currentAdditionalRiverReachMethodTypePointer)->getTypeOfAdditionalRiverReachPropertyAndMethod()), startTime);
+		}
 }
 
 }
@@ -23,6 +23,7 @@
  */
 
 #include "AdditionalRiverSystemMethods.h"
+#include "StageProfiler.h"
 
 #include <algorithm>
 
@@ -89,7 +90,11 @@ void AdditionalRiverSystemMethods::updateAdditionalRiverSystemProperties(const R
 void AdditionalRiverSystemMethods::performAdditionalRiverSystemActions(RiverSystemProperties& riverSystemProperties, const RegularRiverSystemMethods& regularRiverSystemMethods)
 {
 	for(std::vector<AdditionalRiverSystemMethodType*>::iterator currentAdditionalRiverSystemMethodTypePointer = constitutingAdditionalRiverSystemMethodTypes.begin(); currentAdditionalRiverSystemMethodTypePointer < constitutingAdditionalRiverSystemMethodTypes.end(); ++currentAdditionalRiverSystemMethodTypePointer)
-			{ (*(*currentAdditionalRiverSystemMethodTypePointer)).performAdditionalRiverSystemActions(riverSystemProperties, regularRiverSystemMethods); }
+		{
+			double startTime = StageProfiler::startSection();
+			(*(*currentAdditionalRiverSystemMethodTypePointer)).performAdditionalRiverSystemActions(riverSystemProperties, regularRiverSystemMethods);
+			StageProfiler::finishSection(StageProfiler::getSectionForAdditionalRiverSystemMethods((*currentAdditionalRiverSystemMethodTypePointer)->getTypeOfAdditionalRiverSystemPropertyAndMethod()), startTime);
+		}
 }
 
 }
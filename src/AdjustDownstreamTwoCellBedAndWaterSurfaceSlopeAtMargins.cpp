@@ -171,6 +171,8 @@ void AdjustDownstreamTwoCellBedAndWaterSurfaceSlopeAtMargins::adjustSlopes(River
 			}
 
 		}
+
+		riverReachProperties.markAsModified();
 	}
 }
 
@@ -0,0 +1,168 @@
+/*
+ * AllocationTracker.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "AllocationTracker.h"
+
+#include <sstream>
+#include <cstring>
+
+#if defined SEDFLOWALLOCATIONTRACKING
+#include <new>
+#include <cstdlib>
+#if defined CURRENTLYWINDOWS
+//This is the Windows version
+#include <windows.h>
+#endif
+#endif
+
+namespace SedFlow {
+
+volatile long long AllocationTracker::allocations = 0;
+volatile long long AllocationTracker::bytes = 0;
+volatile long long AllocationTracker::deallocations = 0;
+
+#if defined SEDFLOWALLOCATIONTRACKING
+namespace {
+
+inline void atomicAdd(volatile long long* target, long long value)
+{
+#if defined CURRENTLYWINDOWS
+	InterlockedExchangeAdd64(target, value);
+#else
+	__sync_fetch_and_add(target, value);
+#endif
+}
+
+inline long long atomicRead(volatile long long* target)
+{
+#if defined CURRENTLYWINDOWS
+	return InterlockedExchangeAdd64(target, 0);
+#else
+	return __sync_fetch_and_add(target, 0LL);
+#endif
+}
+
+}
+#endif
+
+#if defined SEDFLOWALLOCATIONTRACKING
+void AllocationTracker::countAllocation(std::size_t size)
+{
+	atomicAdd(&allocations, 1);
+	atomicAdd(&bytes, static_cast<long long>(size));
+}
+#else
+void AllocationTracker::countAllocation(std::size_t) {}
+#endif
+
+void AllocationTracker::countDeallocation()
+{
+#if defined SEDFLOWALLOCATIONTRACKING
+	atomicAdd(&deallocations, 1);
+#endif
+}
+
+AllocationTracker::Snapshot AllocationTracker::takeSnapshot()
+{
+	Snapshot result;
+#if defined SEDFLOWALLOCATIONTRACKING
+	result.allocations = atomicRead(&allocations);
+	result.bytes = atomicRead(&bytes);
+	result.deallocations = atomicRead(&deallocations);
+#endif
+	return result;
+}
+
+void AllocationTracker::assertNoAllocationsSince(const Snapshot& snapshot, const char* context)
+{
+	assertAtMostAllocationsSince(snapshot, 0, context);
+}
+
+void AllocationTracker::assertAtMostAllocationsSince(const Snapshot& snapshot, long long maximumNumberOfAllocations, const char* context)
+{
+	if( !isAvailable() ) { return; }
+	Snapshot currentSnapshot = takeSnapshot();
+	long long numberOfAllocations = currentSnapshot.allocations - snapshot.allocations;
+	if( numberOfAllocations > maximumNumberOfAllocations ) { throwAllocationErrorMessage(numberOfAllocations, (currentSnapshot.bytes - snapshot.bytes), maximumNumberOfAllocations, context); }
+}
+
+void AllocationTracker::throwAllocationErrorMessage(long long numberOfAllocations, long long numberOfBytes, long long maximumNumberOfAllocations, const char* context)
+{
+	std::ostringstream oStringStream;
+	oStringStream << numberOfAllocations << " heap allocations of together " << numberOfBytes << " bytes instead of at most " << maximumNumberOfAllocations << " during " << ( (context == NULL) ? "the checked code" : context ) << ". (AllocationTracker)" << std::flush;
+	char* tmpChar = new char [(oStringStream.str()).size()+1];
+	std::strcpy(tmpChar, (oStringStream.str()).c_str());
+	const char *const errorMessage = tmpChar;
+	throw(errorMessage);
+}
+
+}
+
+#if defined SEDFLOWALLOCATIONTRACKING
+// The replacements of the global allocation functions. Their behaviour follows the standard: On failure the new handler is called repeatedly,
+// until either the allocation succeeds or no new handler is installed anymore, in which case std::bad_alloc is thrown.
+namespace {
+
+void* allocateAndCount(std::size_t size)
+{
+	SedFlow::AllocationTracker::countAllocation(size);
+	if( size == 0 ) { size = 1; }
+	void* result;
+	while( (result = std::malloc(size)) == NULL )
+	{
+		std::new_handler currentNewHandler = std::set_new_handler(NULL);
+		std::set_new_handler(currentNewHandler);
+		if( currentNewHandler == NULL ) { throw std::bad_alloc(); }
+		currentNewHandler();
+	}
+	return result;
+}
+
+void* allocateAndCountWithoutThrowing(std::size_t size)
+{
+	void* result = NULL;
+	try { result = allocateAndCount(size); }
+	catch(...) { result = NULL; }
+	return result;
+}
+
+void deallocateAndCount(void* pointer)
+{
+	if( pointer == NULL ) { return; }
+	SedFlow::AllocationTracker::countDeallocation();
+	std::free(pointer);
+}
+
+}
+
+void* operator new(std::size_t size) throw(std::bad_alloc) { return allocateAndCount(size); }
+void* operator new[](std::size_t size) throw(std::bad_alloc) { return allocateAndCount(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) throw() { return allocateAndCountWithoutThrowing(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) throw() { return allocateAndCountWithoutThrowing(size); }
+void operator delete(void* pointer) throw() { deallocateAndCount(pointer); }
+void operator delete[](void* pointer) throw() { deallocateAndCount(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) throw() { deallocateAndCount(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) throw() { deallocateAndCount(pointer); }
+#endif
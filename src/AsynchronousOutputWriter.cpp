@@ -0,0 +1,262 @@
+/*
+ * AsynchronousOutputWriter.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "AsynchronousOutputWriter.h"
+
+#include <cstring>
+
+#include "OutputMethodType.h"
+
+#if defined CURRENTLYWINDOWS
+//This is the Windows version (condition variables need at least Windows Vista)
+#if !defined _WIN32_WINNT || _WIN32_WINNT < 0x0600
+#undef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600
+#endif
+#include <windows.h>
+#else
+//This is the Linux version
+#include <pthread.h>
+#endif
+
+namespace SedFlow {
+
+struct AsynchronousOutputWriter::ThreadingPrimitives {
+#if defined CURRENTLYWINDOWS
+	HANDLE thread;
+	CRITICAL_SECTION mutex;
+	CONDITION_VARIABLE queueNotEmpty;
+	CONDITION_VARIABLE queueNotFull;
+	CONDITION_VARIABLE queueDrained;
+
+	ThreadingPrimitives() : thread(NULL)
+	{
+		InitializeCriticalSection(&mutex);
+		InitializeConditionVariable(&queueNotEmpty);
+		InitializeConditionVariable(&queueNotFull);
+		InitializeConditionVariable(&queueDrained);
+	}
+	~ThreadingPrimitives() { DeleteCriticalSection(&mutex); }
+
+	inline void lock() { EnterCriticalSection(&mutex); }
+	inline void unlock() { LeaveCriticalSection(&mutex); }
+	inline void wait(CONDITION_VARIABLE& condition) { SleepConditionVariableCS(&condition, &mutex, INFINITE); }
+	inline void wakeAll(CONDITION_VARIABLE& condition) { WakeAllConditionVariable(&condition); }
+
+	static DWORD WINAPI threadEntryPoint(LPVOID writer)
+	{
+		AsynchronousOutputWriter::runBackgroundThreadOf( static_cast<AsynchronousOutputWriter*>(writer) );
+		return 0;
+	}
+	inline bool startThread(AsynchronousOutputWriter* writer)
+	{
+		thread = CreateThread(NULL, 0, threadEntryPoint, writer, 0, NULL);
+		return ( thread != NULL );
+	}
+	inline void joinThread()
+	{
+		WaitForSingleObject(thread, INFINITE);
+		CloseHandle(thread);
+		thread = NULL;
+	}
+#else
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t queueNotEmpty;
+	pthread_cond_t queueNotFull;
+	pthread_cond_t queueDrained;
+
+	ThreadingPrimitives()
+	{
+		pthread_mutex_init(&mutex, NULL);
+		pthread_cond_init(&queueNotEmpty, NULL);
+		pthread_cond_init(&queueNotFull, NULL);
+		pthread_cond_init(&queueDrained, NULL);
+	}
+	~ThreadingPrimitives()
+	{
+		pthread_cond_destroy(&queueDrained);
+		pthread_cond_destroy(&queueNotFull);
+		pthread_cond_destroy(&queueNotEmpty);
+		pthread_mutex_destroy(&mutex);
+	}
+
+	inline void lock() { pthread_mutex_lock(&mutex); }
+	inline void unlock() { pthread_mutex_unlock(&mutex); }
+	inline void wait(pthread_cond_t& condition) { pthread_cond_wait(&condition, &mutex); }
+	inline void wakeAll(pthread_cond_t& condition) { pthread_cond_broadcast(&condition); }
+
+	static void* threadEntryPoint(void* writer)
+	{
+		AsynchronousOutputWriter::runBackgroundThreadOf( static_cast<AsynchronousOutputWriter*>(writer) );
+		return NULL;
+	}
+	inline bool startThread(AsynchronousOutputWriter* writer) { return ( pthread_create(&thread, NULL, threadEntryPoint, writer) == 0 ); }
+	inline void joinThread() { pthread_join(thread, NULL); }
+#endif
+};
+
+AsynchronousOutputWriter::AsynchronousOutputWriter(int queueLength):
+		threadingPrimitives(NULL),
+		indexOfFirstQueuedSnapshot(0),
+		numberOfQueuedSnapshots(0),
+		writingSnapshot(false),
+		threadRunning(false),
+		stopRequested(false),
+		errorOccurred(false)
+{
+	if( queueLength < 1 )
+	{
+		const char *const errorMessage = "The queue length of the asynchronous output needs to be at least one.";
+		throw(errorMessage);
+	}
+	queuedSnapshots.resize(queueLength);
+	queuedTargets.assign(queueLength, NULL);
+	threadingPrimitives = new ThreadingPrimitives();
+}
+
+AsynchronousOutputWriter::~AsynchronousOutputWriter()
+{
+	stop();
+	delete threadingPrimitives;
+}
+
+void AsynchronousOutputWriter::start()
+{
+	if(threadRunning) { return; }
+	stopRequested = false;
+	if( !(threadingPrimitives->startThread(this)) )
+	{
+		const char *const errorMessage = "The thread for the asynchronous output could not be started.";
+		throw(errorMessage);
+	}
+	threadRunning = true;
+}
+
+void AsynchronousOutputWriter::stop()
+{
+	if( !threadRunning ) { return; }
+	threadingPrimitives->lock();
+	stopRequested = true;
+	threadingPrimitives->wakeAll(threadingPrimitives->queueNotEmpty);
+	threadingPrimitives->unlock();
+	threadingPrimitives->joinThread();
+	threadRunning = false;
+}
+
+void AsynchronousOutputWriter::enqueue(OutputMethodType* target, std::vector<double>& snapshot)
+{
+	throwIfErrorOccurred();
+	if( !threadRunning )
+	{
+		target->writeSnapshot(snapshot);
+		return;
+	}
+
+	threadingPrimitives->lock();
+	while( numberOfQueuedSnapshots == static_cast<int>(queuedSnapshots.size()) ) { threadingPrimitives->wait(threadingPrimitives->queueNotFull); }
+	int slot = (indexOfFirstQueuedSnapshot + numberOfQueuedSnapshots) % queuedSnapshots.size();
+	queuedSnapshots[slot].swap(snapshot);
+	queuedTargets[slot] = target;
+	++numberOfQueuedSnapshots;
+	// Each snapshot wakes up the background thread. Otherwise snapshots of rare output lines would stay in the queue until the end of the simulation.
+	threadingPrimitives->wakeAll(threadingPrimitives->queueNotEmpty);
+	threadingPrimitives->unlock();
+}
+
+void AsynchronousOutputWriter::waitUntilDrained()
+{
+	if( !threadRunning ) { return; }
+	threadingPrimitives->lock();
+	if( numberOfQueuedSnapshots > 0 ) { threadingPrimitives->wakeAll(threadingPrimitives->queueNotEmpty); }
+	while( numberOfQueuedSnapshots > 0 || writingSnapshot ) { threadingPrimitives->wait(threadingPrimitives->queueDrained); }
+	threadingPrimitives->unlock();
+}
+
+void AsynchronousOutputWriter::throwIfErrorOccurred() const
+{
+	threadingPrimitives->lock();
+	bool errorToBeThrown = errorOccurred;
+	std::string errorMessageCopy = errorMessage;
+	threadingPrimitives->unlock();
+	if(errorToBeThrown)
+	{
+		char* errorMessageNotConst = new char [errorMessageCopy.size()+1];
+		std::strcpy (errorMessageNotConst,errorMessageCopy.c_str());
+		const char *const errorMessageForThrow = errorMessageNotConst;
+		throw(errorMessageForThrow);
+	}
+}
+
+void AsynchronousOutputWriter::runBackgroundThread()
+{
+	OutputMethodType* currentTarget;
+	bool currentErrorOccurred = false;
+	std::string currentErrorMessage;
+	threadingPrimitives->lock();
+	while(true)
+	{
+		while( numberOfQueuedSnapshots == 0 && !stopRequested ) { threadingPrimitives->wait(threadingPrimitives->queueNotEmpty); }
+		if( numberOfQueuedSnapshots == 0 ) { break; }
+
+		// The snapshot is taken out of the queue, so that the lock is not held while formatting and writing.
+		snapshotInProgress.swap( queuedSnapshots[indexOfFirstQueuedSnapshot] );
+		currentTarget = queuedTargets[indexOfFirstQueuedSnapshot];
+		indexOfFirstQueuedSnapshot = (indexOfFirstQueuedSnapshot + 1) % queuedSnapshots.size();
+		--numberOfQueuedSnapshots;
+		writingSnapshot = true;
+		threadingPrimitives->wakeAll(threadingPrimitives->queueNotFull);
+		threadingPrimitives->unlock();
+
+		// After an error further snapshots are discarded. The error is reported to the solver on the next hand over.
+		if( !currentErrorOccurred )
+		{
+			try { currentTarget->writeSnapshot(snapshotInProgress); }
+			catch (const char *const msg)
+			{
+				currentErrorMessage = msg;
+				currentErrorOccurred = true;
+			}
+			catch (...)
+			{
+				currentErrorMessage = "An unknown error occurred while writing an asynchronous output.";
+				currentErrorOccurred = true;
+			}
+		}
+
+		threadingPrimitives->lock();
+		if( currentErrorOccurred && !errorOccurred )
+		{
+			errorMessage = currentErrorMessage;
+			errorOccurred = true;
+		}
+		writingSnapshot = false;
+		if( numberOfQueuedSnapshots == 0 ) { threadingPrimitives->wakeAll(threadingPrimitives->queueDrained); }
+	}
+	threadingPrimitives->wakeAll(threadingPrimitives->queueDrained);
+	threadingPrimitives->unlock();
+}
+
+}
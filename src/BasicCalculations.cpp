@@ -93,7 +93,7 @@ double BasicCalculations::calculateFroude(const RiverReachProperties& riverReach
 	return BasicCalculations::calculateFroude(riverReachProperties.geometricalChannelBehaviour->alluviumChannel->convertMaximumFlowDepthIntoMeanFlowDepth(riverReachProperties.regularRiverReachProperties.maximumWaterdepth),riverReachProperties.regularRiverReachProperties.flowVelocity,(riverReachProperties.getOverallParameters())->getGravityAcceleration());
 }
 
-double BasicCalculations::calculateMaximumFlowDepthForGivenFroudeAndDischarge(double froudeNumber, double discharge, double gravityAcceleration, const ChannelGeometry* channelGeometry, double expectedFlowDepth, double accuracyForTerminatingIteration, int maximumNumberOfIterations, const NumericRootFinder< std::binder2nd< BasicCalculations_EquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero > >* numericRootFinder)
+double BasicCalculations::calculateMaximumFlowDepthForGivenFroudeAndDischarge(double froudeNumber, double discharge, double gravityAcceleration, const ChannelGeometry* channelGeometry, double expectedFlowDepth, double accuracyForTerminatingIteration, int maximumNumberOfIterations, const NumericRootFinder< std::binder2nd< BasicCalculations_EquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero > >* numericRootFinder, const RiverReachProperties* riverReachProperties)
 {
 	double result = 0.0;
 	if(froudeNumber > 0.0)
@@ -110,8 +110,27 @@ double BasicCalculations::calculateMaximumFlowDepthForGivenFroudeAndDischarge(do
 			BasicCalculations_BoundaryConditionsForEquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero boundaryConditions (froudeNumber, discharge, gravityAcceleration, channelGeometry);
 			std::binder2nd< BasicCalculations_EquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero > unaryFunctionObject (BasicCalculations_EquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero(),boundaryConditions);
 
-			std::pair<double,double> brackets = findPositiveBracketsStartingFromExpectedValue< std::binder2nd< BasicCalculations_EquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero > >(unaryFunctionObject,expectedFlowDepth,true,maximumNumberOfIterations,true);
-			result = numericRootFinder->findRoot(unaryFunctionObject,brackets.first,brackets.second,accuracyForTerminatingIteration,maximumNumberOfIterations);
+			RootFinderDiagnostics::Counters startCounters = RootFinderDiagnostics::startSolve();
+			std::pair<double,double> brackets (std::numeric_limits<double>::quiet_NaN(),std::numeric_limits<double>::quiet_NaN());
+			try
+			{
+				brackets = findPositiveBracketsStartingFromExpectedValue< std::binder2nd< BasicCalculations_EquilibriumFlowDepthForGivenFroudeAndDischargeReturnsZero > >(unaryFunctionObject,expectedFlowDepth,true,maximumNumberOfIterations,true);
+				result = numericRootFinder->findRoot(unaryFunctionObject,brackets.first,brackets.second,accuracyForTerminatingIteration,maximumNumberOfIterations);
+			}
+			catch(const char* errorMessage)
+			{
+				if(RootFinderDiagnostics::isEnabled())
+				{
+					RootFinderDiagnostics::Parameters parameters;
+					RootFinderDiagnostics::addParameter(parameters,"froudeNumber",froudeNumber);
+					RootFinderDiagnostics::addParameter(parameters,"discharge",discharge);
+					RootFinderDiagnostics::addParameter(parameters,"gravityAcceleration",gravityAcceleration);
+					RootFinderDiagnostics::addParameters(parameters,"channelGeometry",channelGeometry->createConstructionVariables());
+					RootFinderDiagnostics::recordFailure(RootFinderDiagnostics::FlowDepthForGivenFroudeNumber,riverReachProperties,errorMessage,unaryFunctionObject,numericRootFinder,expectedFlowDepth,brackets,accuracyForTerminatingIteration,maximumNumberOfIterations,parameters);
+				}
+				throw;
+			}
+			RootFinderDiagnostics::completeSolve(RootFinderDiagnostics::FlowDepthForGivenFroudeNumber,riverReachProperties,startCounters,unaryFunctionObject,result,maximumNumberOfIterations);
 		}
 	}
 	else
@@ -0,0 +1,133 @@
+/*
+ * BinaryColumnarOutputFormat.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "BinaryColumnarOutputFormat.h"
+
+#include <cstring>
+
+namespace SedFlow {
+
+const char BinaryColumnarOutputFormat::magicNumber[8] = {'S','E','D','F','L','O','W','B'};
+const char BinaryColumnarOutputFormat::chunkMarker[4] = {'C','H','N','K'};
+const unsigned int BinaryColumnarOutputFormat::formatVersion = 1;
+
+namespace {
+
+void appendUnsignedLongLong(std::vector<char>& target, unsigned long long value, int numberOfBytes)
+{
+	for(int i = 0; i < numberOfBytes; ++i) { target.push_back( static_cast<char>( (value >> (8*i)) & 0xFF ) ); }
+}
+
+unsigned long long decodeUnsignedLongLong(const char* bytes, int numberOfBytes)
+{
+	unsigned long long result = 0;
+	for(int i = 0; i < numberOfBytes; ++i) { result |= static_cast<unsigned long long>( static_cast<unsigned char>(bytes[i]) ) << (8*i); }
+	return result;
+}
+
+}
+
+void BinaryColumnarOutputFormat::appendUnsignedInt(std::vector<char>& target, unsigned int value)
+{
+	appendUnsignedLongLong(target, value, 4);
+}
+
+void BinaryColumnarOutputFormat::appendInt(std::vector<char>& target, int value)
+{
+	appendUnsignedLongLong(target, static_cast<unsigned int>(value), 4);
+}
+
+void BinaryColumnarOutputFormat::appendDouble(std::vector<char>& target, double value)
+{
+	unsigned long long bits;
+	std::memcpy(&bits, &value, sizeof(double));
+	appendUnsignedLongLong(target, bits, 8);
+}
+
+void BinaryColumnarOutputFormat::appendString(std::vector<char>& target, const std::string& value)
+{
+	appendUnsignedInt(target, value.size());
+	target.insert(target.end(), value.begin(), value.end());
+}
+
+void BinaryColumnarOutputFormat::appendStrings(std::vector<char>& target, const std::vector<std::string>& values)
+{
+	appendUnsignedInt(target, values.size());
+	for(std::vector<std::string>::const_iterator currentValue = values.begin(); currentValue < values.end(); ++currentValue)
+		{ appendString(target, *currentValue); }
+}
+
+bool BinaryColumnarOutputFormat::readUnsignedInt(std::istream& source, unsigned int& value)
+{
+	char bytes[4];
+	if( !(source.read(bytes, 4)) ) { return false; }
+	value = static_cast<unsigned int>( decodeUnsignedLongLong(bytes, 4) );
+	return true;
+}
+
+bool BinaryColumnarOutputFormat::readInt(std::istream& source, int& value)
+{
+	unsigned int unsignedValue;
+	if( !(readUnsignedInt(source, unsignedValue)) ) { return false; }
+	value = static_cast<int>(unsignedValue);
+	return true;
+}
+
+bool BinaryColumnarOutputFormat::readDouble(std::istream& source, double& value)
+{
+	char bytes[8];
+	if( !(source.read(bytes, 8)) ) { return false; }
+	value = decodeDouble(bytes);
+	return true;
+}
+
+bool BinaryColumnarOutputFormat::readString(std::istream& source, std::string& value)
+{
+	unsigned int length;
+	if( !(readUnsignedInt(source, length)) ) { return false; }
+	value.assign(length, ' ');
+	if( length > 0 && !(source.read(&(value[0]), length)) ) { return false; }
+	return true;
+}
+
+bool BinaryColumnarOutputFormat::readStrings(std::istream& source, std::vector<std::string>& values)
+{
+	unsigned int numberOfValues;
+	if( !(readUnsignedInt(source, numberOfValues)) ) { return false; }
+	values.resize(numberOfValues);
+	for(std::vector<std::string>::iterator currentValue = values.begin(); currentValue < values.end(); ++currentValue)
+		{ if( !(readString(source, *currentValue)) ) { return false; } }
+	return true;
+}
+
+double BinaryColumnarOutputFormat::decodeDouble(const char* bytes)
+{
+	unsigned long long bits = decodeUnsignedLongLong(bytes, 8);
+	double result;
+	std::memcpy(&result, &bits, sizeof(double));
+	return result;
+}
+
+}
@@ -0,0 +1,157 @@
+/*
+ * BinaryColumnarOutputReader.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "BinaryColumnarOutputReader.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "BinaryColumnarOutputFormat.h"
+
+namespace SedFlow {
+
+BinaryColumnarOutputReader::BinaryColumnarOutputReader(const std::string& fileName):
+	fileName(fileName),
+	precisionForOutput(0),
+	numberOfRowsPerChunk(0),
+	numberOfStrataLayers(0)
+{
+	iFileStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+	if( !(iFileStream.is_open()) )
+	{
+		std::ostringstream oStringStream;
+		oStringStream << "The binary output file \"" << fileName << "\" cannot be opened." << std::flush;
+		char* tmpChar = new char [(oStringStream.str()).size()+1];
+		std::strcpy(tmpChar, (oStringStream.str()).c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+
+	char magicNumber[8];
+	if( !(iFileStream.read(magicNumber, 8)) || std::memcmp(magicNumber, BinaryColumnarOutputFormat::magicNumber, 8) != 0 )
+	{
+		const char *const errorMessage = "The file is not a binary columnar sedFlow output.";
+		throw(errorMessage);
+	}
+	unsigned int formatVersion;
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, formatVersion)) ) { throwCorruptFileError(); }
+	if( formatVersion != BinaryColumnarOutputFormat::formatVersion )
+	{
+		const char *const errorMessage = "Unsupported version of the binary columnar sedFlow output format.";
+		throw(errorMessage);
+	}
+
+	unsigned int unsignedValue;
+	if( !(BinaryColumnarOutputFormat::readInt(iFileStream, precisionForOutput)) ) { throwCorruptFileError(); }
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) ) { throwCorruptFileError(); }
+	numberOfRowsPerChunk = unsignedValue;
+	if( !(BinaryColumnarOutputFormat::readStrings(iFileStream, propertyNames)) ) { throwCorruptFileError(); }
+	if( !(BinaryColumnarOutputFormat::readStrings(iFileStream, cellLabels)) ) { throwCorruptFileError(); }
+
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) ) { throwCorruptFileError(); }
+	userCellIDs.resize(unsignedValue);
+	for(std::vector<int>::iterator currentUserCellID = userCellIDs.begin(); currentUserCellID < userCellIDs.end(); ++currentUserCellID)
+		{ if( !(BinaryColumnarOutputFormat::readInt(iFileStream, *currentUserCellID)) ) { throwCorruptFileError(); } }
+
+	if( !(BinaryColumnarOutputFormat::readStrings(iFileStream, grainTypeNames)) ) { throwCorruptFileError(); }
+
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) ) { throwCorruptFileError(); }
+	fractionalGrainDiameters.resize(unsignedValue);
+	for(std::vector<double>::iterator currentDiameter = fractionalGrainDiameters.begin(); currentDiameter < fractionalGrainDiameters.end(); ++currentDiameter)
+		{ if( !(BinaryColumnarOutputFormat::readDouble(iFileStream, *currentDiameter)) ) { throwCorruptFileError(); } }
+
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) ) { throwCorruptFileError(); }
+	numberOfStrataLayers = unsignedValue;
+	if( !(BinaryColumnarOutputFormat::readStrings(iFileStream, columnNames)) ) { throwCorruptFileError(); }
+
+	beginOfChunks = iFileStream.tellg();
+}
+
+void BinaryColumnarOutputReader::throwCorruptFileError() const
+{
+	std::ostringstream oStringStream;
+	oStringStream << "The header of the binary output file \"" << fileName << "\" is incomplete or corrupt." << std::flush;
+	char* tmpChar = new char [(oStringStream.str()).size()+1];
+	std::strcpy(tmpChar, (oStringStream.str()).c_str());
+	const char *const errorMessage = tmpChar;
+	throw(errorMessage);
+}
+
+int BinaryColumnarOutputReader::getColumnIndex(const std::string& columnName) const
+{
+	for(int i = 0; i < static_cast<int>(columnNames.size()); ++i)
+		{ if( columnNames[i] == columnName ) { return i; } }
+	return -1;
+}
+
+bool BinaryColumnarOutputReader::readNextChunk(std::vector< std::vector<double> >& columns)
+{
+	char chunkMarker[4];
+	if( !(iFileStream.read(chunkMarker, 4)) ) { return false; }
+	if( std::memcmp(chunkMarker, BinaryColumnarOutputFormat::chunkMarker, 4) != 0 )
+	{
+		const char *const errorMessage = "Invalid chunk in binary columnar sedFlow output.";
+		throw(errorMessage);
+	}
+	unsigned int numberOfRows;
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, numberOfRows)) ) { return false; }
+
+	int numberOfColumns = columnNames.size();
+	chunkBuffer.resize( static_cast<std::size_t>(numberOfColumns) * numberOfRows * 8 );
+	if( !(chunkBuffer.empty()) && !(iFileStream.read(&(chunkBuffer[0]), chunkBuffer.size())) ) { return false; }
+
+	columns.resize(numberOfColumns);
+	const char* currentBytes = chunkBuffer.empty() ? NULL : &(chunkBuffer[0]);
+	for(int currentColumn = 0; currentColumn < numberOfColumns; ++currentColumn)
+	{
+		columns[currentColumn].resize(numberOfRows);
+		for(unsigned int currentRow = 0; currentRow < numberOfRows; ++currentRow, currentBytes += 8)
+			{ columns[currentColumn][currentRow] = BinaryColumnarOutputFormat::decodeDouble(currentBytes); }
+	}
+	return true;
+}
+
+void BinaryColumnarOutputReader::rewind()
+{
+	iFileStream.clear();
+	iFileStream.seekg(beginOfChunks);
+}
+
+std::vector<double> BinaryColumnarOutputReader::readWholeColumn(int columnIndex)
+{
+	if( columnIndex < 0 || columnIndex >= static_cast<int>(columnNames.size()) )
+	{
+		const char *const errorMessage = "Invalid column index for binary columnar sedFlow output.";
+		throw(errorMessage);
+	}
+	std::vector<double> result;
+	std::vector< std::vector<double> > columns;
+	rewind();
+	while( readNextChunk(columns) )
+		{ result.insert(result.end(), columns[columnIndex].begin(), columns[columnIndex].end()); }
+	return result;
+}
+
+}
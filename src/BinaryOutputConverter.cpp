@@ -0,0 +1,145 @@
+/*
+ * BinaryOutputConverter.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+// Converts the binary files written by OutputRegularRiverReachPropertiesBinary into tab separated text,
+// which has the same layout as the files written by OutputRegularRiverReachProperties.
+//
+// Usage: BinaryOutputConverter [--info] [--precision N] inputFile.sfb [outputFile.txt]
+// Without an output file the text is written to the standard output.
+// Build: make bin/BinaryOutputConverter CXX_FLAGS="-O1 -DCURRENTLYUNIX"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "BinaryColumnarOutputReader.h"
+#include "NumberFormatter.h"
+
+namespace {
+
+void printUsage(const char* programName)
+{
+	std::cerr << "Usage: " << programName << " [--info] [--precision N] inputFile.sfb [outputFile.txt]" << std::endl;
+}
+
+int printInfo(SedFlow::BinaryColumnarOutputReader& reader)
+{
+	std::cout << "Precision for output: " << reader.getPrecisionForOutput() << std::endl;
+	std::cout << "Number of rows per chunk: " << reader.getNumberOfRowsPerChunk() << std::endl;
+	std::cout << "Properties:";
+	for(std::vector<std::string>::const_iterator currentName = reader.getPropertyNames().begin(); currentName < reader.getPropertyNames().end(); ++currentName) { std::cout << " " << *currentName; }
+	std::cout << std::endl << "Reaches:";
+	for(std::vector<std::string>::const_iterator currentLabel = reader.getCellLabels().begin(); currentLabel < reader.getCellLabels().end(); ++currentLabel) { std::cout << " " << *currentLabel; }
+	std::cout << std::endl << "Grain types:";
+	for(std::vector<std::string>::const_iterator currentName = reader.getGrainTypeNames().begin(); currentName < reader.getGrainTypeNames().end(); ++currentName) { std::cout << " " << *currentName; }
+	std::cout << std::endl << "Fractional grain diameters:";
+	for(std::vector<double>::const_iterator currentDiameter = reader.getFractionalGrainDiameters().begin(); currentDiameter < reader.getFractionalGrainDiameters().end(); ++currentDiameter) { std::cout << " " << *currentDiameter; }
+	std::cout << std::endl << "Number of strata layers: " << reader.getNumberOfStrataLayers() << std::endl;
+	std::cout << "Number of columns: " << reader.getNumberOfColumns() << std::endl;
+
+	std::vector< std::vector<double> > columns;
+	long numberOfRows = 0;
+	while( reader.readNextChunk(columns) ) { numberOfRows += columns.at(0).size(); }
+	std::cout << "Number of rows: " << numberOfRows << std::endl;
+	return 0;
+}
+
+int convertToText(SedFlow::BinaryColumnarOutputReader& reader, std::ostream& output, int precision)
+{
+	SedFlow::NumberFormatter lineFormatter (precision);
+
+	const std::vector<std::string>& columnNames = reader.getColumnNames();
+	for(std::vector<std::string>::const_iterator currentName = columnNames.begin(); currentName < columnNames.end(); ++currentName)
+	{
+		if( currentName != columnNames.begin() ) { output << "\t"; }
+		output << *currentName;
+	}
+	output << std::endl;
+
+	std::vector< std::vector<double> > columns;
+	int numberOfColumns = reader.getNumberOfColumns();
+	while( reader.readNextChunk(columns) )
+	{
+		int numberOfRows = columns.at(0).size();
+		for(int row = 0; row < numberOfRows; ++row)
+		{
+			lineFormatter.clear();
+			lineFormatter.appendScientific(columns[0][row]);
+			for(int column = 1; column < numberOfColumns; ++column)
+			{
+				lineFormatter.append('\t');
+				lineFormatter.appendScientific(columns[column][row]);
+			}
+			lineFormatter.append('\n');
+			lineFormatter.writeLineTo(output);
+		}
+	}
+	output.flush();
+	return ( output.good() ? 0 : 1 );
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+	bool infoOnly = false;
+	int precision = -1;
+	std::vector<std::string> fileNames;
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string argument (argv[i]);
+		if( argument == "--info" ) { infoOnly = true; }
+		else if( argument == "--precision" && (i+1) < argc ) { precision = std::atoi(argv[++i]); }
+		else { fileNames.push_back(argument); }
+	}
+	if( fileNames.empty() || fileNames.size() > 2 )
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	try
+	{
+		SedFlow::BinaryColumnarOutputReader reader (fileNames.at(0));
+		if(infoOnly) { return printInfo(reader); }
+		if( precision < 0 ) { precision = reader.getPrecisionForOutput(); }
+		if( fileNames.size() == 1 ) { return convertToText(reader, std::cout, precision); }
+
+		std::ofstream outputFileStream (fileNames.at(1).c_str(), std::ios::out | std::ios::trunc);
+		if( !outputFileStream.is_open() )
+		{
+			std::cerr << "The file " << fileNames.at(1) << " could not be opened for writing." << std::endl;
+			return 1;
+		}
+		return convertToText(reader, outputFileStream, precision);
+	}
+	catch(const char* errorMessage)
+	{
+		std::cerr << errorMessage << std::endl;
+		return 1;
+	}
+}
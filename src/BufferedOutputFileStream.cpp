@@ -0,0 +1,124 @@
+/*
+ * BufferedOutputFileStream.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "BufferedOutputFileStream.h"
+
+namespace SedFlow {
+
+const std::size_t BufferedOutputFileStream::bufferSize = 1048576;
+
+BufferedOutputFileStream::BufferedOutputFileStream():
+	std::ofstream(),
+	buffer(bufferSize),
+	flushPolicy(CombinerVariables::FlushAfterWallSeconds),
+	numberOfLinesBetweenFlushes(100),
+	wallSecondsBetweenFlushes(10.0),
+	numberOfLinesSinceLastFlush(0),
+	timeOfLastFlush(std::time(NULL))
+{
+	// The buffer has to be set before the file is opened.
+	this->rdbuf()->pubsetbuf(&(buffer[0]), buffer.size());
+}
+
+BufferedOutputFileStream::~BufferedOutputFileStream()
+{
+	if( this->is_open() ) { this->close(); }
+}
+
+void BufferedOutputFileStream::setFlushPolicy(CombinerVariables::TypesOfOutputFlushPolicy flushPolicy, int numberOfLinesBetweenFlushes, double wallSecondsBetweenFlushes)
+{
+	this->flushPolicy = flushPolicy;
+	this->numberOfLinesBetweenFlushes = numberOfLinesBetweenFlushes;
+	this->wallSecondsBetweenFlushes = wallSecondsBetweenFlushes;
+}
+
+void BufferedOutputFileStream::openAndTruncate(const char* fileName, bool binaryMode)
+{
+	if( this->is_open() ) { this->close(); }
+	this->clear();
+	if(binaryMode) { this->open(fileName, std::ios::out | std::ios::trunc | std::ios::binary); }
+	else { this->open(fileName, std::ios::out | std::ios::trunc); }
+	numberOfLinesSinceLastFlush = 0;
+	timeOfLastFlush = std::time(NULL);
+}
+
+void BufferedOutputFileStream::openForAppending(const char* fileName, bool binaryMode)
+{
+	if( this->is_open() ) { this->close(); }
+	this->clear();
+	if(binaryMode) { this->open(fileName, std::ios::out | std::ios::app | std::ios::binary); }
+	else { this->open(fileName, std::ios::out | std::ios::app); }
+	numberOfLinesSinceLastFlush = 0;
+	timeOfLastFlush = std::time(NULL);
+}
+
+void BufferedOutputFileStream::openForUpdating(const char* fileName)
+{
+	if( this->is_open() ) { this->close(); }
+	this->clear();
+	this->open(fileName, std::ios::in | std::ios::out | std::ios::binary);
+	this->seekp(0, std::ios::end);
+	numberOfLinesSinceLastFlush = 0;
+	timeOfLastFlush = std::time(NULL);
+}
+
+bool BufferedOutputFileStream::lineCompleted()
+{
+	++numberOfLinesSinceLastFlush;
+	switch (flushPolicy)
+	{
+	case CombinerVariables::FlushEveryNumberOfLines:
+		if( numberOfLinesSinceLastFlush >= numberOfLinesBetweenFlushes )
+		{
+			flushNow();
+			return true;
+		}
+		return false;
+
+	case CombinerVariables::FlushAfterWallSeconds:
+		if( std::difftime(std::time(NULL), timeOfLastFlush) >= wallSecondsBetweenFlushes )
+		{
+			flushNow();
+			return true;
+		}
+		return false;
+
+	case CombinerVariables::FlushOnlyOnFinalise:
+		return false;
+
+	default:
+		const char *const errorMessage = "Invalid Output Flush Policy Type";
+		throw (errorMessage);
+	}
+}
+
+void BufferedOutputFileStream::flushNow()
+{
+	if( this->is_open() ) { this->flush(); }
+	numberOfLinesSinceLastFlush = 0;
+	timeOfLastFlush = std::time(NULL);
+}
+
+}
@@ -30,4 +30,9 @@ CalcThresholdForInitiationOfBedloadMotion::CalcThresholdForInitiationOfBedloadMo
 
 CalcThresholdForInitiationOfBedloadMotion::~CalcThresholdForInitiationOfBedloadMotion() {}
 
+double CalcThresholdForInitiationOfBedloadMotion::calculate (const RegularRiverReachProperties& regularRiverReachProperties, int) const
+{
+	return this->calculate(regularRiverReachProperties);
+}
+
 }
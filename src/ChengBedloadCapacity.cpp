@@ -122,7 +122,7 @@ Grains ChengBedloadCapacity::calculate(const RiverReachProperties& riverReachPro
 				}
 			#endif
 
-			thetaCriticalNotCorrectedForHiding = thresholdCalculationMethod->calculate(riverReachProperties.regularRiverReachProperties);
+			thetaCriticalNotCorrectedForHiding = thresholdCalculationMethod->calculate(riverReachProperties.regularRiverReachProperties,riverReachProperties.getCellID());
 			if(thetaCriticalBasedOnConstantSred)
 			{
 				CombinerVariables::TypesOfGradientCalculationMethod typeOfSedimentEnergyslopeCalculationMethod = overallMethods.sedimentEnergySlopeCalculationMethod->getTypeOfGradientCalculationMethod();
@@ -27,6 +27,7 @@
 #include <string>
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 
 namespace SedFlow {
 
@@ -344,10 +345,38 @@ std::map< std::string, CombinerVariables::TypesOfOutputMethod> CombinerVariables
 	result["OutputRegularRiverReachPropertiesForVisualInterpretation"] = CombinerVariables::OutputRegularRiverReachPropertiesForVisualInterpretation;
 	result["OutputAccumulatedBedloadTransport"] = CombinerVariables::OutputAccumulatedBedloadTransport;
 	result["OutputSimulationSetup"] = CombinerVariables::OutputSimulationSetup;
+	result["OutputRegularRiverReachPropertiesBinary"] = CombinerVariables::OutputRegularRiverReachPropertiesBinary;
+	result["OutputBinaryCheckpoint"] = CombinerVariables::OutputBinaryCheckpoint;
+	result["OutputSharedMemoryMonitor"] = CombinerVariables::OutputSharedMemoryMonitor;
+	result["OutputRegularRiverReachPropertiesNetCDF"] = CombinerVariables::OutputRegularRiverReachPropertiesNetCDF;
+	result["OutputRegularRiverReachPropertiesDeltaEncoded"] = CombinerVariables::OutputRegularRiverReachPropertiesDeltaEncoded;
 	return result;
 }
 std::map< std::string, CombinerVariables::TypesOfOutputMethod> CombinerVariables::mapForTypesOfOutputMethod(CombinerVariables::createMapForTypesOfOutputMethod());
 
+std::map< std::string, CombinerVariables::TypesOfOutputFlushPolicy> CombinerVariables::createMapForTypesOfOutputFlushPolicy()
+{
+	std::map< std::string, TypesOfOutputFlushPolicy> result;
+	result["FlushEveryNumberOfLines"] = CombinerVariables::FlushEveryNumberOfLines;
+	result["FlushAfterWallSeconds"] = CombinerVariables::FlushAfterWallSeconds;
+	result["FlushOnlyOnFinalise"] = CombinerVariables::FlushOnlyOnFinalise;
+	return result;
+}
+std::map< std::string, CombinerVariables::TypesOfOutputFlushPolicy> CombinerVariables::mapForTypesOfOutputFlushPolicy(CombinerVariables::createMapForTypesOfOutputFlushPolicy());
+
+std::map< std::string, CombinerVariables::TypesOfOutputAggregation> CombinerVariables::createMapForTypesOfOutputAggregation()
+{
+	std::map< std::string, TypesOfOutputAggregation> result;
+	result["InstantaneousValue"] = CombinerVariables::InstantaneousValue;
+	result["IntervalMean"] = CombinerVariables::IntervalMean;
+	result["IntervalMinimum"] = CombinerVariables::IntervalMinimum;
+	result["IntervalMaximum"] = CombinerVariables::IntervalMaximum;
+	result["IntervalTimeIntegral"] = CombinerVariables::IntervalTimeIntegral;
+	result["IntervalTimeOfMaximum"] = CombinerVariables::IntervalTimeOfMaximum;
+	return result;
+}
+std::map< std::string, CombinerVariables::TypesOfOutputAggregation> CombinerVariables::mapForTypesOfOutputAggregation(CombinerVariables::createMapForTypesOfOutputAggregation());
+
 std::map< std::string, CombinerVariables::TypesOfChannelGeometry> CombinerVariables::createMapForTypesOfChannelGeometry()
 {
 	std::map< std::string, TypesOfChannelGeometry> result;
@@ -2058,6 +2087,26 @@ std::string CombinerVariables::typeOfOutputMethodToString (TypesOfOutputMethod t
 		result = "OutputSimulationSetup";
 		break;
 
+	case CombinerVariables::OutputRegularRiverReachPropertiesBinary:
+		result = "OutputRegularRiverReachPropertiesBinary";
+		break;
+
+	case CombinerVariables::OutputBinaryCheckpoint:
+		result = "OutputBinaryCheckpoint";
+		break;
+
+	case CombinerVariables::OutputSharedMemoryMonitor:
+		result = "OutputSharedMemoryMonitor";
+		break;
+
+	case CombinerVariables::OutputRegularRiverReachPropertiesNetCDF:
+		result = "OutputRegularRiverReachPropertiesNetCDF";
+		break;
+
+	case CombinerVariables::OutputRegularRiverReachPropertiesDeltaEncoded:
+		result = "OutputRegularRiverReachPropertiesDeltaEncoded";
+		break;
+
 	default:
 		const char *const errorMessage = "Invalid Output Method Type";
 		throw (errorMessage);
@@ -2065,6 +2114,98 @@ std::string CombinerVariables::typeOfOutputMethodToString (TypesOfOutputMethod t
 	return result;
 }
 
+CombinerVariables::TypesOfOutputFlushPolicy CombinerVariables::stringToTypeOfOutputFlushPolicy (std::string string)
+{
+	std::map< std::string, TypesOfOutputFlushPolicy>::const_iterator resultIterator = mapForTypesOfOutputFlushPolicy.find(string);
+	if (resultIterator == mapForTypesOfOutputFlushPolicy.end())
+	{
+		std::string errorMessageAsString = "String \"";
+		errorMessageAsString.append(string);
+		errorMessageAsString.append("\" not mapped to type of output flush policy.");
+		char* tmpChar = new char [errorMessageAsString.size()+1];
+		std::strcpy(tmpChar, errorMessageAsString.c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+	else { return (*resultIterator).second; }
+}
+
+std::string CombinerVariables::typeOfOutputFlushPolicyToString (TypesOfOutputFlushPolicy typeOfOutputFlushPolicy)
+{
+	std::string result;
+	switch (typeOfOutputFlushPolicy)
+	{
+	case CombinerVariables::FlushEveryNumberOfLines:
+		result = "FlushEveryNumberOfLines";
+		break;
+
+	case CombinerVariables::FlushAfterWallSeconds:
+		result = "FlushAfterWallSeconds";
+		break;
+
+	case CombinerVariables::FlushOnlyOnFinalise:
+		result = "FlushOnlyOnFinalise";
+		break;
+
+	default:
+		const char *const errorMessage = "Invalid Output Flush Policy Type";
+		throw (errorMessage);
+		}
+	return result;
+}
+
+CombinerVariables::TypesOfOutputAggregation CombinerVariables::stringToTypeOfOutputAggregation (std::string string)
+{
+	std::map< std::string, TypesOfOutputAggregation>::const_iterator resultIterator = mapForTypesOfOutputAggregation.find(string);
+	if (resultIterator == mapForTypesOfOutputAggregation.end())
+	{
+		std::string errorMessageAsString = "String \"";
+		errorMessageAsString.append(string);
+		errorMessageAsString.append("\" not mapped to type of output aggregation.");
+		char* tmpChar = new char [errorMessageAsString.size()+1];
+		std::strcpy(tmpChar, errorMessageAsString.c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+	else { return (*resultIterator).second; }
+}
+
+std::string CombinerVariables::typeOfOutputAggregationToString (TypesOfOutputAggregation typeOfOutputAggregation)
+{
+	std::string result;
+	switch (typeOfOutputAggregation)
+	{
+	case CombinerVariables::InstantaneousValue:
+		result = "InstantaneousValue";
+		break;
+
+	case CombinerVariables::IntervalMean:
+		result = "IntervalMean";
+		break;
+
+	case CombinerVariables::IntervalMinimum:
+		result = "IntervalMinimum";
+		break;
+
+	case CombinerVariables::IntervalMaximum:
+		result = "IntervalMaximum";
+		break;
+
+	case CombinerVariables::IntervalTimeIntegral:
+		result = "IntervalTimeIntegral";
+		break;
+
+	case CombinerVariables::IntervalTimeOfMaximum:
+		result = "IntervalTimeOfMaximum";
+		break;
+
+	default:
+		const char *const errorMessage = "Invalid Output Aggregation Type";
+		throw (errorMessage);
+		}
+	return result;
+}
+
 CombinerVariables::TypesOfChannelGeometry CombinerVariables::stringToTypeOfChannelGeometry (std::string string)
 {
 	std::map< std::string, TypesOfChannelGeometry>::const_iterator resultIterator = mapForTypesOfChannelGeometry.find(string);
@@ -0,0 +1,54 @@
+/*
+ * CounterBasedRandomNumbers.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#include "CounterBasedRandomNumbers.h"
+
+#include <cstring>
+
+namespace SedFlow {
+
+//Finaliser of the SplitMix64 generator, which maps consecutive inputs onto statistically independent outputs.
+unsigned long long CounterBasedRandomNumbers::mix(unsigned long long value)
+{
+	value += 0x9E3779B97F4A7C15ULL;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return ( value ^ (value >> 31) );
+}
+
+double CounterBasedRandomNumbers::uniformWithinOpenUnitInterval(int seed, int streamID, double streamKey, unsigned long long counter)
+{
+	unsigned long long streamKeyBits = 0;
+	std::memcpy(&streamKeyBits, &streamKey, sizeof(double));
+
+	unsigned long long result = mix( static_cast<unsigned long long>(static_cast<unsigned int>(seed)) );
+	result = mix( result ^ static_cast<unsigned long long>(static_cast<unsigned int>(streamID)) );
+	result = mix( result ^ streamKeyBits );
+	result = mix( result ^ counter );
+
+	//The upper 53 bits are used as mantissa. Adding 0.5 excludes both zero and one.
+	return ( ( static_cast<double>(result >> 11) + 0.5 ) / 9007199254740992.0 );
+}
+
+}
@@ -107,6 +107,7 @@ ConstructionVariables DarcyWeisbachFlowResistance::createConstructionVariables()
 	doubleVector.clear();
 	doubleVector.push_back(darcyWeisbachFrictionFactorForGravelbed);
 	result.labelledDoubles["darcyWeisbachFrictionFactorForGravelbed"] = doubleVector;
+	addEverTreatedCellIDsToConstructionVariables(result);
 	return result;
 }
 
@@ -0,0 +1,61 @@
+/*
+ * DeltaEncodedOutputFormat.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "DeltaEncodedOutputFormat.h"
+
+namespace SedFlow {
+
+const char DeltaEncodedOutputFormat::magicNumber[8] = {'S','E','D','F','L','O','W','D'};
+const char DeltaEncodedOutputFormat::recordMarker[4] = {'R','C','R','D'};
+const unsigned int DeltaEncodedOutputFormat::formatVersion = 1;
+
+void DeltaEncodedOutputFormat::resizeLayers(Item& item, unsigned int numberOfLayers)
+{
+	item.layers.resize(numberOfLayers);
+	item.versions.resize(numberOfLayers, 0);
+}
+
+void DeltaEncodedOutputFormat::shiftLayers(Item& item, int shift)
+{
+	int numberOfLayers = item.layers.size();
+	if( shift > 0 )
+	{
+		for(int layer = (numberOfLayers - 1); layer >= shift; --layer)
+		{
+			item.layers[layer] = item.layers[layer - shift];
+			item.versions[layer] = item.versions[layer - shift];
+		}
+	}
+	else if( shift < 0 )
+	{
+		for(int layer = 0; (layer - shift) < numberOfLayers; ++layer)
+		{
+			item.layers[layer] = item.layers[layer - shift];
+			item.versions[layer] = item.versions[layer - shift];
+		}
+	}
+}
+
+}
@@ -0,0 +1,201 @@
+/*
+ * DeltaEncodedOutputReader.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "DeltaEncodedOutputReader.h"
+
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#include "BinaryColumnarOutputFormat.h"
+
+namespace SedFlow {
+
+DeltaEncodedOutputReader::DeltaEncodedOutputReader(const std::string& fileName):
+	fileName(fileName),
+	precisionForOutput(0),
+	changeTolerance(0.0),
+	outputTimeStepLength(false),
+	elapsedSeconds(0.0),
+	timeStepLength(0.0),
+	numberOfLayersInLastRecord(0)
+{
+	iFileStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+	if( !(iFileStream.is_open()) )
+	{
+		std::ostringstream oStringStream;
+		oStringStream << "The delta encoded output file \"" << fileName << "\" cannot be opened." << std::flush;
+		char* tmpChar = new char [(oStringStream.str()).size()+1];
+		std::strcpy(tmpChar, (oStringStream.str()).c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+
+	char magicNumber[8];
+	if( !(iFileStream.read(magicNumber, 8)) || std::memcmp(magicNumber, DeltaEncodedOutputFormat::magicNumber, 8) != 0 )
+	{
+		const char *const errorMessage = "The file is not a delta encoded sedFlow output.";
+		throw(errorMessage);
+	}
+	unsigned int formatVersion;
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, formatVersion)) ) { throwCorruptFileError(); }
+	if( formatVersion != DeltaEncodedOutputFormat::formatVersion )
+	{
+		const char *const errorMessage = "Unsupported version of the delta encoded sedFlow output format.";
+		throw(errorMessage);
+	}
+
+	unsigned int unsignedValue;
+	if( !(BinaryColumnarOutputFormat::readInt(iFileStream, precisionForOutput)) ) { throwCorruptFileError(); }
+	if( !(BinaryColumnarOutputFormat::readDouble(iFileStream, changeTolerance)) ) { throwCorruptFileError(); }
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) ) { throwCorruptFileError(); }
+	outputTimeStepLength = ( unsignedValue != 0 );
+	if( !(BinaryColumnarOutputFormat::readStrings(iFileStream, propertyNames)) ) { throwCorruptFileError(); }
+
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) || unsignedValue != propertyNames.size() ) { throwCorruptFileError(); }
+	for(unsigned int i = 0; i < propertyNames.size(); ++i)
+	{
+		if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) || unsignedValue > DeltaEncodedOutputFormat::Strata ) { throwCorruptFileError(); }
+		kindsOfProperties.push_back( static_cast<DeltaEncodedOutputFormat::KindsOfProperty>(unsignedValue) );
+	}
+
+	if( !(BinaryColumnarOutputFormat::readStrings(iFileStream, cellLabels)) ) { throwCorruptFileError(); }
+
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) ) { throwCorruptFileError(); }
+	userCellIDs.resize(unsignedValue);
+	for(std::vector<int>::iterator currentUserCellID = userCellIDs.begin(); currentUserCellID < userCellIDs.end(); ++currentUserCellID)
+		{ if( !(BinaryColumnarOutputFormat::readInt(iFileStream, *currentUserCellID)) ) { throwCorruptFileError(); } }
+
+	if( !(BinaryColumnarOutputFormat::readStrings(iFileStream, grainTypeNames)) ) { throwCorruptFileError(); }
+
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) ) { throwCorruptFileError(); }
+	fractionalGrainDiameters.resize(unsignedValue);
+	for(std::vector<double>::iterator currentDiameter = fractionalGrainDiameters.begin(); currentDiameter < fractionalGrainDiameters.end(); ++currentDiameter)
+		{ if( !(BinaryColumnarOutputFormat::readDouble(iFileStream, *currentDiameter)) ) { throwCorruptFileError(); } }
+
+	beginOfRecords = iFileStream.tellg();
+	items.resize( propertyNames.size() * cellLabels.size() );
+}
+
+void DeltaEncodedOutputReader::throwCorruptFileError() const
+{
+	std::ostringstream oStringStream;
+	oStringStream << "The header of the delta encoded output file \"" << fileName << "\" is incomplete or corrupt." << std::flush;
+	char* tmpChar = new char [(oStringStream.str()).size()+1];
+	std::strcpy(tmpChar, (oStringStream.str()).c_str());
+	const char *const errorMessage = tmpChar;
+	throw(errorMessage);
+}
+
+int DeltaEncodedOutputReader::getNumberOfValuesPerLayer(int propertyIndex) const
+{
+	if( kindsOfProperties.at(propertyIndex) == DeltaEncodedOutputFormat::SingleValue ) { return 1; }
+	return ( grainTypeNames.size() * fractionalGrainDiameters.size() );
+}
+
+bool DeltaEncodedOutputReader::readNextRecord()
+{
+	char recordMarker[4];
+	if( !(iFileStream.read(recordMarker, 4)) ) { return false; }
+	if( std::memcmp(recordMarker, DeltaEncodedOutputFormat::recordMarker, 4) != 0 )
+	{
+		const char *const errorMessage = "Invalid record in delta encoded sedFlow output.";
+		throw(errorMessage);
+	}
+
+	// The complete record is read before it is applied, so that an incomplete record does not change the reconstructed state.
+	double recordElapsedSeconds;
+	double recordTimeStepLength = 0.0;
+	if( !(BinaryColumnarOutputFormat::readDouble(iFileStream, recordElapsedSeconds)) ) { return false; }
+	if( outputTimeStepLength && !(BinaryColumnarOutputFormat::readDouble(iFileStream, recordTimeStepLength)) ) { return false; }
+
+	unsigned int numberOfEntries, itemIndex, unsignedValue;
+	int shift;
+	std::vector< std::pair<unsigned int,unsigned int> > layerCountChanges;
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, numberOfEntries)) ) { return false; }
+	for(unsigned int i = 0; i < numberOfEntries; ++i)
+	{
+		if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, itemIndex)) || !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, unsignedValue)) ) { return false; }
+		layerCountChanges.push_back( std::make_pair(itemIndex, unsignedValue) );
+	}
+	std::vector< std::pair<unsigned int,int> > shifts;
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, numberOfEntries)) ) { return false; }
+	for(unsigned int i = 0; i < numberOfEntries; ++i)
+	{
+		if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, itemIndex)) || !(BinaryColumnarOutputFormat::readInt(iFileStream, shift)) ) { return false; }
+		shifts.push_back( std::make_pair(itemIndex, shift) );
+	}
+
+	std::vector<unsigned int> changedItemIndices, changedLayerIndices, changedVersions;
+	std::vector<double> changedValues;
+	double value;
+	if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, numberOfEntries)) ) { return false; }
+	for(unsigned int i = 0; i < numberOfEntries; ++i)
+	{
+		changedItemIndices.push_back(0);
+		changedLayerIndices.push_back(0);
+		changedVersions.push_back(0);
+		if( !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, changedItemIndices.back())) || !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, changedLayerIndices.back())) || !(BinaryColumnarOutputFormat::readUnsignedInt(iFileStream, changedVersions.back())) ) { return false; }
+		if( changedItemIndices.back() >= items.size() ) { throwCorruptFileError(); }
+		int numberOfValuesPerLayer = getNumberOfValuesPerLayer( changedItemIndices.back() / cellLabels.size() );
+		for(int j = 0; j < numberOfValuesPerLayer; ++j)
+		{
+			if( !(BinaryColumnarOutputFormat::readDouble(iFileStream, value)) ) { return false; }
+			changedValues.push_back(value);
+		}
+	}
+
+	for(std::vector< std::pair<unsigned int,unsigned int> >::const_iterator currentChange = layerCountChanges.begin(); currentChange < layerCountChanges.end(); ++currentChange)
+		{ DeltaEncodedOutputFormat::resizeLayers(items.at(currentChange->first), currentChange->second); }
+	for(std::vector< std::pair<unsigned int,int> >::const_iterator currentShift = shifts.begin(); currentShift < shifts.end(); ++currentShift)
+		{ DeltaEncodedOutputFormat::shiftLayers(items.at(currentShift->first), currentShift->second); }
+	std::vector<double>::const_iterator currentValue = changedValues.begin();
+	for(unsigned int i = 0; i < changedItemIndices.size(); ++i)
+	{
+		DeltaEncodedOutputFormat::Item& item = items[ changedItemIndices[i] ];
+		if( changedLayerIndices[i] >= item.layers.size() ) { throwCorruptFileError(); }
+		int numberOfValuesPerLayer = getNumberOfValuesPerLayer( changedItemIndices[i] / cellLabels.size() );
+		item.layers[ changedLayerIndices[i] ].assign(currentValue, currentValue + numberOfValuesPerLayer);
+		item.versions[ changedLayerIndices[i] ] = changedVersions[i];
+		currentValue += numberOfValuesPerLayer;
+	}
+
+	elapsedSeconds = recordElapsedSeconds;
+	timeStepLength = recordTimeStepLength;
+	numberOfLayersInLastRecord = changedItemIndices.size();
+	return true;
+}
+
+void DeltaEncodedOutputReader::rewind()
+{
+	iFileStream.clear();
+	iFileStream.seekg(beginOfRecords);
+	items.assign( propertyNames.size() * cellLabels.size(), DeltaEncodedOutputFormat::Item() );
+	elapsedSeconds = 0.0;
+	timeStepLength = 0.0;
+	numberOfLayersInLastRecord = 0;
+}
+
+}
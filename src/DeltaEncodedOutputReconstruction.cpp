@@ -0,0 +1,179 @@
+/*
+ * DeltaEncodedOutputReconstruction.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+// Reconstructs the complete state of all layers from the files written by OutputRegularRiverReachPropertiesDeltaEncoded and prints it as text.
+// Each record is printed as a line with the elapsed seconds followed by a line per layer containing
+// the property, the reach, the layer index, the version of the layer and its values.
+// With --time only the last record not later than the given elapsed seconds is printed.
+// With --info only the numbers of records and layers are printed, which shows the reduction achieved by the delta encoding.
+//
+// Usage: DeltaEncodedOutputReconstruction [--info] [--time elapsedSeconds] [--precision N] inputFile.sfd
+// Build: make bin/DeltaEncodedOutputReconstruction CXX_FLAGS="-O1 -DCURRENTLYUNIX"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "DeltaEncodedOutputReader.h"
+#include "NumberFormatter.h"
+
+namespace {
+
+void printUsage(const char* programName)
+{
+	std::cerr << "Usage: " << programName << " [--info] [--time elapsedSeconds] [--precision N] inputFile.sfd" << std::endl;
+}
+
+void appendUnsignedInteger(SedFlow::NumberFormatter& lineFormatter, unsigned int value)
+{
+	char digits[16];
+	int position = 15;
+	digits[position] = '\0';
+	do
+	{
+		digits[--position] = static_cast<char>( '0' + (value % 10) );
+		value /= 10;
+	} while( value > 0 );
+	lineFormatter.append(digits + position);
+}
+
+void printRecord(const SedFlow::DeltaEncodedOutputReader& reader, SedFlow::NumberFormatter& lineFormatter)
+{
+	lineFormatter.clear();
+	lineFormatter.append("ElapsedSeconds\t");
+	lineFormatter.appendScientific(reader.getElapsedSeconds());
+	if( reader.getOutputTimeStepLength() )
+	{
+		lineFormatter.append("\tTimeStepLength\t");
+		lineFormatter.appendScientific(reader.getTimeStepLength());
+	}
+	lineFormatter.append('\n');
+	lineFormatter.writeLineTo(std::cout);
+
+	const std::vector<std::string>& propertyNames = reader.getPropertyNames();
+	const std::vector<std::string>& cellLabels = reader.getCellLabels();
+	for(int propertyIndex = 0; propertyIndex < static_cast<int>(propertyNames.size()); ++propertyIndex)
+	{
+		for(int cellIndex = 0; cellIndex < static_cast<int>(cellLabels.size()); ++cellIndex)
+		{
+			const SedFlow::DeltaEncodedOutputFormat::Item& item = reader.getItem(propertyIndex, cellIndex);
+			for(int layer = 0; layer < static_cast<int>(item.layers.size()); ++layer)
+			{
+				lineFormatter.clear();
+				lineFormatter.append(propertyNames[propertyIndex].c_str());
+				lineFormatter.append('\t');
+				lineFormatter.append(cellLabels[cellIndex].c_str());
+				lineFormatter.append('\t');
+				appendUnsignedInteger(lineFormatter, layer);
+				lineFormatter.append('\t');
+				appendUnsignedInteger(lineFormatter, item.versions[layer]);
+				for(std::vector<double>::const_iterator currentValue = item.layers[layer].begin(); currentValue < item.layers[layer].end(); ++currentValue)
+				{
+					lineFormatter.append( (currentValue == item.layers[layer].begin()) ? '\t' : ' ' );
+					lineFormatter.appendScientific(*currentValue);
+				}
+				lineFormatter.append('\n');
+				lineFormatter.writeLineTo(std::cout);
+			}
+		}
+	}
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+	bool printInfoOnly = false;
+	bool useTime = false;
+	double time = 0.0;
+	int precision = -1;
+	std::vector<std::string> fileNames;
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string argument (argv[i]);
+		if( argument == "--info" ) { printInfoOnly = true; }
+		else if( argument == "--time" && (i+1) < argc ) { useTime = true; time = std::atof(argv[++i]); }
+		else if( argument == "--precision" && (i+1) < argc ) { precision = std::atoi(argv[++i]); }
+		else { fileNames.push_back(argument); }
+	}
+	if( fileNames.size() != 1 )
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	try
+	{
+		SedFlow::DeltaEncodedOutputReader reader (fileNames.at(0));
+		if( precision < 0 ) { precision = reader.getPrecisionForOutput(); }
+		SedFlow::NumberFormatter lineFormatter (precision);
+
+		if(printInfoOnly)
+		{
+			long numberOfRecords = 0;
+			long numberOfWrittenLayers = 0;
+			long numberOfLayers = 0;
+			while( reader.readNextRecord() )
+			{
+				++numberOfRecords;
+				numberOfWrittenLayers += reader.getNumberOfLayersInLastRecord();
+				const std::vector<SedFlow::DeltaEncodedOutputFormat::Item>& items = reader.getItems();
+				for(std::vector<SedFlow::DeltaEncodedOutputFormat::Item>::const_iterator currentItem = items.begin(); currentItem < items.end(); ++currentItem)
+					{ numberOfLayers += currentItem->layers.size(); }
+			}
+			std::cout << "Properties: " << reader.getPropertyNames().size() << ", reaches: " << reader.getCellLabels().size() << ", change tolerance: " << reader.getChangeTolerance() << std::endl;
+			std::cout << "Records: " << numberOfRecords << std::endl;
+			std::cout << "Written layers: " << numberOfWrittenLayers << " of " << numberOfLayers;
+			if( numberOfLayers > 0 ) { std::cout << " (" << ( (100.0 * numberOfWrittenLayers) / numberOfLayers ) << " %)"; }
+			std::cout << std::endl;
+		}
+		else if(useTime)
+		{
+			// Reading a record changes the reconstructed state. Thus the records are counted first and replayed afterwards.
+			long numberOfRecordsToApply = 0;
+			while( reader.readNextRecord() && reader.getElapsedSeconds() <= time ) { ++numberOfRecordsToApply; }
+			if( numberOfRecordsToApply == 0 )
+			{
+				std::cerr << "The file does not contain any record up to the elapsed seconds " << time << "." << std::endl;
+				return 1;
+			}
+			reader.rewind();
+			for(long i = 0; i < numberOfRecordsToApply; ++i) { reader.readNextRecord(); }
+			printRecord(reader, lineFormatter);
+		}
+		else
+		{
+			while( reader.readNextRecord() ) { printRecord(reader, lineFormatter); }
+		}
+		std::cout.flush();
+		return ( std::cout.good() ? 0 : 1 );
+	}
+	catch(const char* errorMessage)
+	{
+		std::cerr << errorMessage << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,91 @@
+/*
+ * ExecutionTrace.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "ExecutionTrace.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+namespace SedFlow {
+
+// About 32 MB per thread.
+const int ExecutionTrace::defaultCapacityPerThread = 1048576;
+
+bool ExecutionTrace::enabled = false;
+std::string ExecutionTrace::traceFileName;
+double ExecutionTrace::referenceTime = 0.0;
+std::vector< std::vector<ExecutionTrace::Event> > ExecutionTrace::eventsPerThread;
+std::vector<long> ExecutionTrace::droppedEventsPerThread;
+
+void ExecutionTrace::enable(const std::string& traceFileName, int numberOfThreads, double referenceTime, int capacityPerThread)
+{
+	ExecutionTrace::traceFileName = traceFileName;
+	ExecutionTrace::referenceTime = referenceTime;
+	eventsPerThread.assign(numberOfThreads, std::vector<Event>());
+	for(std::vector< std::vector<Event> >::iterator currentThread = eventsPerThread.begin(); currentThread < eventsPerThread.end(); ++currentThread)
+		{ currentThread->reserve(capacityPerThread); }
+	droppedEventsPerThread.assign(numberOfThreads, 0);
+	enabled = true;
+}
+
+// Each event is written as a complete event ("ph":"X") with the begin time "ts" and the duration "dur" in microseconds.
+void ExecutionTrace::writeTraceFile(std::ostream& messageStream)
+{
+	std::ofstream traceFile (traceFileName.c_str(), std::ios::out | std::ios::trunc);
+	if( !traceFile.is_open() )
+	{
+		std::ostringstream oStringStream;
+		oStringStream << "The trace file " << traceFileName << " could not be opened.";
+		char* errorMessage = new char [oStringStream.str().size()+1];
+		std::strcpy(errorMessage, oStringStream.str().c_str());
+		throw(errorMessage);
+	}
+
+	long numberOfEvents = 0;
+	long numberOfDroppedEvents = 0;
+	traceFile << std::fixed << std::setprecision(3);
+	traceFile << "{\"traceEvents\":[" << '\n';
+	for(int thread = 0; thread < static_cast<int>(eventsPerThread.size()); ++thread)
+	{
+		if( thread > 0 ) { traceFile << ",\n"; }
+		traceFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":\"thread " << thread << "\"}}";
+		for(std::vector<Event>::const_iterator currentEvent = eventsPerThread[thread].begin(); currentEvent < eventsPerThread[thread].end(); ++currentEvent)
+		{
+			traceFile << ",\n{\"name\":\"" << currentEvent->name << "\",\"cat\":\"" << currentEvent->category << "\",\"ph\":\"X\",\"ts\":" << (1.0e6 * (currentEvent->beginTime - referenceTime)) << ",\"dur\":" << (1.0e6 * (currentEvent->endTime - currentEvent->beginTime)) << ",\"pid\":1,\"tid\":" << thread << '}';
+		}
+		numberOfEvents += eventsPerThread[thread].size();
+		numberOfDroppedEvents += droppedEventsPerThread[thread];
+	}
+	traceFile << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << numberOfDroppedEvents << "}}" << std::endl;
+	traceFile.close();
+
+	messageStream << "Wrote " << numberOfEvents << " trace events to " << traceFileName << '.';
+	if( numberOfDroppedEvents > 0 ) { messageStream << " " << numberOfDroppedEvents << " events have been dropped, as the trace buffers were full."; }
+	messageStream << std::endl << std::endl;
+}
+
+}
@@ -23,14 +23,10 @@
  */
 
 #include "ExplicitKinematicWave.h"
+#include "TimeStepConstraintDiagnostics.h"
 
 #include <algorithm>
 #include <math.h>
-#if defined TIMESTEPANALYSIS
-	#include <iostream>
-	#include <sstream>
-	#include <cstring>
-#endif
 //TODO Delete this debugging line.
 #include <iostream>
 
@@ -100,11 +96,6 @@ double ExplicitKinematicWave::calculateTimeStep (const RiverSystemProperties& ri
 	double newDischargeGradient;
 	double dischargeGradientChange;
 
-#if defined TIMESTEPANALYSIS
-	double thresholdForOutputtingTimeSteps = TIMESTEPANALYSIS;
-	std::ostringstream oStringStream;
-#endif
-
 	double timeStepEntry;
 	const RiverReachProperties* currentRiverReachProperties;
 #if defined SEDFLOWPARALLEL
@@ -125,88 +116,14 @@ double ExplicitKinematicWave::calculateTimeStep (const RiverSystemProperties& ri
 			if ( localVolumeChangeRate < 0.0)
 			{
 				timeStepEntry = ( ((*currentRiverReachProperties).geometricalChannelBehaviour->alluviumChannel->convertMaximumFlowDepthIntoCrossSectionalArea((*currentRiverReachProperties).regularRiverReachProperties.maximumWaterdepth)) * (*currentRiverReachProperties).regularRiverReachProperties.length ) * 0.75  / fabs(localVolumeChangeRate);
-				#if defined TIMESTEPANALYSIS
-					if( timeStepEntry < thresholdForOutputtingTimeSteps )
-					{
-						oStringStream.str("");
-						oStringStream.clear();
-						oStringStream << "Time step of " << timeStepEntry << " seconds at ";
-						if(currentRiverReachProperties->isMargin())
-						{
-							if(currentRiverReachProperties->isDownstreamMargin())
-							{
-								oStringStream << "downstream margin";
-							}
-							else
-							{
-								oStringStream << "upstream margin at reach " << currentRiverReachProperties->getDownstreamUserCellID();
-							}
-						}
-						else
-						{
-							oStringStream << "reach " << currentRiverReachProperties->getUserCellID();
-						}
-						oStringStream << " due to ExplicitKinematicWave check for not emptying complete cell." << std::flush;
-						#pragma omp critical
-						{ std::cout << std::endl << "===============================================================" << oStringStream.str() << std::endl << std::flush; }
-
-						if(riverSystem.overallParameters.incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum())
-						{
-							oStringStream.str("");
-							oStringStream.clear();
-							oStringStream << "Number of time step length outputs reached its maximum of " << riverSystem.overallParameters.getMaximumNumberOfTimeStepOutputs() << "." << std::flush;
-							char* tmpChar = new char [(oStringStream.str()).size()+1];
-							std::strcpy(tmpChar, (oStringStream.str()).c_str());
-							const char *const maximumNumberOfTimeStepOutputsErrorMessage = tmpChar;
-							#pragma omp critical
-							{ throw(maximumNumberOfTimeStepOutputsErrorMessage); }
-						}
-					}
-				#endif
+				TimeStepConstraintDiagnostics::propose(timeStepEntry, TimeStepConstraintDiagnostics::WaterNotEmptyingCell, currentRiverReachProperties);
 				#pragma omp critical
 				{ allCalculatedTimeSteps.push_back(timeStepEntry); }
 			}
 
 			//Check for Courant-Friedrichs-Lewy.
 			timeStepEntry = riverSystem.overallParameters.getCourantFriedrichsLewyNumber() * (std::min(((*currentRiverReachProperties).regularRiverReachProperties.length),((*currentDownstreamCellPointer).regularRiverReachProperties.length))) / (*currentRiverReachProperties).regularRiverReachProperties.flowVelocity ;
-			#if defined TIMESTEPANALYSIS
-				if( timeStepEntry < thresholdForOutputtingTimeSteps )
-				{
-					oStringStream.str("");
-					oStringStream.clear();
-					oStringStream << "Time step of " << timeStepEntry << " seconds at ";
-					if(currentRiverReachProperties->isMargin())
-					{
-						if(currentRiverReachProperties->isDownstreamMargin())
-						{
-							oStringStream << "downstream margin";
-						}
-						else
-						{
-							oStringStream << "upstream margin at reach " << currentRiverReachProperties->getDownstreamUserCellID();
-						}
-					}
-					else
-					{
-						oStringStream << "reach " << currentRiverReachProperties->getUserCellID();
-					}
-					oStringStream << " due to ExplicitKinematicWave check for Courant-Friedrichs-Lewy." << std::flush;
-					#pragma omp critical
-					{ std::cout << std::endl << "===============================================================" << std::endl << oStringStream.str() << std::endl << std::flush; }
-
-					if(riverSystem.overallParameters.incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum())
-					{
-						oStringStream.str("");
-						oStringStream.clear();
-						oStringStream << "Number of time step length outputs reached its maximum of " << riverSystem.overallParameters.getMaximumNumberOfTimeStepOutputs() << "." << std::flush;
-						char* tmpChar = new char [(oStringStream.str()).size()+1];
-						std::strcpy(tmpChar, (oStringStream.str()).c_str());
-						const char *const maximumNumberOfTimeStepOutputsErrorMessage = tmpChar;
-						#pragma omp critical
-						{ throw(maximumNumberOfTimeStepOutputsErrorMessage); }
-					}
-				}
-			#endif
+			TimeStepConstraintDiagnostics::propose(timeStepEntry, TimeStepConstraintDiagnostics::WaterCourantFriedrichsLewy, currentRiverReachProperties);
 			#pragma omp critical
 			{ allCalculatedTimeSteps.push_back(timeStepEntry); }
 
@@ -233,44 +150,6 @@ double ExplicitKinematicWave::calculateTimeStep (const RiverSystemProperties& ri
 			} while (fabs((dischargeGradientChange/currentDischargeGradient)) > maximumRelativeTwoCellDischargeGradientChange);
 
 			timeStepEntry = tempTimeStep * 2.0;
-			#if defined TIMESTEPANALYSIS
-				if( timeStepEntry < thresholdForOutputtingTimeSteps )
-				{
-					oStringStream.str("");
-					oStringStream.clear();
-						oStringStream << "Time step of " << timeStepEntry << " seconds at ";
-						if(currentRiverReachProperties->isMargin())
-						{
-							if(currentRiverReachProperties->isDownstreamMargin())
-							{
-								oStringStream << "downstream margin";
-							}
-							else
-							{
-								oStringStream << "upstream margin at reach " << currentRiverReachProperties->getDownstreamUserCellID();
-							}
-						}
-						else
-						{
-							oStringStream << "reach " << currentRiverReachProperties->getUserCellID();
-						}
-						oStringStream << " due to ExplicitKinematicWave check for not creating too large RelativeTwoCellDischargeGradientChange." << std::flush;
-					#pragma omp critical
-					{ std::cout << std::endl << "===============================================================" << std::endl << oStringStream.str() << std::endl << std::flush; }
-
-					if(riverSystem.overallParameters.incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum())
-					{
-						oStringStream.str("");
-						oStringStream.clear();
-						oStringStream << "Number of time step length outputs reached its maximum of " << riverSystem.overallParameters.getMaximumNumberOfTimeStepOutputs() << "." << std::flush;
-						char* tmpChar = new char [(oStringStream.str()).size()+1];
-						std::strcpy(tmpChar, (oStringStream.str()).c_str());
-						const char *const maximumNumberOfTimeStepOutputsErrorMessage = tmpChar;
-						#pragma omp critical
-						{ throw(maximumNumberOfTimeStepOutputsErrorMessage); }
-					}
-				}
-			#endif
 			#pragma omp critical
 			{ allCalculatedTimeSteps.push_back(timeStepEntry); }
 			*/
@@ -296,6 +175,7 @@ void ExplicitKinematicWave::applyChange (RiverReachProperties& riverReachPropert
 	{
 	double newVolume = (riverReachProperties.regularRiverReachProperties.length * riverReachProperties.geometricalChannelBehaviour->alluviumChannel->convertMaximumFlowDepthIntoCrossSectionalArea(riverReachProperties.regularRiverReachProperties.maximumWaterdepth)) + riverReachProperties.regularRiverReachProperties.waterVolumeChange;
 	riverReachProperties.regularRiverReachProperties.maximumWaterdepth = riverReachProperties.geometricalChannelBehaviour->alluviumChannel->convertCrossSectionalAreaIntoMaximumFlowDepth( (newVolume / riverReachProperties.regularRiverReachProperties.length));
+	riverReachProperties.markAsModified();
 	}
 }
 
@@ -309,14 +189,7 @@ void ExplicitKinematicWave::updateOtherParameters (RiverReachProperties& riverRe
 
 void ExplicitKinematicWave::handDownOtherParameters (RiverReachProperties& riverReachProperties) const
 {
-	riverReachProperties.regularRiverReachProperties.waterEnergyslope = overallMethods.waterEnergySlopeCalculationMethod->calculate(riverReachProperties);
-
-	if( overallMethods.sedimentEnergySlopeCalculationMethod->dependsOnWaterEnergyslope() )
-	{
-		std::pair<double,double> reducedAndUnreducedSlope = overallMethods.sedimentEnergySlopeCalculationMethod->calculateReducedAndUnreducedSedimentEnergyslope(riverReachProperties);
-		riverReachProperties.regularRiverReachProperties.sedimentEnergyslope = reducedAndUnreducedSlope.first;
-		riverReachProperties.regularRiverReachProperties.unreducedSedimentEnergyslope = reducedAndUnreducedSlope.second;
-	}
+	overallMethods.updateWaterEnergyslope(riverReachProperties);
 }
 
 
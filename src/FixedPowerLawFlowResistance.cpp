@@ -117,6 +117,7 @@ ConstructionVariables FixedPowerLawFlowResistance::createConstructionVariables()
 	doubleVector.clear();
 	doubleVector.push_back(exponent);
 	result.labelledDoubles["exponent"] = doubleVector;
+	addEverTreatedCellIDsToConstructionVariables(result);
 	return result;
 }
 
@@ -27,6 +27,7 @@
 #include <algorithm>
 
 #include "FlowMethods.h"
+#include "StageProfiler.h"
 
 namespace SedFlow {
 
@@ -258,7 +259,9 @@ double FlowMethods::calculateTimeStep (const RiverSystemProperties& riverSystem)
 	std::vector<double> singleTimeSteps;
 	for(std::vector<FlowTypeMethods*>::const_iterator currentTypeOfFlowMethods = this->constitutingFlowMethodsTypes.begin(); currentTypeOfFlowMethods < this->constitutingFlowMethodsTypes.end(); ++currentTypeOfFlowMethods)
 	{
+		double startTime = StageProfiler::startSection();
 		singleTimeSteps.push_back( (*(*currentTypeOfFlowMethods)).calculateTimeStep(riverSystem) );
+		StageProfiler::finishSection(StageProfiler::getSectionForFlowMethods((*currentTypeOfFlowMethods)->getTypeOfFlowMethods()), startTime);
 	}
 	return *( std::min_element( singleTimeSteps.begin(), singleTimeSteps.end() ) );
 }
@@ -267,7 +270,9 @@ void FlowMethods::calculateChanges (RiverReachProperties& riverReachProperties,
 {
 	for(std::vector<FlowTypeMethods*>::const_iterator currentTypeOfFlowMethods = this->constitutingFlowMethodsTypes.begin(); currentTypeOfFlowMethods < this->constitutingFlowMethodsTypes.end(); ++currentTypeOfFlowMethods)
 		{
+			double startTime = StageProfiler::startSection();
 			(*(*currentTypeOfFlowMethods)).calculateChange(riverReachProperties, timeStep);
+			StageProfiler::finishSection(StageProfiler::getSectionForFlowMethods((*currentTypeOfFlowMethods)->getTypeOfFlowMethods()), startTime);
 		}
 }
 
@@ -275,7 +280,9 @@ void FlowMethods::handDownChanges (RiverReachProperties& riverReachProperties) c
 {
 	for(std::vector<FlowTypeMethods*>::const_iterator currentTypeOfFlowMethods = this->constitutingFlowMethodsTypes.begin(); currentTypeOfFlowMethods < this->constitutingFlowMethodsTypes.end(); ++currentTypeOfFlowMethods)
 		{
+			double startTime = StageProfiler::startSection();
 			(*(*currentTypeOfFlowMethods)).handDownChange(riverReachProperties);
+			StageProfiler::finishSection(StageProfiler::getSectionForFlowMethods((*currentTypeOfFlowMethods)->getTypeOfFlowMethods()), startTime);
 		}
 }
 
@@ -283,22 +290,29 @@ void FlowMethods::applyChanges (RiverReachProperties& riverReachProperties) cons
 {
 	for(std::vector<FlowTypeMethods*>::const_iterator currentTypeOfFlowMethods = this->constitutingFlowMethodsTypes.begin(); currentTypeOfFlowMethods < this->constitutingFlowMethodsTypes.end(); ++currentTypeOfFlowMethods)
 		{
+			double startTime = StageProfiler::startSection();
 			(*(*currentTypeOfFlowMethods)).applyChange(riverReachProperties);
+			StageProfiler::finishSection(StageProfiler::getSectionForFlowMethods((*currentTypeOfFlowMethods)->getTypeOfFlowMethods()), startTime);
 		}
 }
 void FlowMethods::updateOtherParameters (RiverReachProperties& riverReachProperties) const
 {
 	for(std::vector<FlowTypeMethods*>::const_iterator currentTypeOfFlowMethods = this->constitutingFlowMethodsTypes.begin(); currentTypeOfFlowMethods < this->constitutingFlowMethodsTypes.end(); ++currentTypeOfFlowMethods)
 		{
+			double startTime = StageProfiler::startSection();
 			(*(*currentTypeOfFlowMethods)).updateOtherParameters(riverReachProperties);
+			StageProfiler::finishSection(StageProfiler::getSectionForFlowMethods((*currentTypeOfFlowMethods)->getTypeOfFlowMethods()), startTime);
 		}
+	riverReachProperties.markAsModified();
 }
 
 void FlowMethods::handDownOtherParameters (RiverReachProperties& riverReachProperties) const
 {
 	for(std::vector<FlowTypeMethods*>::const_iterator currentTypeOfFlowMethods = this->constitutingFlowMethodsTypes.begin(); currentTypeOfFlowMethods < this->constitutingFlowMethodsTypes.end(); ++currentTypeOfFlowMethods)
 		{
+			double startTime = StageProfiler::startSection();
 			(*(*currentTypeOfFlowMethods)).handDownOtherParameters(riverReachProperties);
+			StageProfiler::finishSection(StageProfiler::getSectionForFlowMethods((*currentTypeOfFlowMethods)->getTypeOfFlowMethods()), startTime);
 		}
 }
 
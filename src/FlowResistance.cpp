@@ -184,7 +184,11 @@ double FlowResistance::getHydraulicRadiusForActiveWidth(double maximumFlowDepth,
 double FlowResistance::getStartingFlowDepthForIteration(const RiverReachProperties& riverReachProperties) const
 {
 	double result;
-	if( this->everTreatedCellIDs.find(riverReachProperties.getCellID()) != this->everTreatedCellIDs.end() )
+	bool everTreated;
+	//The set is shared by all reaches, which may be treated in parallel. Each reach only asks for and adds its own cellID.
+	#pragma omp critical(FlowResistanceEverTreatedCellIDs)
+	{ everTreated = ( this->everTreatedCellIDs.find(riverReachProperties.getCellID()) != this->everTreatedCellIDs.end() ); }
+	if( everTreated )
 	{
 		result = riverReachProperties.regularRiverReachProperties.maximumWaterdepth;
 	}
@@ -198,7 +202,8 @@ double FlowResistance::getStartingFlowDepthForIteration(const RiverReachProperti
 		{
 			result  = (riverReachProperties.getDownstreamCellPointer())->regularRiverReachProperties.maximumWaterdepth;
 		}
-		(const_cast<FlowResistance*>(this))->everTreatedCellIDs.insert( riverReachProperties.getCellID() );
+		#pragma omp critical(FlowResistanceEverTreatedCellIDs)
+		{ (const_cast<FlowResistance*>(this))->everTreatedCellIDs.insert( riverReachProperties.getCellID() ); }
 	}
 	return result;
 }
@@ -233,13 +238,33 @@ std::pair<double,double> FlowResistance::getFlowDepthAndVelocityEnsuringMinimumH
 
 		if( currentMinusMinimumHydraulicHead(outputFlowDepth) < 0.0 )
 		{
-			double criticalFlowDepth = BasicCalculations::calculateMaximumFlowDepthForGivenFroudeAndDischarge(1.0,discharge,gravityAcceleration,riverReachProperties.geometricalChannelBehaviour->alluviumChannel,this->startingValueForIteration,this->accuracyForTerminatingIteration,this->maximumNumberOfIterations,this->maximumFroudeSolver);
-			////////////////////////////////////////////////////////////////////////////
-			//May be switched for Debugging.
-			std::pair<double,double> brackets = BasicCalculations::findPositiveBracketsStartingFromBoundary< std::binder2nd< FlowResistance_CurrentHydraulicHeadMinusMinimumHydraulicHead > >(currentMinusMinimumHydraulicHead,criticalFlowDepth,true,maximumNumberOfIterations);
-			//std::pair<double,double> brackets = Debugging_FlowResistance_findPositiveBracketsStartingFromBoundary(currentMinusMinimumHydraulicHead,criticalFlowDepth,true,maximumNumberOfIterations);
-			////////////////////////////////////////////////////////////////////////////
-			outputFlowDepth = this->minimumHydraulicSlopeSolver->findRoot(currentMinusMinimumHydraulicHead,brackets.first,brackets.second,accuracyForTerminatingIteration,maximumNumberOfIterations);
+			double criticalFlowDepth = BasicCalculations::calculateMaximumFlowDepthForGivenFroudeAndDischarge(1.0,discharge,gravityAcceleration,riverReachProperties.geometricalChannelBehaviour->alluviumChannel,this->startingValueForIteration,this->accuracyForTerminatingIteration,this->maximumNumberOfIterations,this->maximumFroudeSolver,&riverReachProperties);
+			RootFinderDiagnostics::Counters startCounters = RootFinderDiagnostics::startSolve();
+			std::pair<double,double> brackets (std::numeric_limits<double>::quiet_NaN(),std::numeric_limits<double>::quiet_NaN());
+			try
+			{
+				////////////////////////////////////////////////////////////////////////////
+				//May be switched for Debugging.
+				brackets = BasicCalculations::findPositiveBracketsStartingFromBoundary< std::binder2nd< FlowResistance_CurrentHydraulicHeadMinusMinimumHydraulicHead > >(currentMinusMinimumHydraulicHead,criticalFlowDepth,true,maximumNumberOfIterations);
+				//brackets = Debugging_FlowResistance_findPositiveBracketsStartingFromBoundary(currentMinusMinimumHydraulicHead,criticalFlowDepth,true,maximumNumberOfIterations);
+				////////////////////////////////////////////////////////////////////////////
+				outputFlowDepth = this->minimumHydraulicSlopeSolver->findRoot(currentMinusMinimumHydraulicHead,brackets.first,brackets.second,accuracyForTerminatingIteration,maximumNumberOfIterations);
+			}
+			catch(const char* errorMessage)
+			{
+				if(RootFinderDiagnostics::isEnabled())
+				{
+					RootFinderDiagnostics::Parameters parameters;
+					RootFinderDiagnostics::addParameter(parameters,"minimumHydraulicHead",minimumHydraulicHead);
+					RootFinderDiagnostics::addParameter(parameters,"elevation",localElevation);
+					RootFinderDiagnostics::addParameter(parameters,"discharge",discharge);
+					RootFinderDiagnostics::addParameter(parameters,"gravityAcceleration",gravityAcceleration);
+					RootFinderDiagnostics::addParameters(parameters,"channelGeometry",riverReachProperties.geometricalChannelBehaviour->alluviumChannel->createConstructionVariables());
+					RootFinderDiagnostics::recordFailure(RootFinderDiagnostics::FlowDepthForMinimumHydraulicSlope,&riverReachProperties,errorMessage,currentMinusMinimumHydraulicHead,this->minimumHydraulicSlopeSolver,criticalFlowDepth,brackets,accuracyForTerminatingIteration,maximumNumberOfIterations,parameters);
+				}
+				throw;
+			}
+			RootFinderDiagnostics::completeSolve(RootFinderDiagnostics::FlowDepthForMinimumHydraulicSlope,&riverReachProperties,startCounters,currentMinusMinimumHydraulicHead,outputFlowDepth,maximumNumberOfIterations);
 		}
 	}
 
@@ -333,14 +358,48 @@ FlowResistance::~FlowResistance()
 	delete minimumHydraulicSlopeSolver;
 }
 
+void FlowResistance::addEverTreatedCellIDsToConstructionVariables(ConstructionVariables& target) const
+{
+	std::vector<int> intVector (everTreatedCellIDs.begin(), everTreatedCellIDs.end());
+	target.labelledInts["everTreatedCellIDs"] = intVector;
+}
+
+void FlowResistance::setEverTreatedCellIDs(const std::vector<int>& everTreatedCellIDs)
+{
+	this->everTreatedCellIDs.clear();
+	this->everTreatedCellIDs.insert(everTreatedCellIDs.begin(),everTreatedCellIDs.end());
+}
+
 std::pair<double,double> FlowResistance::calculateFlowDepthAndFlowVelocityUsingDischargeAsInputWithoutPostprocessingChecks(double discharge, const RiverReachProperties& riverReachProperties) const
 {
 	std::pair<double,double> result;
 	double outputFlowDepth = this->getStartingFlowDepthForIteration(riverReachProperties);
 	FlowResistance_BoundaryConditionsForEquilibriumFlowDepthForGivenDischargeAndUsedFlowResistanceReturnsZero boundaryConditions (discharge,riverReachProperties,this);
 	std::binder2nd< FlowResistance_EquilibriumFlowDepthForGivenDischargeAndUsedFlowResistanceReturnsZero > unaryFunctionObject (FlowResistance_EquilibriumFlowDepthForGivenDischargeAndUsedFlowResistanceReturnsZero(),boundaryConditions);
-	std::pair<double,double> brackets = BasicCalculations::findPositiveBracketsStartingFromExpectedValue< std::binder2nd< FlowResistance_EquilibriumFlowDepthForGivenDischargeAndUsedFlowResistanceReturnsZero > >(unaryFunctionObject,outputFlowDepth,false,maximumNumberOfIterations,true);
-	outputFlowDepth = this->flowResistanceSolver->findRoot(unaryFunctionObject,brackets.first,brackets.second,accuracyForTerminatingIteration,maximumNumberOfIterations);
+	double expectedFlowDepth = outputFlowDepth;
+	RootFinderDiagnostics::Counters startCounters = RootFinderDiagnostics::startSolve();
+	std::pair<double,double> brackets (std::numeric_limits<double>::quiet_NaN(),std::numeric_limits<double>::quiet_NaN());
+	try
+	{
+		brackets = BasicCalculations::findPositiveBracketsStartingFromExpectedValue< std::binder2nd< FlowResistance_EquilibriumFlowDepthForGivenDischargeAndUsedFlowResistanceReturnsZero > >(unaryFunctionObject,expectedFlowDepth,false,maximumNumberOfIterations,true);
+		outputFlowDepth = this->flowResistanceSolver->findRoot(unaryFunctionObject,brackets.first,brackets.second,accuracyForTerminatingIteration,maximumNumberOfIterations);
+	}
+	catch(const char* errorMessage)
+	{
+		if(RootFinderDiagnostics::isEnabled())
+		{
+			RootFinderDiagnostics::Parameters parameters;
+			RootFinderDiagnostics::addParameter(parameters,"discharge",discharge);
+			RootFinderDiagnostics::addParameters(parameters,"flowResistance",this->createConstructionVariables());
+			RootFinderDiagnostics::addParameter(parameters,"elevation",riverReachProperties.regularRiverReachProperties.elevation);
+			RootFinderDiagnostics::addParameter(parameters,"waterEnergyslope",riverReachProperties.regularRiverReachProperties.waterEnergyslope);
+			RootFinderDiagnostics::addParameter(parameters,"previousMaximumWaterdepth",riverReachProperties.regularRiverReachProperties.maximumWaterdepth);
+			RootFinderDiagnostics::addParameters(parameters,"channelGeometry",riverReachProperties.geometricalChannelBehaviour->alluviumChannel->createConstructionVariables());
+			RootFinderDiagnostics::recordFailure(RootFinderDiagnostics::FlowDepthForGivenDischarge,&riverReachProperties,errorMessage,unaryFunctionObject,this->flowResistanceSolver,expectedFlowDepth,brackets,accuracyForTerminatingIteration,maximumNumberOfIterations,parameters);
+		}
+		throw;
+	}
+	RootFinderDiagnostics::completeSolve(RootFinderDiagnostics::FlowDepthForGivenDischarge,&riverReachProperties,startCounters,unaryFunctionObject,outputFlowDepth,maximumNumberOfIterations);
 	double flowVelocity = discharge / riverReachProperties.geometricalChannelBehaviour->alluviumChannel->convertMaximumFlowDepthIntoCrossSectionalArea(outputFlowDepth);
 	return (std::pair<double,double>(outputFlowDepth,flowVelocity));
 }
@@ -354,7 +413,7 @@ std::pair<double,double> FlowResistance::calculateFlowDepthAndFlowVelocityUsingD
 	{
 
 		double gravityAcceleration = (riverReachProperties.getOverallParameters())->getGravityAcceleration();
-		double minimumFlowDepthForFroudeCriterion = BasicCalculations::calculateMaximumFlowDepthForGivenFroudeAndDischarge(this->maximumFroudeNumber,discharge,gravityAcceleration,riverReachProperties.geometricalChannelBehaviour->alluviumChannel,this->startingValueForIteration,this->accuracyForTerminatingIteration,this->maximumNumberOfIterations,this->maximumFroudeSolver);
+		double minimumFlowDepthForFroudeCriterion = BasicCalculations::calculateMaximumFlowDepthForGivenFroudeAndDischarge(this->maximumFroudeNumber,discharge,gravityAcceleration,riverReachProperties.geometricalChannelBehaviour->alluviumChannel,this->startingValueForIteration,this->accuracyForTerminatingIteration,this->maximumNumberOfIterations,this->maximumFroudeSolver,&riverReachProperties);
 
 		if(riverReachProperties.regularRiverReachProperties.waterEnergyslope > 0.0)
 			{ result = calculateFlowDepthAndFlowVelocityUsingDischargeAsInputWithoutPostprocessingChecks(discharge,riverReachProperties); }
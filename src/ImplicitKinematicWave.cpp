@@ -23,14 +23,10 @@
  */
 
 #include "ImplicitKinematicWave.h"
+#include "TimeStepConstraintDiagnostics.h"
 #include <math.h>
 #include <algorithm>
 #include <complex>
-#if defined TIMESTEPANALYSIS
-	#include <iostream>
-	#include <sstream>
-	#include <cstring>
-#endif
 //TODO Delete this debugging line.
 #include <iostream>
 
@@ -90,17 +86,13 @@ void ImplicitKinematicWave::updateChangeRateDependingParameters(RiverReachProper
 double ImplicitKinematicWave::calculateTimeStep (const RiverSystemProperties& riverSystem) const
 {
 	double result = maximumTimeStep;
+	TimeStepConstraintDiagnostics::propose(maximumTimeStep, TimeStepConstraintDiagnostics::WaterMaximumTimeStep, NULL);
 	RiverReachProperties* currentDownstreamCellPointer;
 	if(checkForCourantFriedrichsLewy)
 	{
 		std::vector<double> allCalculatedTimeSteps (1,maximumTimeStep);
 		allCalculatedTimeSteps.reserve(riverSystem.regularRiverSystemProperties.cellProperties.size());
 
-		#if defined TIMESTEPANALYSIS
-			double thresholdForOutputtingTimeSteps = TIMESTEPANALYSIS;
-			std::ostringstream oStringStream;
-		#endif
-
 		double timeStepEntry;
 		const RiverReachProperties* currentRiverReachProperties;
 		#pragma omp parallel for private(currentRiverReachProperties,timeStepEntry) default(shared)
@@ -112,44 +104,7 @@ double ImplicitKinematicWave::calculateTimeStep (const RiverSystemProperties& ri
 				currentDownstreamCellPointer = (*currentRiverReachProperties).getDownstreamCellPointer();
 				//Check for Courant-Friedrichs-Lewy.
 				timeStepEntry = riverSystem.overallParameters.getCourantFriedrichsLewyNumber() * (std::min(((*currentRiverReachProperties).regularRiverReachProperties.length),((*currentDownstreamCellPointer).regularRiverReachProperties.length))) / (*currentRiverReachProperties).regularRiverReachProperties.flowVelocity ;
-				#if defined TIMESTEPANALYSIS
-					if( timeStepEntry < thresholdForOutputtingTimeSteps )
-					{
-						oStringStream.str("");
-						oStringStream.clear();
-						oStringStream << "Time step of " << timeStepEntry << " seconds at ";
-						if(currentRiverReachProperties->isMargin())
-						{
-							if(currentRiverReachProperties->isDownstreamMargin())
-							{
-								oStringStream << "downstream margin";
-							}
-							else
-							{
-								oStringStream << "upstream margin at reach " << currentRiverReachProperties->getDownstreamUserCellID();
-							}
-						}
-						else
-						{
-							oStringStream << "reach " << currentRiverReachProperties->getUserCellID();
-						}
-						oStringStream << " due to ImplicitKinematicWave check for Courant-Friedrichs-Lewy." << std::flush;
-						#pragma omp critical
-						{ std::cout << std::endl << "===============================================================" << std::endl << oStringStream.str() << std::endl << std::flush; }
-
-						if(riverSystem.overallParameters.incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum())
-						{
-							oStringStream.str("");
-							oStringStream.clear();
-							oStringStream << "Number of time step length outputs reached its maximum of " << riverSystem.overallParameters.getMaximumNumberOfTimeStepOutputs() << "." << std::flush;
-							char* tmpChar = new char [(oStringStream.str()).size()+1];
-							std::strcpy(tmpChar, (oStringStream.str()).c_str());
-							const char *const maximumNumberOfTimeStepOutputsErrorMessage = tmpChar;
-							#pragma omp critical
-							{ throw(maximumNumberOfTimeStepOutputsErrorMessage); }
-						}
-					}
-				#endif
+				TimeStepConstraintDiagnostics::propose(timeStepEntry, TimeStepConstraintDiagnostics::WaterCourantFriedrichsLewy, currentRiverReachProperties);
 				#pragma omp critical
 				{ allCalculatedTimeSteps.push_back(timeStepEntry); }
 			}
@@ -216,6 +171,7 @@ void ImplicitKinematicWave::calculateChange (RiverReachProperties& riverReachPro
 		riverReachProperties.regularRiverReachProperties.waterVolumeChange = newWaterVolume - currentWaterVolume;
 		riverReachProperties.regularRiverReachProperties.waterVolumeChangeRate = riverReachProperties.regularRiverReachProperties.waterVolumeChange / currentTimeStepLength;
 		riverReachProperties.regularRiverReachProperties.discharge = upstreamDischargeInputs - riverReachProperties.regularRiverReachProperties.waterVolumeChangeRate;
+		riverReachProperties.markAsModified();
 	}
 }
 
@@ -231,6 +187,7 @@ void ImplicitKinematicWave::applyChange (RiverReachProperties& riverReachPropert
 	{
 	double newVolume = (riverReachProperties.regularRiverReachProperties.length * riverReachProperties.geometricalChannelBehaviour->alluviumChannel->convertMaximumFlowDepthIntoCrossSectionalArea(riverReachProperties.regularRiverReachProperties.maximumWaterdepth)) + riverReachProperties.regularRiverReachProperties.waterVolumeChange;
 	riverReachProperties.regularRiverReachProperties.maximumWaterdepth = riverReachProperties.geometricalChannelBehaviour->alluviumChannel->convertCrossSectionalAreaIntoMaximumFlowDepth( (newVolume / riverReachProperties.regularRiverReachProperties.length));
+	riverReachProperties.markAsModified();
 	}
 }
 
@@ -245,14 +202,7 @@ void ImplicitKinematicWave::updateOtherParameters (RiverReachProperties& riverRe
 
 void ImplicitKinematicWave::handDownOtherParameters (RiverReachProperties& riverReachProperties) const
 {
-	riverReachProperties.regularRiverReachProperties.waterEnergyslope = overallMethods.waterEnergySlopeCalculationMethod->calculate(riverReachProperties);
-
-	if( overallMethods.sedimentEnergySlopeCalculationMethod->dependsOnWaterEnergyslope() )
-	{
-		std::pair<double,double> reducedAndUnreducedSlope = overallMethods.sedimentEnergySlopeCalculationMethod->calculateReducedAndUnreducedSedimentEnergyslope(riverReachProperties);
-		riverReachProperties.regularRiverReachProperties.sedimentEnergyslope = reducedAndUnreducedSlope.first;
-		riverReachProperties.regularRiverReachProperties.unreducedSedimentEnergyslope = reducedAndUnreducedSlope.second;
-	}
+	overallMethods.updateWaterEnergyslope(riverReachProperties);
 }
 
 }
@@ -25,7 +25,6 @@
 #include "InputPropertyTimeSeriesLinearlyInterpolated.h"
 
 #include <algorithm>
-#include <map>
 
 namespace SedFlow {
 
@@ -34,17 +33,10 @@ InputPropertyTimeSeriesLinearlyInterpolated::InputPropertyTimeSeriesLinearlyInte
 		ensureModificationAgainstOtherChangeRateModifiers(ensureModificationAgainstOtherChangeRateModifiers),
 		overallMethods(overallMethods)
 {
-	std::map<int,std::vector<TimeSeries> >::iterator iteratorForTimeSeriesInputsByCellID;
-	std::vector<TimeSeries> emptyVector;
 	for(std::vector<TimeSeries>::iterator currentTimeSeries = timeSeriesInputs.begin(); currentTimeSeries < timeSeriesInputs.end(); ++currentTimeSeries)
 	{
-		iteratorForTimeSeriesInputsByCellID = this->timeSeriesInputsByCellID.find(currentTimeSeries->getCellID());
-		if (iteratorForTimeSeriesInputsByCellID == this->timeSeriesInputsByCellID.end())
-		{
-			this->timeSeriesInputsByCellID[ currentTimeSeries->getCellID() ] = emptyVector;
-			iteratorForTimeSeriesInputsByCellID = this->timeSeriesInputsByCellID.find(currentTimeSeries->getCellID());
-		}
-		iteratorForTimeSeriesInputsByCellID->second.push_back( *currentTimeSeries );
+		if( currentTimeSeries->getCellID() >= static_cast<int>(this->timeSeriesInputsByCellID.size()) ) { this->timeSeriesInputsByCellID.resize( currentTimeSeries->getCellID() + 1 ); }
+		this->timeSeriesInputsByCellID[ currentTimeSeries->getCellID() ].push_back( *currentTimeSeries );
 	}
 }
 
@@ -103,93 +95,77 @@ void InputPropertyTimeSeriesLinearlyInterpolated::finalModification(RiverReachPr
 
 void InputPropertyTimeSeriesLinearlyInterpolated::applyModification(RiverReachProperties& riverReachProperties)
 {
-	std::map< std::vector<TimeSeries>*, std::vector<TimeSeries>::iterator > toErase;
-
-	std::map<int,std::vector<TimeSeries> >::iterator timeSeriesInputsIterator = this->timeSeriesInputsByCellID.find(riverReachProperties.getCellID());
-	if(timeSeriesInputsIterator != this->timeSeriesInputsByCellID.end()) //Continue only if the current Cell is treated
+	const int cellID = riverReachProperties.getCellID();
+	if( cellID >= 0 && cellID < static_cast<int>(this->timeSeriesInputsByCellID.size()) ) //Continue only if the current Cell is treated
 	{
 		double reallyElapsedSeconds = (riverReachProperties.getOverallParameters())->getElapsedSeconds();
-		std::vector<TimeSeriesEntry>::const_iterator firstTimeSeriesEntry, secondTimeSeriesEntry;
 		CombinerVariables::TypesOfRegularRiverReachProperties currentProperty;
 		double doubleUpdate;
 		Grains grainsUpdate;
+		std::vector<TimeSeries>& timeSeriesOfCurrentCell = this->timeSeriesInputsByCellID[cellID];
 		//Run through all time series for the current Cell
-		for(std::vector<TimeSeries>::iterator currentTimeSeries = timeSeriesInputsIterator->second.begin(); currentTimeSeries < timeSeriesInputsIterator->second.end(); ++currentTimeSeries)
+		for(std::vector<TimeSeries>::iterator currentTimeSeries = timeSeriesOfCurrentCell.begin(); currentTimeSeries < timeSeriesOfCurrentCell.end(); ++currentTimeSeries)
 		{
 			if ( !( currentTimeSeries->surplusInsteadOfAbsoluteValues && ( currentModificationPhase==ModificationBeforeUpdates || (currentModificationPhase==InputModification && currentTimeSeries->finalInsteadOfInitialAdding) || (currentModificationPhase==FinalModification && (!(currentTimeSeries->finalInsteadOfInitialAdding))) ) ) )
 			//Addition shall only be performed in inputModification!!
 			{
-				if( currentTimeSeries->actualTimeSeries.size() < 2 ) { toErase[ &(timeSeriesInputsIterator->second) ] = currentTimeSeries; }
-				else // Continue only if time series is potentially usable and delete unusable time series
+				// Continue only if the time series is still usable, i.e. if there is an entry beyond the current point in time
+				if( currentTimeSeries->advanceCursorTo(reallyElapsedSeconds) )
 				{
-					secondTimeSeriesEntry = currentTimeSeries->actualTimeSeries.begin() + 1;
-					// Remove the historic past from the time series
-					while( secondTimeSeriesEntry != currentTimeSeries->actualTimeSeries.end() && secondTimeSeriesEntry->elapsedSeconds <= reallyElapsedSeconds)
-					{
-						currentTimeSeries->actualTimeSeries.erase(currentTimeSeries->actualTimeSeries.begin());
-						secondTimeSeriesEntry = currentTimeSeries->actualTimeSeries.begin() + 1;
-					}
-					if (secondTimeSeriesEntry == currentTimeSeries->actualTimeSeries.end()) { toErase[ &(timeSeriesInputsIterator->second) ] = currentTimeSeries; }
-					else // Continue only if time series is still potentially usable and delete unusable time series
+					const TimeSeriesEntry* firstTimeSeriesEntry = &(currentTimeSeries->getEntryAtCursor());
+					const TimeSeriesEntry* secondTimeSeriesEntry = &(currentTimeSeries->getEntryAfterCursor());
+					// Continue only if we have already entered the range of the time series
+					if ( firstTimeSeriesEntry->elapsedSeconds <= reallyElapsedSeconds )
 					{
-						firstTimeSeriesEntry = currentTimeSeries->actualTimeSeries.begin();
-						// Continue only if we have already entered the range of the time series
-						if ( firstTimeSeriesEntry->elapsedSeconds <= reallyElapsedSeconds )
+						currentProperty = currentTimeSeries->property;
+						//If everything went right apply the interpolated time series
+						if(CombinerVariables::regularRiverReachPropertyIsGrains(currentProperty))
+						{
+							grainsUpdate = Grains::interpolateLinearly(firstTimeSeriesEntry->grainsValue, secondTimeSeriesEntry->grainsValue, ((reallyElapsedSeconds - firstTimeSeriesEntry->elapsedSeconds) / (secondTimeSeriesEntry->elapsedSeconds - firstTimeSeriesEntry->elapsedSeconds)) );
+							if(currentTimeSeries->surplusInsteadOfAbsoluteValues) { grainsUpdate += riverReachProperties.regularRiverReachProperties.getGrainsProperty(currentProperty); }
+							riverReachProperties.regularRiverReachProperties.setGrainsProperty(currentProperty, grainsUpdate);
+						}
+						else
+						{
+							doubleUpdate = firstTimeSeriesEntry->doubleValue + ( (secondTimeSeriesEntry->doubleValue - firstTimeSeriesEntry->doubleValue) * (reallyElapsedSeconds - firstTimeSeriesEntry->elapsedSeconds) / (secondTimeSeriesEntry->elapsedSeconds - firstTimeSeriesEntry->elapsedSeconds) );
+							if(currentTimeSeries->surplusInsteadOfAbsoluteValues) { doubleUpdate += riverReachProperties.regularRiverReachProperties.getDoubleProperty(currentProperty); }
+							riverReachProperties.regularRiverReachProperties.setDoubleProperty(currentProperty, doubleUpdate);
+						}
+						riverReachProperties.markAsModified();
+						//After application of interpolated time series update depending parameters.
+						switch (currentProperty)
 						{
-							currentProperty = currentTimeSeries->property;
-							//If everything went right apply the interpolated time series
-							if(CombinerVariables::regularRiverReachPropertyIsGrains(currentProperty))
-							{
-								grainsUpdate = Grains::interpolateLinearly(firstTimeSeriesEntry->grainsValue, secondTimeSeriesEntry->grainsValue, ((reallyElapsedSeconds - firstTimeSeriesEntry->elapsedSeconds) / (secondTimeSeriesEntry->elapsedSeconds - firstTimeSeriesEntry->elapsedSeconds)) );
-								if(currentTimeSeries->surplusInsteadOfAbsoluteValues) { grainsUpdate += riverReachProperties.regularRiverReachProperties.getGrainsProperty(currentProperty); }
-								riverReachProperties.regularRiverReachProperties.setGrainsProperty(currentProperty, grainsUpdate);
-							}
-							else
-							{
-								doubleUpdate = firstTimeSeriesEntry->doubleValue + ( (secondTimeSeriesEntry->doubleValue - firstTimeSeriesEntry->doubleValue) * (reallyElapsedSeconds - firstTimeSeriesEntry->elapsedSeconds) / (secondTimeSeriesEntry->elapsedSeconds - firstTimeSeriesEntry->elapsedSeconds) );
-								if(currentTimeSeries->surplusInsteadOfAbsoluteValues) { doubleUpdate += riverReachProperties.regularRiverReachProperties.getDoubleProperty(currentProperty); }
-								riverReachProperties.regularRiverReachProperties.setDoubleProperty(currentProperty, doubleUpdate);
-							}
-							//After application of interpolated time series update depending parameters.
-							switch (currentProperty)
-							{
-							case CombinerVariables::maximumWaterdepth:
-								overallMethods.flowResistance->calculateAndUpdateDischargeAndFlowVelocityUsingFlowDepthAsInput(riverReachProperties);
-								break;
-
-							case CombinerVariables::discharge:
-								overallMethods.flowResistance->calculateAndUpdateFlowDepthAndFlowVelocityUsingDischargeAsInput(riverReachProperties);
-								break;
-
-							case CombinerVariables::flowVelocity:
-								overallMethods.flowResistance->calculateAndUpdateDischargeAndFlowDepthUsingFlowVelocityAsInput(riverReachProperties);
-								break;
-
-							//TODO Less important: Think of any other depending parameters to be updated.
-
-							//default:
-								//In any other case there are no depending parameters to update.
-							}
+						case CombinerVariables::maximumWaterdepth:
+							overallMethods.flowResistance->calculateAndUpdateDischargeAndFlowVelocityUsingFlowDepthAsInput(riverReachProperties);
+							break;
+
+						case CombinerVariables::discharge:
+							overallMethods.flowResistance->calculateAndUpdateFlowDepthAndFlowVelocityUsingDischargeAsInput(riverReachProperties);
+							break;
+
+						case CombinerVariables::flowVelocity:
+							overallMethods.flowResistance->calculateAndUpdateDischargeAndFlowDepthUsingFlowVelocityAsInput(riverReachProperties);
+							break;
+
+						//TODO Less important: Think of any other depending parameters to be updated.
 
+						//default:
+							//In any other case there are no depending parameters to update.
 						}
+
 					}
 				}
 			}
 		}
 	}
-
-	for(std::map< std::vector<TimeSeries>*, std::vector<TimeSeries>::iterator >::iterator currentEraseEntry = toErase.begin(); currentEraseEntry != toErase.end(); ++currentEraseEntry)
-	{
-		currentEraseEntry->first->erase(currentEraseEntry->second);
-	}
 }
 
 std::vector<TimeSeries> InputPropertyTimeSeriesLinearlyInterpolated::createSingleTimeSeriesVectorCopy()const
 {
 	std::vector<TimeSeries> result;
-	for( std::map< int,std::vector<TimeSeries> >::const_iterator currentTimeSeriesVector = this->timeSeriesInputsByCellID.begin(); currentTimeSeriesVector != this->timeSeriesInputsByCellID.end(); ++currentTimeSeriesVector)
+	for( std::vector< std::vector<TimeSeries> >::const_iterator currentTimeSeriesVector = this->timeSeriesInputsByCellID.begin(); currentTimeSeriesVector < this->timeSeriesInputsByCellID.end(); ++currentTimeSeriesVector)
 	{
-		for(std::vector<TimeSeries>::const_iterator currentTimeSeries = currentTimeSeriesVector->second.begin(); currentTimeSeries < currentTimeSeriesVector->second.end(); ++currentTimeSeries)
+		for(std::vector<TimeSeries>::const_iterator currentTimeSeries = currentTimeSeriesVector->begin(); currentTimeSeries < currentTimeSeriesVector->end(); ++currentTimeSeries)
 				{ result.push_back( *currentTimeSeries ); }
 	}
 	return result;
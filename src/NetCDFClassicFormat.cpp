@@ -0,0 +1,436 @@
+/*
+ * NetCDFClassicFormat.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "NetCDFClassicFormat.h"
+
+#include <cstring>
+
+namespace SedFlow {
+
+const char NetCDFClassicFormat::magicNumber[4] = {'C','D','F','\x01'};
+const unsigned int NetCDFClassicFormat::offsetOfNumberOfRecords = 4;
+
+namespace {
+
+const unsigned int tagOfDimensions = 0x0A;
+const unsigned int tagOfVariables = 0x0B;
+const unsigned int tagOfAttributes = 0x0C;
+
+void appendBigEndian(std::vector<char>& target, unsigned long long value, int numberOfBytes)
+{
+	for(int i = (numberOfBytes - 1); i >= 0; --i) { target.push_back( static_cast<char>( (value >> (8*i)) & 0xFF ) ); }
+}
+
+unsigned long long decodeBigEndian(const char* bytes, int numberOfBytes)
+{
+	unsigned long long result = 0;
+	for(int i = 0; i < numberOfBytes; ++i) { result = (result << 8) | static_cast<unsigned long long>( static_cast<unsigned char>(bytes[i]) ); }
+	return result;
+}
+
+inline unsigned int roundUpToMultipleOfFour(unsigned int value) { return ( ( (value + 3) / 4 ) * 4 ); }
+
+void appendAttributes(std::vector<char>& target, const std::vector<NetCDFClassicFormat::Attribute>& attributes)
+{
+	if( attributes.empty() )
+	{
+		NetCDFClassicFormat::appendUnsignedInt(target, 0);
+		NetCDFClassicFormat::appendUnsignedInt(target, 0);
+		return;
+	}
+	NetCDFClassicFormat::appendUnsignedInt(target, tagOfAttributes);
+	NetCDFClassicFormat::appendUnsignedInt(target, attributes.size());
+	for(std::vector<NetCDFClassicFormat::Attribute>::const_iterator currentAttribute = attributes.begin(); currentAttribute < attributes.end(); ++currentAttribute)
+	{
+		NetCDFClassicFormat::appendName(target, currentAttribute->name);
+		NetCDFClassicFormat::appendUnsignedInt(target, currentAttribute->type);
+		if( currentAttribute->type == NetCDFClassicFormat::NCChar )
+		{
+			NetCDFClassicFormat::appendUnsignedInt(target, currentAttribute->text.size());
+			target.insert(target.end(), currentAttribute->text.begin(), currentAttribute->text.end());
+		}
+		else
+		{
+			NetCDFClassicFormat::appendUnsignedInt(target, currentAttribute->values.size());
+			for(std::vector<double>::const_iterator currentValue = currentAttribute->values.begin(); currentValue < currentAttribute->values.end(); ++currentValue)
+				{ NetCDFClassicFormat::appendValue(target, currentAttribute->type, *currentValue); }
+		}
+		NetCDFClassicFormat::appendPadding(target);
+	}
+}
+
+bool readBytes(std::istream& source, std::vector<char>& bytes, unsigned int numberOfBytes)
+{
+	bytes.resize(numberOfBytes);
+	if( numberOfBytes == 0 ) { return true; }
+	source.read(&(bytes[0]), numberOfBytes);
+	return ( source.gcount() == static_cast<std::streamsize>(numberOfBytes) );
+}
+
+void throwUnsupportedFileError()
+{
+	const char *const errorMessage = "The file is not a NetCDF file in the classic format (CDF-1).";
+	throw(errorMessage);
+}
+
+NetCDFClassicFormat::NetCDFTypes convertToType(unsigned int type)
+{
+	if( type < NetCDFClassicFormat::NCByte || type > NetCDFClassicFormat::NCDouble ) { throwUnsupportedFileError(); }
+	return static_cast<NetCDFClassicFormat::NetCDFTypes>(type);
+}
+
+// Returns false, if the end of the stream has been reached before the list was complete.
+bool readListHeader(std::istream& source, unsigned int expectedTag, unsigned int& numberOfElements)
+{
+	unsigned int tag;
+	if( !(NetCDFClassicFormat::readUnsignedInt(source, tag)) || !(NetCDFClassicFormat::readUnsignedInt(source, numberOfElements)) ) { return false; }
+	if( tag != expectedTag && !(tag == 0 && numberOfElements == 0) ) { throwUnsupportedFileError(); }
+	return true;
+}
+
+bool readAttributes(std::istream& source, std::vector<NetCDFClassicFormat::Attribute>& attributes)
+{
+	attributes.clear();
+	unsigned int numberOfAttributes;
+	if( !(readListHeader(source, tagOfAttributes, numberOfAttributes)) ) { return false; }
+	std::vector<char> bytes;
+	for(unsigned int i = 0; i < numberOfAttributes; ++i)
+	{
+		NetCDFClassicFormat::Attribute attribute;
+		unsigned int type, numberOfValues;
+		if( !(NetCDFClassicFormat::readName(source, attribute.name)) || !(NetCDFClassicFormat::readUnsignedInt(source, type)) || !(NetCDFClassicFormat::readUnsignedInt(source, numberOfValues)) ) { return false; }
+		attribute.type = convertToType(type);
+		int sizeOfType = NetCDFClassicFormat::getSizeOfType(attribute.type);
+		if( !(readBytes(source, bytes, roundUpToMultipleOfFour(numberOfValues * sizeOfType))) ) { return false; }
+		if( attribute.type == NetCDFClassicFormat::NCChar ) { attribute.text.assign(bytes.begin(), bytes.begin() + numberOfValues); }
+		else
+		{
+			for(unsigned int j = 0; j < numberOfValues; ++j) { attribute.values.push_back( NetCDFClassicFormat::decodeValue(&(bytes[j * sizeOfType]), attribute.type) ); }
+		}
+		attributes.push_back(attribute);
+	}
+	return true;
+}
+
+}
+
+int NetCDFClassicFormat::getSizeOfType(NetCDFTypes type)
+{
+	switch (type)
+	{
+	case NCByte:
+	case NCChar:
+		return 1;
+	case NCShort:
+		return 2;
+	case NCInt:
+	case NCFloat:
+		return 4;
+	case NCDouble:
+		return 8;
+	default:
+		const char *const errorMessage = "Invalid NetCDF type";
+		throw(errorMessage);
+	}
+}
+
+void NetCDFClassicFormat::appendUnsignedInt(std::vector<char>& target, unsigned int value)
+{
+	appendBigEndian(target, value, 4);
+}
+
+void NetCDFClassicFormat::appendInt(std::vector<char>& target, int value)
+{
+	appendBigEndian(target, static_cast<unsigned int>(value), 4);
+}
+
+void NetCDFClassicFormat::appendDouble(std::vector<char>& target, double value)
+{
+	unsigned long long bits;
+	std::memcpy(&bits, &value, sizeof(double));
+	appendBigEndian(target, bits, 8);
+}
+
+void NetCDFClassicFormat::appendName(std::vector<char>& target, const std::string& name)
+{
+	appendUnsignedInt(target, name.size());
+	target.insert(target.end(), name.begin(), name.end());
+	appendPadding(target);
+}
+
+void NetCDFClassicFormat::appendPadding(std::vector<char>& target)
+{
+	while( (target.size() % 4) != 0 ) { target.push_back('\0'); }
+}
+
+void NetCDFClassicFormat::appendValue(std::vector<char>& target, NetCDFTypes type, double value)
+{
+	float floatValue;
+	unsigned int floatBits;
+	switch (type)
+	{
+	case NCByte:
+	case NCChar:
+		target.push_back( static_cast<char>( static_cast<int>(value) ) );
+		break;
+	case NCShort:
+		appendBigEndian(target, static_cast<unsigned short>( static_cast<short>(value) ), 2);
+		break;
+	case NCInt:
+		appendInt(target, static_cast<int>(value));
+		break;
+	case NCFloat:
+		floatValue = static_cast<float>(value);
+		std::memcpy(&floatBits, &floatValue, sizeof(float));
+		appendBigEndian(target, floatBits, 4);
+		break;
+	case NCDouble:
+		appendDouble(target, value);
+		break;
+	default:
+		const char *const errorMessage = "Invalid NetCDF type";
+		throw(errorMessage);
+	}
+}
+
+double NetCDFClassicFormat::decodeValue(const char* bytes, NetCDFTypes type)
+{
+	unsigned long long bits;
+	unsigned int floatBits;
+	float floatValue;
+	double doubleValue;
+	switch (type)
+	{
+	case NCByte:
+		return static_cast<double>( static_cast<signed char>(bytes[0]) );
+	case NCChar:
+		return static_cast<double>( static_cast<unsigned char>(bytes[0]) );
+	case NCShort:
+		return static_cast<double>( static_cast<short>( decodeBigEndian(bytes, 2) ) );
+	case NCInt:
+		return static_cast<double>( static_cast<int>( decodeBigEndian(bytes, 4) ) );
+	case NCFloat:
+		floatBits = decodeBigEndian(bytes, 4);
+		std::memcpy(&floatValue, &floatBits, sizeof(float));
+		return static_cast<double>(floatValue);
+	case NCDouble:
+		bits = decodeBigEndian(bytes, 8);
+		std::memcpy(&doubleValue, &bits, sizeof(double));
+		return doubleValue;
+	default:
+		const char *const errorMessage = "Invalid NetCDF type";
+		throw(errorMessage);
+	}
+}
+
+bool NetCDFClassicFormat::readUnsignedInt(std::istream& source, unsigned int& value)
+{
+	char bytes[4];
+	source.read(bytes, 4);
+	if( source.gcount() != 4 ) { return false; }
+	value = decodeBigEndian(bytes, 4);
+	return true;
+}
+
+bool NetCDFClassicFormat::readName(std::istream& source, std::string& name)
+{
+	unsigned int length;
+	if( !(readUnsignedInt(source, length)) ) { return false; }
+	std::vector<char> bytes;
+	if( !(readBytes(source, bytes, roundUpToMultipleOfFour(length))) ) { return false; }
+	name.assign(bytes.begin(), bytes.begin() + length);
+	return true;
+}
+
+bool NetCDFClassicFormat::isRecordVariable(int variableIndex) const
+{
+	const std::vector<int>& dimensionIDs = variables.at(variableIndex).dimensionIDs;
+	return ( !(dimensionIDs.empty()) && dimensions.at(dimensionIDs.front()).length == 0 );
+}
+
+unsigned int NetCDFClassicFormat::getNumberOfValues(int variableIndex) const
+{
+	const std::vector<int>& dimensionIDs = variables.at(variableIndex).dimensionIDs;
+	unsigned int result = 1;
+	for(std::vector<int>::const_iterator currentDimensionID = dimensionIDs.begin(); currentDimensionID < dimensionIDs.end(); ++currentDimensionID)
+	{
+		unsigned int length = dimensions.at(*currentDimensionID).length;
+		if( length == 0 )
+		{
+			if( currentDimensionID != dimensionIDs.begin() )
+			{
+				const char *const errorMessage = "In NetCDF files only the first dimension of a variable may be the record dimension.";
+				throw(errorMessage);
+			}
+			continue;
+		}
+		result *= length;
+	}
+	return result;
+}
+
+unsigned int NetCDFClassicFormat::getRecordSize() const
+{
+	unsigned int result = 0;
+	int numberOfRecordVariables = 0;
+	for(int variableIndex = 0; variableIndex < static_cast<int>(variables.size()); ++variableIndex)
+	{
+		if( isRecordVariable(variableIndex) )
+		{
+			result += variables[variableIndex].vsize;
+			++numberOfRecordVariables;
+		}
+	}
+	// A single record variable is not padded within the records.
+	if( numberOfRecordVariables == 1 )
+	{
+		for(int variableIndex = 0; variableIndex < static_cast<int>(variables.size()); ++variableIndex)
+		{
+			if( isRecordVariable(variableIndex) ) { result = getNumberOfValues(variableIndex) * getSizeOfType(variables[variableIndex].type); }
+		}
+	}
+	return result;
+}
+
+unsigned int NetCDFClassicFormat::getHeaderSize() const
+{
+	std::vector<char> header;
+	appendHeader(header, 0);
+	return header.size();
+}
+
+unsigned int NetCDFClassicFormat::getBeginOfRecords() const
+{
+	unsigned int result = getHeaderSize();
+	for(int variableIndex = 0; variableIndex < static_cast<int>(variables.size()); ++variableIndex)
+	{
+		if( !(isRecordVariable(variableIndex)) ) { result += variables[variableIndex].vsize; }
+	}
+	return result;
+}
+
+void NetCDFClassicFormat::calculateLayout()
+{
+	for(std::vector<Variable>::iterator currentVariable = variables.begin(); currentVariable < variables.end(); ++currentVariable)
+	{
+		currentVariable->vsize = roundUpToMultipleOfFour( getNumberOfValues(currentVariable - variables.begin()) * getSizeOfType(currentVariable->type) );
+		currentVariable->begin = 0;
+	}
+	// The size of the header does not depend on the values of begin.
+	unsigned int currentBegin = getHeaderSize();
+	for(int variableIndex = 0; variableIndex < static_cast<int>(variables.size()); ++variableIndex)
+	{
+		if( !(isRecordVariable(variableIndex)) )
+		{
+			variables[variableIndex].begin = currentBegin;
+			currentBegin += variables[variableIndex].vsize;
+		}
+	}
+	for(int variableIndex = 0; variableIndex < static_cast<int>(variables.size()); ++variableIndex)
+	{
+		if( isRecordVariable(variableIndex) )
+		{
+			variables[variableIndex].begin = currentBegin;
+			currentBegin += variables[variableIndex].vsize;
+		}
+	}
+}
+
+void NetCDFClassicFormat::appendHeader(std::vector<char>& target, unsigned int numberOfRecords) const
+{
+	target.insert(target.end(), magicNumber, magicNumber + 4);
+	appendUnsignedInt(target, numberOfRecords);
+
+	if( dimensions.empty() ) { appendUnsignedInt(target, 0); }
+	else { appendUnsignedInt(target, tagOfDimensions); }
+	appendUnsignedInt(target, dimensions.size());
+	for(std::vector<Dimension>::const_iterator currentDimension = dimensions.begin(); currentDimension < dimensions.end(); ++currentDimension)
+	{
+		appendName(target, currentDimension->name);
+		appendUnsignedInt(target, currentDimension->length);
+	}
+
+	appendAttributes(target, globalAttributes);
+
+	if( variables.empty() ) { appendUnsignedInt(target, 0); }
+	else { appendUnsignedInt(target, tagOfVariables); }
+	appendUnsignedInt(target, variables.size());
+	for(std::vector<Variable>::const_iterator currentVariable = variables.begin(); currentVariable < variables.end(); ++currentVariable)
+	{
+		appendName(target, currentVariable->name);
+		appendUnsignedInt(target, currentVariable->dimensionIDs.size());
+		for(std::vector<int>::const_iterator currentDimensionID = currentVariable->dimensionIDs.begin(); currentDimensionID < currentVariable->dimensionIDs.end(); ++currentDimensionID)
+			{ appendUnsignedInt(target, *currentDimensionID); }
+		appendAttributes(target, currentVariable->attributes);
+		appendUnsignedInt(target, currentVariable->type);
+		appendUnsignedInt(target, currentVariable->vsize);
+		appendUnsignedInt(target, currentVariable->begin);
+	}
+}
+
+bool NetCDFClassicFormat::readHeader(std::istream& source, unsigned int& numberOfRecords)
+{
+	dimensions.clear();
+	globalAttributes.clear();
+	variables.clear();
+
+	char fileMagicNumber[4];
+	source.read(fileMagicNumber, 4);
+	if( source.gcount() != 4 ) { return false; }
+	if( std::memcmp(fileMagicNumber, magicNumber, 4) != 0 ) { throwUnsupportedFileError(); }
+	if( !(readUnsignedInt(source, numberOfRecords)) ) { return false; }
+
+	unsigned int numberOfElements;
+	if( !(readListHeader(source, tagOfDimensions, numberOfElements)) ) { return false; }
+	for(unsigned int i = 0; i < numberOfElements; ++i)
+	{
+		Dimension dimension;
+		if( !(readName(source, dimension.name)) || !(readUnsignedInt(source, dimension.length)) ) { return false; }
+		dimensions.push_back(dimension);
+	}
+
+	if( !(readAttributes(source, globalAttributes)) ) { return false; }
+
+	if( !(readListHeader(source, tagOfVariables, numberOfElements)) ) { return false; }
+	for(unsigned int i = 0; i < numberOfElements; ++i)
+	{
+		Variable variable;
+		unsigned int numberOfDimensions, dimensionID, type;
+		if( !(readName(source, variable.name)) || !(readUnsignedInt(source, numberOfDimensions)) ) { return false; }
+		for(unsigned int j = 0; j < numberOfDimensions; ++j)
+		{
+			if( !(readUnsignedInt(source, dimensionID)) ) { return false; }
+			if( dimensionID >= dimensions.size() ) { throwUnsupportedFileError(); }
+			variable.dimensionIDs.push_back(dimensionID);
+		}
+		if( !(readAttributes(source, variable.attributes)) ) { return false; }
+		if( !(readUnsignedInt(source, type)) || !(readUnsignedInt(source, variable.vsize)) || !(readUnsignedInt(source, variable.begin)) ) { return false; }
+		variable.type = convertToType(type);
+		variables.push_back(variable);
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,168 @@
+/*
+ * NetCDFClassicReader.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "NetCDFClassicReader.h"
+
+#include <cstring>
+#include <sstream>
+
+namespace SedFlow {
+
+NetCDFClassicReader::NetCDFClassicReader(const std::string& fileName):
+	fileName(fileName),
+	numberOfRecords(0)
+{
+	iFileStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+	if( !(iFileStream.is_open()) )
+	{
+		std::ostringstream oStringStream;
+		oStringStream << "The NetCDF file \"" << fileName << "\" cannot be opened." << std::flush;
+		char* tmpChar = new char [(oStringStream.str()).size()+1];
+		std::strcpy(tmpChar, (oStringStream.str()).c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+
+	if( !(format.readHeader(iFileStream, numberOfRecords)) )
+	{
+		std::ostringstream oStringStream;
+		oStringStream << "The header of the NetCDF file \"" << fileName << "\" is incomplete." << std::flush;
+		char* tmpChar = new char [(oStringStream.str()).size()+1];
+		std::strcpy(tmpChar, (oStringStream.str()).c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+
+	// The number of records in the header may lag behind or, after an aborted simulation, run ahead of the data.
+	unsigned int recordSize = format.getRecordSize();
+	if( recordSize > 0 )
+	{
+		iFileStream.seekg(0, std::ios::end);
+		std::streamoff fileSize = iFileStream.tellg();
+		std::streamoff beginOfRecords = format.getBeginOfRecords();
+		unsigned int numberOfCompleteRecords = ( fileSize > beginOfRecords ) ? static_cast<unsigned int>( (fileSize - beginOfRecords) / recordSize ) : 0;
+		if( numberOfCompleteRecords < numberOfRecords ) { numberOfRecords = numberOfCompleteRecords; }
+	}
+	iFileStream.clear();
+}
+
+int NetCDFClassicReader::getVariableIndex(const std::string& variableName) const
+{
+	for(int i = 0; i < static_cast<int>(format.variables.size()); ++i)
+		{ if( format.variables[i].name == variableName ) { return i; } }
+	return -1;
+}
+
+const NetCDFClassicFormat::Attribute* NetCDFClassicReader::getAttribute(const std::string& variableName, const std::string& attributeName) const
+{
+	const std::vector<NetCDFClassicFormat::Attribute>* attributes = &(format.globalAttributes);
+	if( !(variableName.empty()) )
+	{
+		int variableIndex = getVariableIndex(variableName);
+		if( variableIndex < 0 ) { return NULL; }
+		attributes = &(format.variables[variableIndex].attributes);
+	}
+	for(std::vector<NetCDFClassicFormat::Attribute>::const_iterator currentAttribute = attributes->begin(); currentAttribute < attributes->end(); ++currentAttribute)
+		{ if( currentAttribute->name == attributeName ) { return &(*currentAttribute); } }
+	return NULL;
+}
+
+void NetCDFClassicReader::throwInvalidVariableError(const std::string& variableName) const
+{
+	std::ostringstream oStringStream;
+	oStringStream << "The NetCDF file \"" << fileName << "\" does not contain a suitable variable \"" << variableName << "\"." << std::flush;
+	char* tmpChar = new char [(oStringStream.str()).size()+1];
+	std::strcpy(tmpChar, (oStringStream.str()).c_str());
+	const char *const errorMessage = tmpChar;
+	throw(errorMessage);
+}
+
+void NetCDFClassicReader::readValues(int variableIndex, std::streamoff offset, std::vector<double>& values)
+{
+	const NetCDFClassicFormat::Variable& variable = format.variables[variableIndex];
+	unsigned int numberOfValues = format.getNumberOfValues(variableIndex);
+	int sizeOfType = NetCDFClassicFormat::getSizeOfType(variable.type);
+	valueBuffer.resize(numberOfValues * sizeOfType);
+	values.resize(numberOfValues);
+	if( numberOfValues == 0 ) { return; }
+
+	iFileStream.clear();
+	iFileStream.seekg(offset);
+	if( !(iFileStream.read(&(valueBuffer[0]), valueBuffer.size())) )
+	{
+		std::ostringstream oStringStream;
+		oStringStream << "The values of the variable \"" << variable.name << "\" in the NetCDF file \"" << fileName << "\" are incomplete." << std::flush;
+		char* tmpChar = new char [(oStringStream.str()).size()+1];
+		std::strcpy(tmpChar, (oStringStream.str()).c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+	for(unsigned int i = 0; i < numberOfValues; ++i)
+		{ values[i] = NetCDFClassicFormat::decodeValue(&(valueBuffer[i * sizeOfType]), variable.type); }
+}
+
+std::vector<double> NetCDFClassicReader::readVariable(const std::string& variableName)
+{
+	int variableIndex = getVariableIndex(variableName);
+	if( variableIndex < 0 || format.isRecordVariable(variableIndex) ) { throwInvalidVariableError(variableName); }
+	std::vector<double> result;
+	readValues(variableIndex, format.variables[variableIndex].begin, result);
+	return result;
+}
+
+std::vector<std::string> NetCDFClassicReader::readTextVariable(const std::string& variableName)
+{
+	int variableIndex = getVariableIndex(variableName);
+	if( variableIndex < 0 || format.isRecordVariable(variableIndex) || format.variables[variableIndex].type != NetCDFClassicFormat::NCChar || format.variables[variableIndex].dimensionIDs.empty() )
+		{ throwInvalidVariableError(variableName); }
+	std::vector<double> characters;
+	readValues(variableIndex, format.variables[variableIndex].begin, characters);
+
+	unsigned int stringLength = format.dimensions.at(format.variables[variableIndex].dimensionIDs.back()).length;
+	std::vector<std::string> result;
+	for(unsigned int begin = 0; stringLength > 0 && begin < characters.size(); begin += stringLength)
+	{
+		std::string currentString;
+		for(unsigned int i = begin; i < (begin + stringLength) && characters[i] != 0.0; ++i) { currentString.push_back( static_cast<char>(characters[i]) ); }
+		result.push_back(currentString);
+	}
+	return result;
+}
+
+std::vector<double> NetCDFClassicReader::readRecord(const std::string& variableName, unsigned int recordIndex)
+{
+	int variableIndex = getVariableIndex(variableName);
+	if( variableIndex < 0 || !(format.isRecordVariable(variableIndex)) ) { throwInvalidVariableError(variableName); }
+	if( recordIndex >= numberOfRecords )
+	{
+		const char *const errorMessage = "Record index beyond the number of records in the NetCDF file.";
+		throw(errorMessage);
+	}
+	std::vector<double> result;
+	readValues(variableIndex, static_cast<std::streamoff>(format.variables[variableIndex].begin) + static_cast<std::streamoff>(recordIndex) * format.getRecordSize(), result);
+	return result;
+}
+
+}
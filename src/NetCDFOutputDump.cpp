@@ -0,0 +1,168 @@
+/*
+ * NetCDFOutputDump.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+// Prints the header of the NetCDF files written by OutputRegularRiverReachPropertiesNetCDF and optionally the values of the variables as text.
+// It only depends on the bundled NetCDFClassicReader, so that the files can be checked without a NetCDF installation.
+//
+// Usage: NetCDFOutputDump [--values] [--precision N] inputFile.nc
+// Build: make bin/NetCDFOutputDump CXX_FLAGS="-O1 -DCURRENTLYUNIX"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "NetCDFClassicReader.h"
+#include "NumberFormatter.h"
+
+namespace {
+
+void printUsage(const char* programName)
+{
+	std::cerr << "Usage: " << programName << " [--values] [--precision N] inputFile.nc" << std::endl;
+}
+
+const char* typeToString(SedFlow::NetCDFClassicFormat::NetCDFTypes type)
+{
+	switch (type)
+	{
+	case SedFlow::NetCDFClassicFormat::NCByte: return "byte";
+	case SedFlow::NetCDFClassicFormat::NCChar: return "char";
+	case SedFlow::NetCDFClassicFormat::NCShort: return "short";
+	case SedFlow::NetCDFClassicFormat::NCInt: return "int";
+	case SedFlow::NetCDFClassicFormat::NCFloat: return "float";
+	case SedFlow::NetCDFClassicFormat::NCDouble: return "double";
+	default: return "unknown";
+	}
+}
+
+void printAttributes(const std::vector<SedFlow::NetCDFClassicFormat::Attribute>& attributes, const std::string& prefix)
+{
+	for(std::vector<SedFlow::NetCDFClassicFormat::Attribute>::const_iterator currentAttribute = attributes.begin(); currentAttribute < attributes.end(); ++currentAttribute)
+	{
+		std::cout << "\t\t" << prefix << ":" << currentAttribute->name << " = ";
+		if( currentAttribute->type == SedFlow::NetCDFClassicFormat::NCChar ) { std::cout << "\"" << currentAttribute->text << "\""; }
+		else
+		{
+			for(std::vector<double>::const_iterator currentValue = currentAttribute->values.begin(); currentValue < currentAttribute->values.end(); ++currentValue)
+				{ std::cout << ( currentValue == currentAttribute->values.begin() ? "" : ", " ) << *currentValue; }
+		}
+		std::cout << " ;" << std::endl;
+	}
+}
+
+void printHeader(const SedFlow::NetCDFClassicReader& reader)
+{
+	const SedFlow::NetCDFClassicFormat& format = reader.getFormat();
+	std::cout << "dimensions:" << std::endl;
+	for(std::vector<SedFlow::NetCDFClassicFormat::Dimension>::const_iterator currentDimension = format.dimensions.begin(); currentDimension < format.dimensions.end(); ++currentDimension)
+	{
+		std::cout << "\t" << currentDimension->name << " = ";
+		if( currentDimension->length == 0 ) { std::cout << "UNLIMITED ; // (" << reader.getNumberOfRecords() << " currently)" << std::endl; }
+		else { std::cout << currentDimension->length << " ;" << std::endl; }
+	}
+	std::cout << "variables:" << std::endl;
+	for(std::vector<SedFlow::NetCDFClassicFormat::Variable>::const_iterator currentVariable = format.variables.begin(); currentVariable < format.variables.end(); ++currentVariable)
+	{
+		std::cout << "\t" << typeToString(currentVariable->type) << " " << currentVariable->name << "(";
+		for(std::vector<int>::const_iterator currentDimensionID = currentVariable->dimensionIDs.begin(); currentDimensionID < currentVariable->dimensionIDs.end(); ++currentDimensionID)
+			{ std::cout << ( currentDimensionID == currentVariable->dimensionIDs.begin() ? "" : ", " ) << format.dimensions.at(*currentDimensionID).name; }
+		std::cout << ") ;" << std::endl;
+		printAttributes(currentVariable->attributes, currentVariable->name);
+	}
+	std::cout << "// global attributes:" << std::endl;
+	printAttributes(format.globalAttributes, "");
+}
+
+void printValues(const std::vector<double>& values, SedFlow::NumberFormatter& lineFormatter)
+{
+	lineFormatter.clear();
+	for(std::vector<double>::const_iterator currentValue = values.begin(); currentValue < values.end(); ++currentValue)
+	{
+		lineFormatter.append( (currentValue == values.begin()) ? '\t' : ' ' );
+		lineFormatter.appendScientific(*currentValue);
+	}
+	lineFormatter.append('\n');
+	lineFormatter.writeLineTo(std::cout);
+}
+
+void printData(SedFlow::NetCDFClassicReader& reader, int precision)
+{
+	SedFlow::NumberFormatter lineFormatter (precision);
+	const SedFlow::NetCDFClassicFormat& format = reader.getFormat();
+	std::cout << "data:" << std::endl;
+	for(int variableIndex = 0; variableIndex < static_cast<int>(format.variables.size()); ++variableIndex)
+	{
+		const std::string& variableName = format.variables[variableIndex].name;
+		std::cout << variableName << " =" << std::endl;
+		if( format.isRecordVariable(variableIndex) )
+		{
+			for(unsigned int recordIndex = 0; recordIndex < reader.getNumberOfRecords(); ++recordIndex)
+				{ printValues(reader.readRecord(variableName, recordIndex), lineFormatter); }
+		}
+		else if( format.variables[variableIndex].type == SedFlow::NetCDFClassicFormat::NCChar && !(format.variables[variableIndex].dimensionIDs.empty()) )
+		{
+			std::vector<std::string> strings = reader.readTextVariable(variableName);
+			for(std::vector<std::string>::const_iterator currentString = strings.begin(); currentString < strings.end(); ++currentString)
+				{ std::cout << "\t\"" << *currentString << "\"" << std::endl; }
+		}
+		else { printValues(reader.readVariable(variableName), lineFormatter); }
+	}
+	std::cout.flush();
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+	bool printAllValues = false;
+	int precision = 6;
+	std::vector<std::string> fileNames;
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string argument (argv[i]);
+		if( argument == "--values" ) { printAllValues = true; }
+		else if( argument == "--precision" && (i+1) < argc ) { precision = std::atoi(argv[++i]); }
+		else { fileNames.push_back(argument); }
+	}
+	if( fileNames.size() != 1 )
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	try
+	{
+		SedFlow::NetCDFClassicReader reader (fileNames.at(0));
+		printHeader(reader);
+		if(printAllValues) { printData(reader, precision); }
+		return ( std::cout.good() ? 0 : 1 );
+	}
+	catch(const char* errorMessage)
+	{
+		std::cerr << errorMessage << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,151 @@
+/*
+ * NumberFormatter.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "NumberFormatter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cfloat>
+
+namespace SedFlow {
+
+const std::vector<long double> NumberFormatter::powersOfTen(NumberFormatter::createPowersOfTen());
+
+std::vector<long double> NumberFormatter::createPowersOfTen()
+{
+	// All powers up to 10^22 are exactly representable even if long double is the same as double.
+	std::vector<long double> result;
+	result.reserve(maximumPowerOfTen+1);
+	long double currentPower = 1.0L;
+	for(int i = 0; i <= maximumPowerOfTen; ++i)
+	{
+		result.push_back(currentPower);
+		currentPower *= 10.0L;
+	}
+	return result;
+}
+
+NumberFormatter::NumberFormatter(int precision)
+{
+	setPrecision(precision);
+}
+
+void NumberFormatter::setPrecision(int precision)
+{
+	if( precision < 0 )
+	{
+		const char *const errorMessage = "The precision of a NumberFormatter must not be negative.";
+		throw(errorMessage);
+	}
+	this->precision = precision;
+	std::sprintf(fallbackFormat, "%%.%de", precision);
+}
+
+void NumberFormatter::appendScientificUsingSnprintf(double value)
+{
+	char buffer[512];
+	int length = std::sprintf(buffer, fallbackFormat, value);
+	line.append(buffer, length);
+}
+
+void NumberFormatter::appendScientific(double value)
+{
+	if( precision > maximumPrecisionForFastPath || !(value == value) || value > DBL_MAX || value < -DBL_MAX )
+	{
+		appendScientificUsingSnprintf(value);
+		return;
+	}
+
+	if( value == 0.0 )
+	{
+		// Negative zero is printed with its sign as well.
+		if( (1.0 / value) < 0.0 ) { line.push_back('-'); }
+		line.push_back('0');
+		if( precision > 0 )
+		{
+			line.push_back('.');
+			line.append(precision, '0');
+		}
+		line.append("e+00");
+		return;
+	}
+
+	long double absoluteValue = value;
+	if( value < 0.0 ) { absoluteValue = -absoluteValue; }
+	int exponent = static_cast<int>( std::floor( std::log10( static_cast<double>(absoluteValue) ) ) );
+
+	// The estimated exponent may be off by one. Thus the scaling is corrected at most twice.
+	for(int attempt = 0; attempt < 3; ++attempt)
+	{
+		int shift = precision - exponent;
+		if( shift > maximumPowerOfTen || shift < -maximumPowerOfTen ) { break; }
+		long double scaledValue = (shift >= 0) ? (absoluteValue * powersOfTen[shift]) : (absoluteValue / powersOfTen[-shift]);
+		long double roundedDown = std::floor(scaledValue);
+		long double remainder = scaledValue - roundedDown;
+		// The scaling is exact up to a relative error of LDBL_EPSILON. Within this distance to a tie the correct rounding cannot be decided.
+		long double uncertainty = 4.0L * LDBL_EPSILON * scaledValue;
+		if( std::fabs(remainder - 0.5L) <= uncertainty ) { break; }
+		long double roundedDigits = (remainder > 0.5L) ? (roundedDown + 1.0L) : roundedDown;
+
+		if( roundedDigits >= powersOfTen[precision+1] ) { ++exponent; continue; }
+		if( roundedDigits < powersOfTen[precision] ) { --exponent; continue; }
+
+		if( value < 0.0 ) { line.push_back('-'); }
+		appendDigitsAndExponent(static_cast<double>(roundedDigits), exponent);
+		return;
+	}
+	appendScientificUsingSnprintf(value);
+}
+
+void NumberFormatter::appendDigitsAndExponent(double roundedDigits, int exponent)
+{
+	// roundedDigits is an integer with precision+1 digits, which is exactly representable as double.
+	char digits[maximumPrecisionForFastPath+1];
+	for(int i = precision; i >= 0; --i)
+	{
+		double quotient = std::floor(roundedDigits / 10.0);
+		digits[i] = static_cast<char>( '0' + static_cast<int>(roundedDigits - (10.0 * quotient)) );
+		roundedDigits = quotient;
+	}
+	line.push_back(digits[0]);
+	if( precision > 0 )
+	{
+		line.push_back('.');
+		line.append(digits+1, precision);
+	}
+
+	line.push_back('e');
+	if( exponent < 0 )
+	{
+		line.push_back('-');
+		exponent = -exponent;
+	}
+	else { line.push_back('+'); }
+	if( exponent >= 100 ) { line.push_back( static_cast<char>('0' + (exponent / 100)) ); }
+	line.push_back( static_cast<char>('0' + ((exponent / 10) % 10)) );
+	line.push_back( static_cast<char>('0' + (exponent % 10)) );
+}
+
+}
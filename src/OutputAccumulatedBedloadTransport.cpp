@@ -78,6 +78,8 @@ OutputAccumulatedBedloadTransport::OutputAccumulatedBedloadTransport(std::vector
 	overallVolumeOFileStream << std::scientific;
 	detailedFractionalOFileStream.precision(precisionForOutput);
 	detailedFractionalOFileStream << std::scientific;
+	overallVolumeLineFormatter.setPrecision(precisionForOutput);
+	detailedFractionalLineFormatter.setPrecision(precisionForOutput);
 
 	if(userCellIDsForOutput.empty())
 	{
@@ -98,21 +100,13 @@ OutputAccumulatedBedloadTransport::OutputAccumulatedBedloadTransport(std::vector
 		}
 	}
 
-	Grains grainsSample = (cellPointersForOutput.back())->strataPerUnitBedSurface.at(0);
+	grainsTemplate = (cellPointersForOutput.back())->strataPerUnitBedSurface.at(0);
+	grainsTemplate.zeroFractions();
 
-	typesOfGrainsOrderForOutput = grainsSample.getTypesOfGrains();
-
-	grainsSample *= 0.0;
-	this->accumulatedBedloadTransport = std::vector<Grains>(cellPointersForOutput.size(),grainsSample);
-
-	if( this->outputIncludingPoreVolume )
-	{
-		ABTIncrementProperty = CombinerVariables::erosionIncludingPoreVolume;
-	}
-	else
-	{
-		ABTIncrementProperty = CombinerVariables::erosion;
-	}
+	typesOfGrainsOrderForOutput = grainsTemplate.getTypesOfGrains();
+	numberOfFractions = grainsTemplate.getNumberOfFractions();
+	numberOfValuesPerReach = typesOfGrainsOrderForOutput.size() * numberOfFractions;
+	this->accumulatedBedloadTransport.assign( (cellPointersForOutput.size() * numberOfValuesPerReach), 0.0 );
 }
 
 OutputAccumulatedBedloadTransport::~OutputAccumulatedBedloadTransport()
@@ -123,7 +117,8 @@ OutputAccumulatedBedloadTransport::~OutputAccumulatedBedloadTransport()
 
 OutputMethodType* OutputAccumulatedBedloadTransport::createOutputMethodTypePointerCopy() const
 {
-	OutputMethodType* result = new OutputAccumulatedBedloadTransport(this->userCellIDsForOutput, this->path, this->outputFiles, this->writeLineEachTimeStep, this->outputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->outputIncludingPoreVolume, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods, this->outputDetailedFractional);
+	OutputAccumulatedBedloadTransport* result = new OutputAccumulatedBedloadTransport(this->userCellIDsForOutput, this->path, this->outputFiles, this->writeLineEachTimeStep, this->outputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->outputIncludingPoreVolume, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods, this->outputDetailedFractional);
+	result->accumulatedBedloadTransport = this->accumulatedBedloadTransport;
 	return result;
 }
 
@@ -162,20 +157,55 @@ ConstructionVariables OutputAccumulatedBedloadTransport::createConstructionVaria
 	for(std::vector<std::string>::const_iterator iterator = outputFiles.begin(); iterator < outputFiles.end(); ++iterator)
 			{ stringVector.push_back(*iterator); }
 	result.labelledStrings["outputFiles"] = stringVector;
+	addFlushPolicyToConstructionVariables(result);
+	std::vector<ConstructionVariables> constructionVariablesVector;
+	constructionVariablesVector.reserve( cellPointersForOutput.size() );
+	Grains currentGrains = grainsTemplate;
+	std::vector<double>::const_iterator currentValue = accumulatedBedloadTransport.begin();
+	for(int reach = 0; reach < static_cast<int>(cellPointersForOutput.size()); ++reach)
+	{
+		for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrains < typesOfGrainsOrderForOutput.end(); ++currentTypeOfGrains)
+		{
+			for(int fraction = 0; fraction < numberOfFractions; ++fraction, ++currentValue)
+				{ currentGrains.setSingleFraction(*currentTypeOfGrains, fraction, *currentValue); }
+		}
+		constructionVariablesVector.push_back( currentGrains.createConstructionVariables() );
+	}
+	result.labelledObjects["accumulatedBedloadTransport"] = constructionVariablesVector;
 	return result;
 }
 
+void OutputAccumulatedBedloadTransport::setAccumulatedBedloadTransport(const std::vector<Grains>& accumulatedBedloadTransport)
+{
+	if( accumulatedBedloadTransport.size() != cellPointersForOutput.size() )
+	{
+		const char *const errorMessage = "For OutputAccumulatedBedloadTransport the number of accumulated values needs to match the number of reaches for output.";
+		throw(errorMessage);
+	}
+	std::vector<double>::iterator currentValue = this->accumulatedBedloadTransport.begin();
+	for(std::vector<Grains>::const_iterator currentGrains = accumulatedBedloadTransport.begin(); currentGrains < accumulatedBedloadTransport.end(); ++currentGrains)
+	{
+		for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrains < typesOfGrainsOrderForOutput.end(); ++currentTypeOfGrains)
+		{
+			for(int fraction = 0; fraction < numberOfFractions; ++fraction, ++currentValue)
+				{ *currentValue = currentGrains->getSingleFraction(*currentTypeOfGrains, fraction); }
+		}
+	}
+}
+
 void OutputAccumulatedBedloadTransport::initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
 	std::ostringstream diameterStringStream;
 
-	overallVolumeOFileStream.open(overallVolumeOutputFile, std::ios::out | std::ios::trunc);
+	overallVolumeOFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	overallVolumeOFileStream.openAndTruncate(overallVolumeOutputFile);
 	//Write header line
 	overallVolumeOFileStream << "ElapsedSeconds";
 
 	if(this->outputDetailedFractional)
 	{
-		detailedFractionalOFileStream.open(detailedFractionalOutputFile, std::ios::out | std::ios::trunc);
+		detailedFractionalOFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+		detailedFractionalOFileStream.openAndTruncate(detailedFractionalOutputFile);
 		//Write header line
 		detailedFractionalOFileStream << "ElapsedSeconds";
 	}
@@ -200,63 +230,112 @@ void OutputAccumulatedBedloadTransport::initialiseOutput(const std::vector<Outpu
 		}
 	}
 	overallVolumeOFileStream << "\n";
-	overallVolumeOFileStream.close();
+	overallVolumeOFileStream.flushNow();
 
 	if(this->outputDetailedFractional)
 	{
 		detailedFractionalOFileStream << "\n";
-		detailedFractionalOFileStream.close();
+		detailedFractionalOFileStream.flushNow();
 	}
 }
 
+void OutputAccumulatedBedloadTransport::continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	overallVolumeOFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	overallVolumeOFileStream.openForAppending(overallVolumeOutputFile);
+	if(this->outputDetailedFractional)
+	{
+		detailedFractionalOFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+		detailedFractionalOFileStream.openForAppending(detailedFractionalOutputFile);
+	}
+}
+
+std::vector<std::string> OutputAccumulatedBedloadTransport::getAppendedOutputFiles() const
+{
+	std::vector<std::string> result (1,overallVolumeOutputFileAsString);
+	if(this->outputDetailedFractional) { result.push_back(detailedFractionalOutputFileAsString); }
+	return result;
+}
+
 void OutputAccumulatedBedloadTransport::update(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
-	currentABT = this->accumulatedBedloadTransport.begin();
-	for(std::vector<const RegularRiverReachProperties*>::const_iterator currentRiverReachProperties = this->cellPointersForOutput.begin(); ( (currentABT < this->accumulatedBedloadTransport.end()) && (currentRiverReachProperties < this->cellPointersForOutput.end()) ) ; ++currentRiverReachProperties,++currentABT)
+	// Corresponds to the conversion of erosion into erosionIncludingPoreVolume in RegularRiverReachProperties::getGrainsProperty.
+	double incrementFactor = 1.0;
+	if( this->outputIncludingPoreVolume ) { incrementFactor = 1.0 / ( 1.0 - overallParameters->getPoreVolumeFraction() ); }
+
+	int numberOfReaches = cellPointersForOutput.size();
+	#pragma omp parallel for default(shared)
+	for(int reach = 0; reach < numberOfReaches; ++reach)
 	{
-		*currentABT += (*currentRiverReachProperties)->getGrainsProperty(ABTIncrementProperty);
+		const Grains& currentErosion = cellPointersForOutput[reach]->erosion;
+		std::vector<double>::iterator currentValue = accumulatedBedloadTransport.begin() + (reach * numberOfValuesPerReach);
+		for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrains < typesOfGrainsOrderForOutput.end(); ++currentTypeOfGrains)
+		{
+			const GrainType* currentGrainType = currentErosion.getSingleGrainTypeConstPointer(*currentTypeOfGrains);
+			for(int fraction = 0; fraction < numberOfFractions; ++fraction, ++currentValue)
+				{ *currentValue += currentGrainType->getFraction(fraction) * incrementFactor; }
+		}
 	}
 }
 
 void OutputAccumulatedBedloadTransport::forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
-	overallVolumeOFileStream.open(overallVolumeOutputFile, std::ios::out | std::ios::app);
-	overallVolumeOFileStream << overallParameters->getElapsedSeconds();
+	overallVolumeLineFormatter.clear();
+	overallVolumeLineFormatter.appendScientific( overallParameters->getElapsedSeconds() );
 
 	if(this->outputDetailedFractional)
 	{
-		detailedFractionalOFileStream.open(detailedFractionalOutputFile, std::ios::out | std::ios::app);
-		detailedFractionalOFileStream << overallParameters->getElapsedSeconds();
+		detailedFractionalLineFormatter.clear();
+		detailedFractionalLineFormatter.appendScientific( overallParameters->getElapsedSeconds() );
 	}
 
-	for(currentConstABT = this->accumulatedBedloadTransport.begin(); currentConstABT < this->accumulatedBedloadTransport.end(); ++currentConstABT)
+	int numberOfTypesOfGrains = typesOfGrainsOrderForOutput.size();
+	for(std::vector<double>::const_iterator reachBegin = this->accumulatedBedloadTransport.begin(); reachBegin < this->accumulatedBedloadTransport.end(); reachBegin += numberOfValuesPerReach)
 	{
-		overallVolumeOFileStream << "\t" << currentConstABT->getOverallVolume();
+		// The same order of summation as in Grains::getOverallVolume: First over the grain types for each fraction and then over the fractions.
+		double overallVolume = 0.0;
+		for(int fraction = 0; fraction < numberOfFractions; ++fraction)
+		{
+			double overallFractionVolume = 0.0;
+			for(int typeOfGrains = 0; typeOfGrains < numberOfTypesOfGrains; ++typeOfGrains)
+				{ overallFractionVolume += *( reachBegin + (typeOfGrains * numberOfFractions) + fraction ); }
+			overallVolume += overallFractionVolume;
+		}
+		overallVolumeLineFormatter.append('\t');
+		overallVolumeLineFormatter.appendScientific(overallVolume);
 
 		if(this->outputDetailedFractional)
 		{
-			for(currentTypeOfGrainsIterator = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrainsIterator < typesOfGrainsOrderForOutput.end(); ++currentTypeOfGrainsIterator)
+			for(std::vector<double>::const_iterator currentValue = reachBegin; currentValue < (reachBegin + numberOfValuesPerReach); ++currentValue)
 			{
-				currentGrainTypePointer = currentConstABT->getSingleGrainTypeConstPointer(*currentTypeOfGrainsIterator);
-				currentFractionalAbundances = currentGrainTypePointer->getFractions();
-				for(currentFractionIterator = currentFractionalAbundances.begin(); currentFractionIterator < currentFractionalAbundances.end(); ++currentFractionIterator)
-						{ detailedFractionalOFileStream << "\t" << *currentFractionIterator; }
+				detailedFractionalLineFormatter.append('\t');
+				detailedFractionalLineFormatter.appendScientific(*currentValue);
 			}
 		}
 	}
-	overallVolumeOFileStream << "\n";
-	overallVolumeOFileStream.close();
+	overallVolumeLineFormatter.append('\n');
+	overallVolumeLineFormatter.writeLineTo(overallVolumeOFileStream);
+	overallVolumeOFileStream.lineCompleted();
 
 	if(this->outputDetailedFractional)
 	{
-		detailedFractionalOFileStream << "\n";
-		detailedFractionalOFileStream.close();
+		detailedFractionalLineFormatter.append('\n');
+		detailedFractionalLineFormatter.writeLineTo(detailedFractionalOFileStream);
+		detailedFractionalOFileStream.lineCompleted();
 	}
 }
 
 void OutputAccumulatedBedloadTransport::finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
 	if ( !(writeLineEachTimeStep) ) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
+	overallVolumeOFileStream.close();
+	if(this->outputDetailedFractional) { detailedFractionalOFileStream.close(); }
+}
+
+void OutputAccumulatedBedloadTransport::flushOutput()
+{
+	overallVolumeOFileStream.flushNow();
+	if(this->outputDetailedFractional) { detailedFractionalOFileStream.flushNow(); }
 }
 
 }
@@ -0,0 +1,356 @@
+/*
+ * OutputBinaryCheckpoint.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "OutputBinaryCheckpoint.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined CURRENTLYWINDOWS
+//This is the Windows version
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+//This is the Linux version
+#include <unistd.h>
+#include <sys/types.h>
+#endif
+
+#include "BinaryColumnarOutputFormat.h"
+#include "OutputVerbatimTranslationOfConstructionVariablesToXML.h"
+#include "StringTools.h"
+
+namespace SedFlow {
+
+const char OutputBinaryCheckpoint::magicNumber[8] = {'S','E','D','F','L','O','W','C'};
+const unsigned int OutputBinaryCheckpoint::formatVersion = 1;
+
+namespace {
+
+void throwErrorMessageConcerningFile(const char* beforeFileName, const std::string& fileName, const char* afterFileName)
+{
+	std::ostringstream oStringStream;
+	oStringStream << beforeFileName << std::endl << "\"" << fileName << "\"" << std::endl << afterFileName << std::flush;
+
+	char* tmpChar = new char [(oStringStream.str()).size()+1];
+	std::strcpy(tmpChar, (oStringStream.str()).c_str());
+	const char *const errorMessage = tmpChar;
+	throw(errorMessage);
+}
+
+// Returns -1 if the file cannot be opened.
+double getFileSize(const std::string& fileName)
+{
+	std::ifstream file (fileName.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+	if( !file ) { return -1.0; }
+	return static_cast<double>( file.tellg() );
+}
+
+}
+
+OutputBinaryCheckpoint::OutputBinaryCheckpoint(std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods):
+	OutputMethodType(path, outputFiles, writeLineEachTimeStep, outputInterval, explicitTimesForOutput, precisionForOutput, overallParameters, overallMethods, riverSystemProperties, riverSystemMethods),
+	checkpointIsDue(false)
+{
+	this->typeOfOutputMethod = CombinerVariables::OutputBinaryCheckpoint;
+	if (outputFiles.size() != 1)
+	{
+		const char *const errorMessage = "For OutputBinaryCheckpoint exactly one (no more, no less) output file name is needed.";
+		throw(errorMessage);
+	}
+	makePathEndWithOneSlash();
+	outputFile = this->path;
+	outputFile.append( outputFiles.at(0) );
+}
+
+OutputMethodType* OutputBinaryCheckpoint::createOutputMethodTypePointerCopy() const
+{
+	OutputMethodType* result = new OutputBinaryCheckpoint(this->path, this->outputFiles, this->writeLineEachTimeStep, this->outputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods);
+	return result;
+}
+
+ConstructionVariables OutputBinaryCheckpoint::createConstructionVariables()const
+{
+	ConstructionVariables result = ConstructionVariables();
+	result.interfaceOrCombinerType = CombinerVariables::OutputMethodType;
+	result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputBinaryCheckpoint);
+	std::vector<double> doubleVector;
+	doubleVector.push_back(outputInterval);
+	result.labelledDoubles["outputInterval"] = doubleVector;
+	result.labelledDoubles["explicitTimesForOutput"] = explicitTimesForOutput;
+	std::vector<int> intVector;
+	intVector.push_back(precisionForOutput);
+	result.labelledInts["precisionForOutput"] = intVector;
+	std::vector<bool> boolVector;
+	boolVector.push_back(writeLineEachTimeStep);
+	result.labelledBools["writeLineEachTimeStep"] = boolVector;
+	std::vector<std::string> stringVector;
+	stringVector.push_back(path);
+	result.labelledStrings["path"] = stringVector;
+	result.labelledStrings["outputFiles"] = outputFiles;
+	return result;
+}
+
+void OutputBinaryCheckpoint::writeOutputLineIfScheduled(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	// The output methods are treated in parallel. Thus the checkpoint is only written in writeDeferredOutput,
+	// when all other output methods have finished the current time step.
+	checkpointIsDue = ( writeLineEachTimeStep || isDueToWriteLine(overallParameters->getElapsedSeconds(), timeOfLastOutput, outputInterval, remainingTimesForOutputInReverseOrder) );
+}
+
+void OutputBinaryCheckpoint::writeDeferredOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	if(checkpointIsDue)
+	{
+		writeCheckpoint(allConstitutingOutputMethodTypes);
+		checkpointIsDue = false;
+	}
+}
+
+void OutputBinaryCheckpoint::writeCheckpoint(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	// Everything written so far has to be in the files, so that the recorded file sizes match the state of the checkpoint.
+	std::vector<std::string> appendedOutputFiles;
+	std::vector<double> sizesOfAppendedOutputFiles;
+	for(std::vector<OutputMethodType*>::const_iterator currentOutputMethodType = allConstitutingOutputMethodTypes.begin(); currentOutputMethodType < allConstitutingOutputMethodTypes.end(); ++currentOutputMethodType)
+	{
+		(*currentOutputMethodType)->flushOutput();
+		std::vector<std::string> currentAppendedOutputFiles = (*currentOutputMethodType)->getAppendedOutputFiles();
+		for(std::vector<std::string>::const_iterator currentFile = currentAppendedOutputFiles.begin(); currentFile < currentAppendedOutputFiles.end(); ++currentFile)
+		{
+			double currentFileSize = getFileSize(*currentFile);
+			if( currentFileSize >= 0.0 )
+			{
+				appendedOutputFiles.push_back(*currentFile);
+				sizesOfAppendedOutputFiles.push_back(currentFileSize);
+			}
+		}
+	}
+
+	ConstructionVariables sedFlow = OutputVerbatimTranslationOfConstructionVariablesToXML::createConstructionVariablesForCompleteModel(overallParameters, overallMethods, riverSystemProperties, riverSystemMethods, allConstitutingOutputMethodTypes);
+	ConstructionVariables& outputMethods = sedFlow.labelledObjects["outputMethods"].at(0);
+	outputMethods.labelledStrings["appendedOutputFilesAtCheckpoint"] = appendedOutputFiles;
+	outputMethods.labelledDoubles["sizesOfAppendedOutputFilesAtCheckpoint"] = sizesOfAppendedOutputFiles;
+
+	byteBuffer.clear();
+	byteBuffer.insert(byteBuffer.end(), magicNumber, magicNumber + 8);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, formatVersion);
+	appendConstructionVariables(byteBuffer, sedFlow);
+
+	writeFileAtomically(outputFile, byteBuffer);
+}
+
+void OutputBinaryCheckpoint::writeFileAtomically(const std::string& fileName, const std::vector<char>& content)
+{
+	std::string temporaryFileName = fileName;
+	temporaryFileName.append(".tmp");
+
+	std::FILE* file = std::fopen(temporaryFileName.c_str(), "wb");
+	if( file == NULL ) { throwErrorMessageConcerningFile("The checkpoint file", temporaryFileName, "cannot be opened for writing."); }
+	bool success = ( content.empty() || ( std::fwrite(&(content[0]), 1, content.size(), file) == content.size() ) );
+	success = ( std::fflush(file) == 0 ) && success;
+	// The content has to be on the disk before it replaces the previous checkpoint.
+#if defined CURRENTLYWINDOWS
+	success = ( _commit(_fileno(file)) == 0 ) && success;
+#else
+	success = ( fsync(fileno(file)) == 0 ) && success;
+#endif
+	success = ( std::fclose(file) == 0 ) && success;
+	if( !success ) { throwErrorMessageConcerningFile("The checkpoint file", temporaryFileName, "cannot be written completely."); }
+
+#if defined CURRENTLYWINDOWS
+	success = ( MoveFileExA(temporaryFileName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0 );
+#else
+	success = ( std::rename(temporaryFileName.c_str(), fileName.c_str()) == 0 );
+#endif
+	if( !success ) { throwErrorMessageConcerningFile("The checkpoint file", fileName, "cannot be replaced by the new checkpoint."); }
+}
+
+void OutputBinaryCheckpoint::appendConstructionVariables(std::vector<char>& target, const ConstructionVariables& constructionVariables)
+{
+	BinaryColumnarOutputFormat::appendString(target, CombinerVariables::typeOfCombinersAndInterfacesToString(constructionVariables.interfaceOrCombinerType));
+	BinaryColumnarOutputFormat::appendString(target, constructionVariables.realisationType);
+
+	BinaryColumnarOutputFormat::appendUnsignedInt(target, constructionVariables.labelledDoubles.size());
+	for(std::map< std::string, std::vector<double> >::const_iterator currentMapEntry = constructionVariables.labelledDoubles.begin(); currentMapEntry != constructionVariables.labelledDoubles.end(); ++currentMapEntry)
+	{
+		BinaryColumnarOutputFormat::appendString(target, currentMapEntry->first);
+		BinaryColumnarOutputFormat::appendUnsignedInt(target, currentMapEntry->second.size());
+		for(std::vector<double>::const_iterator currentVectorItem = currentMapEntry->second.begin(); currentVectorItem < currentMapEntry->second.end(); ++currentVectorItem)
+			{ BinaryColumnarOutputFormat::appendDouble(target, *currentVectorItem); }
+	}
+
+	BinaryColumnarOutputFormat::appendUnsignedInt(target, constructionVariables.labelledInts.size());
+	for(std::map< std::string, std::vector<int> >::const_iterator currentMapEntry = constructionVariables.labelledInts.begin(); currentMapEntry != constructionVariables.labelledInts.end(); ++currentMapEntry)
+	{
+		BinaryColumnarOutputFormat::appendString(target, currentMapEntry->first);
+		BinaryColumnarOutputFormat::appendUnsignedInt(target, currentMapEntry->second.size());
+		for(std::vector<int>::const_iterator currentVectorItem = currentMapEntry->second.begin(); currentVectorItem < currentMapEntry->second.end(); ++currentVectorItem)
+			{ BinaryColumnarOutputFormat::appendInt(target, *currentVectorItem); }
+	}
+
+	BinaryColumnarOutputFormat::appendUnsignedInt(target, constructionVariables.labelledBools.size());
+	for(std::map< std::string, std::vector<bool> >::const_iterator currentMapEntry = constructionVariables.labelledBools.begin(); currentMapEntry != constructionVariables.labelledBools.end(); ++currentMapEntry)
+	{
+		BinaryColumnarOutputFormat::appendString(target, currentMapEntry->first);
+		BinaryColumnarOutputFormat::appendUnsignedInt(target, currentMapEntry->second.size());
+		for(std::vector<bool>::const_iterator currentVectorItem = currentMapEntry->second.begin(); currentVectorItem < currentMapEntry->second.end(); ++currentVectorItem)
+			{ target.push_back( (*currentVectorItem) ? 1 : 0 ); }
+	}
+
+	BinaryColumnarOutputFormat::appendUnsignedInt(target, constructionVariables.labelledObjects.size());
+	for(std::map< std::string, std::vector<ConstructionVariables> >::const_iterator currentMapEntry = constructionVariables.labelledObjects.begin(); currentMapEntry != constructionVariables.labelledObjects.end(); ++currentMapEntry)
+	{
+		BinaryColumnarOutputFormat::appendString(target, currentMapEntry->first);
+		BinaryColumnarOutputFormat::appendUnsignedInt(target, currentMapEntry->second.size());
+		for(std::vector<ConstructionVariables>::const_iterator currentVectorItem = currentMapEntry->second.begin(); currentVectorItem < currentMapEntry->second.end(); ++currentVectorItem)
+			{ appendConstructionVariables(target, *currentVectorItem); }
+	}
+
+	BinaryColumnarOutputFormat::appendUnsignedInt(target, constructionVariables.labelledStrings.size());
+	for(std::map< std::string, std::vector<std::string> >::const_iterator currentMapEntry = constructionVariables.labelledStrings.begin(); currentMapEntry != constructionVariables.labelledStrings.end(); ++currentMapEntry)
+	{
+		BinaryColumnarOutputFormat::appendString(target, currentMapEntry->first);
+		BinaryColumnarOutputFormat::appendStrings(target, currentMapEntry->second);
+	}
+}
+
+bool OutputBinaryCheckpoint::readConstructionVariables(std::istream& source, ConstructionVariables& constructionVariables)
+{
+	std::string tmpString;
+	if( !BinaryColumnarOutputFormat::readString(source, tmpString) ) { return false; }
+	constructionVariables.interfaceOrCombinerType = CombinerVariables::stringToTypeOfCombinersAndInterfaces(tmpString);
+	if( !BinaryColumnarOutputFormat::readString(source, constructionVariables.realisationType) ) { return false; }
+
+	unsigned int numberOfEntries;
+	unsigned int numberOfItems;
+	std::string label;
+
+	if( !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfEntries) ) { return false; }
+	for(unsigned int entry = 0; entry < numberOfEntries; ++entry)
+	{
+		if( !BinaryColumnarOutputFormat::readString(source, label) || !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfItems) ) { return false; }
+		std::vector<double>& items = constructionVariables.labelledDoubles[label];
+		items.resize(numberOfItems);
+		for(std::vector<double>::iterator currentItem = items.begin(); currentItem < items.end(); ++currentItem)
+			{ if( !BinaryColumnarOutputFormat::readDouble(source, *currentItem) ) { return false; } }
+	}
+
+	if( !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfEntries) ) { return false; }
+	for(unsigned int entry = 0; entry < numberOfEntries; ++entry)
+	{
+		if( !BinaryColumnarOutputFormat::readString(source, label) || !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfItems) ) { return false; }
+		std::vector<int>& items = constructionVariables.labelledInts[label];
+		items.resize(numberOfItems);
+		for(std::vector<int>::iterator currentItem = items.begin(); currentItem < items.end(); ++currentItem)
+			{ if( !BinaryColumnarOutputFormat::readInt(source, *currentItem) ) { return false; } }
+	}
+
+	if( !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfEntries) ) { return false; }
+	for(unsigned int entry = 0; entry < numberOfEntries; ++entry)
+	{
+		if( !BinaryColumnarOutputFormat::readString(source, label) || !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfItems) ) { return false; }
+		std::vector<bool>& items = constructionVariables.labelledBools[label];
+		items.clear();
+		for(unsigned int item = 0; item < numberOfItems; ++item)
+		{
+			char byte;
+			if( !source.get(byte) ) { return false; }
+			items.push_back( byte != 0 );
+		}
+	}
+
+	if( !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfEntries) ) { return false; }
+	for(unsigned int entry = 0; entry < numberOfEntries; ++entry)
+	{
+		if( !BinaryColumnarOutputFormat::readString(source, label) || !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfItems) ) { return false; }
+		std::vector<ConstructionVariables>& items = constructionVariables.labelledObjects[label];
+		items.resize(numberOfItems);
+		for(std::vector<ConstructionVariables>::iterator currentItem = items.begin(); currentItem < items.end(); ++currentItem)
+			{ if( !readConstructionVariables(source, *currentItem) ) { return false; } }
+	}
+
+	if( !BinaryColumnarOutputFormat::readUnsignedInt(source, numberOfEntries) ) { return false; }
+	for(unsigned int entry = 0; entry < numberOfEntries; ++entry)
+	{
+		if( !BinaryColumnarOutputFormat::readString(source, label) || !BinaryColumnarOutputFormat::readStrings(source, constructionVariables.labelledStrings[label]) ) { return false; }
+	}
+
+	return true;
+}
+
+ConstructionVariables OutputBinaryCheckpoint::readCheckpointFile(const char* checkpointFile)
+{
+	std::string fullPath = StringTools::getFullPath(checkpointFile);
+	std::ifstream source (fullPath.c_str(), std::ios::in | std::ios::binary);
+	if( !source ) { throwErrorMessageConcerningFile("The specified checkpoint file", fullPath, "cannot be found."); }
+
+	char fileMagicNumber[8];
+	unsigned int fileFormatVersion;
+	if( !source.read(fileMagicNumber, 8) || std::memcmp(fileMagicNumber, magicNumber, 8) != 0 || !BinaryColumnarOutputFormat::readUnsignedInt(source, fileFormatVersion) )
+		{ throwErrorMessageConcerningFile("The file", fullPath, "is not a sedFlow checkpoint."); }
+	if( fileFormatVersion != formatVersion )
+		{ throwErrorMessageConcerningFile("The checkpoint file", fullPath, "has been written by an incompatible version of sedFlow."); }
+
+	ConstructionVariables result;
+	if( !readConstructionVariables(source, result) )
+		{ throwErrorMessageConcerningFile("The checkpoint file", fullPath, "is incomplete."); }
+	return result;
+}
+
+void OutputBinaryCheckpoint::truncateAppendedOutputFilesToCheckpoint(const ConstructionVariables& sedFlowConstructionVariables)
+{
+	std::map< std::string, std::vector<ConstructionVariables> >::const_iterator outputMethodsIterator = sedFlowConstructionVariables.labelledObjects.find("outputMethods");
+	if( outputMethodsIterator == sedFlowConstructionVariables.labelledObjects.end() ) { return; }
+	const ConstructionVariables& outputMethods = outputMethodsIterator->second.at(0);
+
+	std::map< std::string, std::vector<std::string> >::const_iterator filesIterator = outputMethods.labelledStrings.find("appendedOutputFilesAtCheckpoint");
+	std::map< std::string, std::vector<double> >::const_iterator sizesIterator = outputMethods.labelledDoubles.find("sizesOfAppendedOutputFilesAtCheckpoint");
+	if( filesIterator == outputMethods.labelledStrings.end() || sizesIterator == outputMethods.labelledDoubles.end() ) { return; }
+
+	std::vector<double>::const_iterator currentSize = sizesIterator->second.begin();
+	for(std::vector<std::string>::const_iterator currentFile = filesIterator->second.begin(); ( (currentFile < filesIterator->second.end()) && (currentSize < sizesIterator->second.end()) ); ++currentFile, ++currentSize)
+	{
+		// Files, which are missing or have not grown since the checkpoint, are left unchanged.
+		if( getFileSize(*currentFile) <= *currentSize ) { continue; }
+#if defined CURRENTLYWINDOWS
+		bool success = false;
+		int fileDescriptor = _open(currentFile->c_str(), _O_RDWR | _O_BINARY);
+		if( fileDescriptor != -1 )
+		{
+			success = ( _chsize_s(fileDescriptor, static_cast<__int64>(*currentSize)) == 0 );
+			success = ( _close(fileDescriptor) == 0 ) && success;
+		}
+#else
+		bool success = ( truncate(currentFile->c_str(), static_cast<off_t>(*currentSize)) == 0 );
+#endif
+		if( !success ) { throwErrorMessageConcerningFile("The output file", *currentFile, "cannot be cut back to its size at the time of the checkpoint."); }
+	}
+}
+
+}
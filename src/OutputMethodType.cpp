@@ -41,7 +41,11 @@ OutputMethodType::OutputMethodType(std::string path, std::vector<std::string> ou
 		overallParameters(overallParameters),
 		overallMethods(overallMethods),
 		riverSystemProperties(riverSystemProperties),
-		riverSystemMethods(riverSystemMethods)
+		riverSystemMethods(riverSystemMethods),
+		flushPolicy(CombinerVariables::FlushAfterWallSeconds),
+		numberOfLinesBetweenFlushes(100),
+		wallSecondsBetweenFlushes(10.0),
+		asynchronousOutputWriter(NULL)
 {
 	if( 0 >= this->outputInterval )
 	{
@@ -59,11 +63,48 @@ OutputMethodType::OutputMethodType(std::string path, std::vector<std::string> ou
 		{ this->remainingTimesForOutputInReverseOrder.pop_back(); }
 }
 
+void OutputMethodType::setTimeOfLastOutput(double timeOfLastOutput)
+{
+	this->timeOfLastOutput = timeOfLastOutput;
+	while( !(this->remainingTimesForOutputInReverseOrder.empty()) && this->timeOfLastOutput >= this->remainingTimesForOutputInReverseOrder.back() )
+		{ this->remainingTimesForOutputInReverseOrder.pop_back(); }
+}
+
 void OutputMethodType::makePathEndWithOneSlash()
 {
 	StringTools::ensureForwardSlashesAndMakeStringEndWithOneSlash(path);
 }
 
+void OutputMethodType::setFlushPolicy(CombinerVariables::TypesOfOutputFlushPolicy flushPolicy, int numberOfLinesBetweenFlushes, double wallSecondsBetweenFlushes)
+{
+	if( numberOfLinesBetweenFlushes < 1 )
+	{
+		const char *const errorMessage = "The numberOfLinesBetweenFlushes of an output needs to be at least one.";
+		throw(errorMessage);
+	}
+	if( wallSecondsBetweenFlushes < 0.0 )
+	{
+		const char *const errorMessage = "The wallSecondsBetweenFlushes of an output must not be negative.";
+		throw(errorMessage);
+	}
+	this->flushPolicy = flushPolicy;
+	this->numberOfLinesBetweenFlushes = numberOfLinesBetweenFlushes;
+	this->wallSecondsBetweenFlushes = wallSecondsBetweenFlushes;
+}
+
+void OutputMethodType::addFlushPolicyToConstructionVariables(ConstructionVariables& target) const
+{
+	std::vector<std::string> stringVector;
+	stringVector.push_back( CombinerVariables::typeOfOutputFlushPolicyToString(flushPolicy) );
+	target.labelledStrings["flushPolicy"] = stringVector;
+	std::vector<int> intVector;
+	intVector.push_back(numberOfLinesBetweenFlushes);
+	target.labelledInts["numberOfLinesBetweenFlushes"] = intVector;
+	std::vector<double> doubleVector;
+	doubleVector.push_back(wallSecondsBetweenFlushes);
+	target.labelledDoubles["wallSecondsBetweenFlushes"] = doubleVector;
+}
+
 bool OutputMethodType::isDueToWriteLineWithoutUpdatingParameters(double elapsedSeconds, double timeOfLastOutput, double outputInterval, const std::vector<double>& remainingTimesForOutputInReverseOrder)
 {
 	return ( elapsedSeconds >= (timeOfLastOutput + outputInterval) || (!(remainingTimesForOutputInReverseOrder.empty()) && elapsedSeconds >= remainingTimesForOutputInReverseOrder.back()) );
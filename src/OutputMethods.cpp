@@ -23,6 +23,7 @@
  */
 
 #include "OutputMethods.h"
+#include "StageProfiler.h"
 
 #include <algorithm>
 
@@ -50,14 +51,37 @@ std::vector<OutputMethodType*> OutputMethods::forConstructorsCheckAndCopySingleO
 		for(std::vector<OutputMethodType*>::const_iterator i = singleOutputMethodTypes.begin(); i < singleOutputMethodTypes.end(); ++i)
 		{
 			result.push_back((*(*i)).createOutputMethodTypePointerCopy());
+			result.back()->copyFlushPolicy(*(*i));
 		}
 
 		return result;
 }
 
-OutputMethods::OutputMethods(const std::vector<OutputMethodType*>& singleOutputMethodTypes):
-	constitutingOutputMethodTypes( OutputMethods::forConstructorsCheckAndCopySingleOutputMethodTypes(singleOutputMethodTypes) )
-{}
+OutputMethods::OutputMethods(const std::vector<OutputMethodType*>& singleOutputMethodTypes, bool asynchronousOutput, int asynchronousOutputQueueLength):
+	constitutingOutputMethodTypes( OutputMethods::forConstructorsCheckAndCopySingleOutputMethodTypes(singleOutputMethodTypes) ),
+	asynchronousOutput(asynchronousOutput),
+	asynchronousOutputQueueLength(asynchronousOutputQueueLength),
+	asynchronousOutputWriter(NULL)
+{
+	createAsynchronousOutputWriterIfNeeded();
+}
+
+void OutputMethods::createAsynchronousOutputWriterIfNeeded()
+{
+	if( !asynchronousOutput ) { return; }
+	asynchronousOutputWriter = new AsynchronousOutputWriter(asynchronousOutputQueueLength);
+	for(std::vector<OutputMethodType*>::const_iterator currentOutputMethod = constitutingOutputMethodTypes.begin(); currentOutputMethod < constitutingOutputMethodTypes.end(); ++currentOutputMethod)
+		{ (*currentOutputMethod)->setAsynchronousOutputWriter(asynchronousOutputWriter); }
+}
+
+void OutputMethods::deleteAsynchronousOutputWriter()
+{
+	// The background thread is stopped, before the output methods it writes for are deleted.
+	delete asynchronousOutputWriter;
+	asynchronousOutputWriter = NULL;
+	for(std::vector<OutputMethodType*>::const_iterator currentOutputMethod = constitutingOutputMethodTypes.begin(); currentOutputMethod < constitutingOutputMethodTypes.end(); ++currentOutputMethod)
+		{ (*currentOutputMethod)->setAsynchronousOutputWriter(NULL); }
+}
 
 ConstructionVariables OutputMethods::createConstructionVariables()const
 {
@@ -68,15 +92,32 @@ ConstructionVariables OutputMethods::createConstructionVariables()const
 	for(std::vector<OutputMethodType*>::const_iterator iterator = constitutingOutputMethodTypes.begin(); iterator < constitutingOutputMethodTypes.end(); ++iterator)
 			{ constructionVariablesVector.push_back( (*iterator)->createConstructionVariables() ); }
 	result.labelledObjects["constitutingOutputMethodTypes"] = constructionVariablesVector;
+	std::vector<double> doubleVector;
+	doubleVector.reserve( constitutingOutputMethodTypes.size() );
+	for(std::vector<OutputMethodType*>::const_iterator iterator = constitutingOutputMethodTypes.begin(); iterator < constitutingOutputMethodTypes.end(); ++iterator)
+			{ doubleVector.push_back( (*iterator)->getTimeOfLastOutput() ); }
+	result.labelledDoubles["timesOfLastOutput"] = doubleVector;
+	std::vector<bool> boolVector;
+	boolVector.push_back(asynchronousOutput);
+	result.labelledBools["asynchronousOutput"] = boolVector;
+	std::vector<int> intVector;
+	intVector.push_back(asynchronousOutputQueueLength);
+	result.labelledInts["asynchronousOutputQueueLength"] = intVector;
 	return result;
 }
 
 OutputMethods::OutputMethods(const OutputMethods& toCopy):
-	constitutingOutputMethodTypes( OutputMethods::forConstructorsCheckAndCopySingleOutputMethodTypes(toCopy.constitutingOutputMethodTypes) )
-{}
+	constitutingOutputMethodTypes( OutputMethods::forConstructorsCheckAndCopySingleOutputMethodTypes(toCopy.constitutingOutputMethodTypes) ),
+	asynchronousOutput(toCopy.asynchronousOutput),
+	asynchronousOutputQueueLength(toCopy.asynchronousOutputQueueLength),
+	asynchronousOutputWriter(NULL)
+{
+	createAsynchronousOutputWriterIfNeeded();
+}
 
 OutputMethods::~OutputMethods()
 {
+	deleteAsynchronousOutputWriter();
 	while(!(this->constitutingOutputMethodTypes.empty()))
 	{
 		delete this->constitutingOutputMethodTypes.back();
@@ -91,6 +132,7 @@ void OutputMethods::initialiseOutput()const
 	//TODO Delete this debugging line.
 	std::cout << "OMP OutputMethods::initialiseOutput" << std::endl << std::endl;
 #endif
+	if( asynchronousOutputWriter != NULL ) { asynchronousOutputWriter->start(); }
 	#pragma omp parallel for private(currentOutputMethod) default(shared)
 	for(int i = 0; i < constitutingOutputMethodTypes.size(); ++i)
 	{
@@ -99,6 +141,18 @@ void OutputMethods::initialiseOutput()const
 	}
 }
 
+void OutputMethods::continueOutput()const
+{
+	OutputMethodType* currentOutputMethod;
+	if( asynchronousOutputWriter != NULL ) { asynchronousOutputWriter->start(); }
+	#pragma omp parallel for private(currentOutputMethod) default(shared)
+	for(int i = 0; i < constitutingOutputMethodTypes.size(); ++i)
+	{
+		currentOutputMethod = constitutingOutputMethodTypes[i];
+		currentOutputMethod->continueOutput(constitutingOutputMethodTypes);
+	}
+}
+
 void OutputMethods::update()
 {
 	OutputMethodType* currentOutputMethod;
@@ -109,8 +163,10 @@ void OutputMethods::update()
 	#pragma omp parallel for private(currentOutputMethod) default(shared)
 	for(int i = 0; i < constitutingOutputMethodTypes.size(); ++i)
 	{
+		double startTime = StageProfiler::startSection();
 		currentOutputMethod = constitutingOutputMethodTypes[i];
 		currentOutputMethod->update(constitutingOutputMethodTypes);
+		StageProfiler::finishSection(StageProfiler::getSectionForOutputMethods(currentOutputMethod->getTypeOfOutputMethod()), startTime);
 	}
 }
 
@@ -124,8 +180,16 @@ void OutputMethods::writeOutputLineIfScheduled()
 	#pragma omp parallel for private(currentOutputMethod) default(shared)
 	for(int i = 0; i < constitutingOutputMethodTypes.size(); ++i)
 	{
+		double startTime = StageProfiler::startSection();
 		currentOutputMethod = constitutingOutputMethodTypes[i];
 		currentOutputMethod->writeOutputLineIfScheduled(constitutingOutputMethodTypes);
+		StageProfiler::finishSection(StageProfiler::getSectionForOutputMethods(currentOutputMethod->getTypeOfOutputMethod()), startTime);
+	}
+	for(std::vector<OutputMethodType*>::const_iterator currentOutputMethodType = constitutingOutputMethodTypes.begin(); currentOutputMethodType < constitutingOutputMethodTypes.end(); ++currentOutputMethodType)
+	{
+		double startTime = StageProfiler::startSection();
+		(*currentOutputMethodType)->writeDeferredOutput(constitutingOutputMethodTypes);
+		StageProfiler::finishSection(StageProfiler::getSectionForOutputMethods((*currentOutputMethodType)->getTypeOfOutputMethod()), startTime);
 	}
 }
 
@@ -157,7 +221,25 @@ void OutputMethods::finaliseOutput()const
 		currentOutputMethod = constitutingOutputMethodTypes[i];
 		currentOutputMethod->finaliseOutput(constitutingOutputMethodTypes);
 	}
+	if( asynchronousOutputWriter != NULL ) { asynchronousOutputWriter->stop(); }
 }
 
+void OutputMethods::setTimesOfLastOutput(const std::vector<double>& timesOfLastOutput)
+{
+	if( timesOfLastOutput.size() != constitutingOutputMethodTypes.size() )
+	{
+		const char *const errorMessage = "The number of timesOfLastOutput does not match the number of constitutingOutputMethodTypes.";
+		throw(errorMessage);
+	}
+	std::vector<double>::const_iterator currentTimeOfLastOutput = timesOfLastOutput.begin();
+	for(std::vector<OutputMethodType*>::const_iterator currentOutputMethodType = constitutingOutputMethodTypes.begin(); currentOutputMethodType < constitutingOutputMethodTypes.end(); ++currentOutputMethodType, ++currentTimeOfLastOutput)
+		{ (*currentOutputMethodType)->setTimeOfLastOutput(*currentTimeOfLastOutput); }
+}
+
+void OutputMethods::flushOutput()const
+{
+	for(std::vector<OutputMethodType*>::const_iterator currentOutputMethod = constitutingOutputMethodTypes.begin(); currentOutputMethod < constitutingOutputMethodTypes.end(); ++currentOutputMethod)
+		{ (*currentOutputMethod)->flushOutput(); }
+}
 
 }
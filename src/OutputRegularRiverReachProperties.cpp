@@ -24,15 +24,18 @@
 
 #include "OutputRegularRiverReachProperties.h"
 
+#include "AsynchronousOutputWriter.h"
+
 #include <iostream>
 #include <cstring>
 
 namespace SedFlow {
 
 
-OutputRegularRiverReachProperties::OutputRegularRiverReachProperties(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods):
+OutputRegularRiverReachProperties::OutputRegularRiverReachProperties(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods):
 		OutputMethodType(path, outputFiles, writeLineEachTimeStep, outputInterval, explicitTimesForOutput, precisionForOutput, overallParameters, overallMethods, riverSystemProperties, riverSystemMethods),
 		regularRiverReachPropertiesForOutput(regularRiverReachPropertiesForOutput),
+		aggregationsForOutput(aggregationsForOutput),
 		userCellIDsForOutput(userCellIDsForOutput),
 		outputTimeStepLength(outputTimeStepLength),
 		outputInitialValues(outputInitialValues),
@@ -47,7 +50,10 @@ OutputRegularRiverReachProperties::OutputRegularRiverReachProperties(std::vector
 		secondaryOutputInterval(secondaryOutputInterval),
 		fractionalGrainDiameters(overallParameters->getFractionalGrainDiameters()),
 		fractionalGrainDiametersBegin(fractionalGrainDiameters.begin()),
-		fractionalGrainDiametersEnd(fractionalGrainDiameters.end())
+		fractionalGrainDiametersEnd(fractionalGrainDiameters.end()),
+		aggregationStarted(false),
+		aggregationStartTime(0.0),
+		timeOfLastAggregation(0.0)
 {
 	this->typeOfOutputMethod = CombinerVariables::OutputRegularRiverReachProperties;
 	if (outputFiles.size() != 1)
@@ -65,6 +71,7 @@ OutputRegularRiverReachProperties::OutputRegularRiverReachProperties(std::vector
 	oFileStream << std::scientific;
 	oStringStream.precision(precisionForOutput);
 	oStringStream << std::scientific;
+	lineFormatter.setPrecision(precisionForOutput);
 
 	if(this->printUpstreamMargins)
 	{
@@ -121,6 +128,34 @@ OutputRegularRiverReachProperties::OutputRegularRiverReachProperties(std::vector
 		referenceCell = &( (riverSystemProperties->regularRiverSystemProperties.cellProperties.at( riverSystemProperties->regularRiverSystemProperties.getRealCellIDcorrespondingToUserCellID( referenceCellUserCellID ) )).regularRiverReachProperties );
 	}
 
+	// A single aggregation is applied to all properties.
+	if( this->aggregationsForOutput.empty() ) { this->aggregationsForOutput.push_back(CombinerVariables::InstantaneousValue); }
+	if( this->aggregationsForOutput.size() == 1 ) { this->aggregationsForOutput.resize(this->regularRiverReachPropertiesForOutput.size(), this->aggregationsForOutput.at(0)); }
+	if( this->aggregationsForOutput.size() != this->regularRiverReachPropertiesForOutput.size() )
+	{
+		const char *const errorMessage = "For OutputRegularRiverReachProperties either a single aggregation or one aggregation for each of the regularRiverReachPropertiesForOutput is needed.";
+		throw(errorMessage);
+	}
+
+	int numberOfColumnsPerGrains = typesOfGrainsOrderForOutput.size() * fractionalGrainDiameters.size();
+	int numberOfAggregatedColumns = 0;
+	for(int propertyIndex = 0; propertyIndex < static_cast<int>(this->regularRiverReachPropertiesForOutput.size()); ++propertyIndex)
+	{
+		CombinerVariables::TypesOfRegularRiverReachProperties currentPropertyType = this->regularRiverReachPropertiesForOutput.at(propertyIndex);
+		if( this->aggregationsForOutput.at(propertyIndex) == CombinerVariables::InstantaneousValue ) { continue; }
+		if( currentPropertyType == CombinerVariables::strataPerUnitBedSurface || currentPropertyType == CombinerVariables::strataPerUnitBedSurfaceIncludingPoreVolume )
+		{
+			const char *const errorMessage = "The strata properties cannot be aggregated in OutputRegularRiverReachProperties, as the number of strata layers may change in the course of a simulation.";
+			throw(errorMessage);
+		}
+		aggregatedPropertyIndices.push_back(propertyIndex);
+		numberOfColumnsOfAggregatedProperties.push_back( cellPointersForOutput.size() * ( CombinerVariables::regularRiverReachPropertyIsGrains(currentPropertyType) ? numberOfColumnsPerGrains : 1 ) );
+		numberOfAggregatedColumns += numberOfColumnsOfAggregatedProperties.back();
+	}
+	minimumValues.assign(numberOfAggregatedColumns,0.0);
+	maximumValues.assign(numberOfAggregatedColumns,0.0);
+	timeIntegrals.assign(numberOfAggregatedColumns,0.0);
+	timesOfMaximum.assign(numberOfAggregatedColumns,0.0);
 }
 
 OutputRegularRiverReachProperties::~OutputRegularRiverReachProperties()
@@ -130,7 +165,61 @@ OutputRegularRiverReachProperties::~OutputRegularRiverReachProperties()
 
 OutputMethodType* OutputRegularRiverReachProperties::createOutputMethodTypePointerCopy() const
 {
-	OutputMethodType* result = new OutputRegularRiverReachProperties(this->regularRiverReachPropertiesForOutput, this->userCellIDsForOutput, this->outputTimeStepLength, this->outputInitialValues, this->printUpstreamMargins, this->printDownstreamMargin, this->path, this->outputFiles, this->writeLineEachTimeStep, this->outputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->useSecondaryOutputInterval, this->referenceCellUserCellID, this->referenceProperty, this->thresholdToBeExceeded, this->secondaryOutputInterval, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods);
+	OutputRegularRiverReachProperties* result = new OutputRegularRiverReachProperties(this->regularRiverReachPropertiesForOutput, this->aggregationsForOutput, this->userCellIDsForOutput, this->outputTimeStepLength, this->outputInitialValues, this->printUpstreamMargins, this->printDownstreamMargin, this->path, this->outputFiles, this->writeLineEachTimeStep, this->outputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->useSecondaryOutputInterval, this->referenceCellUserCellID, this->referenceProperty, this->thresholdToBeExceeded, this->secondaryOutputInterval, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods);
+	result->setAggregationState(this->getAggregationState());
+	return result;
+}
+
+std::vector<double> OutputRegularRiverReachProperties::getAggregationState() const
+{
+	std::vector<double> result;
+	if( !aggregationStarted ) { return result; }
+	result.reserve( 2 + (4 * minimumValues.size()) );
+	result.push_back(aggregationStartTime);
+	result.push_back(timeOfLastAggregation);
+	result.insert(result.end(), minimumValues.begin(), minimumValues.end());
+	result.insert(result.end(), maximumValues.begin(), maximumValues.end());
+	result.insert(result.end(), timeIntegrals.begin(), timeIntegrals.end());
+	result.insert(result.end(), timesOfMaximum.begin(), timesOfMaximum.end());
+	return result;
+}
+
+void OutputRegularRiverReachProperties::setAggregationState(const std::vector<double>& aggregationState)
+{
+	if( aggregationState.empty() )
+	{
+		aggregationStarted = false;
+		return;
+	}
+	int numberOfAggregatedColumns = minimumValues.size();
+	if( static_cast<int>(aggregationState.size()) != ( 2 + (4 * numberOfAggregatedColumns) ) )
+	{
+		const char *const errorMessage = "For OutputRegularRiverReachProperties the aggregation state needs to match the aggregated properties and reaches for output.";
+		throw(errorMessage);
+	}
+	std::vector<double>::const_iterator currentValue = aggregationState.begin();
+	aggregationStartTime = *currentValue;
+	++currentValue;
+	timeOfLastAggregation = *currentValue;
+	++currentValue;
+	minimumValues.assign(currentValue, currentValue + numberOfAggregatedColumns);
+	currentValue += numberOfAggregatedColumns;
+	maximumValues.assign(currentValue, currentValue + numberOfAggregatedColumns);
+	currentValue += numberOfAggregatedColumns;
+	timeIntegrals.assign(currentValue, currentValue + numberOfAggregatedColumns);
+	currentValue += numberOfAggregatedColumns;
+	timesOfMaximum.assign(currentValue, currentValue + numberOfAggregatedColumns);
+	aggregationStarted = true;
+}
+
+std::string OutputRegularRiverReachProperties::getPropertyLabelForOutput(int propertyIndex) const
+{
+	std::string result = CombinerVariables::typeOfRegularRiverReachPropertiesToString( regularRiverReachPropertiesForOutput.at(propertyIndex) );
+	if( aggregationsForOutput.at(propertyIndex) != CombinerVariables::InstantaneousValue )
+	{
+		result.append("_");
+		result.append( CombinerVariables::typeOfOutputAggregationToString( aggregationsForOutput.at(propertyIndex) ) );
+	}
 	return result;
 }
 
@@ -195,6 +284,13 @@ ConstructionVariables OutputRegularRiverReachProperties::createConstructionVaria
 	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator iterator = regularRiverReachPropertiesForOutput.begin(); iterator < regularRiverReachPropertiesForOutput.end(); ++iterator)
 			{ stringVector.push_back( CombinerVariables::typeOfRegularRiverReachPropertiesToString(*iterator) ); }
 	result.labelledStrings["regularRiverReachPropertiesForOutput"] = stringVector;
+	stringVector.clear();
+	for(std::vector<CombinerVariables::TypesOfOutputAggregation>::const_iterator iterator = aggregationsForOutput.begin(); iterator < aggregationsForOutput.end(); ++iterator)
+			{ stringVector.push_back( CombinerVariables::typeOfOutputAggregationToString(*iterator) ); }
+	result.labelledStrings["aggregationsForOutput"] = stringVector;
+	doubleVector = getAggregationState();
+	if( !(doubleVector.empty()) ) { result.labelledDoubles["aggregationState"] = doubleVector; }
+	addFlushPolicyToConstructionVariables(result);
 	return result;
 }
 
@@ -203,12 +299,15 @@ void OutputRegularRiverReachProperties::initialiseOutput(const std::vector<Outpu
 	int numberOfStrataLayers = (cellPointersForOutput.at(0))->strataPerUnitBedSurface.size();
 	std::ostringstream diameterStringStream;
 
-	oFileStream.open(outputFile, std::ios::out | std::ios::trunc);
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openAndTruncate(outputFile);
 	//Write header line
 	oFileStream << "ElapsedSeconds";
 	if(outputTimeStepLength) { oFileStream << "\t" << "CurrentTimeStepLength[sec]"; }
+	std::string propertyLabel;
 	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentPropertyType = regularRiverReachPropertiesForOutput.begin(); currentPropertyType < regularRiverReachPropertiesForOutput.end(); ++currentPropertyType)
 	{
+		propertyLabel = getPropertyLabelForOutput(currentPropertyType - regularRiverReachPropertiesForOutput.begin());
 		if (CombinerVariables::regularRiverReachPropertyIsGrains(*currentPropertyType))
 		{
 			if( *currentPropertyType == CombinerVariables::strataPerUnitBedSurface )
@@ -225,7 +324,7 @@ void OutputRegularRiverReachProperties::initialiseOutput(const std::vector<Outpu
 								diameterStringStream.clear();
 								diameterStringStream << *currentDiameter;
 								diameterStringStream.flush();
-								oFileStream << "\t" << CombinerVariables::typeOfRegularRiverReachPropertiesToString(*currentPropertyType) << "_" << *currentCellIDLabel << "_Layer" << currentStrataLayer << "_" << CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) << "_Fraction" << diameterStringStream.str() << "m";
+								oFileStream << "\t" << propertyLabel << "_" << *currentCellIDLabel << "_Layer" << currentStrataLayer << "_" << CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) << "_Fraction" << diameterStringStream.str() << "m";
 							}
 						}
 					}
@@ -243,7 +342,7 @@ void OutputRegularRiverReachProperties::initialiseOutput(const std::vector<Outpu
 							diameterStringStream.clear();
 							diameterStringStream << *currentDiameter;
 							diameterStringStream.flush();
-							oFileStream << "\t" << CombinerVariables::typeOfRegularRiverReachPropertiesToString(*currentPropertyType) << "_" << *currentCellIDLabel << "_" << CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) << "_Fraction" << diameterStringStream.str() << "m";
+							oFileStream << "\t" << propertyLabel << "_" << *currentCellIDLabel << "_" << CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) << "_Fraction" << diameterStringStream.str() << "m";
 						}
 					}
 				}
@@ -252,15 +351,29 @@ void OutputRegularRiverReachProperties::initialiseOutput(const std::vector<Outpu
 		else
 		{
 			for(std::vector<std::string>::const_iterator currentCellIDLabel = cellIDLabels.begin(); currentCellIDLabel < cellIDLabels.end(); ++currentCellIDLabel)
-			{ oFileStream << "\t" << CombinerVariables::typeOfRegularRiverReachPropertiesToString(*currentPropertyType) << "_" << *currentCellIDLabel; }
+			{ oFileStream << "\t" << propertyLabel << "_" << *currentCellIDLabel; }
 		}
 	}
 	oFileStream << "\n";
-	oFileStream.close();
+	oFileStream.flushNow();
 
+	updateAggregation();
 	if(outputInitialValues) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
 }
 
+void OutputRegularRiverReachProperties::continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openForAppending(outputFile);
+	// The aggregation state of the interrupted simulation has been restored from the checkpoint. Otherwise the aggregation starts now.
+	updateAggregation();
+}
+
+std::vector<std::string> OutputRegularRiverReachProperties::getAppendedOutputFiles() const
+{
+	return std::vector<std::string>(1,outputFileAsString);
+}
+
 void OutputRegularRiverReachProperties::update(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
 	if(useSecondaryOutputInterval)
@@ -274,108 +387,207 @@ void OutputRegularRiverReachProperties::update(const std::vector<OutputMethodTyp
 			this->outputInterval = primaryOutputInterval;
 		}
 	}
+	updateAggregation();
 }
 
 void OutputRegularRiverReachProperties::forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
-	oFileStream.open(outputFile, std::ios::out | std::ios::app);
-	oFileStream << overallParameters->getElapsedSeconds();
-	if(outputTimeStepLength) { oFileStream << "\t" << overallParameters->getCurrentTimeStepLengthInSeconds(); }
+	collectCurrentSnapshot();
+	if( !(aggregatedPropertyIndices.empty()) )
+	{
+		updateAggregation();
+		insertAggregatedValuesIntoCurrentSnapshotAndRestartAggregation();
+	}
+	if( asynchronousOutputWriter == NULL ) { writeSnapshot(currentSnapshot); }
+	else { asynchronousOutputWriter->enqueue(this, currentSnapshot); }
+}
+
+void OutputRegularRiverReachProperties::collectCurrentSnapshot()
+{
+	currentSnapshot.clear();
+	currentSnapshot.push_back( overallParameters->getElapsedSeconds() );
+	if(outputTimeStepLength) { currentSnapshot.push_back( overallParameters->getCurrentTimeStepLengthInSeconds() ); }
+	double poreVolumeFactor = 1.0 / (1.0 - overallParameters->getPoreVolumeFraction());
+	snapshotBeginsOfProperties.clear();
 	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentPropertyType = regularRiverReachPropertiesForOutput.begin(); currentPropertyType < regularRiverReachPropertiesForOutput.end(); ++currentPropertyType)
 	{
-		oFileStream << "\t";
-		if ( CombinerVariables::regularRiverReachPropertyIsGrains(*currentPropertyType) )
+		snapshotBeginsOfProperties.push_back( currentSnapshot.size() );
+		appendPropertyValues(currentSnapshot, *currentPropertyType, poreVolumeFactor);
+	}
+}
+
+void OutputRegularRiverReachProperties::appendPropertyValues(std::vector<double>& target, CombinerVariables::TypesOfRegularRiverReachProperties propertyType, double poreVolumeFactor)
+{
+	for(currentCellPointerIterator = cellPointersForOutput.begin(); currentCellPointerIterator < cellPointersForOutput.end(); ++currentCellPointerIterator)
+	{
+		switch(propertyType)
 		{
-			for(currentCellPointerIterator = cellPointersForOutput.begin(); currentCellPointerIterator < (cellPointersForOutput.end()-1); ++currentCellPointerIterator)
-			{
-				oFileStream << printGrainsProperty(*currentCellPointerIterator, *currentPropertyType) << "\t";
-			}
-			oFileStream << printGrainsProperty(cellPointersForOutput.back(), *currentPropertyType);
+		case CombinerVariables::strataPerUnitBedSurface:
+			for(currentGrainsIterator = (*currentCellPointerIterator)->strataPerUnitBedSurface.begin(); currentGrainsIterator < (*currentCellPointerIterator)->strataPerUnitBedSurface.end(); ++currentGrainsIterator)
+				{ appendGrainsValues(target, *currentGrainsIterator, 1.0); }
+			break;
+
+		case CombinerVariables::strataPerUnitBedSurfaceIncludingPoreVolume:
+			for(currentGrainsIterator = (*currentCellPointerIterator)->strataPerUnitBedSurface.begin(); currentGrainsIterator < (*currentCellPointerIterator)->strataPerUnitBedSurface.end(); ++currentGrainsIterator)
+				{ appendGrainsValues(target, *currentGrainsIterator, poreVolumeFactor); }
+			break;
+
+		default:
+			if ( CombinerVariables::regularRiverReachPropertyIsGrains(propertyType) )
+				{ appendGrainsValues( target, (*currentCellPointerIterator)->getGrainsProperty(propertyType), 1.0 ); }
+			else
+				{ target.push_back( (*currentCellPointerIterator)->getDoubleProperty(propertyType) ); }
+			break;
 		}
-		else
+	}
+}
+
+void OutputRegularRiverReachProperties::updateAggregation()
+{
+	if( aggregatedPropertyIndices.empty() ) { return; }
+
+	// The strata properties cannot be aggregated. Thus the pore volume factor is not needed.
+	currentAggregatedValues.clear();
+	for(std::vector<int>::const_iterator currentPropertyIndex = aggregatedPropertyIndices.begin(); currentPropertyIndex < aggregatedPropertyIndices.end(); ++currentPropertyIndex)
+		{ appendPropertyValues(currentAggregatedValues, regularRiverReachPropertiesForOutput[*currentPropertyIndex], 1.0); }
+
+	double elapsedSeconds = overallParameters->getElapsedSeconds();
+	std::vector<double>::iterator currentMinimum = minimumValues.begin();
+	std::vector<double>::iterator currentMaximum = maximumValues.begin();
+	std::vector<double>::iterator currentTimeIntegral = timeIntegrals.begin();
+	std::vector<double>::iterator currentTimeOfMaximum = timesOfMaximum.begin();
+	std::vector<double>::const_iterator currentValue;
+
+	if( !aggregationStarted )
+	{
+		for(currentValue = currentAggregatedValues.begin(); currentValue < currentAggregatedValues.end(); ++currentValue, ++currentMinimum, ++currentMaximum, ++currentTimeIntegral, ++currentTimeOfMaximum)
 		{
-			for(currentCellPointerIterator = cellPointersForOutput.begin(); currentCellPointerIterator < (cellPointersForOutput.end()-1); ++currentCellPointerIterator)
-			{
-				oFileStream << (*currentCellPointerIterator)->getDoubleProperty(*currentPropertyType) << "\t";
-			}
-			oFileStream << (cellPointersForOutput.back())->getDoubleProperty(*currentPropertyType);
+			*currentMinimum = *currentValue;
+			*currentMaximum = *currentValue;
+			*currentTimeIntegral = 0.0;
+			*currentTimeOfMaximum = elapsedSeconds;
 		}
+		aggregationStartTime = elapsedSeconds;
+		timeOfLastAggregation = elapsedSeconds;
+		aggregationStarted = true;
+		return;
 	}
-	oFileStream << "\n";
-	oFileStream.close();
+
+	double timeStepLength = elapsedSeconds - timeOfLastAggregation;
+	if( timeStepLength <= 0.0 ) { return; }
+	for(currentValue = currentAggregatedValues.begin(); currentValue < currentAggregatedValues.end(); ++currentValue, ++currentMinimum, ++currentMaximum, ++currentTimeIntegral, ++currentTimeOfMaximum)
+	{
+		if( *currentValue < *currentMinimum ) { *currentMinimum = *currentValue; }
+		if( *currentValue > *currentMaximum )
+		{
+			*currentMaximum = *currentValue;
+			*currentTimeOfMaximum = elapsedSeconds;
+		}
+		*currentTimeIntegral += *currentValue * timeStepLength;
+	}
+	timeOfLastAggregation = elapsedSeconds;
 }
 
-void OutputRegularRiverReachProperties::finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+void OutputRegularRiverReachProperties::insertAggregatedValuesIntoCurrentSnapshotAndRestartAggregation()
 {
-	if ( !(writeLineEachTimeStep) ) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
+	double elapsedSeconds = overallParameters->getElapsedSeconds();
+	double aggregationDuration = timeOfLastAggregation - aggregationStartTime;
+	std::vector<double>::iterator currentMinimum = minimumValues.begin();
+	std::vector<double>::iterator currentMaximum = maximumValues.begin();
+	std::vector<double>::iterator currentTimeIntegral = timeIntegrals.begin();
+	std::vector<double>::iterator currentTimeOfMaximum = timesOfMaximum.begin();
+	std::vector<double>::iterator currentValue;
+	std::vector<double>::iterator endOfProperty;
+	double instantaneousValue;
+
+	for(int i = 0; i < static_cast<int>(aggregatedPropertyIndices.size()); ++i)
+	{
+		CombinerVariables::TypesOfOutputAggregation currentAggregation = aggregationsForOutput[ aggregatedPropertyIndices[i] ];
+		currentValue = currentSnapshot.begin() + snapshotBeginsOfProperties[ aggregatedPropertyIndices[i] ];
+		endOfProperty = currentValue + numberOfColumnsOfAggregatedProperties[i];
+		for(; currentValue < endOfProperty; ++currentValue, ++currentMinimum, ++currentMaximum, ++currentTimeIntegral, ++currentTimeOfMaximum)
+		{
+			instantaneousValue = *currentValue;
+			switch(currentAggregation)
+			{
+			case CombinerVariables::IntervalMean:
+				if( aggregationDuration > 0.0 ) { *currentValue = *currentTimeIntegral / aggregationDuration; }
+				break;
+
+			case CombinerVariables::IntervalMinimum:
+				*currentValue = *currentMinimum;
+				break;
+
+			case CombinerVariables::IntervalMaximum:
+				*currentValue = *currentMaximum;
+				break;
+
+			case CombinerVariables::IntervalTimeIntegral:
+				*currentValue = *currentTimeIntegral;
+				break;
+
+			case CombinerVariables::IntervalTimeOfMaximum:
+				*currentValue = *currentTimeOfMaximum;
+				break;
+
+			default:
+				const char *const errorMessage = "Invalid Output Aggregation Type for OutputRegularRiverReachProperties";
+				throw (errorMessage);
+			}
+
+			// The next output interval starts with the current values.
+			*currentMinimum = instantaneousValue;
+			*currentMaximum = instantaneousValue;
+			*currentTimeIntegral = 0.0;
+			*currentTimeOfMaximum = elapsedSeconds;
+		}
+	}
+	aggregationStartTime = elapsedSeconds;
+	timeOfLastAggregation = elapsedSeconds;
 }
 
-void OutputRegularRiverReachProperties::appendGrainstoOStringStream(const Grains& toPrint)
+void OutputRegularRiverReachProperties::appendGrainsValues(std::vector<double>& target, const Grains& toAppend, double multiplicationFactor)
 {
-	for(currentTypeOfGrainsIterator = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrainsIterator < (typesOfGrainsOrderForOutput.end()-1); ++currentTypeOfGrainsIterator)
+	for(currentTypeOfGrainsIterator = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrainsIterator < typesOfGrainsOrderForOutput.end(); ++currentTypeOfGrainsIterator)
 	{
-		currentGrainTypePointer = toPrint.getSingleGrainTypeConstPointer(*currentTypeOfGrainsIterator);
+		currentGrainTypePointer = toAppend.getSingleGrainTypeConstPointer(*currentTypeOfGrainsIterator);
 		currentFractionalAbundances = currentGrainTypePointer->getFractions();
 		for(currentFractionIterator = currentFractionalAbundances.begin(); currentFractionIterator < currentFractionalAbundances.end(); ++currentFractionIterator)
-				{ oStringStream << *currentFractionIterator << "\t"; }
+			{ target.push_back( (*currentFractionIterator) * multiplicationFactor ); }
 	}
-	currentGrainTypePointer = toPrint.getSingleGrainTypeConstPointer(typesOfGrainsOrderForOutput.back());
-	currentFractionalAbundances = currentGrainTypePointer->getFractions();
-	for(currentFractionIterator = currentFractionalAbundances.begin(); currentFractionIterator < (currentFractionalAbundances.end()-1); ++currentFractionIterator)
-			{ oStringStream << *currentFractionIterator << "\t"; }
-	oStringStream << *currentFractionIterator;
-	oStringStream.flush();
 }
 
-std::string OutputRegularRiverReachProperties::printGrains(const Grains& toPrint)
+void OutputRegularRiverReachProperties::writeSnapshot(const std::vector<double>& snapshot)
 {
-	oStringStream.str("");
-	oStringStream.clear();
-	appendGrainstoOStringStream(toPrint);
-	oStringStream.flush();
-	return oStringStream.str();
+	std::vector<double>::const_iterator currentValue = snapshot.begin();
+	lineFormatter.clear();
+	lineFormatter.appendScientific(*currentValue);
+	for(++currentValue; currentValue < snapshot.end(); ++currentValue)
+	{
+		lineFormatter.append('\t');
+		lineFormatter.appendScientific(*currentValue);
+	}
+	lineFormatter.append('\n');
+	lineFormatter.writeLineTo(oFileStream);
+	oFileStream.lineCompleted();
 }
 
-std::string OutputRegularRiverReachProperties::printStrata(const std::vector<Grains>& toPrint)
+void OutputRegularRiverReachProperties::finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
-	oStringStream.str("");
-	oStringStream.clear();
-	for(currentGrainsIterator = toPrint.begin(); currentGrainsIterator < (toPrint.end()-1); ++currentGrainsIterator)
+	if ( !(writeLineEachTimeStep) ) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
+	if( asynchronousOutputWriter != NULL )
 	{
-		appendGrainstoOStringStream(*currentGrainsIterator);
-		oStringStream << "\t";
+		asynchronousOutputWriter->waitUntilDrained();
+		asynchronousOutputWriter->throwIfErrorOccurred();
 	}
-	appendGrainstoOStringStream(toPrint.back());
-	oStringStream.flush();
-	return oStringStream.str();
+	oFileStream.close();
 }
 
-std::string OutputRegularRiverReachProperties::printGrainsProperty(const RegularRiverReachProperties* cellPointer, CombinerVariables::TypesOfRegularRiverReachProperties typeOfProperty)
+void OutputRegularRiverReachProperties::flushOutput()
 {
-	std::string result;
-	double multiplicationFactor;
-	std::vector<Grains> strataForPrinting;
-	switch(typeOfProperty)
-	{
-	case CombinerVariables::strataPerUnitBedSurface:
-		result = printStrata(cellPointer->strataPerUnitBedSurface);
-		break;
-
-	case CombinerVariables::strataPerUnitBedSurfaceIncludingPoreVolume:
-		multiplicationFactor = 1.0 / (1.0 - overallParameters->getPoreVolumeFraction());
-		strataForPrinting = cellPointer->strataPerUnitBedSurface;
-		for(std::vector<Grains>::iterator currentStrataLayer = strataForPrinting.begin(); currentStrataLayer < strataForPrinting.end(); ++currentStrataLayer)
-		{
-			*currentStrataLayer *= multiplicationFactor;
-		}
-		result = printStrata(strataForPrinting);
-		break;
-
-	default:
-		result = printGrains(cellPointer->getGrainsProperty(typeOfProperty));
-		break;
-	}
-	return result;
+	if( asynchronousOutputWriter != NULL ) { asynchronousOutputWriter->waitUntilDrained(); }
+	oFileStream.flushNow();
 }
 
 }
+
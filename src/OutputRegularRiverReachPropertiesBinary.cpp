@@ -0,0 +1,206 @@
+/*
+ * OutputRegularRiverReachPropertiesBinary.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "OutputRegularRiverReachPropertiesBinary.h"
+
+#include "BinaryColumnarOutputFormat.h"
+#include "AsynchronousOutputWriter.h"
+
+namespace SedFlow {
+
+OutputRegularRiverReachPropertiesBinary::OutputRegularRiverReachPropertiesBinary(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, int numberOfRowsPerChunk, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods):
+		OutputRegularRiverReachProperties(regularRiverReachPropertiesForOutput, aggregationsForOutput, userCellIDsForOutput, outputTimeStepLength, outputInitialValues, printUpstreamMargins, printDownstreamMargin, path, outputFiles, writeLineEachTimeStep, outputInterval, explicitTimesForOutput, precisionForOutput, useSecondaryOutputInterval, referenceCellUserCellID, referenceProperty, thresholdToBeExceeded, secondaryOutputInterval, overallParameters, overallMethods, riverSystemProperties, riverSystemMethods),
+		numberOfRowsPerChunk(numberOfRowsPerChunk),
+		numberOfStrataLayers( (cellPointersForOutput.at(0))->strataPerUnitBedSurface.size() ),
+		numberOfRowsInCurrentChunk(0)
+{
+	this->typeOfOutputMethod = CombinerVariables::OutputRegularRiverReachPropertiesBinary;
+	if( this->numberOfRowsPerChunk < 1 )
+	{
+		const char *const errorMessage = "For OutputRegularRiverReachPropertiesBinary the numberOfRowsPerChunk needs to be at least one.";
+		throw(errorMessage);
+	}
+	createColumnNames();
+	chunkValues.assign( columnNames.size() * this->numberOfRowsPerChunk, 0.0 );
+}
+
+OutputMethodType* OutputRegularRiverReachPropertiesBinary::createOutputMethodTypePointerCopy() const
+{
+	OutputRegularRiverReachPropertiesBinary* result = new OutputRegularRiverReachPropertiesBinary(this->regularRiverReachPropertiesForOutput, this->aggregationsForOutput, this->userCellIDsForOutput, this->outputTimeStepLength, this->outputInitialValues, this->printUpstreamMargins, this->printDownstreamMargin, this->path, this->outputFiles, this->writeLineEachTimeStep, this->primaryOutputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->useSecondaryOutputInterval, this->referenceCellUserCellID, this->referenceProperty, this->thresholdToBeExceeded, this->secondaryOutputInterval, this->numberOfRowsPerChunk, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods);
+	result->setAggregationState(this->getAggregationState());
+	return result;
+}
+
+ConstructionVariables OutputRegularRiverReachPropertiesBinary::createConstructionVariables()const
+{
+	ConstructionVariables result = OutputRegularRiverReachProperties::createConstructionVariables();
+	result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputRegularRiverReachPropertiesBinary);
+	std::vector<int> intVector;
+	intVector.push_back(numberOfRowsPerChunk);
+	result.labelledInts["numberOfRowsPerChunk"] = intVector;
+	return result;
+}
+
+void OutputRegularRiverReachPropertiesBinary::createColumnNames()
+{
+	std::ostringstream diameterStringStream;
+	std::vector<std::string> fractionLabels;
+	for(std::vector<double>::const_iterator currentDiameter = fractionalGrainDiametersBegin; currentDiameter < fractionalGrainDiametersEnd; ++currentDiameter)
+	{
+		diameterStringStream.str("");
+		diameterStringStream.clear();
+		diameterStringStream << "_Fraction" << *currentDiameter << "m";
+		fractionLabels.push_back(diameterStringStream.str());
+	}
+
+	columnNames.clear();
+	columnNames.push_back("ElapsedSeconds");
+	if(outputTimeStepLength) { columnNames.push_back("CurrentTimeStepLength[sec]"); }
+	std::string prefix;
+	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentPropertyType = regularRiverReachPropertiesForOutput.begin(); currentPropertyType < regularRiverReachPropertiesForOutput.end(); ++currentPropertyType)
+	{
+		std::string propertyLabel = getPropertyLabelForOutput(currentPropertyType - regularRiverReachPropertiesForOutput.begin());
+		bool isStrata = ( *currentPropertyType == CombinerVariables::strataPerUnitBedSurface || *currentPropertyType == CombinerVariables::strataPerUnitBedSurfaceIncludingPoreVolume );
+		for(std::vector<std::string>::const_iterator currentCellIDLabel = cellIDLabels.begin(); currentCellIDLabel < cellIDLabels.end(); ++currentCellIDLabel)
+		{
+			prefix = propertyLabel;
+			prefix.append("_");
+			prefix.append(*currentCellIDLabel);
+			if( !(CombinerVariables::regularRiverReachPropertyIsGrains(*currentPropertyType)) ) { columnNames.push_back(prefix); continue; }
+
+			int numberOfLayers = isStrata ? numberOfStrataLayers : 1;
+			for(int currentStrataLayer = 0; currentStrataLayer < numberOfLayers; ++currentStrataLayer)
+			{
+				std::ostringstream layerStringStream;
+				if(isStrata) { layerStringStream << "_Layer" << currentStrataLayer; }
+				for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrains < typesOfGrainsOrderForOutput.end() ; ++currentTypeOfGrains)
+				{
+					for(std::vector<std::string>::const_iterator currentFractionLabel = fractionLabels.begin(); currentFractionLabel < fractionLabels.end(); ++currentFractionLabel)
+						{ columnNames.push_back( prefix + layerStringStream.str() + "_" + CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) + *currentFractionLabel ); }
+				}
+			}
+		}
+	}
+}
+
+void OutputRegularRiverReachPropertiesBinary::initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	std::vector<std::string> propertyNames;
+	for(int propertyIndex = 0; propertyIndex < static_cast<int>(regularRiverReachPropertiesForOutput.size()); ++propertyIndex)
+		{ propertyNames.push_back( getPropertyLabelForOutput(propertyIndex) ); }
+	std::vector<std::string> grainTypeNames;
+	for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrains < typesOfGrainsOrderForOutput.end() ; ++currentTypeOfGrains)
+		{ grainTypeNames.push_back( CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) ); }
+
+	byteBuffer.clear();
+	byteBuffer.insert(byteBuffer.end(), BinaryColumnarOutputFormat::magicNumber, BinaryColumnarOutputFormat::magicNumber + 8);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, BinaryColumnarOutputFormat::formatVersion);
+	BinaryColumnarOutputFormat::appendInt(byteBuffer, precisionForOutput);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, numberOfRowsPerChunk);
+	BinaryColumnarOutputFormat::appendStrings(byteBuffer, propertyNames);
+	BinaryColumnarOutputFormat::appendStrings(byteBuffer, cellIDLabels);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, userCellIDsForOutput.size());
+	for(std::vector<int>::const_iterator currentUserCellID = userCellIDsForOutput.begin(); currentUserCellID < userCellIDsForOutput.end(); ++currentUserCellID)
+		{ BinaryColumnarOutputFormat::appendInt(byteBuffer, *currentUserCellID); }
+	BinaryColumnarOutputFormat::appendStrings(byteBuffer, grainTypeNames);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, fractionalGrainDiameters.size());
+	for(std::vector<double>::const_iterator currentDiameter = fractionalGrainDiametersBegin; currentDiameter < fractionalGrainDiametersEnd; ++currentDiameter)
+		{ BinaryColumnarOutputFormat::appendDouble(byteBuffer, *currentDiameter); }
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, numberOfStrataLayers);
+	BinaryColumnarOutputFormat::appendStrings(byteBuffer, columnNames);
+
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openAndTruncate(outputFile, true);
+	oFileStream.write(&(byteBuffer[0]), byteBuffer.size());
+	oFileStream.flushNow();
+	numberOfRowsInCurrentChunk = 0;
+
+	updateAggregation();
+	if(outputInitialValues) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
+}
+
+void OutputRegularRiverReachPropertiesBinary::continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	// The header has been written by the interrupted simulation. Thus only further chunks are appended.
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openForAppending(outputFile, true);
+	numberOfRowsInCurrentChunk = 0;
+	updateAggregation();
+}
+
+void OutputRegularRiverReachPropertiesBinary::writeSnapshot(const std::vector<double>& snapshot)
+{
+	if( snapshot.size() != columnNames.size() )
+	{
+		const char *const errorMessage = "OutputRegularRiverReachPropertiesBinary needs the same number of strata layers in all reaches and time steps.";
+		throw(errorMessage);
+	}
+	int numberOfColumns = snapshot.size();
+	for(int column = 0; column < numberOfColumns; ++column)
+		{ chunkValues[ (column * numberOfRowsPerChunk) + numberOfRowsInCurrentChunk ] = snapshot[column]; }
+
+	++numberOfRowsInCurrentChunk;
+	if( numberOfRowsInCurrentChunk == numberOfRowsPerChunk ) { writeCurrentChunk(); }
+}
+
+void OutputRegularRiverReachPropertiesBinary::writeCurrentChunk()
+{
+	if( numberOfRowsInCurrentChunk == 0 ) { return; }
+	byteBuffer.clear();
+	byteBuffer.reserve( 8 + (chunkValues.size() * 8) );
+	byteBuffer.insert(byteBuffer.end(), BinaryColumnarOutputFormat::chunkMarker, BinaryColumnarOutputFormat::chunkMarker + 4);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, numberOfRowsInCurrentChunk);
+	for(int column = 0; column < static_cast<int>(columnNames.size()); ++column)
+	{
+		std::vector<double>::const_iterator columnBegin = chunkValues.begin() + (column * numberOfRowsPerChunk);
+		for(std::vector<double>::const_iterator currentValue = columnBegin; currentValue < (columnBegin + numberOfRowsInCurrentChunk); ++currentValue)
+			{ BinaryColumnarOutputFormat::appendDouble(byteBuffer, *currentValue); }
+	}
+	oFileStream.write(&(byteBuffer[0]), byteBuffer.size());
+	numberOfRowsInCurrentChunk = 0;
+	oFileStream.lineCompleted();
+}
+
+void OutputRegularRiverReachPropertiesBinary::finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	if ( !(writeLineEachTimeStep) ) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
+	if( asynchronousOutputWriter != NULL )
+	{
+		asynchronousOutputWriter->waitUntilDrained();
+		asynchronousOutputWriter->throwIfErrorOccurred();
+	}
+	writeCurrentChunk();
+	oFileStream.close();
+}
+
+void OutputRegularRiverReachPropertiesBinary::flushOutput()
+{
+	if( asynchronousOutputWriter != NULL ) { asynchronousOutputWriter->waitUntilDrained(); }
+	// Incomplete chunks are written as shorter chunks, so that nothing is lost on error exits.
+	if( oFileStream.is_open() ) { writeCurrentChunk(); }
+	oFileStream.flushNow();
+}
+
+}
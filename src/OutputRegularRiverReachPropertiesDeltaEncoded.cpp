@@ -0,0 +1,274 @@
+/*
+ * OutputRegularRiverReachPropertiesDeltaEncoded.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "OutputRegularRiverReachPropertiesDeltaEncoded.h"
+
+#include <cmath>
+
+#include "BinaryColumnarOutputFormat.h"
+#include "DeltaEncodedOutputReader.h"
+#include "AsynchronousOutputWriter.h"
+
+namespace SedFlow {
+
+OutputRegularRiverReachPropertiesDeltaEncoded::OutputRegularRiverReachPropertiesDeltaEncoded(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, double changeTolerance, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods):
+		OutputRegularRiverReachProperties(regularRiverReachPropertiesForOutput, aggregationsForOutput, userCellIDsForOutput, outputTimeStepLength, outputInitialValues, printUpstreamMargins, printDownstreamMargin, path, outputFiles, writeLineEachTimeStep, outputInterval, explicitTimesForOutput, precisionForOutput, useSecondaryOutputInterval, referenceCellUserCellID, referenceProperty, thresholdToBeExceeded, secondaryOutputInterval, overallParameters, overallMethods, riverSystemProperties, riverSystemMethods),
+		changeTolerance(changeTolerance),
+		numberOfValuesPerGrains( typesOfGrainsOrderForOutput.size() * fractionalGrainDiameters.size() )
+{
+	this->typeOfOutputMethod = CombinerVariables::OutputRegularRiverReachPropertiesDeltaEncoded;
+	if( this->changeTolerance < 0.0 )
+	{
+		const char *const errorMessage = "For OutputRegularRiverReachPropertiesDeltaEncoded the changeTolerance must not be negative.";
+		throw(errorMessage);
+	}
+	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentPropertyType = this->regularRiverReachPropertiesForOutput.begin(); currentPropertyType < this->regularRiverReachPropertiesForOutput.end(); ++currentPropertyType)
+	{
+		if( *currentPropertyType == CombinerVariables::strataPerUnitBedSurface || *currentPropertyType == CombinerVariables::strataPerUnitBedSurfaceIncludingPoreVolume ) { kindsOfProperties.push_back(DeltaEncodedOutputFormat::Strata); }
+		else if( CombinerVariables::regularRiverReachPropertyIsGrains(*currentPropertyType) ) { kindsOfProperties.push_back(DeltaEncodedOutputFormat::SingleGrains); }
+		else { kindsOfProperties.push_back(DeltaEncodedOutputFormat::SingleValue); }
+	}
+	writtenItems.resize( kindsOfProperties.size() * cellPointersForOutput.size() );
+}
+
+OutputMethodType* OutputRegularRiverReachPropertiesDeltaEncoded::createOutputMethodTypePointerCopy() const
+{
+	OutputRegularRiverReachPropertiesDeltaEncoded* result = new OutputRegularRiverReachPropertiesDeltaEncoded(this->regularRiverReachPropertiesForOutput, this->aggregationsForOutput, this->userCellIDsForOutput, this->outputTimeStepLength, this->outputInitialValues, this->printUpstreamMargins, this->printDownstreamMargin, this->path, this->outputFiles, this->writeLineEachTimeStep, this->primaryOutputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->useSecondaryOutputInterval, this->referenceCellUserCellID, this->referenceProperty, this->thresholdToBeExceeded, this->secondaryOutputInterval, this->changeTolerance, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods);
+	result->setAggregationState(this->getAggregationState());
+	result->writtenItems = this->writtenItems;
+	return result;
+}
+
+ConstructionVariables OutputRegularRiverReachPropertiesDeltaEncoded::createConstructionVariables()const
+{
+	ConstructionVariables result = OutputRegularRiverReachProperties::createConstructionVariables();
+	result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputRegularRiverReachPropertiesDeltaEncoded);
+	std::vector<double> doubleVector;
+	doubleVector.push_back(changeTolerance);
+	result.labelledDoubles["changeTolerance"] = doubleVector;
+	return result;
+}
+
+void OutputRegularRiverReachPropertiesDeltaEncoded::initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	std::vector<std::string> propertyNames;
+	for(int propertyIndex = 0; propertyIndex < static_cast<int>(regularRiverReachPropertiesForOutput.size()); ++propertyIndex)
+		{ propertyNames.push_back( getPropertyLabelForOutput(propertyIndex) ); }
+	std::vector<std::string> grainTypeNames;
+	for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrains < typesOfGrainsOrderForOutput.end() ; ++currentTypeOfGrains)
+		{ grainTypeNames.push_back( CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) ); }
+
+	byteBuffer.clear();
+	byteBuffer.insert(byteBuffer.end(), DeltaEncodedOutputFormat::magicNumber, DeltaEncodedOutputFormat::magicNumber + 8);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, DeltaEncodedOutputFormat::formatVersion);
+	BinaryColumnarOutputFormat::appendInt(byteBuffer, precisionForOutput);
+	BinaryColumnarOutputFormat::appendDouble(byteBuffer, changeTolerance);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, (outputTimeStepLength ? 1 : 0));
+	BinaryColumnarOutputFormat::appendStrings(byteBuffer, propertyNames);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, kindsOfProperties.size());
+	for(std::vector<DeltaEncodedOutputFormat::KindsOfProperty>::const_iterator currentKind = kindsOfProperties.begin(); currentKind < kindsOfProperties.end(); ++currentKind)
+		{ BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, *currentKind); }
+	BinaryColumnarOutputFormat::appendStrings(byteBuffer, cellIDLabels);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, userCellIDsForOutput.size());
+	for(std::vector<int>::const_iterator currentUserCellID = userCellIDsForOutput.begin(); currentUserCellID < userCellIDsForOutput.end(); ++currentUserCellID)
+		{ BinaryColumnarOutputFormat::appendInt(byteBuffer, *currentUserCellID); }
+	BinaryColumnarOutputFormat::appendStrings(byteBuffer, grainTypeNames);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, fractionalGrainDiameters.size());
+	for(std::vector<double>::const_iterator currentDiameter = fractionalGrainDiametersBegin; currentDiameter < fractionalGrainDiametersEnd; ++currentDiameter)
+		{ BinaryColumnarOutputFormat::appendDouble(byteBuffer, *currentDiameter); }
+
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openAndTruncate(outputFile, true);
+	oFileStream.write(&(byteBuffer[0]), byteBuffer.size());
+	oFileStream.flushNow();
+	writtenItems.assign( kindsOfProperties.size() * cellPointersForOutput.size(), DeltaEncodedOutputFormat::Item() );
+
+	updateAggregation();
+	if(outputInitialValues) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
+}
+
+void OutputRegularRiverReachPropertiesDeltaEncoded::continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	// The file has been truncated to the records of the checkpoint. Replaying them restores the layers written so far, which the next records refer to.
+	{
+	DeltaEncodedOutputReader reader (outputFileAsString);
+	while( reader.readNextRecord() ) {}
+	if( reader.getItems().size() != writtenItems.size() )
+	{
+		const char *const errorMessage = "The delta encoded output file of an interrupted simulation does not match the OutputRegularRiverReachPropertiesDeltaEncoded.";
+		throw(errorMessage);
+	}
+	writtenItems = reader.getItems();
+	}
+
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openForAppending(outputFile, true);
+	updateAggregation();
+}
+
+void OutputRegularRiverReachPropertiesDeltaEncoded::forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	collectCurrentSnapshot();
+	if( !(aggregatedPropertyIndices.empty()) )
+	{
+		updateAggregation();
+		insertAggregatedValuesIntoCurrentSnapshotAndRestartAggregation();
+	}
+	// The numbers of strata layers are appended to the snapshot, so that writeSnapshot can split the values into layers.
+	for(int propertyIndex = 0; propertyIndex < static_cast<int>(kindsOfProperties.size()); ++propertyIndex)
+	{
+		if( kindsOfProperties[propertyIndex] != DeltaEncodedOutputFormat::Strata ) { continue; }
+		for(currentCellPointerIterator = cellPointersForOutput.begin(); currentCellPointerIterator < cellPointersForOutput.end(); ++currentCellPointerIterator)
+			{ currentSnapshot.push_back( (*currentCellPointerIterator)->strataPerUnitBedSurface.size() ); }
+	}
+	if( asynchronousOutputWriter == NULL ) { writeSnapshot(currentSnapshot); }
+	else { asynchronousOutputWriter->enqueue(this, currentSnapshot); }
+}
+
+bool OutputRegularRiverReachPropertiesDeltaEncoded::layerMatches(const std::vector<double>& writtenLayer, const double* newLayer, int numberOfValuesPerLayer) const
+{
+	if( static_cast<int>(writtenLayer.size()) != numberOfValuesPerLayer ) { return false; }
+	for(int i = 0; i < numberOfValuesPerLayer; ++i)
+	{
+		// Written this way NaN values never match.
+		if( !( std::fabs(newLayer[i] - writtenLayer[i]) <= changeTolerance ) ) { return false; }
+	}
+	return true;
+}
+
+int OutputRegularRiverReachPropertiesDeltaEncoded::countMatchingLayers(const DeltaEncodedOutputFormat::Item& item, int shift, int numberOfValuesPerLayer) const
+{
+	int numberOfLayers = item.layers.size();
+	int result = 0;
+	for(int layer = 0; layer < numberOfLayers; ++layer)
+	{
+		int formerLayer = layer - shift;
+		if( formerLayer < 0 || formerLayer >= numberOfLayers ) { formerLayer = layer; }
+		if( layerMatches(item.layers[formerLayer], beginsOfNewLayers[layer], numberOfValuesPerLayer) ) { ++result; }
+	}
+	return result;
+}
+
+void OutputRegularRiverReachPropertiesDeltaEncoded::writeSnapshot(const std::vector<double>& snapshot)
+{
+	int numberOfCells = cellPointersForOutput.size();
+	int numberOfLayerCounts = 0;
+	for(std::vector<DeltaEncodedOutputFormat::KindsOfProperty>::const_iterator currentKind = kindsOfProperties.begin(); currentKind < kindsOfProperties.end(); ++currentKind)
+		{ if( *currentKind == DeltaEncodedOutputFormat::Strata ) { numberOfLayerCounts += numberOfCells; } }
+	const double* currentValue = &(snapshot[0]) + (outputTimeStepLength ? 2 : 1);
+	const double* currentLayerCount = &(snapshot[0]) + (snapshot.size() - numberOfLayerCounts);
+
+	layerCountChangesBuffer.clear();
+	shiftsBuffer.clear();
+	changedLayersBuffer.clear();
+	unsigned int numberOfLayerCountChanges = 0;
+	unsigned int numberOfShifts = 0;
+	unsigned int numberOfChangedLayers = 0;
+
+	for(int propertyIndex = 0; propertyIndex < static_cast<int>(kindsOfProperties.size()); ++propertyIndex)
+	{
+		DeltaEncodedOutputFormat::KindsOfProperty currentKind = kindsOfProperties[propertyIndex];
+		int numberOfValuesPerLayer = ( currentKind == DeltaEncodedOutputFormat::SingleValue ) ? 1 : numberOfValuesPerGrains;
+		for(int cellIndex = 0; cellIndex < numberOfCells; ++cellIndex)
+		{
+			unsigned int itemIndex = (propertyIndex * numberOfCells) + cellIndex;
+			DeltaEncodedOutputFormat::Item& item = writtenItems[itemIndex];
+			int numberOfLayers = 1;
+			if( currentKind == DeltaEncodedOutputFormat::Strata )
+			{
+				numberOfLayers = static_cast<int>(*currentLayerCount);
+				++currentLayerCount;
+			}
+			beginsOfNewLayers.resize(numberOfLayers);
+			for(int layer = 0; layer < numberOfLayers; ++layer, currentValue += numberOfValuesPerLayer) { beginsOfNewLayers[layer] = currentValue; }
+
+			if( static_cast<int>(item.layers.size()) != numberOfLayers )
+			{
+				DeltaEncodedOutputFormat::resizeLayers(item, numberOfLayers);
+				BinaryColumnarOutputFormat::appendUnsignedInt(layerCountChangesBuffer, itemIndex);
+				BinaryColumnarOutputFormat::appendUnsignedInt(layerCountChangesBuffer, numberOfLayers);
+				++numberOfLayerCountChanges;
+			}
+
+			// The stratigraphy update moves all strata below the active layer by one layer on deposition and erosion.
+			if( currentKind == DeltaEncodedOutputFormat::Strata && numberOfLayers > 2 )
+			{
+				int bestShift = 0;
+				int maximumNumberOfMatchingLayers = countMatchingLayers(item, 0, numberOfValuesPerLayer);
+				if( maximumNumberOfMatchingLayers < numberOfLayers )
+				{
+					for(int shift = -1; shift <= 1; shift += 2)
+					{
+						int numberOfMatchingLayers = countMatchingLayers(item, shift, numberOfValuesPerLayer);
+						if( numberOfMatchingLayers > maximumNumberOfMatchingLayers )
+						{
+							maximumNumberOfMatchingLayers = numberOfMatchingLayers;
+							bestShift = shift;
+						}
+					}
+				}
+				if( bestShift != 0 )
+				{
+					DeltaEncodedOutputFormat::shiftLayers(item, bestShift);
+					BinaryColumnarOutputFormat::appendUnsignedInt(shiftsBuffer, itemIndex);
+					BinaryColumnarOutputFormat::appendInt(shiftsBuffer, bestShift);
+					++numberOfShifts;
+				}
+			}
+
+			for(int layer = 0; layer < numberOfLayers; ++layer)
+			{
+				if( layerMatches(item.layers[layer], beginsOfNewLayers[layer], numberOfValuesPerLayer) ) { continue; }
+				item.layers[layer].assign(beginsOfNewLayers[layer], beginsOfNewLayers[layer] + numberOfValuesPerLayer);
+				++(item.versions[layer]);
+				BinaryColumnarOutputFormat::appendUnsignedInt(changedLayersBuffer, itemIndex);
+				BinaryColumnarOutputFormat::appendUnsignedInt(changedLayersBuffer, layer);
+				BinaryColumnarOutputFormat::appendUnsignedInt(changedLayersBuffer, item.versions[layer]);
+				for(int i = 0; i < numberOfValuesPerLayer; ++i) { BinaryColumnarOutputFormat::appendDouble(changedLayersBuffer, beginsOfNewLayers[layer][i]); }
+				++numberOfChangedLayers;
+			}
+		}
+	}
+	if( currentValue != ( &(snapshot[0]) + (snapshot.size() - numberOfLayerCounts) ) )
+	{
+		const char *const errorMessage = "Internal error: The snapshot does not match the layers of OutputRegularRiverReachPropertiesDeltaEncoded.";
+		throw(errorMessage);
+	}
+
+	byteBuffer.clear();
+	byteBuffer.insert(byteBuffer.end(), DeltaEncodedOutputFormat::recordMarker, DeltaEncodedOutputFormat::recordMarker + 4);
+	BinaryColumnarOutputFormat::appendDouble(byteBuffer, snapshot[0]);
+	if(outputTimeStepLength) { BinaryColumnarOutputFormat::appendDouble(byteBuffer, snapshot[1]); }
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, numberOfLayerCountChanges);
+	byteBuffer.insert(byteBuffer.end(), layerCountChangesBuffer.begin(), layerCountChangesBuffer.end());
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, numberOfShifts);
+	byteBuffer.insert(byteBuffer.end(), shiftsBuffer.begin(), shiftsBuffer.end());
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, numberOfChangedLayers);
+	byteBuffer.insert(byteBuffer.end(), changedLayersBuffer.begin(), changedLayersBuffer.end());
+	oFileStream.write(&(byteBuffer[0]), byteBuffer.size());
+	oFileStream.lineCompleted();
+}
+
+}
@@ -65,6 +65,7 @@ OutputRegularRiverReachPropertiesForVisualInterpretation::OutputRegularRiverReac
 	oFileStream << std::scientific;
 	oStringStream.precision(precisionForOutput);
 	oStringStream << std::scientific;
+	lineFormatter.setPrecision(precisionForOutput);
 
 	if(this->printUpstreamMargins)
 	{
@@ -199,6 +200,7 @@ ConstructionVariables OutputRegularRiverReachPropertiesForVisualInterpretation::
 	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator iterator = regularRiverReachPropertiesForOutput.begin(); iterator < regularRiverReachPropertiesForOutput.end(); ++iterator)
 			{ stringVector.push_back( CombinerVariables::typeOfRegularRiverReachPropertiesToString(*iterator) ); }
 	result.labelledStrings["regularRiverReachPropertiesForOutput"] = stringVector;
+	addFlushPolicyToConstructionVariables(result);
 	return result;
 }
 
@@ -230,7 +232,8 @@ void OutputRegularRiverReachPropertiesForVisualInterpretation::initialiseOutput(
 	int numberOfTabDelimitedCellsInStrataProperty = ( numberOfCells * numberOfTabDelimitedCellsInStrata ) + numberOfCells - 1;
 	int tmpNumberOfTabDelimitedCells;
 
-	oFileStream.open(outputFile, std::ios::out | std::ios::trunc);
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openAndTruncate(outputFile);
 	//Write first header line i.e. properties
 	oFileStream << "Reach Property";
 	if(outputTimeStepLength) { oFileStream << "\t\t"; }
@@ -617,10 +620,21 @@ void OutputRegularRiverReachPropertiesForVisualInterpretation::initialiseOutput(
 	oFileStream << "\t||\t";
 	for(int i = 0; i < horizontalBarLength; ++i) { oFileStream << "="; }
 	oFileStream << "\n";
-	oFileStream.close();
+	oFileStream.flushNow();
 	if(outputInitialValues) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
 }
 
+void OutputRegularRiverReachPropertiesForVisualInterpretation::continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openForAppending(outputFile);
+}
+
+std::vector<std::string> OutputRegularRiverReachPropertiesForVisualInterpretation::getAppendedOutputFiles() const
+{
+	return std::vector<std::string>(1,outputFileAsString);
+}
+
 void OutputRegularRiverReachPropertiesForVisualInterpretation::update(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
 	if(useSecondaryOutputInterval)
@@ -638,109 +652,102 @@ void OutputRegularRiverReachPropertiesForVisualInterpretation::update(const std:
 
 void OutputRegularRiverReachPropertiesForVisualInterpretation::forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
-	oFileStream.open(outputFile, std::ios::out | std::ios::app);
-	oFileStream << overallParameters->getElapsedSeconds();
-	if(outputTimeStepLength) { oFileStream << "\t|\t" << overallParameters->getCurrentTimeStepLengthInSeconds(); }
+	lineFormatter.clear();
+	lineFormatter.appendScientific( overallParameters->getElapsedSeconds() );
+	if(outputTimeStepLength)
+	{
+		lineFormatter.append("\t|\t");
+		lineFormatter.appendScientific( overallParameters->getCurrentTimeStepLengthInSeconds() );
+	}
 	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentPropertyType = regularRiverReachPropertiesForOutput.begin(); currentPropertyType < regularRiverReachPropertiesForOutput.end(); ++currentPropertyType)
 	{
-		oFileStream << "\t||\t";
+		lineFormatter.append("\t||\t");
 		if ( CombinerVariables::regularRiverReachPropertyIsGrains(*currentPropertyType) )
 		{
 			for(currentCellPointerIterator = cellPointersForOutput.begin(); currentCellPointerIterator < (cellPointersForOutput.end()-1); ++currentCellPointerIterator)
 			{
-				oFileStream << printGrainsProperty(*currentCellPointerIterator, *currentPropertyType) << "\t|\t";
+				appendGrainsPropertyToLine(*currentCellPointerIterator, *currentPropertyType);
+				lineFormatter.append("\t|\t");
 			}
-			oFileStream << printGrainsProperty(cellPointersForOutput.back(), *currentPropertyType);
+			appendGrainsPropertyToLine(cellPointersForOutput.back(), *currentPropertyType);
 		}
 		else
 		{
 			for(currentCellPointerIterator = cellPointersForOutput.begin(); currentCellPointerIterator < (cellPointersForOutput.end()-1); ++currentCellPointerIterator)
 			{
-				oFileStream << (*currentCellPointerIterator)->getDoubleProperty(*currentPropertyType) << "\t|\t";
+				lineFormatter.appendScientific( (*currentCellPointerIterator)->getDoubleProperty(*currentPropertyType) );
+				lineFormatter.append("\t|\t");
 			}
-			oFileStream << (cellPointersForOutput.back())->getDoubleProperty(*currentPropertyType);
+			lineFormatter.appendScientific( (cellPointersForOutput.back())->getDoubleProperty(*currentPropertyType) );
 		}
 	}
-	oFileStream << "\t||\n";
-	oFileStream.close();
+	lineFormatter.append("\t||\n");
+	lineFormatter.writeLineTo(oFileStream);
+	oFileStream.lineCompleted();
 }
 
 void OutputRegularRiverReachPropertiesForVisualInterpretation::finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
 {
 	if ( !(writeLineEachTimeStep) ) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
-	oFileStream.open(outputFile, std::ios::out | std::ios::app);
 	for(int i = 0; i < horizontalBarLength; ++i) { oFileStream << "="; }
 	oFileStream << "\n";
 	oFileStream.close();
 }
 
-void OutputRegularRiverReachPropertiesForVisualInterpretation::appendGrainstoOStringStream(const Grains& toPrint)
+void OutputRegularRiverReachPropertiesForVisualInterpretation::flushOutput()
+{
+	oFileStream.flushNow();
+}
+
+void OutputRegularRiverReachPropertiesForVisualInterpretation::appendGrainsToLine(const Grains& toPrint, double multiplicationFactor)
 {
 	for(currentTypeOfGrainsIterator = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrainsIterator < (typesOfGrainsOrderForOutput.end()-1); ++currentTypeOfGrainsIterator)
 	{
 		currentGrainTypePointer = toPrint.getSingleGrainTypeConstPointer(*currentTypeOfGrainsIterator);
 		currentFractionalAbundances = currentGrainTypePointer->getFractions();
 		for(currentFractionIterator = currentFractionalAbundances.begin(); currentFractionIterator < currentFractionalAbundances.end(); ++currentFractionIterator)
-				{ oStringStream << *currentFractionIterator << "\t"; }
-		oStringStream << "*\t";
+		{
+			lineFormatter.appendScientific( (*currentFractionIterator) * multiplicationFactor );
+			lineFormatter.append('\t');
+		}
+		lineFormatter.append("*\t");
 	}
 	currentGrainTypePointer = toPrint.getSingleGrainTypeConstPointer(typesOfGrainsOrderForOutput.back());
 	currentFractionalAbundances = currentGrainTypePointer->getFractions();
 	for(currentFractionIterator = currentFractionalAbundances.begin(); currentFractionIterator < (currentFractionalAbundances.end()-1); ++currentFractionIterator)
-			{ oStringStream << *currentFractionIterator << "\t"; }
-	oStringStream << *currentFractionIterator;
-	oStringStream.flush();
-}
-
-std::string OutputRegularRiverReachPropertiesForVisualInterpretation::printGrains(const Grains& toPrint)
-{
-	oStringStream.str("");
-	oStringStream.clear();
-	appendGrainstoOStringStream(toPrint);
-	oStringStream.flush();
-	return oStringStream.str();
+	{
+		lineFormatter.appendScientific( (*currentFractionIterator) * multiplicationFactor );
+		lineFormatter.append('\t');
+	}
+	lineFormatter.appendScientific( (*currentFractionIterator) * multiplicationFactor );
 }
 
-std::string OutputRegularRiverReachPropertiesForVisualInterpretation::printStrata(const std::vector<Grains>& toPrint)
+void OutputRegularRiverReachPropertiesForVisualInterpretation::appendStrataToLine(const std::vector<Grains>& toPrint, double multiplicationFactor)
 {
-	oStringStream.str("");
-	oStringStream.clear();
 	for(currentGrainsIterator = toPrint.begin(); currentGrainsIterator < (toPrint.end()-1); ++currentGrainsIterator)
 	{
-		appendGrainstoOStringStream(*currentGrainsIterator);
-		oStringStream << "\t:\t";
+		appendGrainsToLine(*currentGrainsIterator, multiplicationFactor);
+		lineFormatter.append("\t:\t");
 	}
-	appendGrainstoOStringStream(toPrint.back());
-	oStringStream.flush();
-	return oStringStream.str();
+	appendGrainsToLine(toPrint.back(), multiplicationFactor);
 }
 
-std::string OutputRegularRiverReachPropertiesForVisualInterpretation::printGrainsProperty(const RegularRiverReachProperties* cellPointer, CombinerVariables::TypesOfRegularRiverReachProperties typeOfProperty)
+void OutputRegularRiverReachPropertiesForVisualInterpretation::appendGrainsPropertyToLine(const RegularRiverReachProperties* cellPointer, CombinerVariables::TypesOfRegularRiverReachProperties typeOfProperty)
 {
-	std::string result;
-	double multiplicationFactor;
-	std::vector<Grains> strataForPrinting;
 	switch(typeOfProperty)
 	{
 	case CombinerVariables::strataPerUnitBedSurface:
-		result = printStrata(cellPointer->strataPerUnitBedSurface);
+		appendStrataToLine(cellPointer->strataPerUnitBedSurface, 1.0);
 		break;
 
 	case CombinerVariables::strataPerUnitBedSurfaceIncludingPoreVolume:
-		multiplicationFactor = 1.0 / (1.0 - overallParameters->getPoreVolumeFraction());
-		strataForPrinting = cellPointer->strataPerUnitBedSurface;
-		for(std::vector<Grains>::iterator currentStrataLayer = strataForPrinting.begin(); currentStrataLayer < strataForPrinting.end(); ++currentStrataLayer)
-		{
-			*currentStrataLayer *= multiplicationFactor;
-		}
-		result = printStrata(strataForPrinting);
+		appendStrataToLine(cellPointer->strataPerUnitBedSurface, ( 1.0 / (1.0 - overallParameters->getPoreVolumeFraction()) ));
 		break;
 
 	default:
-		result = printGrains(cellPointer->getGrainsProperty(typeOfProperty));
+		appendGrainsToLine(cellPointer->getGrainsProperty(typeOfProperty), 1.0);
 		break;
 	}
-	return result;
 }
 
 }
@@ -0,0 +1,302 @@
+/*
+ * OutputRegularRiverReachPropertiesNetCDF.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "OutputRegularRiverReachPropertiesNetCDF.h"
+
+#include "AsynchronousOutputWriter.h"
+
+namespace SedFlow {
+
+OutputRegularRiverReachPropertiesNetCDF::OutputRegularRiverReachPropertiesNetCDF(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput, std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput, std::vector<int> userCellIDsForOutput, bool outputTimeStepLength, bool outputInitialValues, bool printUpstreamMargins, bool printDownstreamMargin, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, bool useSecondaryOutputInterval, int referenceCellUserCellID, CombinerVariables::TypesOfRegularRiverReachProperties referenceProperty, double thresholdToBeExceeded, double secondaryOutputInterval, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods):
+		OutputRegularRiverReachProperties(regularRiverReachPropertiesForOutput, aggregationsForOutput, userCellIDsForOutput, outputTimeStepLength, outputInitialValues, printUpstreamMargins, printDownstreamMargin, path, outputFiles, writeLineEachTimeStep, outputInterval, explicitTimesForOutput, precisionForOutput, useSecondaryOutputInterval, referenceCellUserCellID, referenceProperty, thresholdToBeExceeded, secondaryOutputInterval, overallParameters, overallMethods, riverSystemProperties, riverSystemMethods),
+		numberOfValuesPerRecord(0),
+		numberOfRecords(0)
+{
+	this->typeOfOutputMethod = CombinerVariables::OutputRegularRiverReachPropertiesNetCDF;
+	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentPropertyType = this->regularRiverReachPropertiesForOutput.begin(); currentPropertyType < this->regularRiverReachPropertiesForOutput.end(); ++currentPropertyType)
+	{
+		if( *currentPropertyType == CombinerVariables::strataPerUnitBedSurface || *currentPropertyType == CombinerVariables::strataPerUnitBedSurfaceIncludingPoreVolume )
+		{
+			const char *const errorMessage = "The strata properties cannot be written by OutputRegularRiverReachPropertiesNetCDF, as the number of strata layers may change in the course of a simulation.";
+			throw(errorMessage);
+		}
+	}
+	createFormat();
+}
+
+OutputMethodType* OutputRegularRiverReachPropertiesNetCDF::createOutputMethodTypePointerCopy() const
+{
+	OutputRegularRiverReachPropertiesNetCDF* result = new OutputRegularRiverReachPropertiesNetCDF(this->regularRiverReachPropertiesForOutput, this->aggregationsForOutput, this->userCellIDsForOutput, this->outputTimeStepLength, this->outputInitialValues, this->printUpstreamMargins, this->printDownstreamMargin, this->path, this->outputFiles, this->writeLineEachTimeStep, this->primaryOutputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->useSecondaryOutputInterval, this->referenceCellUserCellID, this->referenceProperty, this->thresholdToBeExceeded, this->secondaryOutputInterval, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods);
+	result->setAggregationState(this->getAggregationState());
+	return result;
+}
+
+ConstructionVariables OutputRegularRiverReachPropertiesNetCDF::createConstructionVariables()const
+{
+	ConstructionVariables result = OutputRegularRiverReachProperties::createConstructionVariables();
+	result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputRegularRiverReachPropertiesNetCDF);
+	return result;
+}
+
+void OutputRegularRiverReachPropertiesNetCDF::createFormat()
+{
+	std::vector<std::string> grainTypeNames;
+	for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrains < typesOfGrainsOrderForOutput.end() ; ++currentTypeOfGrains)
+		{ grainTypeNames.push_back( CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) ); }
+	unsigned int labelLength = 1;
+	for(std::vector<std::string>::const_iterator currentLabel = cellIDLabels.begin(); currentLabel < cellIDLabels.end(); ++currentLabel)
+		{ if( currentLabel->size() > labelLength ) { labelLength = currentLabel->size(); } }
+	for(std::vector<std::string>::const_iterator currentName = grainTypeNames.begin(); currentName < grainTypeNames.end(); ++currentName)
+		{ if( currentName->size() > labelLength ) { labelLength = currentName->size(); } }
+
+	// The dimension IDs are the indices in this list.
+	const int timeDimension = 0;
+	const int reachDimension = 1;
+	const int grainTypeDimension = 2;
+	const int fractionDimension = 3;
+	const int labelLengthDimension = 4;
+	NetCDFClassicFormat::Dimension dimension;
+	dimension.name = "time";
+	dimension.length = 0;
+	format.dimensions.push_back(dimension);
+	dimension.name = "reach";
+	dimension.length = cellPointersForOutput.size();
+	format.dimensions.push_back(dimension);
+	dimension.name = "grainType";
+	dimension.length = grainTypeNames.size();
+	format.dimensions.push_back(dimension);
+	dimension.name = "fraction";
+	dimension.length = fractionalGrainDiameters.size();
+	format.dimensions.push_back(dimension);
+	dimension.name = "labelLength";
+	dimension.length = labelLength;
+	format.dimensions.push_back(dimension);
+
+	NetCDFClassicFormat::Attribute attribute;
+	attribute.type = NetCDFClassicFormat::NCChar;
+	attribute.name = "title";
+	attribute.text = "sedFlow regular river reach properties";
+	format.globalAttributes.push_back(attribute);
+	attribute.name = "source";
+	attribute.text = "sedFlow";
+	format.globalAttributes.push_back(attribute);
+
+	NetCDFClassicFormat::Attribute unitsAttribute;
+	unitsAttribute.type = NetCDFClassicFormat::NCChar;
+	unitsAttribute.name = "units";
+
+	// The fixed size variables. Their values are written by appendFixedSizeVariables in the same order.
+	NetCDFClassicFormat::Variable variable;
+	variable.name = "reachUserCellID";
+	variable.type = NetCDFClassicFormat::NCInt;
+	variable.dimensionIDs.assign(1, reachDimension);
+	attribute.name = "comment";
+	attribute.text = "-1 for the margins";
+	variable.attributes.assign(1, attribute);
+	format.variables.push_back(variable);
+	variable.attributes.clear();
+
+	variable.name = "reachLabel";
+	variable.type = NetCDFClassicFormat::NCChar;
+	variable.dimensionIDs.clear();
+	variable.dimensionIDs.push_back(reachDimension);
+	variable.dimensionIDs.push_back(labelLengthDimension);
+	format.variables.push_back(variable);
+
+	variable.name = "reachLength";
+	variable.type = NetCDFClassicFormat::NCDouble;
+	variable.dimensionIDs.assign(1, reachDimension);
+	unitsAttribute.text = "m";
+	variable.attributes.assign(1, unitsAttribute);
+	format.variables.push_back(variable);
+
+	variable.name = "reachInitialElevation";
+	format.variables.push_back(variable);
+
+	variable.name = "fractionalGrainDiameter";
+	variable.dimensionIDs.assign(1, fractionDimension);
+	format.variables.push_back(variable);
+	variable.attributes.clear();
+
+	variable.name = "grainTypeName";
+	variable.type = NetCDFClassicFormat::NCChar;
+	variable.dimensionIDs.clear();
+	variable.dimensionIDs.push_back(grainTypeDimension);
+	variable.dimensionIDs.push_back(labelLengthDimension);
+	format.variables.push_back(variable);
+
+	// The record variables contain the values of a snapshot in the same order, as the properties and reaches are already nested like the dimensions.
+	variable.type = NetCDFClassicFormat::NCDouble;
+	variable.name = "time";
+	variable.dimensionIDs.assign(1, timeDimension);
+	unitsAttribute.text = "s";
+	variable.attributes.assign(1, unitsAttribute);
+	format.variables.push_back(variable);
+	numberOfValuesPerRecord = 1;
+
+	if(outputTimeStepLength)
+	{
+		variable.name = "timeStepLength";
+		format.variables.push_back(variable);
+		++numberOfValuesPerRecord;
+	}
+	variable.attributes.clear();
+
+	int numberOfValuesPerGrains = grainTypeNames.size() * fractionalGrainDiameters.size();
+	for(int propertyIndex = 0; propertyIndex < static_cast<int>(regularRiverReachPropertiesForOutput.size()); ++propertyIndex)
+	{
+		variable.name = getPropertyLabelForOutput(propertyIndex);
+		variable.dimensionIDs.clear();
+		variable.dimensionIDs.push_back(timeDimension);
+		variable.dimensionIDs.push_back(reachDimension);
+		if( CombinerVariables::regularRiverReachPropertyIsGrains( regularRiverReachPropertiesForOutput[propertyIndex] ) )
+		{
+			variable.dimensionIDs.push_back(grainTypeDimension);
+			variable.dimensionIDs.push_back(fractionDimension);
+			numberOfValuesPerRecord += cellPointersForOutput.size() * numberOfValuesPerGrains;
+		}
+		else { numberOfValuesPerRecord += cellPointersForOutput.size(); }
+		format.variables.push_back(variable);
+	}
+
+	format.calculateLayout();
+}
+
+void OutputRegularRiverReachPropertiesNetCDF::appendFixedSizeVariables()
+{
+	unsigned int labelLength = format.dimensions.at(4).length;
+
+	// The upstream margins precede and the downstream margin follows the reaches in userCellIDsForOutput.
+	int numberOfUpstreamMargins = cellPointersForOutput.size() - userCellIDsForOutput.size() - (printDownstreamMargin ? 1 : 0);
+	for(int i = 0; i < numberOfUpstreamMargins; ++i) { NetCDFClassicFormat::appendInt(byteBuffer, -1); }
+	for(std::vector<int>::const_iterator currentUserCellID = userCellIDsForOutput.begin(); currentUserCellID < userCellIDsForOutput.end(); ++currentUserCellID)
+		{ NetCDFClassicFormat::appendInt(byteBuffer, *currentUserCellID); }
+	if(printDownstreamMargin) { NetCDFClassicFormat::appendInt(byteBuffer, -1); }
+
+	for(std::vector<std::string>::const_iterator currentLabel = cellIDLabels.begin(); currentLabel < cellIDLabels.end(); ++currentLabel)
+	{
+		byteBuffer.insert(byteBuffer.end(), currentLabel->begin(), currentLabel->end());
+		byteBuffer.insert(byteBuffer.end(), (labelLength - currentLabel->size()), '\0');
+	}
+	NetCDFClassicFormat::appendPadding(byteBuffer);
+
+	for(currentCellPointerIterator = cellPointersForOutput.begin(); currentCellPointerIterator < cellPointersForOutput.end(); ++currentCellPointerIterator)
+		{ NetCDFClassicFormat::appendDouble(byteBuffer, (*currentCellPointerIterator)->getDoubleProperty(CombinerVariables::length)); }
+	for(currentCellPointerIterator = cellPointersForOutput.begin(); currentCellPointerIterator < cellPointersForOutput.end(); ++currentCellPointerIterator)
+		{ NetCDFClassicFormat::appendDouble(byteBuffer, (*currentCellPointerIterator)->getDoubleProperty(CombinerVariables::elevation)); }
+	for(std::vector<double>::const_iterator currentDiameter = fractionalGrainDiametersBegin; currentDiameter < fractionalGrainDiametersEnd; ++currentDiameter)
+		{ NetCDFClassicFormat::appendDouble(byteBuffer, *currentDiameter); }
+
+	for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = typesOfGrainsOrderForOutput.begin(); currentTypeOfGrains < typesOfGrainsOrderForOutput.end() ; ++currentTypeOfGrains)
+	{
+		std::string grainTypeName = CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains);
+		byteBuffer.insert(byteBuffer.end(), grainTypeName.begin(), grainTypeName.end());
+		byteBuffer.insert(byteBuffer.end(), (labelLength - grainTypeName.size()), '\0');
+	}
+	NetCDFClassicFormat::appendPadding(byteBuffer);
+}
+
+void OutputRegularRiverReachPropertiesNetCDF::initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	byteBuffer.clear();
+	numberOfRecords = 0;
+	format.appendHeader(byteBuffer, numberOfRecords);
+	appendFixedSizeVariables();
+	if( byteBuffer.size() != format.getBeginOfRecords() )
+	{
+		const char *const errorMessage = "Internal error: The fixed size variables of OutputRegularRiverReachPropertiesNetCDF do not match the NetCDF header.";
+		throw(errorMessage);
+	}
+
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openAndTruncate(outputFile, true);
+	oFileStream.write(&(byteBuffer[0]), byteBuffer.size());
+	oFileStream.flushNow();
+
+	updateAggregation();
+	if(outputInitialValues) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
+}
+
+void OutputRegularRiverReachPropertiesNetCDF::continueOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	// The file has been truncated to the complete records of the checkpoint. Its header may still contain a later number of records.
+	oFileStream.setFlushPolicy(flushPolicy, numberOfLinesBetweenFlushes, wallSecondsBetweenFlushes);
+	oFileStream.openForUpdating(outputFile);
+	std::streamoff fileSize = oFileStream.tellp();
+	std::streamoff beginOfRecords = format.getBeginOfRecords();
+	numberOfRecords = ( fileSize > beginOfRecords ) ? static_cast<unsigned int>( (fileSize - beginOfRecords) / format.getRecordSize() ) : 0;
+	updateNumberOfRecordsInFile();
+	updateAggregation();
+}
+
+void OutputRegularRiverReachPropertiesNetCDF::writeSnapshot(const std::vector<double>& snapshot)
+{
+	if( static_cast<int>(snapshot.size()) != numberOfValuesPerRecord )
+	{
+		const char *const errorMessage = "Internal error: The snapshot does not match the record of OutputRegularRiverReachPropertiesNetCDF.";
+		throw(errorMessage);
+	}
+	byteBuffer.clear();
+	byteBuffer.reserve(numberOfValuesPerRecord * 8);
+	for(std::vector<double>::const_iterator currentValue = snapshot.begin(); currentValue < snapshot.end(); ++currentValue)
+		{ NetCDFClassicFormat::appendDouble(byteBuffer, *currentValue); }
+	oFileStream.write(&(byteBuffer[0]), byteBuffer.size());
+	++numberOfRecords;
+	// The number of records in the header never exceeds the records actually written to the file.
+	if( oFileStream.lineCompleted() ) { updateNumberOfRecordsInFile(); }
+}
+
+void OutputRegularRiverReachPropertiesNetCDF::updateNumberOfRecordsInFile()
+{
+	if( !(oFileStream.is_open()) ) { return; }
+	std::vector<char> numberOfRecordsBytes;
+	NetCDFClassicFormat::appendUnsignedInt(numberOfRecordsBytes, numberOfRecords);
+	oFileStream.seekp(NetCDFClassicFormat::offsetOfNumberOfRecords);
+	oFileStream.write(&(numberOfRecordsBytes[0]), numberOfRecordsBytes.size());
+	oFileStream.seekp(0, std::ios::end);
+	oFileStream.flush();
+}
+
+void OutputRegularRiverReachPropertiesNetCDF::finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	if ( !(writeLineEachTimeStep) ) { forcedWriteOutputLine(allConstitutingOutputMethodTypes); }
+	if( asynchronousOutputWriter != NULL )
+	{
+		asynchronousOutputWriter->waitUntilDrained();
+		asynchronousOutputWriter->throwIfErrorOccurred();
+	}
+	oFileStream.flushNow();
+	updateNumberOfRecordsInFile();
+	oFileStream.close();
+}
+
+void OutputRegularRiverReachPropertiesNetCDF::flushOutput()
+{
+	if( asynchronousOutputWriter != NULL ) { asynchronousOutputWriter->waitUntilDrained(); }
+	oFileStream.flushNow();
+	updateNumberOfRecordsInFile();
+}
+
+}
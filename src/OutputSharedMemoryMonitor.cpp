@@ -0,0 +1,170 @@
+/*
+ * OutputSharedMemoryMonitor.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "OutputSharedMemoryMonitor.h"
+
+namespace SedFlow {
+
+OutputSharedMemoryMonitor::OutputSharedMemoryMonitor(const std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>& regularRiverReachPropertiesForOutput, std::vector<int> userCellIDsForOutput, int numberOfTimeStepsBetweenPublications, int numberOfSlots, std::string path, std::vector<std::string> outputFiles, bool writeLineEachTimeStep, double outputInterval, const std::vector<double>& explicitTimesForOutput, int precisionForOutput, const OverallParameters* overallParameters, const OverallMethods* overallMethods, const RiverSystemProperties* riverSystemProperties, const RiverSystemMethods* riverSystemMethods):
+	OutputMethodType(path, outputFiles, writeLineEachTimeStep, outputInterval, explicitTimesForOutput, precisionForOutput, overallParameters, overallMethods, riverSystemProperties, riverSystemMethods),
+	regularRiverReachPropertiesForOutput(regularRiverReachPropertiesForOutput),
+	userCellIDsForOutput(userCellIDsForOutput),
+	numberOfTimeStepsBetweenPublications(numberOfTimeStepsBetweenPublications),
+	numberOfTimeStepsSinceLastPublication(0),
+	numberOfSlots(numberOfSlots)
+{
+	this->typeOfOutputMethod = CombinerVariables::OutputSharedMemoryMonitor;
+	if (outputFiles.size() != 1)
+	{
+		const char *const errorMessage = "For OutputSharedMemoryMonitor exactly one (no more, no less) name of the shared memory segment is needed.";
+		throw(errorMessage);
+	}
+	if( numberOfTimeStepsBetweenPublications < 1 )
+	{
+		const char *const errorMessage = "For OutputSharedMemoryMonitor the numberOfTimeStepsBetweenPublications needs to be at least one.";
+		throw(errorMessage);
+	}
+	if( numberOfSlots < 2 )
+	{
+		const char *const errorMessage = "For OutputSharedMemoryMonitor the numberOfSlots needs to be at least two.";
+		throw(errorMessage);
+	}
+	if( regularRiverReachPropertiesForOutput.empty() )
+	{
+		const char *const errorMessage = "For OutputSharedMemoryMonitor at least one property for output is needed.";
+		throw(errorMessage);
+	}
+	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentProperty = regularRiverReachPropertiesForOutput.begin(); currentProperty < regularRiverReachPropertiesForOutput.end(); ++currentProperty)
+	{
+		if( CombinerVariables::regularRiverReachPropertyIsGrains(*currentProperty) )
+		{
+			const char *const errorMessage = "OutputSharedMemoryMonitor can only publish properties with a single value per reach (e.g. activeLayerPerUnitBedSurfaceD50, but not activeLayerPerUnitBedSurface).";
+			throw(errorMessage);
+		}
+	}
+
+	if(userCellIDsForOutput.empty())
+	{
+		for(std::vector<RiverReachProperties>::const_iterator currentRiverReachProperties = riverSystemProperties->regularRiverSystemProperties.cellProperties.begin(); currentRiverReachProperties < riverSystemProperties->regularRiverSystemProperties.cellProperties.end(); ++currentRiverReachProperties)
+		{
+			if ( !( currentRiverReachProperties->isMargin() ) )
+			{
+				cellPointersForOutput.push_back( &( currentRiverReachProperties->regularRiverReachProperties ) );
+				this->userCellIDsForOutput.push_back( riverSystemProperties->regularRiverSystemProperties.getUserCellIDcorrespondingToRealCellID( currentRiverReachProperties->getCellID() ) );
+			}
+		}
+	}
+	else
+	{
+		for(std::vector<int>::const_iterator currentUserCellID = userCellIDsForOutput.begin(); currentUserCellID < userCellIDsForOutput.end(); ++currentUserCellID)
+		{
+			cellPointersForOutput.push_back( &( (riverSystemProperties->regularRiverSystemProperties.cellProperties.at( riverSystemProperties->regularRiverSystemProperties.getRealCellIDcorrespondingToUserCellID( *currentUserCellID ) )).regularRiverReachProperties ) );
+		}
+	}
+
+	currentValues.assign( (regularRiverReachPropertiesForOutput.size() * cellPointersForOutput.size()), 0.0 );
+}
+
+OutputMethodType* OutputSharedMemoryMonitor::createOutputMethodTypePointerCopy() const
+{
+	OutputMethodType* result = new OutputSharedMemoryMonitor(this->regularRiverReachPropertiesForOutput, this->userCellIDsForOutput, this->numberOfTimeStepsBetweenPublications, this->numberOfSlots, this->path, this->outputFiles, this->writeLineEachTimeStep, this->outputInterval, this->explicitTimesForOutput, this->precisionForOutput, this->overallParameters, this->overallMethods, this->riverSystemProperties, this->riverSystemMethods);
+	return result;
+}
+
+ConstructionVariables OutputSharedMemoryMonitor::createConstructionVariables()const
+{
+	ConstructionVariables result = ConstructionVariables();
+	result.interfaceOrCombinerType = CombinerVariables::OutputMethodType;
+	result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputSharedMemoryMonitor);
+	std::vector<double> doubleVector;
+	doubleVector.push_back(outputInterval);
+	result.labelledDoubles["outputInterval"] = doubleVector;
+	result.labelledDoubles["explicitTimesForOutput"] = explicitTimesForOutput;
+	std::vector<int> intVector;
+	intVector.push_back(precisionForOutput);
+	result.labelledInts["precisionForOutput"] = intVector;
+	result.labelledInts["reachIDsForOutput"] = userCellIDsForOutput;
+	intVector.clear();
+	intVector.push_back(numberOfTimeStepsBetweenPublications);
+	result.labelledInts["numberOfTimeStepsBetweenPublications"] = intVector;
+	intVector.clear();
+	intVector.push_back(numberOfSlots);
+	result.labelledInts["numberOfSlots"] = intVector;
+	std::vector<bool> boolVector;
+	boolVector.push_back(writeLineEachTimeStep);
+	result.labelledBools["writeLineEachTimeStep"] = boolVector;
+	std::vector<std::string> stringVector;
+	stringVector.push_back(path);
+	result.labelledStrings["path"] = stringVector;
+	result.labelledStrings["outputFiles"] = outputFiles;
+	stringVector.clear();
+	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentProperty = regularRiverReachPropertiesForOutput.begin(); currentProperty < regularRiverReachPropertiesForOutput.end(); ++currentProperty)
+			{ stringVector.push_back( CombinerVariables::typeOfRegularRiverReachPropertiesToString(*currentProperty) ); }
+	result.labelledStrings["regularRiverReachPropertiesForOutput"] = stringVector;
+	return result;
+}
+
+void OutputSharedMemoryMonitor::initialiseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	std::vector<std::string> propertyNames;
+	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentProperty = regularRiverReachPropertiesForOutput.begin(); currentProperty < regularRiverReachPropertiesForOutput.end(); ++currentProperty)
+			{ propertyNames.push_back( CombinerVariables::typeOfRegularRiverReachPropertiesToString(*currentProperty) ); }
+	ringBuffer.create(outputFiles.at(0), propertyNames, userCellIDsForOutput, numberOfSlots);
+	publishCurrentValues();
+}
+
+void OutputSharedMemoryMonitor::writeOutputLineIfScheduled(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	++numberOfTimeStepsSinceLastPublication;
+	if( numberOfTimeStepsSinceLastPublication >= numberOfTimeStepsBetweenPublications ) { publishCurrentValues(); }
+}
+
+void OutputSharedMemoryMonitor::forcedWriteOutputLine(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	publishCurrentValues();
+}
+
+void OutputSharedMemoryMonitor::finaliseOutput(const std::vector<OutputMethodType*>& allConstitutingOutputMethodTypes)
+{
+	// The final state is published in any case, so that attached readers end with it.
+	if( numberOfTimeStepsSinceLastPublication > 0 ) { publishCurrentValues(); }
+	ringBuffer.markWriterFinished();
+	ringBuffer.detach();
+}
+
+void OutputSharedMemoryMonitor::publishCurrentValues()
+{
+	if( !(ringBuffer.isAttached()) ) { return; }
+	std::vector<double>::iterator currentValue = currentValues.begin();
+	for(std::vector<CombinerVariables::TypesOfRegularRiverReachProperties>::const_iterator currentProperty = regularRiverReachPropertiesForOutput.begin(); currentProperty < regularRiverReachPropertiesForOutput.end(); ++currentProperty)
+	{
+		for(std::vector<const RegularRiverReachProperties*>::const_iterator currentCellPointer = cellPointersForOutput.begin(); currentCellPointer < cellPointersForOutput.end(); ++currentCellPointer, ++currentValue)
+			{ *currentValue = (*currentCellPointer)->getDoubleProperty(*currentProperty); }
+	}
+	ringBuffer.publish(overallParameters->getElapsedSeconds(), overallParameters->getCurrentTimeStepLengthInSeconds(), currentValues);
+	numberOfTimeStepsSinceLastPublication = 0;
+}
+
+}
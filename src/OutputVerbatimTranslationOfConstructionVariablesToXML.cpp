@@ -334,6 +334,10 @@ ConstructionVariables OutputVerbatimTranslationOfConstructionVariablesToXML::cre
 			{ tmpConstructionVariablesVector.push_back( (*currentOutputMethodType)->createConstructionVariables() ); }
 	outputMethods.labelledObjects["constitutingOutputMethodTypes"] = tmpConstructionVariablesVector;
 	tmpConstructionVariablesVector.clear();
+	std::vector<double> timesOfLastOutput;
+	for(std::vector<OutputMethodType*>::const_iterator currentOutputMethodType = allConstitutingOutputMethodTypes.begin(); currentOutputMethodType < allConstitutingOutputMethodTypes.end(); ++currentOutputMethodType)
+			{ timesOfLastOutput.push_back( (*currentOutputMethodType)->getTimeOfLastOutput() ); }
+	outputMethods.labelledDoubles["timesOfLastOutput"] = timesOfLastOutput;
 
 	tmpConstructionVariablesVector.push_back( outputMethods );
 	sedFlow.labelledObjects["outputMethods"] = tmpConstructionVariablesVector;
@@ -24,8 +24,34 @@
 
 #include "OverallMethods.h"
 
+#if defined _DEBUG || defined DEBUG
+#include <cstring>
+#include <sstream>
+#endif
+
 namespace SedFlow {
 
+#if defined _DEBUG || defined DEBUG
+namespace {
+
+// A slope, which has not been recalculated, has to equal the result of a recalculation. Otherwise a slope relevant property has been changed without RiverReachProperties::markAsModified.
+void checkSkippedSlopeRecalculation(double keptSlope, double recalculatedSlope, const char* slopeName, const RiverReachProperties& riverReachProperties)
+{
+	if( keptSlope != recalculatedSlope && !( keptSlope != keptSlope && recalculatedSlope != recalculatedSlope ) )
+	{
+		std::ostringstream oStringStream;
+		oStringStream.precision(17);
+		oStringStream << "The kept " << slopeName << " " << keptSlope << " of the reach " << riverReachProperties.getUserCellID() << " differs from the recalculated value " << recalculatedSlope << ". A slope relevant property has been changed without RiverReachProperties::markAsModified." << std::flush;
+		char* tmpChar = new char [(oStringStream.str()).size()+1];
+		std::strcpy(tmpChar, (oStringStream.str()).c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+}
+
+}
+#endif
+
 OverallMethods::OverallMethods():
 	bedSlopeCalculationMethod(NULL),
 	waterEnergySlopeCalculationMethod(NULL),
@@ -73,4 +99,68 @@ ConstructionVariables OverallMethods::createConstructionVariables()const
 	return result;
 }
 
+void OverallMethods::updateBedslope(RiverReachProperties& riverReachProperties) const
+{
+	if( riverReachProperties.bedslopeNeedsUpdate() )
+	{
+		unsigned long neighbourhoodModificationCount = riverReachProperties.getNeighbourhoodModificationCount();
+		riverReachProperties.regularRiverReachProperties.bedslope = bedSlopeCalculationMethod->calculate(riverReachProperties);
+		riverReachProperties.setBedslopeBasedOnModificationCount(neighbourhoodModificationCount);
+		if( waterEnergySlopeCalculationMethod->dependsOnBedslope() ) { riverReachProperties.invalidateWaterEnergyslope(); }
+		if( sedimentEnergySlopeCalculationMethod->dependsOnBedslope() ) { riverReachProperties.invalidateSedimentEnergyslope(); }
+	}
+#if defined _DEBUG || defined DEBUG
+	else { checkSkippedSlopeRecalculation(riverReachProperties.regularRiverReachProperties.bedslope, bedSlopeCalculationMethod->calculate(riverReachProperties), "bedslope", riverReachProperties); }
+#endif
+
+	if( waterEnergySlopeCalculationMethod->dependsOnBedslope() )
+	{
+		this->updateWaterEnergyslope(riverReachProperties);
+	}
+
+	if( sedimentEnergySlopeCalculationMethod->dependsOnBedslope() )
+	{
+		this->updateSedimentEnergyslope(riverReachProperties);
+	}
+}
+
+void OverallMethods::updateWaterEnergyslope(RiverReachProperties& riverReachProperties) const
+{
+	if( riverReachProperties.waterEnergyslopeNeedsUpdate() )
+	{
+		unsigned long neighbourhoodModificationCount = riverReachProperties.getNeighbourhoodModificationCount();
+		riverReachProperties.regularRiverReachProperties.waterEnergyslope = waterEnergySlopeCalculationMethod->calculate(riverReachProperties);
+		riverReachProperties.setWaterEnergyslopeBasedOnModificationCount(neighbourhoodModificationCount);
+		if( sedimentEnergySlopeCalculationMethod->dependsOnWaterEnergyslope() ) { riverReachProperties.invalidateSedimentEnergyslope(); }
+	}
+#if defined _DEBUG || defined DEBUG
+	else { checkSkippedSlopeRecalculation(riverReachProperties.regularRiverReachProperties.waterEnergyslope, waterEnergySlopeCalculationMethod->calculate(riverReachProperties), "waterEnergyslope", riverReachProperties); }
+#endif
+
+	if( sedimentEnergySlopeCalculationMethod->dependsOnWaterEnergyslope() )
+	{
+		this->updateSedimentEnergyslope(riverReachProperties);
+	}
+}
+
+void OverallMethods::updateSedimentEnergyslope(RiverReachProperties& riverReachProperties) const
+{
+	if( riverReachProperties.sedimentEnergyslopeNeedsUpdate() )
+	{
+		unsigned long neighbourhoodModificationCount = riverReachProperties.getNeighbourhoodModificationCount();
+		std::pair<double,double> reducedAndUnreducedSlope = sedimentEnergySlopeCalculationMethod->calculateReducedAndUnreducedSedimentEnergyslope(riverReachProperties);
+		riverReachProperties.regularRiverReachProperties.sedimentEnergyslope = reducedAndUnreducedSlope.first;
+		riverReachProperties.regularRiverReachProperties.unreducedSedimentEnergyslope = reducedAndUnreducedSlope.second;
+		riverReachProperties.setSedimentEnergyslopeBasedOnModificationCount(neighbourhoodModificationCount);
+	}
+#if defined _DEBUG || defined DEBUG
+	else
+	{
+		std::pair<double,double> reducedAndUnreducedSlope = sedimentEnergySlopeCalculationMethod->calculateReducedAndUnreducedSedimentEnergyslope(riverReachProperties);
+		checkSkippedSlopeRecalculation(riverReachProperties.regularRiverReachProperties.sedimentEnergyslope, reducedAndUnreducedSlope.first, "sedimentEnergyslope", riverReachProperties);
+		checkSkippedSlopeRecalculation(riverReachProperties.regularRiverReachProperties.unreducedSedimentEnergyslope, reducedAndUnreducedSlope.second, "unreducedSedimentEnergyslope", riverReachProperties);
+	}
+#endif
+}
+
 }
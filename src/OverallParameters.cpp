@@ -42,10 +42,6 @@ OverallParameters::OverallParameters(double densityWater, double densitySediment
 	courantFriedrichsLewyNumber(courantFriedrichsLewyNumber),
 	timeStepThresholdForTerminatingSimulation(timeStepThresholdForTerminatingSimulation),
 	timeStepFactor(timeStepFactor),
-#if defined TIMESTEPANALYSIS
-	numberOfTimeStepOutputs(0),
-	maximumNumberOfTimeStepOutputs(1000),
-#endif
 	updateRegularPropertiesAfterInitialisation(updateRegularPropertiesAfterInitialisation),
 	updateAdditionalRiverReachPropertiesAfterInitialisation(updateRegularPropertiesAfterInitialisation),
 	updateOutputMethodsAfterInitialisation(updateRegularPropertiesAfterInitialisation)
@@ -100,14 +96,6 @@ ConstructionVariables OverallParameters::createConstructionVariables()const
 	doubleVector.clear();
 	doubleVector.push_back(timeStepFactor);
 	result.labelledDoubles["timeStepFactor"] = doubleVector;
-#if defined TIMESTEPANALYSIS
-	std::vector<int> intVector;
-	intVector.push_back(numberOfTimeStepOutputs);
-	result.labelledInts["numberOfTimeStepOutputs"] = intVector;
-	intVector.clear();
-	intVector.push_back(maximumNumberOfTimeStepOutputs);
-	result.labelledInts["maximumNumberOfTimeStepOutputs"] = intVector;
-#endif
 	std::vector<bool> boolVector;
 	boolVector.push_back(updateRegularPropertiesAfterInitialisation);
 	result.labelledBools["updateRegularPropertiesAfterInitialisation"] = boolVector;
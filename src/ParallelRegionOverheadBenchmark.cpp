@@ -0,0 +1,142 @@
+/*
+ * ParallelRegionOverheadBenchmark.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+// Compares the loop structure of RegularRiverSystemMethods::calculateAndModifyChangeRates before and after
+// the fusion into a single parallel region: Once with a separate "parallel for" region for each loop and once
+// with a single parallel region containing work sharing loops. The per-reach work is a small dummy calculation,
+// so that the difference between the two variants is dominated by the fork/join overhead.
+//
+// Usage: ParallelRegionOverheadBenchmark [numberOfReaches] [numberOfTimeSteps] [workPerReach]
+// Build: make bin/ParallelRegionOverheadBenchmark CXX_FLAGS="-O1 -fopenmp -DSEDFLOWPARALLEL"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+#if defined SEDFLOWPARALLEL
+#include <omp.h>
+#else
+#include <ctime>
+#endif
+
+namespace {
+
+// Number of loops in calculateAndModifyChangeRates for a flow method with change rate modifiers and a single modification iteration.
+const int numberOfLoopsPerTimeStep = 10;
+
+double currentTime()
+{
+#if defined SEDFLOWPARALLEL
+	return omp_get_wtime();
+#else
+	return ( static_cast<double>(std::clock()) / CLOCKS_PER_SEC );
+#endif
+}
+
+inline void dummyReachCalculation(std::vector<double>& values, int reachID, int workPerReach)
+{
+	double value = values[reachID];
+	for(int i = 0; i < workPerReach; ++i) { value = std::sqrt( (value * value) + 1.0 ) - 0.5; }
+	values[reachID] = value;
+}
+
+double runSeparateRegions(std::vector<double>& values, int numberOfTimeSteps, int workPerReach)
+{
+	int numberOfReaches = values.size();
+	double startTime = currentTime();
+	for(int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+	{
+		for(int loop = 0; loop < numberOfLoopsPerTimeStep; ++loop)
+		{
+			#pragma omp parallel for schedule(dynamic)
+			for(int i = 0; i < numberOfReaches; ++i)
+				{ dummyReachCalculation(values, i, workPerReach); }
+		}
+	}
+	return ( currentTime() - startTime );
+}
+
+double runSingleRegion(std::vector<double>& values, int numberOfTimeSteps, int workPerReach)
+{
+	int numberOfReaches = values.size();
+	double startTime = currentTime();
+	for(int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+	{
+		#pragma omp parallel default(shared)
+		{
+		for(int loop = 0; loop < numberOfLoopsPerTimeStep; ++loop)
+		{
+			#pragma omp for schedule(dynamic)
+			for(int i = 0; i < numberOfReaches; ++i)
+				{ dummyReachCalculation(values, i, workPerReach); }
+		}
+		}
+	}
+	return ( currentTime() - startTime );
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+	int numberOfReaches = 20;
+	int numberOfTimeSteps = 20000;
+	int workPerReach = 50;
+	if( argc > 1 ) { numberOfReaches = std::atoi(argv[1]); }
+	if( argc > 2 ) { numberOfTimeSteps = std::atoi(argv[2]); }
+	if( argc > 3 ) { workPerReach = std::atoi(argv[3]); }
+
+	if( numberOfReaches < 1 || numberOfTimeSteps < 1 || workPerReach < 0 )
+	{
+		std::cerr << "Usage: " << argv[0] << " [numberOfReaches] [numberOfTimeSteps] [workPerReach]" << std::endl;
+		return 1;
+	}
+
+#if defined SEDFLOWPARALLEL
+	std::cout << "Number of threads: " << omp_get_max_threads() << std::endl;
+#else
+	std::cout << "Compiled without SEDFLOWPARALLEL: Both variants run serially." << std::endl;
+#endif
+	std::cout << "Number of reaches: " << numberOfReaches << ", number of time steps: " << numberOfTimeSteps << ", work per reach: " << workPerReach << std::endl;
+
+	std::vector<double> values (numberOfReaches, 1.0);
+	// Warm up the thread pool.
+	runSingleRegion(values, 100, workPerReach);
+
+	double separateRegionsSeconds = runSeparateRegions(values, numberOfTimeSteps, workPerReach);
+	double singleRegionSeconds = runSingleRegion(values, numberOfTimeSteps, workPerReach);
+
+	double microsecondsPerTimeStepFactor = 1.0e6 / numberOfTimeSteps;
+	std::cout << "Separate parallel regions: " << (separateRegionsSeconds * microsecondsPerTimeStepFactor) << " microseconds per time step" << std::endl;
+	std::cout << "Single parallel region:    " << (singleRegionSeconds * microsecondsPerTimeStepFactor) << " microseconds per time step" << std::endl;
+	std::cout << "Saved overhead per loop:   " << ( (separateRegionsSeconds - singleRegionSeconds) * microsecondsPerTimeStepFactor / numberOfLoopsPerTimeStep ) << " microseconds" << std::endl;
+
+	// Prevent the dummy calculations from being optimised away.
+	double checksum = 0.0;
+	for(std::vector<double>::const_iterator currentValue = values.begin(); currentValue < values.end(); ++currentValue) { checksum += *currentValue; }
+	std::cout << "Checksum: " << checksum << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * ReachCostModel.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#include "ReachCostModel.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace SedFlow {
+
+const double ReachCostModel::weightOfCurrentTimeStep = 0.3;
+
+void ReachCostModel::adaptToNumberOfItems(int numberOfItems)
+{
+	if( numberOfItems != static_cast<int>(processingOrder.size()) )
+	{
+		smoothedCosts.assign(numberOfItems,0.0);
+		costsOfCurrentTimeStep.assign(numberOfItems,0.0);
+		processingOrder.clear();
+		for(int i = 0; i < numberOfItems; ++i) { processingOrder.push_back(i); }
+	}
+}
+
+void ReachCostModel::updateProcessingOrder(int numberOfItems)
+{
+	if( numberOfItems != static_cast<int>(processingOrder.size()) )
+	{
+		adaptToNumberOfItems(numberOfItems);
+		return;
+	}
+
+#if defined SEDFLOWPARALLEL
+	std::vector< std::pair<double,int> > costsAndIndices;
+	costsAndIndices.reserve(numberOfItems);
+	for(int i = 0; i < numberOfItems; ++i)
+	{
+		smoothedCosts[i] = ( (1.0 - weightOfCurrentTimeStep) * smoothedCosts[i] ) + ( weightOfCurrentTimeStep * costsOfCurrentTimeStep[i] );
+		costsOfCurrentTimeStep[i] = 0.0;
+		costsAndIndices.push_back( std::make_pair(smoothedCosts[i],i) );
+	}
+	std::sort(costsAndIndices.begin(),costsAndIndices.end(),std::greater< std::pair<double,int> >());
+	for(int i = 0; i < numberOfItems; ++i) { processingOrder[i] = costsAndIndices[i].second; }
+#endif
+}
+
+}
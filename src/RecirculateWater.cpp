@@ -86,6 +86,7 @@ void RecirculateWater::inputModification(RiverReachProperties& riverReachPropert
 	if ( riverReachProperties.isUpstreamMargin() )
 	{
 		riverReachProperties.regularRiverReachProperties.discharge = inputDischarge;
+		riverReachProperties.markAsModified();
 	}
 }
 
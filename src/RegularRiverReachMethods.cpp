@@ -77,6 +77,11 @@ double RegularRiverReachMethods::getCurrentDarcyWeisbachFrictionFactorF(const Ri
 
 void RegularRiverReachMethods::calculateActiveWidth(RiverReachProperties& riverReachProperties, const SedimentFlowMethods& sedimentFlowMethods, const OverallMethods& overallMethods) const
 {
-	riverReachProperties.regularRiverReachProperties.activeWidth = (*activeWidthCalculationMethod).calculateActiveWidth(riverReachProperties, sedimentFlowMethods, overallMethods);
+	double newActiveWidth = (*activeWidthCalculationMethod).calculateActiveWidth(riverReachProperties, sedimentFlowMethods, overallMethods);
+	if( newActiveWidth != riverReachProperties.regularRiverReachProperties.activeWidth )
+	{
+		riverReachProperties.regularRiverReachProperties.activeWidth = newActiveWidth;
+		riverReachProperties.markAsModified();
+	}
 }
 }
@@ -23,18 +23,24 @@
  */
 
 #include "RegularRiverSystemMethods.h"
+#include "StageProfiler.h"
 
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <utility>
 
 namespace SedFlow {
 
 RegularRiverSystemMethods::RegularRiverSystemMethods(std::vector<RiverReachMethods> riverReachMethods, FlowMethods flowMethods, ChangeRateModifiers changeRateModifiers):
 	riverReachMethods(riverReachMethods),
 	flowMethods(flowMethods),
-	changeRateModifiers(changeRateModifiers)
+	changeRateModifiers(changeRateModifiers),
+	numberOfCellsInBranchSchedule(-1),
+	numberOfRiverReachMethodsInDownstreamDistanceSchedule(-1)
 {
 	std::sort(this->riverReachMethods.begin(),this->riverReachMethods.end());
+	costModelForRiverReachMethods.updateProcessingOrder( this->riverReachMethods.size() );
 }
 
 RegularRiverSystemMethods::~RegularRiverSystemMethods() {}
@@ -80,185 +86,281 @@ void RegularRiverSystemMethods::calculateAndModifyChangeRates(RiverSystemPropert
 {
 	FlowTypeMethods* sedimentFlowMethodsAsFlowTypeMethods = flowMethods.createPointerCopyOfSingleFlowTypeMethods(CombinerVariables::sedimentFlowMethods);
 	SedimentFlowMethods& sedimentFlowMethods = *( static_cast<SedimentFlowMethods*>(sedimentFlowMethodsAsFlowTypeMethods) );
-	RiverReachProperties* currentRiverReachProperties;
-	RiverReachProperties* currentUpstreamProperties;
-	RiverReachMethods* currentRiverReachMethods;
-	ChangeRateModifiersForSingleFlowMethod* currentModifiers;
-	CombinerVariables::TypesOfGeneralFlowMethods currentGeneralFlowMethodType;
-	for(std::vector<FlowTypeMethods*>::const_iterator currentFlowMethod = flowMethods.getBeginFlowMethodsTypeConstIterator(); currentFlowMethod < flowMethods.getEndFlowMethodsTypeConstIterator(); ++currentFlowMethod)
-	{
-		currentGeneralFlowMethodType = (*(*currentFlowMethod)).getTypeOfGeneralFlowMethods();
+	std::vector<RiverReachProperties>& cellProperties = parameters.regularRiverSystemProperties.cellProperties;
+	int numberOfCells = cellProperties.size();
+	int numberOfRiverReachMethods = riverReachMethods.size();
+	bool furtherModificationIterationNecessary;
+
+	//The processing orders are updated once per time step based on the costs measured during the previous time steps.
+	costModelForCells.updateProcessingOrder(numberOfCells);
+	costModelForRiverReachMethods.updateProcessingOrder(numberOfRiverReachMethods);
+#if defined SEDFLOWDETERMINISTIC
+	if( numberOfRiverReachMethodsInDownstreamDistanceSchedule != numberOfRiverReachMethods ) { determineDownstreamDistanceSchedule(parameters); }
+#endif
 
-		if (changeRateModifiers.checkForGeneralFlowMethodTreatment(currentGeneralFlowMethodType))
+	//A single parallel region is used for the complete calculation of the change rates, as forking and joining the threads for every loop
+	//dominates the computation time for small river systems with short time steps. Each thread runs through the flow methods on its own,
+	//while the work is shared within the loops. The implicit barriers at the end of the loops separate the stages depending on each other.
+	#pragma omp parallel default(shared)
+	{
+		RiverReachProperties* currentRiverReachProperties;
+		RiverReachProperties* currentUpstreamProperties;
+		RiverReachMethods* currentRiverReachMethods;
+		ChangeRateModifiersForSingleFlowMethod* currentModifiers;
+		CombinerVariables::TypesOfGeneralFlowMethods currentGeneralFlowMethodType;
+		int currentSection;
+
+		for(std::vector<FlowTypeMethods*>::const_iterator currentFlowMethod = flowMethods.getBeginFlowMethodsTypeConstIterator(); currentFlowMethod < flowMethods.getEndFlowMethodsTypeConstIterator(); ++currentFlowMethod)
 		{
-			currentModifiers = changeRateModifiers.getChangeRateModifiersCorrespondingToGeneralFlowMethodPointer(currentGeneralFlowMethodType);
+			currentGeneralFlowMethodType = (*(*currentFlowMethod)).getTypeOfGeneralFlowMethods();
+			currentSection = StageProfiler::getSectionForFlowMethods( (*(*currentFlowMethod)).getTypeOfFlowMethods() );
 
-#if defined SEDFLOWPARALLEL
-			//TODO Delete this debugging line.
-			std::cout << "OMP RegularRiverSystemMethods::calculateAndModifyChangeRates_1" << std::endl << std::endl;
-#endif
-			#pragma omp parallel for private(currentRiverReachProperties)
-			for(int i = 0; i < parameters.regularRiverSystemProperties.cellProperties.size(); ++i)
-			{
-				currentRiverReachProperties = &(parameters.regularRiverSystemProperties.cellProperties[i]);
-				currentModifiers->inputModification(*currentRiverReachProperties);
-			}
-#if defined SEDFLOWPARALLEL
-			//TODO Delete this debugging line.
-			std::cout << "OMP RegularRiverSystemMethods::calculateAndModifyChangeRates_2" << std::endl << std::endl;
-#endif
-			#pragma omp parallel for private(currentRiverReachMethods, currentRiverReachProperties, currentUpstreamProperties)
-			for(int i = 0; i < riverReachMethods.size(); ++i)
+			if (changeRateModifiers.checkForGeneralFlowMethodTreatment(currentGeneralFlowMethodType))
 			{
-				currentRiverReachMethods = &(riverReachMethods[i]);
-				currentRiverReachProperties = currentRiverReachMethods->getPointerToCorrespondingRiverReachProperties();
-				currentUpstreamProperties = (currentRiverReachProperties->getUpstreamCellPointers()).at(0);
-				if(currentUpstreamProperties->isUpstreamMargin())
-				{
-					updateBedSlope(*currentUpstreamProperties, overallMethods);
-					updateWaterEnergySlope(*currentUpstreamProperties, overallMethods);
-					updateSedimentEnergySlope(*currentUpstreamProperties, overallMethods);
-					RegularRiverReachMethods regularRiverReachMethods = currentRiverReachMethods->getRegularRiverReachMethods();
-					regularRiverReachMethods.calculateTau(*currentUpstreamProperties, overallMethods);
-					regularRiverReachMethods.calculateActiveWidth(*currentUpstreamProperties, sedimentFlowMethods, overallMethods);
-				}
-				updateBedSlope(*currentRiverReachProperties, overallMethods);
-				updateWaterEnergySlope(*currentRiverReachProperties, overallMethods);
-				updateSedimentEnergySlope(*currentRiverReachProperties, overallMethods);
-				currentRiverReachMethods->calculateTau();
-				currentRiverReachMethods->calculateActiveWidth(sedimentFlowMethods);
-			}
-
-			do {
+				currentModifiers = changeRateModifiers.getChangeRateModifiersCorrespondingToGeneralFlowMethodPointer(currentGeneralFlowMethodType);
 
-#if defined SEDFLOWPARALLEL
-				//TODO Delete this debugging line.
-				std::cout << "OMP RegularRiverSystemMethods::calculateAndModifyChangeRates_3" << std::endl << std::endl;
-#endif
-				#pragma omp parallel for private (currentRiverReachProperties)
-				for(int i = 0; i < parameters.regularRiverSystemProperties.cellProperties.size(); ++i)
+				#pragma omp for schedule(dynamic)
+				for(int position = 0; position < numberOfCells; ++position)
 				{
-					currentRiverReachProperties = &(parameters.regularRiverSystemProperties.cellProperties[i]);
-					(*currentFlowMethod)->calculateChangeRate(*currentRiverReachProperties);
-#if defined SEDFLOWPARALLEL
+					int i = costModelForCells.getIndexForForwardLoop(position);
+					double startTime = costModelForCells.startMeasurement();
+					currentRiverReachProperties = &(cellProperties[i]);
+					currentModifiers->inputModification(*currentRiverReachProperties);
+					costModelForCells.addMeasuredCost(i,startTime);
 				}
-				#pragma omp parallel for private (currentRiverReachProperties)
-				for(int i = 0; i < parameters.regularRiverSystemProperties.cellProperties.size(); ++i)
-				{
-					currentRiverReachProperties = &(parameters.regularRiverSystemProperties.cellProperties[i]);
-#endif
-					(*currentFlowMethod)->handDownChangeRate(*currentRiverReachProperties);
-					currentModifiers->modificationBeforeUpdates(*currentRiverReachProperties);
-				}
-#if defined SEDFLOWPARALLEL
-				//TODO Delete this debugging line.
-				std::cout << "OMP RegularRiverSystemMethods::calculateAndModifyChangeRates_4" << std::endl << std::endl;
-#endif
-				#pragma omp parallel for private(currentRiverReachMethods, currentRiverReachProperties, currentUpstreamProperties)
-				for(int i = (riverReachMethods.size()-1); i > -1; --i)
+				#pragma omp for schedule(dynamic)
+				for(int position = 0; position < numberOfRiverReachMethods; ++position)
 				{
+					int i = costModelForRiverReachMethods.getIndexForForwardLoop(position);
+					double startTime = costModelForRiverReachMethods.startMeasurement();
 					currentRiverReachMethods = &(riverReachMethods[i]);
 					currentRiverReachProperties = currentRiverReachMethods->getPointerToCorrespondingRiverReachProperties();
 					currentUpstreamProperties = (currentRiverReachProperties->getUpstreamCellPointers()).at(0);
-					updateBedSlope(*currentRiverReachProperties, overallMethods);
-					flowMethods.updateOtherParameters(*currentRiverReachProperties);
 					if(currentUpstreamProperties->isUpstreamMargin())
 					{
 						updateBedSlope(*currentUpstreamProperties, overallMethods);
-						flowMethods.updateOtherParameters(*currentUpstreamProperties);
+						updateWaterEnergySlope(*currentUpstreamProperties, overallMethods);
+						updateSedimentEnergySlope(*currentUpstreamProperties, overallMethods);
+						RegularRiverReachMethods regularRiverReachMethods = currentRiverReachMethods->getRegularRiverReachMethods();
+						regularRiverReachMethods.calculateTau(*currentUpstreamProperties, overallMethods);
+						regularRiverReachMethods.calculateActiveWidth(*currentUpstreamProperties, sedimentFlowMethods, overallMethods);
 					}
+					updateBedSlope(*currentRiverReachProperties, overallMethods);
+					updateWaterEnergySlope(*currentRiverReachProperties, overallMethods);
+					updateSedimentEnergySlope(*currentRiverReachProperties, overallMethods);
+					currentRiverReachMethods->calculateTau();
+					currentRiverReachMethods->calculateActiveWidth(sedimentFlowMethods);
+					costModelForRiverReachMethods.addMeasuredCost(i,startTime);
 				}
+
+				do {
+
+					#pragma omp for schedule(dynamic)
+					for(int position = 0; position < numberOfCells; ++position)
+					{
+						int i = costModelForCells.getIndexForForwardLoop(position);
+						double startTime = costModelForCells.startMeasurement();
+						currentRiverReachProperties = &(cellProperties[i]);
+						double calculationStartTime = StageProfiler::startSection();
+						(*currentFlowMethod)->calculateChangeRate(*currentRiverReachProperties);
+						StageProfiler::finishSection(currentSection, calculationStartTime);
 #if defined SEDFLOWPARALLEL
-				//TODO Delete this debugging line.
-				std::cout << "OMP RegularRiverSystemMethods::calculateAndModifyChangeRates_5" << std::endl << std::endl;
+						costModelForCells.addMeasuredCost(i,startTime);
+					}
+					#pragma omp for schedule(dynamic)
+					for(int position = 0; position < numberOfCells; ++position)
+					{
+						int i = costModelForCells.getIndexForForwardLoop(position);
+						double startTime = costModelForCells.startMeasurement();
+						currentRiverReachProperties = &(cellProperties[i]);
 #endif
-				#pragma omp parallel for private(currentRiverReachMethods, currentRiverReachProperties, currentUpstreamProperties)
-				for(int i = 0; i < riverReachMethods.size(); ++i)
+						double handDownStartTime = StageProfiler::startSection();
+						(*currentFlowMethod)->handDownChangeRate(*currentRiverReachProperties);
+						StageProfiler::finishSection(currentSection, handDownStartTime);
+						currentModifiers->modificationBeforeUpdates(*currentRiverReachProperties);
+						costModelForCells.addMeasuredCost(i,startTime);
+					}
+					//The update of a reach reads the already updated downstream neighbour and the not yet updated upstream neighbour.
+#if defined SEDFLOWDETERMINISTIC
+					for(std::vector< std::vector<int> >::const_iterator currentDistance = riverReachMethodsIDsPerDownstreamDistance.begin(); currentDistance < riverReachMethodsIDsPerDownstreamDistance.end(); ++currentDistance)
+					{
+						int numberOfRiverReachMethodsAtCurrentDistance = currentDistance->size();
+						#pragma omp for schedule(dynamic)
+						for(int position = 0; position < numberOfRiverReachMethodsAtCurrentDistance; ++position)
+							{ updateBedSlopeAndOtherParameters( (*currentDistance)[position], overallMethods ); }
+					}
+#else
+					#pragma omp for schedule(dynamic)
+					for(int position = 0; position < numberOfRiverReachMethods; ++position)
+						{ updateBedSlopeAndOtherParameters( costModelForRiverReachMethods.getIndexForBackwardLoop(position), overallMethods ); }
+#endif
+					#pragma omp for schedule(dynamic)
+					for(int position = 0; position < numberOfRiverReachMethods; ++position)
+					{
+						int i = costModelForRiverReachMethods.getIndexForForwardLoop(position);
+						double startTime = costModelForRiverReachMethods.startMeasurement();
+						currentRiverReachMethods = &(riverReachMethods[i]);
+						currentRiverReachProperties = currentRiverReachMethods->getPointerToCorrespondingRiverReachProperties();
+						currentUpstreamProperties = (currentRiverReachProperties->getUpstreamCellPointers()).at(0);
+						if(currentUpstreamProperties->isUpstreamMargin())
+						{
+							flowMethods.handDownOtherParameters(*currentUpstreamProperties);
+							updateWaterEnergySlope(*currentUpstreamProperties, overallMethods);
+							updateSedimentEnergySlope(*currentUpstreamProperties, overallMethods);
+							RegularRiverReachMethods regularRiverReachMethods = currentRiverReachMethods->getRegularRiverReachMethods();
+							regularRiverReachMethods.calculateTau(*currentUpstreamProperties, overallMethods);
+							regularRiverReachMethods.calculateActiveWidth(*currentUpstreamProperties, sedimentFlowMethods, overallMethods);
+							(*(*currentFlowMethod)).updateChangeRateDependingParameters(*currentUpstreamProperties);
+						}
+						flowMethods.handDownOtherParameters(*currentRiverReachProperties);
+						currentRiverReachMethods->updateAdditionalRiverReachProperties();
+						updateWaterEnergySlope(*currentRiverReachProperties, overallMethods);
+						updateSedimentEnergySlope(*currentRiverReachProperties, overallMethods);
+						currentRiverReachMethods->calculateTau();
+						currentRiverReachMethods->calculateActiveWidth(sedimentFlowMethods);
+						(*(*currentFlowMethod)).updateChangeRateDependingParameters(*currentRiverReachProperties);
+						costModelForRiverReachMethods.addMeasuredCost(i,startTime);
+					}
+
+					//Equivalent to currentModifiers->furtherModificationIterationNecessary(parameters), but evaluated by the threads of the current team.
+					#pragma omp single
+					{ furtherModificationIterationNecessary = true; }
+					#pragma omp for schedule(dynamic) reduction(&&:furtherModificationIterationNecessary)
+					for(int i = 0; i < numberOfCells; ++i)
+						{ furtherModificationIterationNecessary = furtherModificationIterationNecessary && currentModifiers->furtherModificationIterationNecessary(cellProperties[i]); }
+
+				} while ( furtherModificationIterationNecessary );
+
+				#pragma omp for schedule(dynamic)
+				for(int position = 0; position < numberOfCells; ++position)
+				{
+					int i = costModelForCells.getIndexForForwardLoop(position);
+					double startTime = costModelForCells.startMeasurement();
+					currentRiverReachProperties = &(cellProperties[i]);
+					currentModifiers->finalModification(*currentRiverReachProperties);
+					costModelForCells.addMeasuredCost(i,startTime);
+				}
+				#pragma omp for schedule(dynamic)
+				for(int position = 0; position < numberOfRiverReachMethods; ++position)
 				{
+					int i = costModelForRiverReachMethods.getIndexForForwardLoop(position);
+					double startTime = costModelForRiverReachMethods.startMeasurement();
 					currentRiverReachMethods = &(riverReachMethods[i]);
 					currentRiverReachProperties = currentRiverReachMethods->getPointerToCorrespondingRiverReachProperties();
 					currentUpstreamProperties = (currentRiverReachProperties->getUpstreamCellPointers()).at(0);
 					if(currentUpstreamProperties->isUpstreamMargin())
 					{
-						flowMethods.handDownOtherParameters(*currentUpstreamProperties);
+						updateBedSlope(*currentUpstreamProperties, overallMethods);
 						updateWaterEnergySlope(*currentUpstreamProperties, overallMethods);
 						updateSedimentEnergySlope(*currentUpstreamProperties, overallMethods);
 						RegularRiverReachMethods regularRiverReachMethods = currentRiverReachMethods->getRegularRiverReachMethods();
 						regularRiverReachMethods.calculateTau(*currentUpstreamProperties, overallMethods);
 						regularRiverReachMethods.calculateActiveWidth(*currentUpstreamProperties, sedimentFlowMethods, overallMethods);
-						(*(*currentFlowMethod)).updateChangeRateDependingParameters(*currentUpstreamProperties);
 					}
-					flowMethods.handDownOtherParameters(*currentRiverReachProperties);
-					currentRiverReachMethods->updateAdditionalRiverReachProperties();
+					updateBedSlope(*currentRiverReachProperties, overallMethods);
 					updateWaterEnergySlope(*currentRiverReachProperties, overallMethods);
 					updateSedimentEnergySlope(*currentRiverReachProperties, overallMethods);
 					currentRiverReachMethods->calculateTau();
 					currentRiverReachMethods->calculateActiveWidth(sedimentFlowMethods);
-					(*(*currentFlowMethod)).updateChangeRateDependingParameters(*currentRiverReachProperties);
+					costModelForRiverReachMethods.addMeasuredCost(i,startTime);
 				}
-
-			} while ( currentModifiers->furtherModificationIterationNecessary(parameters) );
-
-#if defined SEDFLOWPARALLEL
-			//TODO Delete this debugging line.
-			std::cout << "OMP RegularRiverSystemMethods::calculateAndModifyChangeRates_6" << std::endl << std::endl;
-#endif
-			#pragma omp parallel for private(currentRiverReachProperties)
-			for(int i = 0; i < parameters.regularRiverSystemProperties.cellProperties.size(); ++i)
-			{
-				currentRiverReachProperties = &(parameters.regularRiverSystemProperties.cellProperties[i]);
-				currentModifiers->finalModification(*currentRiverReachProperties);
 			}
-#if defined SEDFLOWPARALLEL
-			//TODO Delete this debugging line.
-			std::cout << "OMP RegularRiverSystemMethods::calculateAndModifyChangeRates_7" << std::endl << std::endl;
-#endif
-			#pragma omp parallel for private(currentRiverReachMethods, currentRiverReachProperties, currentUpstreamProperties)
-			for(int i = 0; i < riverReachMethods.size(); ++i)
+			else
 			{
-				currentRiverReachMethods = &(riverReachMethods[i]);
-				currentRiverReachProperties = currentRiverReachMethods->getPointerToCorrespondingRiverReachProperties();
-				currentUpstreamProperties = (currentRiverReachProperties->getUpstreamCellPointers()).at(0);
-				if(currentUpstreamProperties->isUpstreamMargin())
+				#pragma omp for schedule(dynamic)
+				for(int position = 0; position < numberOfCells; ++position)
 				{
-					updateBedSlope(*currentUpstreamProperties, overallMethods);
-					updateWaterEnergySlope(*currentUpstreamProperties, overallMethods);
-					updateSedimentEnergySlope(*currentUpstreamProperties, overallMethods);
-					RegularRiverReachMethods regularRiverReachMethods = currentRiverReachMethods->getRegularRiverReachMethods();
-					regularRiverReachMethods.calculateTau(*currentUpstreamProperties, overallMethods);
-					regularRiverReachMethods.calculateActiveWidth(*currentUpstreamProperties, sedimentFlowMethods, overallMethods);
+					int i = costModelForCells.getIndexForForwardLoop(position);
+					double startTime = costModelForCells.startMeasurement();
+					currentRiverReachProperties = &(cellProperties[i]);
+					double calculationStartTime = StageProfiler::startSection();
+					(*(*currentFlowMethod)).calculateChangeRate(*currentRiverReachProperties);
+					StageProfiler::finishSection(currentSection, calculationStartTime);
+#if defined SEDFLOWPARALLEL
+					costModelForCells.addMeasuredCost(i,startTime);
+				}
+				#pragma omp for schedule(dynamic)
+				for(int position = 0; position < numberOfCells; ++position)
+				{
+					int i = costModelForCells.getIndexForForwardLoop(position);
+					double startTime = costModelForCells.startMeasurement();
+					currentRiverReachProperties = &(cellProperties[i]);
+#endif
+					double handDownStartTime = StageProfiler::startSection();
+					(*(*currentFlowMethod)).handDownChangeRate(*currentRiverReachProperties);
+					StageProfiler::finishSection(currentSection, handDownStartTime);
+					(*(*currentFlowMethod)).updateChangeRateDependingParameters(*currentRiverReachProperties);
+					costModelForCells.addMeasuredCost(i,startTime);
 				}
-				updateBedSlope(*currentRiverReachProperties, overallMethods);
-				updateWaterEnergySlope(*currentRiverReachProperties, overallMethods);
-				updateSedimentEnergySlope(*currentRiverReachProperties, overallMethods);
-				currentRiverReachMethods->calculateTau();
-				currentRiverReachMethods->calculateActiveWidth(sedimentFlowMethods);
 			}
 		}
-		else
+	}
+	delete sedimentFlowMethodsAsFlowTypeMethods;
+}
+
+void RegularRiverSystemMethods::updateBedSlopeAndOtherParameters(int riverReachMethodsID, const OverallMethods& overallMethods)
+{
+	double startTime = costModelForRiverReachMethods.startMeasurement();
+	RiverReachMethods* currentRiverReachMethods = &(riverReachMethods[riverReachMethodsID]);
+	RiverReachProperties* currentRiverReachProperties = currentRiverReachMethods->getPointerToCorrespondingRiverReachProperties();
+	RiverReachProperties* currentUpstreamProperties = (currentRiverReachProperties->getUpstreamCellPointers()).at(0);
+	updateBedSlope(*currentRiverReachProperties, overallMethods);
+	flowMethods.updateOtherParameters(*currentRiverReachProperties);
+	if(currentUpstreamProperties->isUpstreamMargin())
+	{
+		updateBedSlope(*currentUpstreamProperties, overallMethods);
+		flowMethods.updateOtherParameters(*currentUpstreamProperties);
+	}
+	costModelForRiverReachMethods.addMeasuredCost(riverReachMethodsID,startTime);
+}
+
+void RegularRiverSystemMethods::determineDownstreamDistanceSchedule(const RiverSystemProperties& parameters)
+{
+	const std::vector<RiverReachProperties>& cellProperties = parameters.regularRiverSystemProperties.cellProperties;
+	const RiverReachProperties* firstCell = &(cellProperties.front());
+	int numberOfCells = cellProperties.size();
+
+	//The distance of a cell is the number of steps to the downstream margin. It is determined by following the downstream pointers until a cell with known distance is reached.
+	std::vector<int> downstreamDistanceOfCell (numberOfCells, -1);
+	std::vector<int> cellIDsWithUnknownDistance;
+	for(int cellID = 0; cellID < numberOfCells; ++cellID)
+	{
+		const RiverReachProperties* currentCell = &(cellProperties[cellID]);
+		while( downstreamDistanceOfCell[ (currentCell - firstCell) ] < 0 )
 		{
-#if defined SEDFLOWPARALLEL
-			//TODO Delete this debugging line.
-			std::cout << "OMP RegularRiverSystemMethods::calculateAndModifyChangeRates_8" << std::endl << std::endl;
-#endif
-			#pragma omp parallel for private(currentRiverReachProperties)
-			for(int i = 0; i < parameters.regularRiverSystemProperties.cellProperties.size(); ++i)
+			cellIDsWithUnknownDistance.push_back( static_cast<int>(currentCell - firstCell) );
+			if( static_cast<int>(cellIDsWithUnknownDistance.size()) > numberOfCells )
 			{
-				currentRiverReachProperties = &(parameters.regularRiverSystemProperties.cellProperties[i]);
-				(*(*currentFlowMethod)).calculateChangeRate(*currentRiverReachProperties);
-#if defined SEDFLOWPARALLEL
+				const char *const cyclicNetworkErrorMessage = "RegularRiverSystemMethods: The river network contains a cycle.";
+				throw(cyclicNetworkErrorMessage);
 			}
-			#pragma omp parallel for private(currentRiverReachProperties)
-			for(int i = 0; i < parameters.regularRiverSystemProperties.cellProperties.size(); ++i)
+			if( currentCell->getDownstreamCellPointer() == NULL )
 			{
-				currentRiverReachProperties = &(parameters.regularRiverSystemProperties.cellProperties[i]);
-#endif
-				(*(*currentFlowMethod)).handDownChangeRate(*currentRiverReachProperties);
-				(*(*currentFlowMethod)).updateChangeRateDependingParameters(*currentRiverReachProperties);
+				downstreamDistanceOfCell[ (currentCell - firstCell) ] = 0;
+				cellIDsWithUnknownDistance.pop_back();
 			}
+			else { currentCell = currentCell->getDownstreamCellPointer(); }
 		}
+		int currentDistance = downstreamDistanceOfCell[ (currentCell - firstCell) ];
+		for(std::vector<int>::const_reverse_iterator currentCellID = cellIDsWithUnknownDistance.rbegin(); currentCellID < cellIDsWithUnknownDistance.rend(); ++currentCellID)
+			{ downstreamDistanceOfCell[*currentCellID] = ++currentDistance; }
+		cellIDsWithUnknownDistance.clear();
 	}
-	delete sedimentFlowMethodsAsFlowTypeMethods;
+
+	std::vector< std::vector<int> > riverReachMethodsIDsPerDistance;
+	int numberOfRiverReachMethods = riverReachMethods.size();
+	for(int riverReachMethodsID = 0; riverReachMethodsID < numberOfRiverReachMethods; ++riverReachMethodsID)
+	{
+		int currentDistance = downstreamDistanceOfCell[ (riverReachMethods[riverReachMethodsID].getPointerToCorrespondingRiverReachProperties() - firstCell) ];
+		if( currentDistance >= static_cast<int>(riverReachMethodsIDsPerDistance.size()) ) { riverReachMethodsIDsPerDistance.resize( (currentDistance + 1) ); }
+		riverReachMethodsIDsPerDistance[currentDistance].push_back(riverReachMethodsID);
+	}
+	//Distances without any riverReachMethods (e.g. the downstream margin itself) would only cost a barrier.
+	riverReachMethodsIDsPerDownstreamDistance.clear();
+	for(std::vector< std::vector<int> >::const_iterator currentDistance = riverReachMethodsIDsPerDistance.begin(); currentDistance < riverReachMethodsIDsPerDistance.end(); ++currentDistance)
+		{ if( !(currentDistance->empty()) ) { riverReachMethodsIDsPerDownstreamDistance.push_back(*currentDistance); } }
+
+	numberOfRiverReachMethodsInDownstreamDistanceSchedule = numberOfRiverReachMethods;
 }
 
 double RegularRiverSystemMethods::calculateTimeStep(const RiverSystemProperties& parameters)
@@ -266,22 +368,152 @@ double RegularRiverSystemMethods::calculateTimeStep(const RiverSystemProperties&
 	return flowMethods.calculateTimeStep(parameters);
 }
 
+void RegularRiverSystemMethods::determineBranchSchedule(const RiverSystemProperties& parameters)
+{
+	const std::vector<RiverReachProperties>& cellProperties = parameters.regularRiverSystemProperties.cellProperties;
+	const RiverReachProperties* firstCell = &(cellProperties.front());
+	int numberOfCells = cellProperties.size();
+
+	cellIDsPerBranch.clear();
+	joiningUpstreamCellIDsPerBranch.clear();
+	branchIDsPerTopologicalLevel.clear();
+
+	//A branch starts at each reach which has not exactly one upstream reach and continues downstream as long as the next reach has exactly one upstream reach.
+	std::vector<int> branchIDOfCell (numberOfCells, -1);
+	std::vector<RiverReachProperties*> currentUpstreamCellPointers;
+	for(int cellID = 0; cellID < numberOfCells; ++cellID)
+	{
+		currentUpstreamCellPointers = cellProperties[cellID].getUpstreamCellPointers();
+		if( currentUpstreamCellPointers.size() != 1 )
+		{
+			std::vector<int> currentBranch;
+			std::vector<int> joiningUpstreamCellIDs;
+			for(std::vector<RiverReachProperties*>::const_iterator currentUpstreamCellPointer = currentUpstreamCellPointers.begin(); currentUpstreamCellPointer < currentUpstreamCellPointers.end(); ++currentUpstreamCellPointer)
+				{ joiningUpstreamCellIDs.push_back( static_cast<int>((*currentUpstreamCellPointer) - firstCell) ); }
+			std::sort(joiningUpstreamCellIDs.begin(),joiningUpstreamCellIDs.end());
+
+			const RiverReachProperties* currentCell = &(cellProperties[cellID]);
+			do
+			{
+				currentBranch.push_back( static_cast<int>(currentCell - firstCell) );
+				branchIDOfCell[currentBranch.back()] = cellIDsPerBranch.size();
+				currentCell = currentCell->getDownstreamCellPointer();
+			} while ( currentCell != NULL && (currentCell->getUpstreamCellPointers()).size() == 1 );
+
+			cellIDsPerBranch.push_back(currentBranch);
+			joiningUpstreamCellIDsPerBranch.push_back(joiningUpstreamCellIDs);
+		}
+	}
+
+	if( std::find(branchIDOfCell.begin(),branchIDOfCell.end(),-1) != branchIDOfCell.end() )
+	{
+		const char *const unassignedCellErrorMessage = "RegularRiverSystemMethods: Not all reaches could be assigned to a branch of the river network.";
+		throw(unassignedCellErrorMessage);
+	}
+
+	//The topological level of a branch is one above the highest level of the branches joining at its upstream end.
+	int numberOfBranches = cellIDsPerBranch.size();
+	std::vector<int> topologicalLevelOfBranch (numberOfBranches, -1);
+	int numberOfUnassignedBranches = numberOfBranches;
+	int highestTopologicalLevel = -1;
+	while( numberOfUnassignedBranches > 0 )
+	{
+		int previousNumberOfUnassignedBranches = numberOfUnassignedBranches;
+		for(int branchID = 0; branchID < numberOfBranches; ++branchID)
+		{
+			if( topologicalLevelOfBranch[branchID] < 0 )
+			{
+				int currentLevel = 0;
+				bool allUpstreamBranchesAssigned = true;
+				for(std::vector<int>::const_iterator currentUpstreamCellID = joiningUpstreamCellIDsPerBranch[branchID].begin(); currentUpstreamCellID < joiningUpstreamCellIDsPerBranch[branchID].end(); ++currentUpstreamCellID)
+				{
+					int upstreamLevel = topologicalLevelOfBranch[ branchIDOfCell[*currentUpstreamCellID] ];
+					if( upstreamLevel < 0 ) { allUpstreamBranchesAssigned = false; break; }
+					currentLevel = std::max( currentLevel, (upstreamLevel + 1) );
+				}
+				if( allUpstreamBranchesAssigned )
+				{
+					topologicalLevelOfBranch[branchID] = currentLevel;
+					highestTopologicalLevel = std::max( highestTopologicalLevel, currentLevel );
+					--numberOfUnassignedBranches;
+				}
+			}
+		}
+		if( numberOfUnassignedBranches == previousNumberOfUnassignedBranches )
+		{
+			const char *const cyclicNetworkErrorMessage = "RegularRiverSystemMethods: The river network contains a cycle.";
+			throw(cyclicNetworkErrorMessage);
+		}
+	}
+
+	//Within each level the longest branches are handed out to the threads first.
+	std::vector< std::vector< std::pair<int,int> > > lengthsAndBranchIDsPerTopologicalLevel ( (highestTopologicalLevel + 1) );
+	for(int branchID = 0; branchID < numberOfBranches; ++branchID)
+		{ lengthsAndBranchIDsPerTopologicalLevel[ topologicalLevelOfBranch[branchID] ].push_back( std::make_pair( static_cast<int>(cellIDsPerBranch[branchID].size()), branchID ) ); }
+	branchIDsPerTopologicalLevel.resize( (highestTopologicalLevel + 1) );
+	for(int level = 0; level <= highestTopologicalLevel; ++level)
+	{
+		std::stable_sort(lengthsAndBranchIDsPerTopologicalLevel[level].begin(),lengthsAndBranchIDsPerTopologicalLevel[level].end(),std::greater< std::pair<int,int> >());
+		for(std::vector< std::pair<int,int> >::const_iterator currentLengthAndBranchID = lengthsAndBranchIDsPerTopologicalLevel[level].begin(); currentLengthAndBranchID < lengthsAndBranchIDsPerTopologicalLevel[level].end(); ++currentLengthAndBranchID)
+			{ branchIDsPerTopologicalLevel[level].push_back(currentLengthAndBranchID->second); }
+	}
+
+	numberOfCellsInBranchSchedule = numberOfCells;
+}
+
 void RegularRiverSystemMethods::calculateAndHandDownChanges(RiverSystemProperties& parameters)
 {
 	double currentTimeStepLength = parameters.overallParameters.getCurrentTimeStepLengthInSeconds();
+	std::vector<RiverReachProperties>& cellProperties = parameters.regularRiverSystemProperties.cellProperties;
+
+	if( numberOfCellsInBranchSchedule != static_cast<int>(cellProperties.size()) ) { determineBranchSchedule(parameters); }
+	costModelForCells.adaptToNumberOfItems(cellProperties.size());
+
+	std::vector<int>* currentBranch;
+	std::vector<int>* currentJoiningUpstreamCellIDs;
+	RiverReachProperties* currentRiverReachProperties;
 
-	//The serial execution of calculateChanges is done on purpose, as ImplicitKinematicWave::calculateChange depends on a serial execution.
-	for(std::vector<RiverReachProperties>::iterator currentRiverReachPropertiesIterator = parameters.regularRiverSystemProperties.cellProperties.begin(); currentRiverReachPropertiesIterator < parameters.regularRiverSystemProperties.cellProperties.end(); ++currentRiverReachPropertiesIterator)
+	//ImplicitKinematicWave::calculateChange depends on the results of the upstream reaches.
+	//Therefore the branches are treated level by level, while the reaches within a branch are treated in downstream order.
+	for(std::vector< std::vector<int> >::const_iterator currentLevel = branchIDsPerTopologicalLevel.begin(); currentLevel < branchIDsPerTopologicalLevel.end(); ++currentLevel)
 	{
-		flowMethods.calculateChanges(*currentRiverReachPropertiesIterator,currentTimeStepLength);
+		#pragma omp parallel for private(currentBranch) schedule(dynamic)
+		for(int i = 0; i < static_cast<int>(currentLevel->size()); ++i)
+		{
+			currentBranch = &(cellIDsPerBranch[ (*currentLevel)[i] ]);
+			for(std::vector<int>::const_iterator currentCellID = currentBranch->begin(); currentCellID < currentBranch->end(); ++currentCellID)
+			{
+				double startTime = costModelForCells.startMeasurement();
+				flowMethods.calculateChanges(cellProperties[*currentCellID],currentTimeStepLength);
+				costModelForCells.addMeasuredCost(*currentCellID,startTime);
+			}
+		}
 	}
 
-	//This serial execution of handDownChanges after the complete execution of calculateChanges is done on purpose.
+	//handDownChanges is executed after the complete execution of calculateChanges on purpose.
 	//If calculateChanges and handDownChanges were executed in the same loop, the calc method would overwrite the the deposition which has been defined by the handDown method of the previous cell.
-	//handDownChanges needs to be executed serial, since the deposition is handed downward and so the execution for single reach depends on the previous execution for the upstream reach.
-	for(std::vector<RiverReachProperties>::iterator currentRiverReachPropertiesIterator = parameters.regularRiverSystemProperties.cellProperties.begin(); currentRiverReachPropertiesIterator < parameters.regularRiverSystemProperties.cellProperties.end(); ++currentRiverReachPropertiesIterator)
+	//The deposition is handed downward and so the execution for single reach depends on the previous execution for the upstream reaches.
+	//The last reach of a branch hands down into the first reach of another branch. This confluence join is done by the downstream branch
+	//in the order of ascending cellIDs, so that parallel branches never write to the same reach and the results equal the ones of a serial execution.
+	for(std::vector< std::vector<int> >::const_iterator currentLevel = branchIDsPerTopologicalLevel.begin(); currentLevel < branchIDsPerTopologicalLevel.end(); ++currentLevel)
 	{
-		flowMethods.handDownChanges(*currentRiverReachPropertiesIterator);
+		#pragma omp parallel for private(currentBranch, currentJoiningUpstreamCellIDs, currentRiverReachProperties) schedule(dynamic)
+		for(int i = 0; i < static_cast<int>(currentLevel->size()); ++i)
+		{
+			currentBranch = &(cellIDsPerBranch[ (*currentLevel)[i] ]);
+			currentJoiningUpstreamCellIDs = &(joiningUpstreamCellIDsPerBranch[ (*currentLevel)[i] ]);
+			for(std::vector<int>::const_iterator currentCellID = currentJoiningUpstreamCellIDs->begin(); currentCellID < currentJoiningUpstreamCellIDs->end(); ++currentCellID)
+				{ flowMethods.handDownChanges(cellProperties[*currentCellID]); }
+			for(std::vector<int>::const_iterator currentCellID = currentBranch->begin(); currentCellID < currentBranch->end(); ++currentCellID)
+			{
+				currentRiverReachProperties = &(cellProperties[*currentCellID]);
+				//The last reach of a branch is handed down by the joining downstream branch unless it is the downstream margin.
+				if( currentCellID == (currentBranch->end()-1) && currentRiverReachProperties->getDownstreamCellPointer() != NULL ) { break; }
+				double startTime = costModelForCells.startMeasurement();
+				flowMethods.handDownChanges(*currentRiverReachProperties);
+				costModelForCells.addMeasuredCost(*currentCellID,startTime);
+			}
+		}
 	}
 }
 
@@ -292,28 +524,47 @@ void RegularRiverSystemMethods::performAdditionalReachActions()
 	//TODO Delete this debugging line.
 	std::cout << "OMP RegularRiverSystemMethods::performAdditionalReachActions" << std::endl << std::endl;
 #endif
-	#pragma omp parallel for private(currentRiverReachMethods)
-	for(int i = 0; i < riverReachMethods.size(); ++i)
+	costModelForRiverReachMethods.adaptToNumberOfItems(riverReachMethods.size());
+	#pragma omp parallel for private(currentRiverReachMethods) schedule(dynamic)
+	for(int position = 0; position < riverReachMethods.size(); ++position)
 	{
+		int i = costModelForRiverReachMethods.getIndexForForwardLoop(position);
+		double startTime = costModelForRiverReachMethods.startMeasurement();
 		currentRiverReachMethods = &(riverReachMethods[i]);
 		(*currentRiverReachMethods).performAdditionalRiverReachActions();
+		costModelForRiverReachMethods.addMeasuredCost(i,startTime);
 	}
 }
 
 void RegularRiverSystemMethods::applyChanges(RiverSystemProperties& parameters)
 {
+	std::vector<RiverReachProperties>& cellProperties = parameters.regularRiverSystemProperties.cellProperties;
+
+	if( numberOfCellsInBranchSchedule != static_cast<int>(cellProperties.size()) ) { determineBranchSchedule(parameters); }
+	costModelForCells.adaptToNumberOfItems(cellProperties.size());
+
+	std::vector<int>* currentBranch;
 	RiverReachProperties* currentRiverReachProperties;
-#if defined SEDFLOWPARALLEL
-	//TODO Delete this debugging line.
-	std::cout << "OMP RegularRiverSystemMethods::applyChanges" << std::endl << std::endl;
-#endif
-	#pragma omp parallel for private(currentRiverReachProperties)
-	for(int i = 0; i < parameters.regularRiverSystemProperties.cellProperties.size(); ++i)
+
+	//UniformDischarge::applyChange takes over the already updated discharges of the upstream reaches.
+	//Therefore the branches are treated level by level, while the reaches within a branch are treated in downstream order.
+	for(std::vector< std::vector<int> >::const_iterator currentLevel = branchIDsPerTopologicalLevel.begin(); currentLevel < branchIDsPerTopologicalLevel.end(); ++currentLevel)
 	{
-		currentRiverReachProperties = &(parameters.regularRiverSystemProperties.cellProperties[i]);
-		if( !(currentRiverReachProperties->isMargin()) )
+		#pragma omp parallel for private(currentBranch, currentRiverReachProperties) schedule(dynamic)
+		for(int i = 0; i < static_cast<int>(currentLevel->size()); ++i)
 		{
-			flowMethods.applyChanges((*currentRiverReachProperties));
+			currentBranch = &(cellIDsPerBranch[ (*currentLevel)[i] ]);
+			for(std::vector<int>::const_iterator currentCellID = currentBranch->begin(); currentCellID < currentBranch->end(); ++currentCellID)
+			{
+				currentRiverReachProperties = &(cellProperties[*currentCellID]);
+				if( !(currentRiverReachProperties->isMargin()) )
+				{
+					double startTime = costModelForCells.startMeasurement();
+					flowMethods.applyChanges((*currentRiverReachProperties));
+					currentRiverReachProperties->markAsModified();
+					costModelForCells.addMeasuredCost(*currentCellID,startTime);
+				}
+			}
 		}
 	}
 }
@@ -338,76 +589,49 @@ void RegularRiverSystemMethods::updateAdditionalRiverReachProperties()
 	//TODO Delete this debugging line.
 	std::cout << "OMP RegularRiverSystemMethods::updateAdditionalRiverReachProperties" << std::endl << std::endl;
 #endif
-	#pragma omp parallel for private(currentRiverReachMethods)
-	for(int i = 0; i < riverReachMethods.size(); ++i)
+	costModelForRiverReachMethods.adaptToNumberOfItems(riverReachMethods.size());
+	#pragma omp parallel for private(currentRiverReachMethods) schedule(dynamic)
+	for(int position = 0; position < riverReachMethods.size(); ++position)
 	{
+		int i = costModelForRiverReachMethods.getIndexForForwardLoop(position);
+		double startTime = costModelForRiverReachMethods.startMeasurement();
 		currentRiverReachMethods = &(riverReachMethods[i]);
-		(*currentRiverReachMethods).updateAdditionalRiverReachProperties(); }
+		(*currentRiverReachMethods).updateAdditionalRiverReachProperties();
+		costModelForRiverReachMethods.addMeasuredCost(i,startTime);
+	}
 }
 
 void RegularRiverSystemMethods::updateBedSlopes(RiverSystemProperties& parameters, const OverallMethods& overallMethods)const
 {
-	parameters.regularRiverSystemProperties.setSingleRegularParameter(CombinerVariables::bedslope, overallMethods.bedSlopeCalculationMethod->calculate(parameters) );
-
-	if( overallMethods.waterEnergySlopeCalculationMethod->dependsOnBedslope() )
-	{
-		this->updateWaterEnergySlopes(parameters,overallMethods);
-	}
-
-	if( overallMethods.sedimentEnergySlopeCalculationMethod->dependsOnBedslope() )
-	{
-		this->updateSedimentEnergySlopes(parameters,overallMethods);
-	}
+	for(std::vector<RiverReachProperties>::iterator currentRiverReachProperties = parameters.regularRiverSystemProperties.cellProperties.begin(); currentRiverReachProperties < parameters.regularRiverSystemProperties.cellProperties.end(); ++currentRiverReachProperties)
+		{ overallMethods.updateBedslope(*currentRiverReachProperties); }
 }
 
 void RegularRiverSystemMethods::updateBedSlope(RiverReachProperties& riverReachProperties, const OverallMethods& overallMethods)const
 {
-	riverReachProperties.regularRiverReachProperties.bedslope = overallMethods.bedSlopeCalculationMethod->calculate(riverReachProperties);
-
-	if( overallMethods.waterEnergySlopeCalculationMethod->dependsOnBedslope() )
-	{
-		this->updateWaterEnergySlope(riverReachProperties,overallMethods);
-	}
-
-	if( overallMethods.sedimentEnergySlopeCalculationMethod->dependsOnBedslope() )
-	{
-		this->updateSedimentEnergySlope(riverReachProperties,overallMethods);
-	}
+	overallMethods.updateBedslope(riverReachProperties);
 }
 
 void RegularRiverSystemMethods::updateWaterEnergySlopes(RiverSystemProperties& parameters, const OverallMethods& overallMethods)const
 {
-	parameters.regularRiverSystemProperties.setSingleRegularParameter(CombinerVariables::waterEnergyslope, overallMethods.waterEnergySlopeCalculationMethod->calculate(parameters) );
-
-	if( overallMethods.sedimentEnergySlopeCalculationMethod->dependsOnWaterEnergyslope() )
-	{
-		this->updateSedimentEnergySlopes(parameters,overallMethods);
-	}
-
+	for(std::vector<RiverReachProperties>::iterator currentRiverReachProperties = parameters.regularRiverSystemProperties.cellProperties.begin(); currentRiverReachProperties < parameters.regularRiverSystemProperties.cellProperties.end(); ++currentRiverReachProperties)
+		{ overallMethods.updateWaterEnergyslope(*currentRiverReachProperties); }
 }
 
 void RegularRiverSystemMethods::updateWaterEnergySlope(RiverReachProperties& riverReachProperties, const OverallMethods& overallMethods)const
 {
-	riverReachProperties.regularRiverReachProperties.waterEnergyslope = overallMethods.waterEnergySlopeCalculationMethod->calculate(riverReachProperties);
-
-	if( overallMethods.sedimentEnergySlopeCalculationMethod->dependsOnWaterEnergyslope() )
-	{
-		this->updateSedimentEnergySlope(riverReachProperties,overallMethods);
-	}
+	overallMethods.updateWaterEnergyslope(riverReachProperties);
 }
 
 void RegularRiverSystemMethods::updateSedimentEnergySlopes(RiverSystemProperties& parameters, const OverallMethods& overallMethods)const
 {
-	std::pair< std::vector<double>, std::vector<double> > reducedAndUnreducedSlopes = overallMethods.sedimentEnergySlopeCalculationMethod->calculateReducedAndUnreducedSedimentEnergyslope(parameters);
-	parameters.regularRiverSystemProperties.setSingleRegularParameter(CombinerVariables::sedimentEnergyslope, reducedAndUnreducedSlopes.first );
-	parameters.regularRiverSystemProperties.setSingleRegularParameter(CombinerVariables::unreducedSedimentEnergyslope, reducedAndUnreducedSlopes.second );
+	for(std::vector<RiverReachProperties>::iterator currentRiverReachProperties = parameters.regularRiverSystemProperties.cellProperties.begin(); currentRiverReachProperties < parameters.regularRiverSystemProperties.cellProperties.end(); ++currentRiverReachProperties)
+		{ overallMethods.updateSedimentEnergyslope(*currentRiverReachProperties); }
 }
 
 void RegularRiverSystemMethods::updateSedimentEnergySlope(RiverReachProperties& riverReachProperties, const OverallMethods& overallMethods)const
 {
-	std::pair<double,double> reducedAndUnreducedSlope =  overallMethods.sedimentEnergySlopeCalculationMethod->calculateReducedAndUnreducedSedimentEnergyslope(riverReachProperties);
-	riverReachProperties.regularRiverReachProperties.sedimentEnergyslope = reducedAndUnreducedSlope.first;
-	riverReachProperties.regularRiverReachProperties.unreducedSedimentEnergyslope = reducedAndUnreducedSlope.second;
+	overallMethods.updateSedimentEnergyslope(riverReachProperties);
 }
 
 void RegularRiverSystemMethods::updateTaus()const
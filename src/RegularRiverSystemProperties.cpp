@@ -203,6 +203,7 @@ RegularRiverSystemProperties::RegularRiverSystemProperties(const std::vector<Riv
 				double furtherDownstreamElevation = furtherDownstreamCell->regularRiverReachProperties.elevation;
 				slope = (downstreamElevation - furtherDownstreamElevation) / localLength;
 				currentRiverReachProperties->regularRiverReachProperties.elevation = downstreamElevation + ( slope * localLength );
+				currentRiverReachProperties->markAsModified();
 			}
 
 			if( currentRiverReachProperties->isDownstreamMargin() )
@@ -225,6 +226,7 @@ RegularRiverSystemProperties::RegularRiverSystemProperties(const std::vector<Riv
 				currentRiverReachProperties->regularRiverReachProperties.elevation = upstreamElevation - ( slope * localLength );
 				currentRiverReachProperties->regularRiverReachProperties.sillOccurence = false;
 				currentRiverReachProperties->regularRiverReachProperties.sillTopEdgeElevation = -9999.0;
+				currentRiverReachProperties->markAsModified();
 			}
 		}
 	}
@@ -306,15 +308,45 @@ ConstructionVariables RegularRiverSystemProperties::createConstructionVariables(
 		}
 	}
 	result.labelledObjects["cellProperties"] = constructionVariablesVector;
+	constructionVariablesVector.clear();
+	for(std::vector<RiverReachProperties>::const_iterator iterator = cellProperties.begin(); iterator < cellProperties.end(); ++iterator)
+	{
+		if( (*iterator).isMargin() ) { constructionVariablesVector.push_back( (*iterator).regularRiverReachProperties.createConstructionVariables() ); }
+	}
+	result.labelledObjects["regularPropertiesOfMarginCells"] = constructionVariablesVector;
 	return result;
 }
 
 void RegularRiverSystemProperties::setRegularCellParameters (const RegularRiverReachProperties& newParameters, int cellID)
 {
 	(this->cellProperties.at(cellID)).regularRiverReachProperties = newParameters;
+	(this->cellProperties.at(cellID)).markAsModified();
 
 }
 
+void RegularRiverSystemProperties::setRegularPropertiesOfMarginCells (const std::vector<RegularRiverReachProperties>& newParameters)
+{
+	std::vector<RegularRiverReachProperties>::size_type numberOfMarginCells = 0;
+	for(std::vector<RiverReachProperties>::const_iterator iterator = cellProperties.begin(); iterator < cellProperties.end(); ++iterator)
+		{ if( (*iterator).isMargin() ) { ++numberOfMarginCells; } }
+	if( newParameters.size() != numberOfMarginCells )
+	{
+		const char *const errorMessage = "The number of given properties does not match the number of margin cells. (RegularRiverSystemProperties)";
+		throw(errorMessage);
+	}
+
+	std::vector<RegularRiverReachProperties>::const_iterator currentNewParameters = newParameters.begin();
+	for(std::vector<RiverReachProperties>::iterator iterator = cellProperties.begin(); iterator < cellProperties.end(); ++iterator)
+	{
+		if( (*iterator).isMargin() )
+		{
+			(*iterator).regularRiverReachProperties = *currentNewParameters;
+			(*iterator).markAsModified();
+			++currentNewParameters;
+		}
+	}
+}
+
 std::vector<double> RegularRiverSystemProperties::extractSingleRegularParameter (CombinerVariables::TypesOfRegularRiverReachProperties parameter) const
 {
 	std::vector<double> result;
@@ -430,6 +462,8 @@ void RegularRiverSystemProperties::setSingleRegularParameter (CombinerVariables:
 		const char *const defaultErrorMessage = "Parameter update has not been defined for this Regular River Parameter";
 		throw (defaultErrorMessage);
 	}
+	for(std::vector<RiverReachProperties>::iterator currentRiverReachProperties = this->cellProperties.begin(); currentRiverReachProperties < this->cellProperties.end(); ++currentRiverReachProperties)
+		{ (*currentRiverReachProperties).markAsModified(); }
 }
 
 RiverReachProperties* RegularRiverSystemProperties::getReachPropertiesPointerCorrespondingToUserCellID (int userCellID)
@@ -118,7 +118,7 @@ Grains RickenmannBedloadCapacityBasedOnTheta::calculate(const RiverReachProperti
 				}
 			#endif
 
-			double thetaCriticalNotCorrectedForHiding = thresholdCalculationMethod->calculate(riverReachProperties.regularRiverReachProperties);
+			double thetaCriticalNotCorrectedForHiding = thresholdCalculationMethod->calculate(riverReachProperties.regularRiverReachProperties,riverReachProperties.getCellID());
 			if(thetaCriticalBasedOnConstantSred)
 			{
 				CombinerVariables::TypesOfGradientCalculationMethod typeOfSedimentEnergyslopeCalculationMethod = overallMethods.sedimentEnergySlopeCalculationMethod->getTypeOfGradientCalculationMethod();
@@ -110,7 +110,7 @@ Grains RickenmannBedloadCapacityBasedOnThetaNonFractional::calculate(const River
 			if(useOnePointOneAsExponentForFroudeNumber)
 				{ froudeFactor = pow(froudeFactor,1.1); }
 
-			double thetaCritical = thresholdCalculationMethod->calculate(riverReachProperties.regularRiverReachProperties);
+			double thetaCritical = thresholdCalculationMethod->calculate(riverReachProperties.regularRiverReachProperties,riverReachProperties.getCellID());
 			if(thetaCriticalBasedOnConstantSred)
 			{
 				CombinerVariables::TypesOfGradientCalculationMethod typeOfSedimentEnergyslopeCalculationMethod = overallMethods.sedimentEnergySlopeCalculationMethod->getTypeOfGradientCalculationMethod();
@@ -80,11 +80,13 @@ void RiverReachMethods::calculateActiveWidth(const SedimentFlowMethods& sediment
 void RiverReachMethods::updateAdditionalRiverReachProperties()
 {
 	additionalRiverReachMethods.updateAdditionalRiverReachProperties(riverReachProperties->regularRiverReachProperties, riverReachProperties->geometricalChannelBehaviour, regularRiverReachMethods);
+	if( !(additionalRiverReachMethods.isEmpty()) ) { riverReachProperties->markAsModified(); }
 }
 
 void RiverReachMethods::performAdditionalRiverReachActions()
 {
 	additionalRiverReachMethods.performTypeSpecificActions(*riverReachProperties, regularRiverReachMethods);
+	if( !(additionalRiverReachMethods.isEmpty()) ) { riverReachProperties->markAsModified(); }
 }
 
 
@@ -31,6 +31,7 @@ namespace SedFlow {
 RiverReachProperties::RiverReachProperties(int cellID, RegularRiverReachProperties regularRiverReachProperties,	AdditionalRiverReachProperties additionalRiverPropertiesAndMethods, const StrataSorting* strataSorting, const GeometricalChannelBehaviour* geometricalChannelBehaviour, const SillProperties* sillProperties, OverallParameters* overallParameters):
 	cellID(cellID),
 	downstreamCellID((cellID+1)),
+	downstreamCellPointer(NULL),
 	upstreamMarginCell(false),
 	downstreamMarginCell(false),
 	regularRiverReachProperties(regularRiverReachProperties),
@@ -41,6 +42,8 @@ RiverReachProperties::RiverReachProperties(int cellID, RegularRiverReachProperti
 	mapFromRealCellIDtoUserCellID(NULL),
 	overallParameters(overallParameters)
 {
+	this->resetModificationCounters();
+
 	if( cellID == std::numeric_limits<int>::min() )
 	{
 		const char *const errorMessage = "One of the cellID's (large negative number) is not allowed.";
@@ -51,6 +54,7 @@ RiverReachProperties::RiverReachProperties(int cellID, RegularRiverReachProperti
 RiverReachProperties::RiverReachProperties(int cellID, int downstreamCellID, RegularRiverReachProperties regularRiverReachProperties, AdditionalRiverReachProperties additionalRiverPropertiesAndMethods, const StrataSorting* strataSorting, const GeometricalChannelBehaviour* geometricalChannelBehaviour, const SillProperties* sillProperties, OverallParameters* overallParameters):
 	cellID(cellID),
 	downstreamCellID(downstreamCellID),
+	downstreamCellPointer(NULL),
 	upstreamMarginCell(false),
 	downstreamMarginCell(false),
 
@@ -62,6 +66,8 @@ RiverReachProperties::RiverReachProperties(int cellID, int downstreamCellID, Reg
 	mapFromRealCellIDtoUserCellID(NULL),
 	overallParameters(overallParameters)
 {
+	this->resetModificationCounters();
+
 	if( cellID >= downstreamCellID )
 	{
 		const char *const firstErrorMessage = "Cell-IDs have to be ordered from upstream to downstream.";
@@ -77,6 +83,7 @@ RiverReachProperties::RiverReachProperties(int cellID, int downstreamCellID, Reg
 RiverReachProperties::RiverReachProperties(const RiverReachProperties& toCopy):
 	cellID(toCopy.cellID),
 	downstreamCellID(toCopy.downstreamCellID),
+	downstreamCellPointer(NULL),
 	numberOfUpstreamCells(toCopy.numberOfUpstreamCells),
 	upstreamCellIDs(toCopy.upstreamCellIDs),
 	upstreamMarginCell(toCopy.upstreamMarginCell),
@@ -89,6 +96,8 @@ RiverReachProperties::RiverReachProperties(const RiverReachProperties& toCopy):
 	mapFromRealCellIDtoUserCellID(NULL),
 	overallParameters(toCopy.overallParameters)
 {
+	this->resetModificationCounters();
+
 	if(!(this->downstreamMarginCell))
 		{ if( cellID >= downstreamCellID )
 			{
@@ -126,6 +135,15 @@ RiverReachProperties::~RiverReachProperties()
 	delete sillProperties;
 }
 
+unsigned long RiverReachProperties::getNeighbourhoodModificationCount() const
+{
+	unsigned long result = modificationCounter;
+	if( downstreamCellPointer != NULL ) { result += downstreamCellPointer->modificationCounter; }
+	for(std::vector<RiverReachProperties*>::const_iterator currentUpstreamCellPointer = upstreamCellPointers.begin(); currentUpstreamCellPointer < upstreamCellPointers.end(); ++currentUpstreamCellPointer)
+		{ result += (*currentUpstreamCellPointer)->modificationCounter; }
+	return result;
+}
+
 RiverReachProperties RiverReachProperties::createCopyAsUpstreamMarginCell(const RiverReachProperties& toCopy)
 {
 	RiverReachProperties result = RiverReachProperties(toCopy);
@@ -0,0 +1,351 @@
+/*
+ * RootFinderDiagnostics.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "RootFinderDiagnostics.h"
+#include "RiverReachProperties.h"
+#include "OverallParameters.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <cstring>
+#include <functional>
+
+#if defined SEDFLOWPARALLEL
+#include <omp.h>
+#endif
+
+namespace SedFlow {
+
+bool RootFinderDiagnostics::enabled = false;
+std::vector<RootFinderDiagnostics::ThreadCounters> RootFinderDiagnostics::countersPerThread;
+std::vector<RootFinderDiagnostics::ThreadStatistics> RootFinderDiagnostics::statisticsPerThread;
+std::string RootFinderDiagnostics::replayFileName;
+std::ofstream RootFinderDiagnostics::replayFile;
+long RootFinderDiagnostics::numberOfRecordedFailures = 0;
+const int RootFinderDiagnostics::numberOfSampledFunctionValues = 41;
+
+void RootFinderDiagnostics::enable(const std::string& replayFileName)
+{
+	int numberOfThreads = 1;
+#if defined SEDFLOWPARALLEL
+	numberOfThreads = omp_get_max_threads();
+#endif
+	countersPerThread.assign(numberOfThreads, ThreadCounters());
+	statisticsPerThread.assign(numberOfThreads, ThreadStatistics());
+	numberOfRecordedFailures = 0;
+	RootFinderDiagnostics::replayFileName = replayFileName;
+	if( !replayFileName.empty() )
+	{
+		replayFile.open(replayFileName.c_str(), std::ios::out | std::ios::trunc);
+		if( !replayFile.is_open() )
+		{
+			std::ostringstream oStringStream;
+			oStringStream << "The root finder replay file " << replayFileName << " could not be opened." << std::flush;
+			char* tmpChar = new char [(oStringStream.str()).size()+1];
+			std::strcpy(tmpChar, (oStringStream.str()).c_str());
+			const char *const errorMessage = tmpChar;
+			throw(errorMessage);
+		}
+		replayFile << "# Failed root searches of sedFlow. Each failure lists its inputs followed by a table of flow depths and function values." << std::endl;
+	}
+	enabled = true;
+}
+
+int RootFinderDiagnostics::getThread()
+{
+#if defined SEDFLOWPARALLEL
+	int thread = omp_get_thread_num();
+	if( thread < static_cast<int>(countersPerThread.size()) ) { return thread; }
+	return -1;
+#else
+	return 0;
+#endif
+}
+
+int RootFinderDiagnostics::getUserCellID(const RiverReachProperties* riverReachProperties)
+{
+	if( riverReachProperties == NULL ) { return -1; }
+	if( riverReachProperties->isUpstreamMargin() ) { return riverReachProperties->getDownstreamUserCellID(); }
+	return riverReachProperties->getUserCellID();
+}
+
+void RootFinderDiagnostics::countIterationInternally()
+{
+	int thread = getThread();
+	if( thread >= 0 ) { ++(countersPerThread[thread].counters.iterations); }
+}
+
+void RootFinderDiagnostics::countBracketExpansionInternally()
+{
+	int thread = getThread();
+	if( thread >= 0 ) { ++(countersPerThread[thread].counters.bracketExpansions); }
+}
+
+RootFinderDiagnostics::Counters RootFinderDiagnostics::getCountersInternally()
+{
+	int thread = getThread();
+	if( thread < 0 ) { return Counters(); }
+	return countersPerThread[thread].counters;
+}
+
+void RootFinderDiagnostics::completeSolveInternally(CallSites callSite, const RiverReachProperties* riverReachProperties, const Counters& startCounters, double residual, int maximumNumberOfIterations)
+{
+	int thread = getThread();
+	if( thread < 0 ) { return; }
+	const Counters& currentCounters = countersPerThread[thread].counters;
+	long iterations = currentCounters.iterations - startCounters.iterations;
+	long bracketExpansions = currentCounters.bracketExpansions - startCounters.bracketExpansions;
+
+	CallSiteStatistics& statistics = statisticsPerThread[thread].callSites[callSite];
+	++(statistics.calls);
+	statistics.maximumNumberOfIterations = std::max(statistics.maximumNumberOfIterations, maximumNumberOfIterations);
+	statistics.sumOfResiduals += residual;
+	statistics.maximumResidual = std::max(statistics.maximumResidual, residual);
+	if( iterations >= static_cast<long>(statistics.iterationHistogram.size()) ) { statistics.iterationHistogram.resize((iterations + 1), 0); }
+	++(statistics.iterationHistogram[iterations]);
+	if( bracketExpansions >= static_cast<long>(statistics.bracketExpansionHistogram.size()) ) { statistics.bracketExpansionHistogram.resize((bracketExpansions + 1), 0); }
+	++(statistics.bracketExpansionHistogram[bracketExpansions]);
+
+	ReachStatistics& reachStatistics = statistics.reaches[ getUserCellID(riverReachProperties) ];
+	++(reachStatistics.calls);
+	reachStatistics.iterations += iterations;
+	reachStatistics.maximumIterations = std::max(reachStatistics.maximumIterations, iterations);
+	reachStatistics.maximumResidual = std::max(reachStatistics.maximumResidual, residual);
+}
+
+std::vector<double> RootFinderDiagnostics::getSamplingPositions(double expectedValue, std::pair<double,double> brackets)
+{
+	std::vector<double> result;
+	result.reserve(numberOfSampledFunctionValues);
+	if( brackets.first == brackets.first && brackets.second == brackets.second )
+	{
+		// Linear sampling between the brackets including both brackets.
+		double increment = (brackets.second - brackets.first) / static_cast<double>(numberOfSampledFunctionValues - 1);
+		for(int i = 0; i < numberOfSampledFunctionValues; ++i) { result.push_back( (brackets.first + (i * increment)) ); }
+	}
+	else
+	{
+		// Logarithmic sampling around the expected value covering the range searched for brackets, i.e. halving and doubling.
+		int halfNumberOfSamples = numberOfSampledFunctionValues / 2;
+		for(int i = -halfNumberOfSamples; i <= halfNumberOfSamples; ++i) { result.push_back( (expectedValue * pow(2.0, static_cast<double>(i))) ); }
+	}
+	return result;
+}
+
+void RootFinderDiagnostics::writeFailure(CallSites callSite, const RiverReachProperties* riverReachProperties, const char* errorMessage, const std::string& typeOfNumericRootFinder, double expectedValue, std::pair<double,double> brackets, double accuracyForTerminatingIteration, int maximumNumberOfIterations, const Parameters& parameters, const std::vector< std::pair<double,double> >& sampledFunctionValues)
+{
+	int thread = getThread();
+	if( thread >= 0 ) { ++(statisticsPerThread[thread].callSites[callSite].failures); }
+	if( replayFileName.empty() ) { return; }
+
+	#pragma omp critical(RootFinderDiagnosticsReplayFile)
+	{
+		++numberOfRecordedFailures;
+		replayFile << std::setprecision(17);
+		replayFile << std::endl << "failure " << numberOfRecordedFailures << std::endl;
+		replayFile << "callSite " << callSiteToString(callSite) << std::endl;
+		replayFile << "errorMessage " << ( (errorMessage == NULL) ? "unknown" : errorMessage ) << std::endl;
+		replayFile << "numericRootFinder " << typeOfNumericRootFinder << std::endl;
+		replayFile << "userCellID " << getUserCellID(riverReachProperties) << std::endl;
+		if( riverReachProperties != NULL ) { replayFile << "elapsedSeconds " << (riverReachProperties->getOverallParameters())->getElapsedSeconds() << std::endl; }
+		replayFile << "expectedValue " << expectedValue << std::endl;
+		replayFile << "firstBracket " << brackets.first << std::endl;
+		replayFile << "secondBracket " << brackets.second << std::endl;
+		replayFile << "accuracyForTerminatingIteration " << accuracyForTerminatingIteration << std::endl;
+		replayFile << "maximumNumberOfIterations " << maximumNumberOfIterations << std::endl;
+		for(Parameters::const_iterator currentParameter = parameters.begin(); currentParameter < parameters.end(); ++currentParameter)
+			{ replayFile << currentParameter->first << " " << currentParameter->second << std::endl; }
+		replayFile << "functionValues " << sampledFunctionValues.size() << std::endl;
+		for(std::vector< std::pair<double,double> >::const_iterator currentValue = sampledFunctionValues.begin(); currentValue < sampledFunctionValues.end(); ++currentValue)
+			{ replayFile << currentValue->first << "\t" << currentValue->second << std::endl; }
+		replayFile << std::flush;
+		std::cerr << "The inputs of the failed root search have been written to the replay file " << replayFileName << " as failure " << numberOfRecordedFailures << "." << std::endl;
+	}
+}
+
+void RootFinderDiagnostics::addParameter(Parameters& parameters, const std::string& name, double value)
+{
+	std::ostringstream oStringStream;
+	oStringStream << std::setprecision(17) << value;
+	parameters.push_back( std::make_pair(name, oStringStream.str()) );
+}
+
+void RootFinderDiagnostics::addParameters(Parameters& parameters, const std::string& prefix, const ConstructionVariables& constructionVariables)
+{
+	parameters.push_back( std::make_pair(prefix, constructionVariables.realisationType) );
+	for(std::map< std::string, std::vector<double> >::const_iterator currentMapEntry = constructionVariables.labelledDoubles.begin(); currentMapEntry != constructionVariables.labelledDoubles.end(); ++currentMapEntry)
+	{
+		std::ostringstream oStringStream;
+		oStringStream << std::setprecision(17);
+		for(std::vector<double>::const_iterator currentValue = currentMapEntry->second.begin(); currentValue < currentMapEntry->second.end(); ++currentValue)
+		{
+			if( currentValue != currentMapEntry->second.begin() ) { oStringStream << " "; }
+			oStringStream << *currentValue;
+		}
+		parameters.push_back( std::make_pair((prefix + "." + currentMapEntry->first), oStringStream.str()) );
+	}
+}
+
+const char* RootFinderDiagnostics::callSiteToString(CallSites callSite)
+{
+	switch(callSite)
+	{
+	case FlowDepthForGivenDischarge: return "flow depth for given discharge";
+	case FlowDepthForGivenFroudeNumber: return "flow depth for given Froude number";
+	case FlowDepthForMinimumHydraulicSlope: return "flow depth for minimum hydraulic slope";
+	default:
+		const char *const errorMessage = "Invalid root finder call site";
+		throw(errorMessage);
+	}
+}
+
+std::vector<long> RootFinderDiagnostics::sumUpHistograms(CallSites callSite, bool iterations)
+{
+	std::vector<long> result;
+	for(int thread = 0; thread < static_cast<int>(countersPerThread.size()); ++thread)
+	{
+		const CallSiteStatistics& statistics = statisticsPerThread[thread].callSites[callSite];
+		const std::vector<long>& histogram = iterations ? statistics.iterationHistogram : statistics.bracketExpansionHistogram;
+		if( histogram.size() > result.size() ) { result.resize(histogram.size(), 0); }
+		for(int i = 0; i < static_cast<int>(histogram.size()); ++i) { result[i] += histogram[i]; }
+	}
+	return result;
+}
+
+long RootFinderDiagnostics::getPercentile(const std::vector<long>& histogram, double percentileRank)
+{
+	long numberOfValues = 0;
+	for(std::vector<long>::const_iterator currentBin = histogram.begin(); currentBin < histogram.end(); ++currentBin) { numberOfValues += *currentBin; }
+	long cumulatedValues = 0;
+	for(int i = 0; i < static_cast<int>(histogram.size()); ++i)
+	{
+		cumulatedValues += histogram[i];
+		if( cumulatedValues > 0 && cumulatedValues >= (percentileRank * numberOfValues) ) { return i; }
+	}
+	return 0;
+}
+
+double RootFinderDiagnostics::getMean(const std::vector<long>& histogram)
+{
+	long numberOfValues = 0;
+	double sum = 0.0;
+	for(int i = 0; i < static_cast<int>(histogram.size()); ++i)
+	{
+		numberOfValues += histogram[i];
+		sum += static_cast<double>(i) * histogram[i];
+	}
+	return ( (numberOfValues > 0) ? (sum / numberOfValues) : 0.0 );
+}
+
+void RootFinderDiagnostics::printSummary(std::ostream& outputStream, int numberOfReportedReaches)
+{
+	if( !enabled ) { return; }
+
+	std::ios_base::fmtflags previousFlags = outputStream.flags();
+	std::streamsize previousPrecision = outputStream.precision();
+	outputStream << std::endl << "Convergence of the numeric root finders:" << std::endl;
+	outputStream << std::left << std::setw(40) << "Call site" << std::right << std::setw(12) << "calls" << std::setw(10) << "failures" << std::setw(8) << "allowed"
+		<< std::setw(8) << "mean" << std::setw(6) << "p50" << std::setw(6) << "p90" << std::setw(6) << "p99" << std::setw(6) << "max"
+		<< std::setw(16) << "mean brackets" << std::setw(14) << "max brackets" << std::setw(15) << "mean residual" << std::setw(15) << "max residual" << std::endl;
+
+	for(int callSite = 0; callSite < NumberOfCallSites; ++callSite)
+	{
+		long calls = 0;
+		long failures = 0;
+		int maximumNumberOfIterations = 0;
+		double sumOfResiduals = 0.0;
+		double maximumResidual = 0.0;
+		for(int thread = 0; thread < static_cast<int>(countersPerThread.size()); ++thread)
+		{
+			const CallSiteStatistics& statistics = statisticsPerThread[thread].callSites[callSite];
+			calls += statistics.calls;
+			failures += statistics.failures;
+			maximumNumberOfIterations = std::max(maximumNumberOfIterations, statistics.maximumNumberOfIterations);
+			sumOfResiduals += statistics.sumOfResiduals;
+			maximumResidual = std::max(maximumResidual, statistics.maximumResidual);
+		}
+		if( calls == 0 && failures == 0 ) { continue; }
+		std::vector<long> iterationHistogram = sumUpHistograms(static_cast<CallSites>(callSite), true);
+		std::vector<long> bracketExpansionHistogram = sumUpHistograms(static_cast<CallSites>(callSite), false);
+
+		outputStream << std::left << std::setw(40) << callSiteToString(static_cast<CallSites>(callSite)) << std::right << std::setw(12) << calls << std::setw(10) << failures << std::setw(8) << maximumNumberOfIterations
+			<< std::fixed << std::setprecision(2) << std::setw(8) << getMean(iterationHistogram) << std::setw(6) << getPercentile(iterationHistogram, 0.5) << std::setw(6) << getPercentile(iterationHistogram, 0.9) << std::setw(6) << getPercentile(iterationHistogram, 0.99) << std::setw(6) << ( iterationHistogram.empty() ? 0 : (iterationHistogram.size() - 1) )
+			<< std::setw(16) << getMean(bracketExpansionHistogram) << std::setw(14) << ( bracketExpansionHistogram.empty() ? 0 : (bracketExpansionHistogram.size() - 1) )
+			<< std::scientific << std::setprecision(3) << std::setw(15) << ( (calls > 0) ? (sumOfResiduals / calls) : 0.0 ) << std::setw(15) << maximumResidual << std::endl;
+	}
+
+	for(int callSite = 0; callSite < NumberOfCallSites; ++callSite)
+	{
+		std::vector<long> iterationHistogram = sumUpHistograms(static_cast<CallSites>(callSite), true);
+		if( iterationHistogram.empty() ) { continue; }
+
+		outputStream << std::endl << "Iterations for " << callSiteToString(static_cast<CallSites>(callSite)) << ":" << std::endl;
+		outputStream << std::right << std::setw(12) << "iterations" << std::setw(14) << "calls" << std::endl;
+		for(int i = 0; i < static_cast<int>(iterationHistogram.size()); ++i)
+		{
+			if( iterationHistogram[i] == 0 ) { continue; }
+			outputStream << std::setw(12) << i << std::setw(14) << iterationHistogram[i] << std::endl;
+		}
+
+		std::map<int,ReachStatistics> reaches;
+		for(int thread = 0; thread < static_cast<int>(countersPerThread.size()); ++thread)
+		{
+			const std::map<int,ReachStatistics>& reachesOfThread = statisticsPerThread[thread].callSites[callSite].reaches;
+			for(std::map<int,ReachStatistics>::const_iterator currentReach = reachesOfThread.begin(); currentReach != reachesOfThread.end(); ++currentReach)
+			{
+				ReachStatistics& reachStatistics = reaches[currentReach->first];
+				reachStatistics.calls += currentReach->second.calls;
+				reachStatistics.iterations += currentReach->second.iterations;
+				reachStatistics.maximumIterations = std::max(reachStatistics.maximumIterations, currentReach->second.maximumIterations);
+				reachStatistics.maximumResidual = std::max(reachStatistics.maximumResidual, currentReach->second.maximumResidual);
+			}
+		}
+		std::vector< std::pair<long,int> > iterationsAndReaches;
+		iterationsAndReaches.reserve(reaches.size());
+		for(std::map<int,ReachStatistics>::const_iterator currentReach = reaches.begin(); currentReach != reaches.end(); ++currentReach)
+			{ iterationsAndReaches.push_back( std::make_pair(currentReach->second.iterations, currentReach->first) ); }
+		std::sort(iterationsAndReaches.begin(), iterationsAndReaches.end(), std::greater< std::pair<long,int> >());
+
+		outputStream << "Reaches with most iterations (" << std::min(numberOfReportedReaches, static_cast<int>(iterationsAndReaches.size())) << " of " << iterationsAndReaches.size() << "):" << std::endl;
+		outputStream << std::left << std::setw(12) << "Reach" << std::right << std::setw(14) << "calls" << std::setw(14) << "iterations" << std::setw(8) << "mean" << std::setw(6) << "max" << std::setw(15) << "max residual" << std::endl;
+		for(int i = 0; i < std::min(numberOfReportedReaches, static_cast<int>(iterationsAndReaches.size())); ++i)
+		{
+			const ReachStatistics& reachStatistics = reaches[iterationsAndReaches[i].second];
+			outputStream << std::left << std::setw(12);
+			if( iterationsAndReaches[i].second < 0 ) { outputStream << "none"; }
+			else { outputStream << iterationsAndReaches[i].second; }
+			outputStream << std::right << std::setw(14) << reachStatistics.calls << std::setw(14) << reachStatistics.iterations
+				<< std::fixed << std::setprecision(2) << std::setw(8) << ( static_cast<double>(reachStatistics.iterations) / reachStatistics.calls ) << std::setw(6) << reachStatistics.maximumIterations
+				<< std::scientific << std::setprecision(3) << std::setw(15) << reachStatistics.maximumResidual << std::endl;
+		}
+	}
+	if( numberOfRecordedFailures > 0 ) { outputStream << std::endl << numberOfRecordedFailures << " failed root searches have been written to the replay file " << replayFileName << "." << std::endl; }
+	outputStream << std::endl;
+	outputStream.flags(previousFlags);
+	outputStream.precision(previousPrecision);
+}
+
+}
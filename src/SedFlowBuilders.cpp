@@ -24,6 +24,8 @@
 
 #include "SedFlowBuilders.h"
 
+#include <sstream>
+
 namespace SedFlow {
 
 void* SedFlowBuilders::generalBuilder (const ConstructionVariables& constructionVariables, const HighestOrderStructuresPointers& highestOrderStructuresPointers)
@@ -694,7 +696,18 @@ OutputMethods* SedFlowBuilders::outputMethodsBuilder (const ConstructionVariable
 			{ singleOutputMethodTypes.push_back( static_cast<OutputMethodType*>( SedFlowBuilders::generalBuilder( (*currentInnerIterator), highestOrderStructuresPointers) ) ); }
 	}
 
-	OutputMethods* result = new OutputMethods(singleOutputMethodTypes);
+	bool asynchronousOutput = false;
+	std::map< std::string, std::vector<bool> >::const_iterator tempBoolIterator = constructionVariables.labelledBools.find("asynchronousOutput");
+	if(tempBoolIterator != constructionVariables.labelledBools.end() ) { asynchronousOutput = tempBoolIterator->second.at(0); }
+
+	int asynchronousOutputQueueLength = 16;
+	std::map< std::string, std::vector<int> >::const_iterator tempIntIterator = constructionVariables.labelledInts.find("asynchronousOutputQueueLength");
+	if(tempIntIterator != constructionVariables.labelledInts.end() ) { asynchronousOutputQueueLength = tempIntIterator->second.at(0); }
+
+	OutputMethods* result = new OutputMethods(singleOutputMethodTypes,asynchronousOutput,asynchronousOutputQueueLength);
+
+	std::map< std::string, std::vector<double> >::const_iterator tempDoubleIterator = constructionVariables.labelledDoubles.find("timesOfLastOutput");
+	if(tempDoubleIterator != constructionVariables.labelledDoubles.end() ) { result->setTimesOfLastOutput(tempDoubleIterator->second); }
 
 	while(!(singleOutputMethodTypes.empty()))
 	{
@@ -748,7 +761,17 @@ RegularRiverSystemProperties* SedFlowBuilders::regularRiverSystemPropertiesBuild
 		for(std::vector<void*>::const_iterator currentVoidPointer = ((*tempObjectsIterator).second).begin(); currentVoidPointer < ((*tempObjectsIterator).second).end(); ++currentVoidPointer)
 			{ cellProperties.push_back( *(static_cast<RiverReachProperties*>(*currentVoidPointer)) ); }
 	}
-	return ( new RegularRiverSystemProperties(cellProperties) );
+	RegularRiverSystemProperties* result = new RegularRiverSystemProperties(cellProperties);
+
+	tempObjectsIterator = labelledObjects.find("regularPropertiesOfMarginCells");
+	if( tempObjectsIterator != labelledObjects.end() && !( ((*tempObjectsIterator).second).empty() ) )
+	{
+		std::vector<RegularRiverReachProperties> regularPropertiesOfMarginCells;
+		for(std::vector<void*>::const_iterator currentVoidPointer = ((*tempObjectsIterator).second).begin(); currentVoidPointer < ((*tempObjectsIterator).second).end(); ++currentVoidPointer)
+			{ regularPropertiesOfMarginCells.push_back( *(static_cast<RegularRiverReachProperties*>(*currentVoidPointer)) ); }
+		result->setRegularPropertiesOfMarginCells(regularPropertiesOfMarginCells);
+	}
+	return result;
 }
 
 RiverReachProperties* SedFlowBuilders::riverReachPropertiesBuilder(const ConstructionVariables& constructionVariables, const HighestOrderStructuresPointers& highestOrderStructuresPointers, std::map< std::string, std::vector<void*> > labelledObjects)
@@ -1444,6 +1467,7 @@ TimeSeriesEntry* SedFlowBuilders::timeSeriesEntryBuilder(const ConstructionVaria
 TimeSeries* SedFlowBuilders::timeSeriesBuilder(const ConstructionVariables& constructionVariables, const HighestOrderStructuresPointers& highestOrderStructuresPointers, std::map< std::string, std::vector<void*> > labelledObjects)
 {
 	std::map< std::string, std::vector<int> >::const_iterator tempIntIterator;
+	std::map< std::string, std::vector<double> >::const_iterator tempDoubleIterator;
 	std::map< std::string, std::vector<bool> >::const_iterator tempBoolIterator;
 	std::map< std::string, std::vector<std::string> >::const_iterator tempStringIterator;
 	std::map< std::string, std::vector<void*> >::const_iterator tempObjectsIterator;
@@ -1512,7 +1536,64 @@ TimeSeries* SedFlowBuilders::timeSeriesBuilder(const ConstructionVariables& cons
 		finalInsteadOfInitialAdding = ((*tempBoolIterator).second).at(0);
 	}
 
-	return (new TimeSeries(userCellID,margin,property,timeSeries,surplusInsteadOfAbsoluteValues,finalInsteadOfInitialAdding,highestOrderStructuresPointers.riverSystemProperties->regularRiverSystemProperties) );
+	TimeSeries* result = new TimeSeries(userCellID,margin,property,timeSeries,surplusInsteadOfAbsoluteValues,finalInsteadOfInitialAdding,highestOrderStructuresPointers.riverSystemProperties->regularRiverSystemProperties);
+
+	// The buffered entries may be followed by further entries, which are read from a spreadsheet during the simulation.
+	tempStringIterator = constructionVariables.labelledStrings.find("streamingSourceFile");
+	if(tempStringIterator != constructionVariables.labelledStrings.end() )
+	{
+		std::string streamingSourceFile = ((*tempStringIterator).second).at(0);
+
+		tempStringIterator = constructionVariables.labelledStrings.find("elapsedSecondsColumn");
+		std::string elapsedSecondsColumn;
+		if(tempStringIterator == constructionVariables.labelledStrings.end() ) { elapsedSecondsColumn = "ElapsedSeconds"; }
+		else { elapsedSecondsColumn = ((*tempStringIterator).second).at(0); }
+
+		tempStringIterator = constructionVariables.labelledStrings.find("valueColumn");
+		std::string valueColumn;
+		if(tempStringIterator == constructionVariables.labelledStrings.end() )
+		{
+			delete result;
+			const char *const valueColumnErrorMessage = "The variable valueColumn is needed for the construction of a TimeSeries with streamingSourceFile.";
+			throw(valueColumnErrorMessage);
+		}
+		else { valueColumn = ((*tempStringIterator).second).at(0); }
+
+		tempDoubleIterator = constructionVariables.labelledDoubles.find("valueFactor");
+		double valueFactor;
+		if(tempDoubleIterator == constructionVariables.labelledDoubles.end() ) { valueFactor = 1.0; }
+		else { valueFactor = ((*tempDoubleIterator).second).at(0); }
+
+		tempIntIterator = constructionVariables.labelledInts.find("numberOfEntriesPerStreamingWindow");
+		int numberOfEntriesPerStreamingWindow;
+		if(tempIntIterator == constructionVariables.labelledInts.end() ) { numberOfEntriesPerStreamingWindow = 64; }
+		else { numberOfEntriesPerStreamingWindow = ((*tempIntIterator).second).at(0); }
+
+		tempStringIterator = constructionVariables.labelledStrings.find("streamingSourceOffset");
+		std::streamoff streamingSourceOffset = -1;
+		if(tempStringIterator != constructionVariables.labelledStrings.end() )
+		{
+			std::istringstream iStringStream (((*tempStringIterator).second).at(0));
+			iStringStream >> streamingSourceOffset;
+		}
+
+		tempObjectsIterator = labelledObjects.find("streamingGrainsBase");
+		if(tempObjectsIterator == labelledObjects.end() )
+		{
+			StreamingTimeSeriesSource streamingSource (streamingSourceFile,elapsedSecondsColumn,valueColumn,valueFactor,numberOfEntriesPerStreamingWindow);
+			streamingSource.setOffsetOfNextRow(streamingSourceOffset);
+			result->setStreamingSource(streamingSource);
+		}
+		else
+		{
+			Grains streamingGrainsBase = *( static_cast<Grains*>( ((*tempObjectsIterator).second).at(0) ) );
+			StreamingTimeSeriesSource streamingSource (streamingSourceFile,elapsedSecondsColumn,valueColumn,valueFactor,streamingGrainsBase,numberOfEntriesPerStreamingWindow);
+			streamingSource.setOffsetOfNextRow(streamingSourceOffset);
+			result->setStreamingSource(streamingSource);
+		}
+	}
+
+	return result;
 }
 
 }
@@ -37,9 +37,8 @@
 
 namespace SedFlow {
 
-SedFlowCore::SedFlowCore(const char* inputXMLfile)
+ConstructionVariables SedFlowCore::readInputXMLFile(const char* inputXMLfile, const std::string& setupCacheFolder)
 {
-
 	std::string fullPath = StringTools::getFullPath(inputXMLfile);
 
 	if( !(StringTools::fileExists(fullPath)) )
@@ -71,10 +70,23 @@ SedFlowCore::SedFlowCore(const char* inputXMLfile)
 
 	UserInputReader* userInputReader = SedFlowInterfaceRealisationBuilders::userInputReaderBuilder( doc.first_child().name() );
 
+	SetupCache::setCacheFolder(setupCacheFolder);
 	ConstructionVariables sedFlowConstructionVariables = userInputReader->convertUserInputXMLIntoConstructionVariables(doc,fullPath);
 
 	delete userInputReader;
 
+	return sedFlowConstructionVariables;
+}
+
+SedFlowCore::SedFlowCore(const char* inputFile, bool restartFromCheckpoint, const std::string& setupCacheFolder)
+{
+	ConstructionVariables sedFlowConstructionVariables;
+	if(restartFromCheckpoint)
+	{
+		sedFlowConstructionVariables = OutputBinaryCheckpoint::readCheckpointFile(inputFile);
+		OutputBinaryCheckpoint::truncateAppendedOutputFilesToCheckpoint(sedFlowConstructionVariables);
+	}
+	else { sedFlowConstructionVariables = readInputXMLFile(inputFile, setupCacheFolder); }
 
 	std::map< std::string, std::vector<ConstructionVariables> >::const_iterator tempObjectsIterator;
 	HighestOrderStructuresPointers highestOrderStructuresPointers = HighestOrderStructuresPointers();
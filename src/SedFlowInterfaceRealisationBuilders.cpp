@@ -33,8 +33,13 @@
 
 //Types of Output Method
 #include "OutputVerbatimTranslationOfConstructionVariablesToXML.h"
+#include "OutputBinaryCheckpoint.h"
+#include "OutputSharedMemoryMonitor.h"
 #include "OutputRegularRiverReachProperties.h"
 #include "OutputRegularRiverReachPropertiesForVisualInterpretation.h"
+#include "OutputRegularRiverReachPropertiesBinary.h"
+#include "OutputRegularRiverReachPropertiesNetCDF.h"
+#include "OutputRegularRiverReachPropertiesDeltaEncoded.h"
 #include "OutputAccumulatedBedloadTransport.h"
 #include "OutputSimulationSetup.h"
 
@@ -248,10 +253,23 @@ OutputMethodType* SedFlowInterfaceRealisationBuilders::outputMethodTypeBuilder(c
 	}
 	else { precisionForOutput = intMapIterator->second.at(0); }
 
+	CombinerVariables::TypesOfOutputFlushPolicy flushPolicy = CombinerVariables::FlushAfterWallSeconds;
+	stringMapIterator = constructionVariables.labelledStrings.find("flushPolicy");
+	if(stringMapIterator != constructionVariables.labelledStrings.end() ) { flushPolicy = CombinerVariables::stringToTypeOfOutputFlushPolicy( stringMapIterator->second.at(0) ); }
+
+	int numberOfLinesBetweenFlushes = 100;
+	intMapIterator = constructionVariables.labelledInts.find("numberOfLinesBetweenFlushes");
+	if(intMapIterator != constructionVariables.labelledInts.end() ) { numberOfLinesBetweenFlushes = intMapIterator->second.at(0); }
+
+	double wallSecondsBetweenFlushes = 10.0;
+	doubleMapIterator = constructionVariables.labelledDoubles.find("wallSecondsBetweenFlushes");
+	if(doubleMapIterator != constructionVariables.labelledDoubles.end() ) { wallSecondsBetweenFlushes = doubleMapIterator->second.at(0); }
+
 	bool overwriteFiles;
 	int fileID;
 	int numberOfFileIDDigits;
 	std::vector<CombinerVariables::TypesOfRegularRiverReachProperties> regularRiverReachPropertiesForOutput;
+	std::vector<CombinerVariables::TypesOfOutputAggregation> aggregationsForOutput;
 	std::vector<int> userCellIDsForOutput;
 	bool outputTimeStepLength, outputInitialValues, printUpstreamMargins, printDownstreamMargin;
 	int horizontalBarLength;
@@ -265,6 +283,9 @@ OutputMethodType* SedFlowInterfaceRealisationBuilders::outputMethodTypeBuilder(c
 	std::vector<CombinerVariables::TypesOfCombinersAndInterfaces> setupPropertiesForOutput;
 	bool printSimulationID, printSimulationName, printStartingTime, printModelVersion;
 	std::string simulationID, simulationName;
+	int numberOfRowsPerChunk = 64;
+	double changeTolerance = 0.0;
+	int numberOfTimeStepsBetweenPublications, numberOfSlots;
 
 	switch (typeOfOutputMethod)
 	{
@@ -289,7 +310,50 @@ OutputMethodType* SedFlowInterfaceRealisationBuilders::outputMethodTypeBuilder(c
 		result = new OutputVerbatimTranslationOfConstructionVariablesToXML(overwriteFiles,fileID,numberOfFileIDDigits,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods);
 		break;
 
+	case CombinerVariables::OutputBinaryCheckpoint:
+		result = new OutputBinaryCheckpoint(path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods);
+		break;
+
+	case CombinerVariables::OutputSharedMemoryMonitor:
+		stringMapIterator = constructionVariables.labelledStrings.find("regularRiverReachPropertiesForOutput");
+		if(stringMapIterator == constructionVariables.labelledStrings.end() )
+		{
+			const char *const regularRiverReachPropertiesForOutputErrorMessage = "The variable regularRiverReachPropertiesForOutput is needed for the construction of the OutputMethodType OutputSharedMemoryMonitor";
+			throw(regularRiverReachPropertiesForOutputErrorMessage);
+		}
+		else
+		{
+			for(std::vector<std::string>::const_iterator currentString = stringMapIterator->second.begin(); currentString < stringMapIterator->second.end(); ++currentString)
+					{ regularRiverReachPropertiesForOutput.push_back( CombinerVariables::stringToTypeOfRegularRiverReachProperties( *currentString ) );	}
+		}
+		intMapIterator = constructionVariables.labelledInts.find("reachIDsForOutput");
+		if(intMapIterator == constructionVariables.labelledInts.end() )
+		{
+			const char *const reachIDsForOutputErrorMessage = "The variable reachIDsForOutput is needed for the construction of the OutputMethodType OutputSharedMemoryMonitor";
+			throw(reachIDsForOutputErrorMessage);
+		}
+		else { userCellIDsForOutput = intMapIterator->second; }
+		intMapIterator = constructionVariables.labelledInts.find("numberOfTimeStepsBetweenPublications");
+		if(intMapIterator == constructionVariables.labelledInts.end() )
+		{
+			const char *const numberOfTimeStepsBetweenPublicationsErrorMessage = "The variable numberOfTimeStepsBetweenPublications is needed for the construction of the OutputMethodType OutputSharedMemoryMonitor";
+			throw(numberOfTimeStepsBetweenPublicationsErrorMessage);
+		}
+		else { numberOfTimeStepsBetweenPublications = intMapIterator->second.at(0); }
+		intMapIterator = constructionVariables.labelledInts.find("numberOfSlots");
+		if(intMapIterator == constructionVariables.labelledInts.end() )
+		{
+			const char *const numberOfSlotsErrorMessage = "The variable numberOfSlots is needed for the construction of the OutputMethodType OutputSharedMemoryMonitor";
+			throw(numberOfSlotsErrorMessage);
+		}
+		else { numberOfSlots = intMapIterator->second.at(0); }
+		result = new OutputSharedMemoryMonitor(regularRiverReachPropertiesForOutput,userCellIDsForOutput,numberOfTimeStepsBetweenPublications,numberOfSlots,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods);
+		break;
+
 	case CombinerVariables::OutputRegularRiverReachProperties:
+	case CombinerVariables::OutputRegularRiverReachPropertiesBinary:
+	case CombinerVariables::OutputRegularRiverReachPropertiesNetCDF:
+	case CombinerVariables::OutputRegularRiverReachPropertiesDeltaEncoded:
 		stringMapIterator = constructionVariables.labelledStrings.find("regularRiverReachPropertiesForOutput");
 		if(stringMapIterator == constructionVariables.labelledStrings.end() )
 		{
@@ -303,6 +367,12 @@ OutputMethodType* SedFlowInterfaceRealisationBuilders::outputMethodTypeBuilder(c
 			for(std::vector<std::string>::const_iterator currentString = stringVector.begin(); currentString < stringVector.end(); ++currentString)
 					{ regularRiverReachPropertiesForOutput.push_back( CombinerVariables::stringToTypeOfRegularRiverReachProperties( *currentString ) );	}
 		}
+		stringMapIterator = constructionVariables.labelledStrings.find("aggregationsForOutput");
+		if(stringMapIterator != constructionVariables.labelledStrings.end() )
+		{
+			for(std::vector<std::string>::const_iterator currentString = stringMapIterator->second.begin(); currentString < stringMapIterator->second.end(); ++currentString)
+					{ aggregationsForOutput.push_back( CombinerVariables::stringToTypeOfOutputAggregation( *currentString ) ); }
+		}
 		intMapIterator = constructionVariables.labelledInts.find("reachIDsForOutput");
 		if(intMapIterator == constructionVariables.labelledInts.end() )
 		{
@@ -372,7 +442,32 @@ OutputMethodType* SedFlowInterfaceRealisationBuilders::outputMethodTypeBuilder(c
 			}
 			else { secondaryOutputInterval = doubleMapIterator->second.at(0); }
 		}
-		result = new OutputRegularRiverReachProperties(regularRiverReachPropertiesForOutput,userCellIDsForOutput,outputTimeStepLength,outputInitialValues,printUpstreamMargins,printDownstreamMargin,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,useSecondaryOutputInterval,referenceCellUserCellID,referenceProperty,thresholdToBeExceeded,secondaryOutputInterval,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods);
+		{
+		OutputRegularRiverReachProperties* outputRegularRiverReachProperties;
+		if( typeOfOutputMethod == CombinerVariables::OutputRegularRiverReachPropertiesBinary )
+		{
+			intMapIterator = constructionVariables.labelledInts.find("numberOfRowsPerChunk");
+			if(intMapIterator != constructionVariables.labelledInts.end() ) { numberOfRowsPerChunk = intMapIterator->second.at(0); }
+			outputRegularRiverReachProperties = new OutputRegularRiverReachPropertiesBinary(regularRiverReachPropertiesForOutput,aggregationsForOutput,userCellIDsForOutput,outputTimeStepLength,outputInitialValues,printUpstreamMargins,printDownstreamMargin,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,useSecondaryOutputInterval,referenceCellUserCellID,referenceProperty,thresholdToBeExceeded,secondaryOutputInterval,numberOfRowsPerChunk,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods);
+		}
+		else if( typeOfOutputMethod == CombinerVariables::OutputRegularRiverReachPropertiesNetCDF )
+		{
+			outputRegularRiverReachProperties = new OutputRegularRiverReachPropertiesNetCDF(regularRiverReachPropertiesForOutput,aggregationsForOutput,userCellIDsForOutput,outputTimeStepLength,outputInitialValues,printUpstreamMargins,printDownstreamMargin,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,useSecondaryOutputInterval,referenceCellUserCellID,referenceProperty,thresholdToBeExceeded,secondaryOutputInterval,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods);
+		}
+		else if( typeOfOutputMethod == CombinerVariables::OutputRegularRiverReachPropertiesDeltaEncoded )
+		{
+			doubleMapIterator = constructionVariables.labelledDoubles.find("changeTolerance");
+			if(doubleMapIterator != constructionVariables.labelledDoubles.end() ) { changeTolerance = doubleMapIterator->second.at(0); }
+			outputRegularRiverReachProperties = new OutputRegularRiverReachPropertiesDeltaEncoded(regularRiverReachPropertiesForOutput,aggregationsForOutput,userCellIDsForOutput,outputTimeStepLength,outputInitialValues,printUpstreamMargins,printDownstreamMargin,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,useSecondaryOutputInterval,referenceCellUserCellID,referenceProperty,thresholdToBeExceeded,secondaryOutputInterval,changeTolerance,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods);
+		}
+		else
+		{
+			outputRegularRiverReachProperties = new OutputRegularRiverReachProperties(regularRiverReachPropertiesForOutput,aggregationsForOutput,userCellIDsForOutput,outputTimeStepLength,outputInitialValues,printUpstreamMargins,printDownstreamMargin,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,useSecondaryOutputInterval,referenceCellUserCellID,referenceProperty,thresholdToBeExceeded,secondaryOutputInterval,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods);
+		}
+		doubleMapIterator = constructionVariables.labelledDoubles.find("aggregationState");
+		if(doubleMapIterator != constructionVariables.labelledDoubles.end() ) { outputRegularRiverReachProperties->setAggregationState(doubleMapIterator->second); }
+		result = outputRegularRiverReachProperties;
+		}
 		break;
 
 	case CombinerVariables::OutputRegularRiverReachPropertiesForVisualInterpretation:
@@ -493,7 +588,18 @@ OutputMethodType* SedFlowInterfaceRealisationBuilders::outputMethodTypeBuilder(c
 		}
 		else { outputDetailedFractional = boolMapIterator->second.at(0); }
 
-		result = new OutputAccumulatedBedloadTransport(userCellIDsForOutput,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,outputIncludingPoreVolume,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods,outputDetailedFractional);
+		{
+		OutputAccumulatedBedloadTransport* outputAccumulatedBedloadTransport = new OutputAccumulatedBedloadTransport(userCellIDsForOutput,path,outputFiles,writeLineEachTimeStep,outputInterval,explicitTimesForOutput,precisionForOutput,outputIncludingPoreVolume,highestOrderStructuresPointers.overallParameters,highestOrderStructuresPointers.overallMethods,highestOrderStructuresPointers.riverSystemProperties,highestOrderStructuresPointers.riverSystemMethods,outputDetailedFractional);
+		std::map<std::string, std::vector<void*> >::const_iterator objectMapIterator = labelledObjects.find("accumulatedBedloadTransport");
+		if(objectMapIterator != labelledObjects.end() )
+		{
+			std::vector<Grains> accumulatedBedloadTransport;
+			for(std::vector<void*>::const_iterator currentGrains = objectMapIterator->second.begin(); currentGrains < objectMapIterator->second.end(); ++currentGrains)
+				{ accumulatedBedloadTransport.push_back( *(static_cast<Grains*>(*currentGrains)) ); }
+			outputAccumulatedBedloadTransport->setAccumulatedBedloadTransport(accumulatedBedloadTransport);
+		}
+		result = outputAccumulatedBedloadTransport;
+		}
 		break;
 
 	case CombinerVariables::OutputSimulationSetup:
@@ -571,6 +677,8 @@ OutputMethodType* SedFlowInterfaceRealisationBuilders::outputMethodTypeBuilder(c
 		throw (invalidTypeErrorMessage);
 	}
 
+	result->setFlushPolicy(flushPolicy,numberOfLinesBetweenFlushes,wallSecondsBetweenFlushes);
+
 	return result;
 }
 
@@ -1027,6 +1135,18 @@ StrataSorting* SedFlowInterfaceRealisationBuilders::strataSortingBuilder(const C
 			{
 				result = new TwoLayerWithShearStressBasedUpdate(thresholdCalculationMethod, dynamicBreakUpConditions, usePredefinedBreakUpConditions, layerThickness, dynamic, layerThicknessFactor, referenceGrainSizePercentile);
 			}
+
+			std::map<std::string, std::vector<int> >::const_iterator sublayerCellIDsIterator = constructionVariables.labelledInts.find("cellIDsOfSublayerCompositions");
+			objectMapIterator = labelledObjects.find("sublayerCompositions");
+			std::map<std::string, std::vector<int> >::const_iterator baseDataCellIDsIterator = constructionVariables.labelledInts.find("cellIDsOfBaseDataForSublayerInfluence");
+			doubleMapIterator = constructionVariables.labelledDoubles.find("baseDataForSublayerInfluenceOneAfterAnother");
+			if( (sublayerCellIDsIterator != constructionVariables.labelledInts.end()) && (objectMapIterator != labelledObjects.end()) && (baseDataCellIDsIterator != constructionVariables.labelledInts.end()) && (doubleMapIterator != constructionVariables.labelledDoubles.end()) )
+			{
+				std::vector<Grains> sublayerCompositions;
+				for(std::vector<void*>::const_iterator currentGrains = objectMapIterator->second.begin(); currentGrains < objectMapIterator->second.end(); ++currentGrains)
+					{ sublayerCompositions.push_back( *(static_cast<Grains*>(*currentGrains)) ); }
+				static_cast<TwoLayerWithShearStressBasedUpdate*>(result)->setStoredSublayerData(sublayerCellIDsIterator->second, sublayerCompositions, baseDataCellIDsIterator->second, doubleMapIterator->second);
+			}
 		}
 		break;
 
@@ -1476,6 +1596,9 @@ FlowResistance* SedFlowInterfaceRealisationBuilders::flowResistanceBuilder(const
 		throw (invalidTypeErrorMessage);
 	}
 
+	intMapIterator = constructionVariables.labelledInts.find("everTreatedCellIDs");
+	if(intMapIterator != constructionVariables.labelledInts.end() ) { result->setEverTreatedCellIDs(intMapIterator->second); }
+
 	return result;
 }
 
@@ -2260,7 +2383,23 @@ CalcBedloadVelocity* SedFlowInterfaceRealisationBuilders::calcBedloadVelocityBui
 		}
 		else { estimateThicknessOfMovingSedimentLayer = static_cast<EstimateThicknessOfMovingSedimentLayer*>( objectMapIterator->second.at(0) ); }
 
-		result = new VelocityAsTransportRatePerUnitCrossSectionalArea(estimateThicknessOfMovingSedimentLayer);
+		{
+		std::map<std::string, std::vector<int> >::const_iterator cellIDsIterator = constructionVariables.labelledInts.find("cellIDsOfPreviousErosionRates");
+		std::map<std::string, std::vector<double> >::const_iterator previousErosionRatesIterator = constructionVariables.labelledDoubles.find("previousErosionRates");
+		if( (cellIDsIterator != constructionVariables.labelledInts.end()) && (previousErosionRatesIterator != constructionVariables.labelledDoubles.end()) )
+		{
+			if( cellIDsIterator->second.size() != previousErosionRatesIterator->second.size() )
+			{
+				const char *const previousErosionRatesErrorMessage = "The variables cellIDsOfPreviousErosionRates and previousErosionRates do not match for the CalcBedloadVelocity VelocityAsTransportRatePerUnitCrossSectionalArea.";
+				throw(previousErosionRatesErrorMessage);
+			}
+			std::map<int,double> mapFromCellIDToPreviousErosionRate;
+			for(std::vector<int>::size_type i = 0; i < cellIDsIterator->second.size(); ++i)
+				{ mapFromCellIDToPreviousErosionRate[ cellIDsIterator->second[i] ] = previousErosionRatesIterator->second[i]; }
+			result = new VelocityAsTransportRatePerUnitCrossSectionalArea(estimateThicknessOfMovingSedimentLayer,mapFromCellIDToPreviousErosionRate);
+		}
+		else { result = new VelocityAsTransportRatePerUnitCrossSectionalArea(estimateThicknessOfMovingSedimentLayer); }
+		}
 		break;
 
 	default:
@@ -2524,7 +2663,18 @@ CalcThresholdForInitiationOfBedloadMotion* SedFlowInterfaceRealisationBuilders::
 		}
 		else { betaSpecialValues = doubleMapIterator->second; }
 
-		result = new StochasticThresholdForInitiationOfBedloadMotion(minimumThresholdValue,miu,beta,seed,weightForCurrent,weightForPrevious,weightForPrePrevious,correctionForBedloadWeightAtSteepCounterSlopes,widthsForSpecialValues,miuSpecialValues,betaSpecialValues);
+		StochasticThresholdForInitiationOfBedloadMotion* stochasticThreshold = new StochasticThresholdForInitiationOfBedloadMotion(minimumThresholdValue,miu,beta,seed,weightForCurrent,weightForPrevious,weightForPrePrevious,correctionForBedloadWeightAtSteepCounterSlopes,widthsForSpecialValues,miuSpecialValues,betaSpecialValues);
+
+		intMapIterator = constructionVariables.labelledInts.find("cellIDsOfValues");
+		std::map<std::string, std::vector<double> >::const_iterator activeWidthsIterator = constructionVariables.labelledDoubles.find("activeWidthsOfValues");
+		doubleMapIterator = constructionVariables.labelledDoubles.find("valuesOneAfterAnother");
+		if( (intMapIterator != constructionVariables.labelledInts.end()) && (activeWidthsIterator != constructionVariables.labelledDoubles.end()) && (doubleMapIterator != constructionVariables.labelledDoubles.end()) )
+			{ stochasticThreshold->setValuesForCellIDsAndWidths(intMapIterator->second, activeWidthsIterator->second, doubleMapIterator->second); }
+		doubleMapIterator = constructionVariables.labelledDoubles.find("numberOfDrawnRandomNumbers");
+		if(doubleMapIterator != constructionVariables.labelledDoubles.end() )
+			{ stochasticThreshold->setNumberOfDrawnRandomNumbers(doubleMapIterator->second.at(0)); }
+
+		result = stochasticThreshold;
 		break;
 	}
 
@@ -28,15 +28,11 @@
 #include <stdlib.h>
 #include <algorithm>
 #include <limits>
-#if defined TIMESTEPANALYSIS
-	#include <iostream>
-	#include <sstream>
-	#include <cstring>
-#endif
 
 #include "SedimentFlowTypeMethods.h"
 #include "RiverReachMethods.h"
 #include "FlowTypeMethods.h"
+#include "TimeStepConstraintDiagnostics.h"
 
 namespace SedFlow {
 
@@ -88,14 +84,9 @@ double SedimentFlowTypeMethods::calculateTimeStep (const RiverSystemProperties&
 	double localDepositionAndErosionVolume;
 	double downstreamDepositionAndErosionVolume;
 
-	#if defined TIMESTEPANALYSIS
-		double thresholdForOutputtingTimeSteps = TIMESTEPANALYSIS;
-		std::ostringstream oStringStream;
-	#endif
-
 	double timeStepEntry;
 	const RiverReachProperties* currentRiverReachProperties;
-	#pragma omp parallel for private(currentRiverReachProperties,timeStepEntry,currentDownstreamCellPointer,localLinearConversion,downstreamLinearConversion,bedslopeChangeRate,bedslopeChange,currentBedslope,tempTimeStep,localOverallDepositionRate,localOverallErosionRate,downstreamOverallDepositionRate,downstreamOverallErosionRate,localDepositionAndErosionRate,downstreamDepositionAndErosionRate,localDepositionAndErosion,downstreamDepositionAndErosion,localDepositionAndErosionVolume,downstreamDepositionAndErosionVolume) default(shared)
+	#pragma omp parallel for private(currentRiverReachProperties,timeStepEntry,currentDownstreamCellPointer,currentLocalSedimentVelocity,localLinearConversion,downstreamLinearConversion,bedslopeChangeRate,bedslopeChange,currentBedslope,tempTimeStep,localOverallDepositionRate,localOverallErosionRate,downstreamOverallDepositionRate,downstreamOverallErosionRate,localDepositionAndErosionRate,downstreamDepositionAndErosionRate,localDepositionAndErosion,downstreamDepositionAndErosion,localDepositionAndErosionVolume,downstreamDepositionAndErosionVolume) default(shared)
 	for(int i = 0; i < (riverSystem.regularRiverSystemProperties.cellProperties.size() - 1); ++i)
 	{
 		currentRiverReachProperties = &(riverSystem.regularRiverSystemProperties.cellProperties[i]);
@@ -107,44 +98,7 @@ double SedimentFlowTypeMethods::calculateTimeStep (const RiverSystemProperties&
 			if( currentLocalSedimentVelocity > 0.0 )
 			{
 				timeStepEntry = ( riverSystem.overallParameters.getCourantFriedrichsLewyNumber() * (std::min(((*currentRiverReachProperties).regularRiverReachProperties.length),((*currentDownstreamCellPointer).regularRiverReachProperties.length))) / currentLocalSedimentVelocity );
-				#if defined TIMESTEPANALYSIS
-					if( timeStepEntry < thresholdForOutputtingTimeSteps )
-					{
-						oStringStream.str("");
-						oStringStream.clear();
-						oStringStream << "Time step of " << timeStepEntry << " seconds at ";
-						if(currentRiverReachProperties->isMargin())
-						{
-							if(currentRiverReachProperties->isDownstreamMargin())
-							{
-								oStringStream << "downstream margin";
-							}
-							else
-							{
-								oStringStream << "upstream margin at reach " << currentRiverReachProperties->getDownstreamUserCellID();
-							}
-						}
-						else
-						{
-							oStringStream << "reach " << currentRiverReachProperties->getUserCellID();
-						}
-						oStringStream << " due to SedimentFlowTypeMethods check for Courant-Friedrichs-Lewy." << std::flush;
-						#pragma omp critical
-						{ std::cout << std::endl << "===============================================================" << std::endl << oStringStream.str() << std::endl << std::flush; }
-
-						if(riverSystem.overallParameters.incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum())
-						{
-							oStringStream.str("");
-							oStringStream.clear();
-							oStringStream << "Number of time step length outputs reached its maximum of " << riverSystem.overallParameters.getMaximumNumberOfTimeStepOutputs() << "." << std::flush;
-							char* tmpChar = new char [(oStringStream.str()).size()+1];
-							std::strcpy(tmpChar, (oStringStream.str()).c_str());
-							const char *const maximumNumberOfTimeStepOutputsErrorMessage = tmpChar;
-							#pragma omp critical
-							{ throw(maximumNumberOfTimeStepOutputsErrorMessage); }
-						}
-					}
-				#endif
+				TimeStepConstraintDiagnostics::propose(timeStepEntry, TimeStepConstraintDiagnostics::SedimentCourantFriedrichsLewy, currentRiverReachProperties);
 				#pragma omp critical
 				{ allCalculatedTimeSteps.push_back(timeStepEntry); }
 			}
@@ -154,44 +108,7 @@ double SedimentFlowTypeMethods::calculateTimeStep (const RiverSystemProperties&
 			if( (*currentRiverReachProperties).regularRiverReachProperties.strataPerUnitBedSurface.size() > 1 && ((*currentRiverReachProperties).regularRiverReachProperties.strataPerUnitBedSurface.at(1)).getOverallVolume() > 0.0000001 )
 			{
 				timeStepEntry = currentLocalActiveOverallVolume * maximumFractionOfActiveLayerToBeEroded /  ( (*currentRiverReachProperties).geometricalChannelBehaviour->convertActiveWidthAndOverallSedimentVolumeIncrementIntoSedimentVolumeIncrementPerUnitBedSurface((*currentRiverReachProperties).regularRiverReachProperties.activeWidth, (*currentRiverReachProperties).regularRiverReachProperties.erosionRate)  ).getOverallVolume();
-				#if defined TIMESTEPANALYSIS
-					if( timeStepEntry < thresholdForOutputtingTimeSteps )
-					{
-						oStringStream.str("");
-						oStringStream.clear();
-						oStringStream << "Time step of " << timeStepEntry << " seconds at ";
-						if(currentRiverReachProperties->isMargin())
-						{
-							if(currentRiverReachProperties->isDownstreamMargin())
-							{
-								oStringStream << "downstream margin";
-							}
-							else
-							{
-								oStringStream << "upstream margin at reach " << currentRiverReachProperties->getDownstreamUserCellID();
-							}
-						}
-						else
-						{
-							oStringStream << "reach " << currentRiverReachProperties->getUserCellID();
-						}
-						oStringStream << " due to SedimentFlowTypeMethods check for not eroding more than active layer." << std::flush;
-						#pragma omp critical
-						{ std::cout << std::endl << "===============================================================" << std::endl << oStringStream.str() << std::endl << std::flush; }
-
-						if(riverSystem.overallParameters.incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum())
-						{
-							oStringStream.str("");
-							oStringStream.clear();
-							oStringStream << "Number of time step length outputs reached its maximum of " << riverSystem.overallParameters.getMaximumNumberOfTimeStepOutputs() << "." << std::flush;
-							char* tmpChar = new char [(oStringStream.str()).size()+1];
-							std::strcpy(tmpChar, (oStringStream.str()).c_str());
-							const char *const maximumNumberOfTimeStepOutputsErrorMessage = tmpChar;
-							#pragma omp critical
-							{ throw(maximumNumberOfTimeStepOutputsErrorMessage); }
-						}
-					}
-				#endif
+				TimeStepConstraintDiagnostics::propose(timeStepEntry, TimeStepConstraintDiagnostics::SedimentActiveLayerErosion, currentRiverReachProperties);
 				#pragma omp critical
 				{ allCalculatedTimeSteps.push_back(timeStepEntry); }
 			}
@@ -206,44 +123,7 @@ double SedimentFlowTypeMethods::calculateTimeStep (const RiverSystemProperties&
 				{
 					bedslopeChangeRate = (1.0 / (1.0 - riverSystem.overallParameters.getPoreVolumeFraction()) ) * fabs( ( (localLinearConversion.second * ((*currentRiverReachProperties).regularRiverReachProperties.depositionRate.getOverallVolume()-(*currentRiverReachProperties).regularRiverReachProperties.erosionRate.getOverallVolume())) - (downstreamLinearConversion.second * ((*currentDownstreamCellPointer).regularRiverReachProperties.depositionRate.getOverallVolume()-(*currentDownstreamCellPointer).regularRiverReachProperties.erosionRate.getOverallVolume())) ) / (*currentRiverReachProperties).regularRiverReachProperties.length  );
 					timeStepEntry = maximumRelativeTwoCellBedSlopeChange * currentBedslope /  bedslopeChangeRate ;
-					#if defined TIMESTEPANALYSIS
-						if( timeStepEntry < thresholdForOutputtingTimeSteps )
-						{
-							oStringStream.str("");
-							oStringStream.clear();
-							oStringStream << "Time step of " << timeStepEntry << " seconds at ";
-							if(currentRiverReachProperties->isMargin())
-							{
-								if(currentRiverReachProperties->isDownstreamMargin())
-								{
-									oStringStream << "downstream margin";
-								}
-								else
-								{
-									oStringStream << "upstream margin at reach " << currentRiverReachProperties->getDownstreamUserCellID();
-								}
-							}
-							else
-							{
-								oStringStream << "reach " << currentRiverReachProperties->getUserCellID();
-							}
-							oStringStream << " due to SedimentFlowTypeMethods check for not creating negative slopes." << std::flush;
-							#pragma omp critical
-							{ std::cout << std::endl << "===============================================================" << std::endl  << oStringStream.str() << std::endl << std::flush; }
-
-							if(riverSystem.overallParameters.incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum())
-							{
-								oStringStream.str("");
-								oStringStream.clear();
-								oStringStream << "Number of time step length outputs reached its maximum of " << riverSystem.overallParameters.getMaximumNumberOfTimeStepOutputs() << "." << std::flush;
-								char* tmpChar = new char [(oStringStream.str()).size()+1];
-								std::strcpy(tmpChar, (oStringStream.str()).c_str());
-								const char *const maximumNumberOfTimeStepOutputsErrorMessage = tmpChar;
-								#pragma omp critical
-								{ throw(maximumNumberOfTimeStepOutputsErrorMessage); }
-							}
-						}
-					#endif
+					TimeStepConstraintDiagnostics::propose(timeStepEntry, TimeStepConstraintDiagnostics::SedimentBedSlopeChange, currentRiverReachProperties);
 					#pragma omp critical
 					{ allCalculatedTimeSteps.push_back(timeStepEntry); }
 				}else
@@ -291,44 +171,7 @@ double SedimentFlowTypeMethods::calculateTimeStep (const RiverSystemProperties&
 						bedslopeChange = fabs( ( (*currentRiverReachProperties).geometricalChannelBehaviour->convertActiveWidthAndOverallSedimentVolumeIncrementIntoElevationIncrementWithoutUpdatingAlluviumChannel((*currentRiverReachProperties).regularRiverReachProperties.activeWidth, (*currentRiverReachProperties).regularRiverReachProperties.length, localDepositionAndErosionVolume) -  (*currentDownstreamCellPointer).geometricalChannelBehaviour->convertActiveWidthAndOverallSedimentVolumeIncrementIntoElevationIncrementWithoutUpdatingAlluviumChannel((*currentDownstreamCellPointer).regularRiverReachProperties.activeWidth, (*currentDownstreamCellPointer).regularRiverReachProperties.length, downstreamDepositionAndErosionVolume) ) / (*currentRiverReachProperties).regularRiverReachProperties.length );
 					}
 					timeStepEntry = tempTimeStep;
-					#if defined TIMESTEPANALYSIS
-						if( timeStepEntry < thresholdForOutputtingTimeSteps )
-						{
-							oStringStream.str("");
-							oStringStream.clear();
-							oStringStream << "Time step of " << timeStepEntry << " seconds at ";
-							if(currentRiverReachProperties->isMargin())
-							{
-								if(currentRiverReachProperties->isDownstreamMargin())
-								{
-									oStringStream << "downstream margin";
-								}
-								else
-								{
-									oStringStream << "upstream margin at reach " << currentRiverReachProperties->getDownstreamUserCellID();
-								}
-							}
-							else
-							{
-								oStringStream << "reach " << currentRiverReachProperties->getUserCellID();
-							}
-							oStringStream << " due to SedimentFlowTypeMethods check for not creating negative slopes." << std::flush;
-							#pragma omp critical
-							{ std::cout << std::endl << "===============================================================" << std::endl << oStringStream.str() << std::endl << std::flush; }
-
-							if(riverSystem.overallParameters.incrementNumberOfTimeStepOutputsAndCheckIfReachedMaximum())
-							{
-								oStringStream.str("");
-								oStringStream.clear();
-								oStringStream << "Number of time step length outputs reached its maximum of " << riverSystem.overallParameters.getMaximumNumberOfTimeStepOutputs() << "." << std::flush;
-								char* tmpChar = new char [(oStringStream.str()).size()+1];
-								std::strcpy(tmpChar, (oStringStream.str()).c_str());
-								const char *const maximumNumberOfTimeStepOutputsErrorMessage = tmpChar;
-								#pragma omp critical
-								{ throw(maximumNumberOfTimeStepOutputsErrorMessage); }
-							}
-						}
-					#endif
+					TimeStepConstraintDiagnostics::propose(timeStepEntry, TimeStepConstraintDiagnostics::SedimentBedSlopeChange, currentRiverReachProperties);
 					#pragma omp critical
 					{ allCalculatedTimeSteps.push_back(timeStepEntry); }
 				}
@@ -388,6 +231,7 @@ void SedimentFlowTypeMethods::applyChange (RiverReachProperties& riverReachPrope
 	double overallErosionVolume = std::accumulate(overallErosion.begin(),overallErosion.end(),0.0);
 	double overallVolumeIncrement = ( overallDepositionVolume - overallErosionVolume ) / ( 1.0 - (riverReachProperties.getOverallParameters())->getPoreVolumeFraction() );
 	riverReachProperties.regularRiverReachProperties.elevation += (*(riverReachProperties.geometricalChannelBehaviour)).convertActiveWidthAndOverallSedimentVolumeIncrementIntoElevationIncrementIncludingAlluviumChannelUpdate( riverReachProperties.regularRiverReachProperties.activeWidth, riverReachProperties.regularRiverReachProperties.length, overallVolumeIncrement );
+	riverReachProperties.markAsModified();
 }
 
 void SedimentFlowTypeMethods::updateOtherParameters (RiverReachProperties& riverReachProperties) const
@@ -397,28 +241,7 @@ void SedimentFlowTypeMethods::updateOtherParameters (RiverReachProperties& river
 
 void SedimentFlowTypeMethods::handDownOtherParameters (RiverReachProperties& riverReachProperties) const
 {
-	riverReachProperties.regularRiverReachProperties.bedslope = overallMethods.bedSlopeCalculationMethod->calculate(riverReachProperties);
-
-
-	if( overallMethods.waterEnergySlopeCalculationMethod->dependsOnBedslope() )
-	{
-		riverReachProperties.regularRiverReachProperties.waterEnergyslope = overallMethods.waterEnergySlopeCalculationMethod->calculate(riverReachProperties);
-
-		if( overallMethods.sedimentEnergySlopeCalculationMethod->dependsOnWaterEnergyslope() )
-		{
-			std::pair<double,double> reducedAndUnreducedSlope =  overallMethods.sedimentEnergySlopeCalculationMethod->calculateReducedAndUnreducedSedimentEnergyslope(riverReachProperties);
-			riverReachProperties.regularRiverReachProperties.sedimentEnergyslope = reducedAndUnreducedSlope.first;
-			riverReachProperties.regularRiverReachProperties.unreducedSedimentEnergyslope = reducedAndUnreducedSlope.second;
-		}
-
-	}
-
-	if( overallMethods.sedimentEnergySlopeCalculationMethod->dependsOnBedslope() )
-	{
-		std::pair<double,double> reducedAndUnreducedSlope =  overallMethods.sedimentEnergySlopeCalculationMethod->calculateReducedAndUnreducedSedimentEnergyslope(riverReachProperties);
-		riverReachProperties.regularRiverReachProperties.sedimentEnergyslope = reducedAndUnreducedSlope.first;
-		riverReachProperties.regularRiverReachProperties.unreducedSedimentEnergyslope = reducedAndUnreducedSlope.second;
-	}
+	overallMethods.updateBedslope(riverReachProperties);
 }
 
 std::string SedimentFlowTypeMethods::getTypeOfSedimentFlowMethodsAsString() const
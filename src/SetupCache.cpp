@@ -0,0 +1,238 @@
+/*
+ * SetupCache.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#include "SetupCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if defined CURRENTLYWINDOWS
+//This is the Windows version
+#include <windows.h>
+#include <process.h>
+#else
+//This is the Linux version
+#include <unistd.h>
+#endif
+
+#include "BinaryColumnarOutputFormat.h"
+#include "OutputBinaryCheckpoint.h"
+#include "StringTools.h"
+
+#define myStringify(s) myStringifySubsidiary(s)
+#define myStringifySubsidiary(s) #s
+
+namespace SedFlow {
+
+const char SetupCache::magicNumber[8] = {'S','E','D','F','L','O','W','S'};
+const unsigned int SetupCache::formatVersion = 2;
+std::string SetupCache::cacheFolder;
+
+namespace {
+
+// 64 bit FNV-1a hash
+const unsigned long long fnvOffsetBasis = 0xCBF29CE484222325ULL;
+const unsigned long long fnvPrime = 0x00000100000001B3ULL;
+
+inline void hashBytes(unsigned long long& hash, const char* bytes, std::size_t numberOfBytes)
+{
+	for(const char* currentByte = bytes; currentByte < (bytes + numberOfBytes); ++currentByte)
+	{
+		hash ^= static_cast<unsigned char>(*currentByte);
+		hash *= fnvPrime;
+	}
+}
+
+// The terminating zero separates consecutive strings.
+inline void hashString(unsigned long long& hash, const std::string& string)
+{
+	hashBytes(hash, string.c_str(), string.size()+1);
+}
+
+// Hashes the content and the size of the file. A missing file is hashed as empty string.
+void hashFile(unsigned long long& hash, const std::string& fileName)
+{
+	std::ifstream file (fileName.c_str(), std::ios::in | std::ios::binary);
+	unsigned long long fileSize = 0;
+	if( file )
+	{
+		std::vector<char> buffer (1 << 20);
+		while( file.read(&(buffer[0]), buffer.size()) || file.gcount() > 0 )
+		{
+			hashBytes(hash, &(buffer[0]), file.gcount());
+			fileSize += file.gcount();
+		}
+	}
+	std::ostringstream oStringStream;
+	oStringStream << fileSize << std::flush;
+	hashString(hash, oStringStream.str());
+}
+
+}
+
+void SetupCache::setCacheFolder(const std::string& cacheFolder)
+{
+	SetupCache::cacheFolder = cacheFolder;
+}
+
+unsigned long long SetupCache::calculateKey(const std::string& relevantInputXML, std::string path)
+{
+	StringTools::ensureForwardSlashesAndMakeStringEndWithOneSlash(path);
+
+	unsigned long long result = fnvOffsetBasis;
+	hashBytes(result, magicNumber, 8);
+	std::ostringstream oStringStream;
+	oStringStream << formatVersion << std::flush;
+	hashString(result, oStringStream.str());
+	#if defined SEDFLOWVERSION
+	hashString(result, myStringify(SEDFLOWVERSION));
+	#endif
+
+	hashString(result, path);
+	hashString(result, relevantInputXML);
+
+	const char* const inputFolders[] = {"LongitudinalProfile/", "DischargeAndOtherInputs/", "GrainSizeDistributions/"};
+	for(int i = 0; i < 3; ++i)
+	{
+		std::string currentFolder = path;
+		currentFolder.append(inputFolders[i]);
+		hashString(result, inputFolders[i]);
+		std::vector<std::string> filesInFolder = StringTools::listFilesInFolder(currentFolder);
+		for(std::vector<std::string>::const_iterator currentFile = filesInFolder.begin(); currentFile < filesInFolder.end(); ++currentFile)
+		{
+			hashString(result, *currentFile);
+			hashFile(result, currentFolder + *currentFile);
+		}
+	}
+
+	return result;
+}
+
+std::string SetupCache::getCacheFileName(unsigned long long key)
+{
+	std::string folder = cacheFolder;
+	StringTools::ensureForwardSlashesAndMakeStringEndWithOneSlash(folder);
+	std::ostringstream oStringStream;
+	oStringStream << folder;
+	oStringStream.fill('0');
+	oStringStream.width(16);
+	oStringStream << std::hex << key << ".setup" << std::flush;
+	return oStringStream.str();
+}
+
+std::string SetupCache::getReachIDExplanationsFileName(std::string path)
+{
+	StringTools::ensureForwardSlashesAndMakeStringEndWithOneSlash(path);
+	path.append("Output/ReachIDExplanations.txt");
+	return path;
+}
+
+bool SetupCache::load(unsigned long long key, const std::string& path, ConstructionVariables& riverSystem)
+{
+	std::ifstream source (getCacheFileName(key).c_str(), std::ios::in | std::ios::binary);
+	if( !source ) { return false; }
+
+	char fileMagicNumber[8];
+	unsigned int fileFormatVersion;
+	unsigned int lowerHalfOfKey;
+	unsigned int upperHalfOfKey;
+	if( !source.read(fileMagicNumber, 8) || std::memcmp(fileMagicNumber, magicNumber, 8) != 0 ) { return false; }
+	if( !BinaryColumnarOutputFormat::readUnsignedInt(source, fileFormatVersion) || fileFormatVersion != formatVersion ) { return false; }
+	if( !BinaryColumnarOutputFormat::readUnsignedInt(source, lowerHalfOfKey) || !BinaryColumnarOutputFormat::readUnsignedInt(source, upperHalfOfKey) ) { return false; }
+	if( ( static_cast<unsigned long long>(lowerHalfOfKey) | (static_cast<unsigned long long>(upperHalfOfKey) << 32) ) != key ) { return false; }
+
+	std::string reachIDExplanations;
+	ConstructionVariables result;
+	if( !BinaryColumnarOutputFormat::readString(source, reachIDExplanations) || !OutputBinaryCheckpoint::readConstructionVariables(source, result) ) { return false; }
+
+	// Like the input reader, the explanations are only written if the Output folder exists.
+	std::ofstream reachIDExplanationsFile (getReachIDExplanationsFileName(path).c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+	reachIDExplanationsFile << reachIDExplanations;
+
+	riverSystem = result;
+	return true;
+}
+
+void SetupCache::store(unsigned long long key, const std::string& path, const ConstructionVariables& riverSystem)
+{
+	std::string reachIDExplanations;
+	std::ifstream reachIDExplanationsFile (getReachIDExplanationsFileName(path).c_str(), std::ios::in | std::ios::binary);
+	if( reachIDExplanationsFile )
+	{
+		std::ostringstream oStringStream;
+		oStringStream << reachIDExplanationsFile.rdbuf();
+		reachIDExplanations = oStringStream.str();
+	}
+
+	std::vector<char> byteBuffer (magicNumber, magicNumber + 8);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, formatVersion);
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, static_cast<unsigned int>(key & 0xFFFFFFFFULL));
+	BinaryColumnarOutputFormat::appendUnsignedInt(byteBuffer, static_cast<unsigned int>(key >> 32));
+	BinaryColumnarOutputFormat::appendString(byteBuffer, reachIDExplanations);
+	OutputBinaryCheckpoint::appendConstructionVariables(byteBuffer, riverSystem);
+
+	// Several simulations might start with the same set-up at the same time. Thus each of them writes its own temporary file,
+	// which replaces the entry only once it is complete.
+	std::string cacheFileName = getCacheFileName(key);
+	std::ostringstream oStringStream;
+	oStringStream << cacheFileName << ".";
+#if defined CURRENTLYWINDOWS
+	oStringStream << _getpid();
+#else
+	oStringStream << getpid();
+#endif
+	oStringStream << ".tmp" << std::flush;
+	std::string temporaryFileName = oStringStream.str();
+
+	std::FILE* file = std::fopen(temporaryFileName.c_str(), "wb");
+	bool success = ( file != NULL );
+	if(success)
+	{
+		success = ( std::fwrite(&(byteBuffer[0]), 1, byteBuffer.size(), file) == byteBuffer.size() );
+		success = ( std::fclose(file) == 0 ) && success;
+	}
+	if(success)
+	{
+#if defined CURRENTLYWINDOWS
+		success = ( MoveFileExA(temporaryFileName.c_str(), cacheFileName.c_str(), MOVEFILE_REPLACE_EXISTING) != 0 );
+#else
+		success = ( std::rename(temporaryFileName.c_str(), cacheFileName.c_str()) == 0 );
+#endif
+	}
+	if(!success)
+	{
+		std::remove(temporaryFileName.c_str());
+		std::string errorMessageString = "The river system cannot be stored in the cache folder:\n";
+		errorMessageString.append(cacheFolder);
+		char* tmpChar = new char [errorMessageString.size()+1];
+		std::strcpy(tmpChar, errorMessageString.c_str());
+		const char *const errorMessage = tmpChar;
+		throw(errorMessage);
+	}
+}
+
+}
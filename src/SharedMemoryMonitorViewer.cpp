@@ -0,0 +1,170 @@
+/*
+ * SharedMemoryMonitorViewer.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+// Attaches to the shared memory segment of an OutputSharedMemoryMonitor and prints the published records as tables
+// with one line per reach, while the simulation is running. The viewer only reads and never blocks the simulation.
+// Records, which have been overwritten in the ring buffer before the viewer could read them, are skipped.
+//
+// Usage: SharedMemoryMonitorViewer [--once] [--interval milliseconds] [--precision N] [name]
+// Without a name the default name of the sharedMemoryMonitor (sedFlowMonitor) is used. With --once only the latest record is printed.
+// Build: make bin/SharedMemoryMonitorViewer CXX_FLAGS="-O1 -DCURRENTLYUNIX"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#if defined CURRENTLYWINDOWS
+//This is the Windows version
+#include <windows.h>
+#else
+//This is the Linux version
+#include <unistd.h>
+#endif
+
+#include "SharedMemoryRingBuffer.h"
+
+namespace {
+
+void printUsage(const char* programName)
+{
+	std::cerr << "Usage: " << programName << " [--once] [--interval milliseconds] [--precision N] [name]" << std::endl;
+}
+
+void sleepMilliseconds(int milliseconds)
+{
+#if defined CURRENTLYWINDOWS
+	Sleep(milliseconds);
+#else
+	usleep(milliseconds * 1000);
+#endif
+}
+
+void printRecord(const SedFlow::SharedMemoryRingBuffer& ringBuffer, unsigned long long recordNumber, double elapsedSeconds, double timeStepLengthInSeconds, const std::vector<double>& values)
+{
+	std::cout << "Record " << recordNumber << "\tElapsedSeconds " << elapsedSeconds << "\tTimeStepLengthInSeconds " << timeStepLengthInSeconds << std::endl;
+	std::cout << "ReachID";
+	const std::vector<std::string>& propertyNames = ringBuffer.getPropertyNames();
+	for(std::vector<std::string>::const_iterator currentName = propertyNames.begin(); currentName < propertyNames.end(); ++currentName) { std::cout << "\t" << *currentName; }
+	std::cout << std::endl;
+
+	int numberOfReaches = ringBuffer.getNumberOfReaches();
+	int numberOfProperties = ringBuffer.getNumberOfProperties();
+	for(int reach = 0; reach < numberOfReaches; ++reach)
+	{
+		std::cout << ringBuffer.getUserCellIDs()[reach];
+		for(int property = 0; property < numberOfProperties; ++property) { std::cout << "\t" << values[(property * numberOfReaches) + reach]; }
+		std::cout << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+	bool onlyLatestRecord = false;
+	int intervalInMilliseconds = 1000;
+	int precision = 4;
+	std::string name ("sedFlowMonitor");
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string argument (argv[i]);
+		if( argument == "--once" ) { onlyLatestRecord = true; }
+		else if( argument == "--interval" && (i+1) < argc ) { intervalInMilliseconds = std::atoi(argv[++i]); }
+		else if( argument == "--precision" && (i+1) < argc ) { precision = std::atoi(argv[++i]); }
+		else if( !(argument.empty()) && argument[0] != '-' ) { name = argument; }
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if( intervalInMilliseconds < 1 || precision < 1 )
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+	std::cout.precision(precision);
+	std::cout << std::scientific;
+
+	SedFlow::SharedMemoryRingBuffer ringBuffer;
+	bool waitingMessagePrinted = false;
+	while( !(ringBuffer.isAttached()) )
+	{
+		try { ringBuffer.attach(name); }
+		catch(const char* errorMessage)
+		{
+			if(onlyLatestRecord)
+			{
+				std::cerr << errorMessage << std::endl;
+				return 1;
+			}
+			if( !waitingMessagePrinted )
+			{
+				std::cerr << "Waiting for the simulation to publish into " << SedFlow::SharedMemoryRingBuffer::getPlatformName(name) << " ..." << std::endl;
+				waitingMessagePrinted = true;
+			}
+			sleepMilliseconds(intervalInMilliseconds);
+		}
+	}
+	std::cout << "Attached to " << SedFlow::SharedMemoryRingBuffer::getPlatformName(name) << " with " << ringBuffer.getNumberOfReaches() << " reaches, " << ringBuffer.getNumberOfProperties() << " properties and " << ringBuffer.getNumberOfSlots() << " slots." << std::endl << std::endl;
+
+	double elapsedSeconds, timeStepLengthInSeconds;
+	std::vector<double> values;
+	unsigned long long lastPrintedRecordNumber = 0;
+	unsigned long long numberOfSkippedRecords = 0;
+	while(true)
+	{
+		bool writerHasFinished = ringBuffer.writerHasFinished();
+		unsigned long long latestRecordNumber = ringBuffer.getLatestRecordNumber();
+		unsigned long long firstRecordNumber = lastPrintedRecordNumber + 1;
+		if( onlyLatestRecord && latestRecordNumber > 0 ) { firstRecordNumber = latestRecordNumber; }
+		// Older records are certainly overwritten.
+		else if( latestRecordNumber >= firstRecordNumber && (latestRecordNumber - firstRecordNumber + 1) > static_cast<unsigned long long>(ringBuffer.getNumberOfSlots()) )
+		{
+			numberOfSkippedRecords += latestRecordNumber - ringBuffer.getNumberOfSlots() + 1 - firstRecordNumber;
+			firstRecordNumber = latestRecordNumber - ringBuffer.getNumberOfSlots() + 1;
+		}
+
+		for(unsigned long long recordNumber = firstRecordNumber; recordNumber <= latestRecordNumber; ++recordNumber)
+		{
+			if( ringBuffer.readRecord(recordNumber, elapsedSeconds, timeStepLengthInSeconds, values) ) { printRecord(ringBuffer, recordNumber, elapsedSeconds, timeStepLengthInSeconds, values); }
+			else { ++numberOfSkippedRecords; }
+			lastPrintedRecordNumber = recordNumber;
+		}
+		std::cout.flush();
+
+		if( onlyLatestRecord ) { break; }
+		if( writerHasFinished )
+		{
+			std::cout << "The simulation has finished." << std::endl;
+			break;
+		}
+		sleepMilliseconds(intervalInMilliseconds);
+	}
+	if( numberOfSkippedRecords > 0 ) { std::cerr << numberOfSkippedRecords << " records have been overwritten before they could be printed." << std::endl; }
+	return 0;
+}
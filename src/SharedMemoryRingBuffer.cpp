@@ -0,0 +1,404 @@
+/*
+ * SharedMemoryRingBuffer.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "SharedMemoryRingBuffer.h"
+
+#include <cstring>
+#include <sstream>
+
+#if defined CURRENTLYWINDOWS
+//This is the Windows version
+#include <windows.h>
+#else
+//This is the Linux version
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace SedFlow {
+
+const char SharedMemoryRingBuffer::magicNumber[8] = {'S','E','D','F','L','O','W','M'};
+const unsigned int SharedMemoryRingBuffer::formatVersion = 1;
+const int SharedMemoryRingBuffer::lengthOfPropertyNames = 64;
+
+namespace {
+
+struct RingBufferHeader {
+	char magicNumber[8];
+	unsigned int formatVersion;
+	unsigned int headerSize;
+	unsigned int numberOfReaches;
+	unsigned int numberOfProperties;
+	unsigned int numberOfSlots;
+	unsigned int slotSize;
+	volatile unsigned long long latestRecordNumber;
+	volatile unsigned int writerState;
+	unsigned int padding;
+};
+
+struct SlotHeader {
+	volatile unsigned long long sequenceNumber;
+	unsigned long long recordNumber;
+	double elapsedSeconds;
+	double timeStepLengthInSeconds;
+};
+
+const unsigned int writerRunning = 1;
+const unsigned int writerFinished = 2;
+
+// The writer needs a few microseconds for a slot. Thus a reader, which does not get a consistent copy within these attempts, gives up for this record.
+const int maximumNumberOfReadAttempts = 1000;
+
+// Prevents the compiler and the processor from moving memory accesses across this point.
+inline void memoryBarrier()
+{
+#if defined CURRENTLYWINDOWS
+	MemoryBarrier();
+#else
+	__sync_synchronize();
+#endif
+}
+
+void throwErrorMessageConcerningSegment(const char* beforeName, const std::string& name, const char* afterName)
+{
+	std::ostringstream oStringStream;
+	oStringStream << beforeName << std::endl << "\"" << name << "\"" << std::endl << afterName << std::flush;
+
+	char* tmpChar = new char [(oStringStream.str()).size()+1];
+	std::strcpy(tmpChar, (oStringStream.str()).c_str());
+	const char *const errorMessage = tmpChar;
+	throw(errorMessage);
+}
+
+}
+
+struct SharedMemoryRingBuffer::PlatformHandle {
+#if defined CURRENTLYWINDOWS
+	HANDLE fileMapping;
+
+	PlatformHandle() : fileMapping(NULL) {}
+#else
+	PlatformHandle() {}
+#endif
+};
+
+SharedMemoryRingBuffer::SharedMemoryRingBuffer():
+	platformHandle(new PlatformHandle()),
+	isWriter(false),
+	mappedMemory(NULL),
+	mappedSize(0),
+	numberOfReaches(0),
+	numberOfProperties(0),
+	numberOfSlots(0),
+	headerSize(0),
+	slotSize(0)
+{}
+
+SharedMemoryRingBuffer::~SharedMemoryRingBuffer()
+{
+	detach();
+	delete platformHandle;
+}
+
+std::string SharedMemoryRingBuffer::getPlatformName(const std::string& name)
+{
+#if defined CURRENTLYWINDOWS
+	std::string result ("Local\\");
+	std::string::size_type firstCharacter = name.find_first_not_of('/');
+	if( firstCharacter != std::string::npos ) { result.append( name.substr(firstCharacter) ); }
+	return result;
+#else
+	if( !(name.empty()) && name[0] == '/' ) { return name; }
+	std::string result ("/");
+	result.append(name);
+	return result;
+#endif
+}
+
+std::size_t SharedMemoryRingBuffer::calculateHeaderSize(int numberOfReaches, int numberOfProperties)
+{
+	std::size_t result = sizeof(RingBufferHeader) + ( numberOfReaches * sizeof(int) ) + ( numberOfProperties * lengthOfPropertyNames );
+	// The slots start at a multiple of eight bytes, so that their values are aligned.
+	return ( ( (result + 7) / 8 ) * 8 );
+}
+
+std::size_t SharedMemoryRingBuffer::calculateSlotSize(int numberOfReaches, int numberOfProperties)
+{
+	return ( sizeof(SlotHeader) + ( numberOfReaches * numberOfProperties * sizeof(double) ) );
+}
+
+char* SharedMemoryRingBuffer::getSlot(unsigned long long recordNumber) const
+{
+	return ( mappedMemory + headerSize + ( static_cast<std::size_t>( (recordNumber - 1) % numberOfSlots ) * slotSize ) );
+}
+
+void SharedMemoryRingBuffer::create(const std::string& name, const std::vector<std::string>& propertyNames, const std::vector<int>& userCellIDs, int numberOfSlots)
+{
+	if( propertyNames.empty() || userCellIDs.empty() )
+	{
+		const char *const errorMessage = "A shared memory ring buffer needs at least one property and one reach.";
+		throw(errorMessage);
+	}
+	if( numberOfSlots < 2 )
+	{
+		const char *const errorMessage = "A shared memory ring buffer needs at least two slots.";
+		throw(errorMessage);
+	}
+	detach();
+
+	this->name = getPlatformName(name);
+	this->numberOfReaches = userCellIDs.size();
+	this->numberOfProperties = propertyNames.size();
+	this->numberOfSlots = numberOfSlots;
+	this->headerSize = calculateHeaderSize(this->numberOfReaches, this->numberOfProperties);
+	this->slotSize = calculateSlotSize(this->numberOfReaches, this->numberOfProperties);
+	this->userCellIDs = userCellIDs;
+	this->propertyNames = propertyNames;
+	std::size_t size = headerSize + ( numberOfSlots * slotSize );
+
+#if defined CURRENTLYWINDOWS
+	platformHandle->fileMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, static_cast<DWORD>(size), this->name.c_str());
+	if( platformHandle->fileMapping == NULL ) { throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be created."); }
+	void* memory = MapViewOfFile(platformHandle->fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if( memory == NULL )
+	{
+		CloseHandle(platformHandle->fileMapping);
+		platformHandle->fileMapping = NULL;
+		throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be mapped.");
+	}
+	// A mapping, which already existed, is not zero-initialised.
+	std::memset(memory, 0, size);
+#else
+	// A segment left behind by an aborted simulation is replaced. Readers still attached to it keep their old mapping.
+	shm_unlink(this->name.c_str());
+	int fileDescriptor = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+	if( fileDescriptor < 0 ) { throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be created."); }
+	if( ftruncate(fileDescriptor, size) != 0 )
+	{
+		close(fileDescriptor);
+		shm_unlink(this->name.c_str());
+		throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be resized.");
+	}
+	void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+	close(fileDescriptor);
+	if( memory == MAP_FAILED )
+	{
+		shm_unlink(this->name.c_str());
+		throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be mapped.");
+	}
+#endif
+	mappedMemory = static_cast<char*>(memory);
+	mappedSize = size;
+	isWriter = true;
+
+	RingBufferHeader* header = reinterpret_cast<RingBufferHeader*>(mappedMemory);
+	header->formatVersion = formatVersion;
+	header->headerSize = headerSize;
+	header->numberOfReaches = this->numberOfReaches;
+	header->numberOfProperties = this->numberOfProperties;
+	header->numberOfSlots = numberOfSlots;
+	header->slotSize = slotSize;
+	header->latestRecordNumber = 0;
+	header->writerState = writerRunning;
+	std::memcpy(mappedMemory + sizeof(RingBufferHeader), &(userCellIDs[0]), numberOfReaches * sizeof(int));
+	char* currentPropertyName = mappedMemory + sizeof(RingBufferHeader) + ( numberOfReaches * sizeof(int) );
+	for(std::vector<std::string>::const_iterator currentName = propertyNames.begin(); currentName < propertyNames.end(); ++currentName, currentPropertyName += lengthOfPropertyNames)
+		{ currentName->copy( currentPropertyName, (lengthOfPropertyNames - 1) ); }
+	// Readers accept the segment only once the magic number is there.
+	memoryBarrier();
+	std::memcpy(header->magicNumber, magicNumber, 8);
+	memoryBarrier();
+}
+
+void SharedMemoryRingBuffer::attach(const std::string& name)
+{
+	detach();
+	this->name = getPlatformName(name);
+
+#if defined CURRENTLYWINDOWS
+	platformHandle->fileMapping = OpenFileMappingA(FILE_MAP_READ, FALSE, this->name.c_str());
+	if( platformHandle->fileMapping == NULL ) { throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be opened."); }
+	void* memory = MapViewOfFile(platformHandle->fileMapping, FILE_MAP_READ, 0, 0, 0);
+	if( memory == NULL )
+	{
+		CloseHandle(platformHandle->fileMapping);
+		platformHandle->fileMapping = NULL;
+		throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be mapped.");
+	}
+	MEMORY_BASIC_INFORMATION memoryInformation;
+	VirtualQuery(memory, &memoryInformation, sizeof(memoryInformation));
+	mappedSize = memoryInformation.RegionSize;
+#else
+	int fileDescriptor = shm_open(this->name.c_str(), O_RDONLY, 0);
+	if( fileDescriptor < 0 ) { throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be opened."); }
+	struct stat fileStatus;
+	if( fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size < static_cast<off_t>(sizeof(RingBufferHeader)) )
+	{
+		close(fileDescriptor);
+		throwErrorMessageConcerningSegment("The shared memory segment", this->name, "is not yet complete.");
+	}
+	mappedSize = fileStatus.st_size;
+	void* memory = mmap(NULL, mappedSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+	close(fileDescriptor);
+	if( memory == MAP_FAILED ) { throwErrorMessageConcerningSegment("The shared memory segment", this->name, "could not be mapped."); }
+#endif
+	mappedMemory = static_cast<char*>(memory);
+	isWriter = false;
+
+	const RingBufferHeader* header = reinterpret_cast<const RingBufferHeader*>(mappedMemory);
+	memoryBarrier();
+	if( std::memcmp(header->magicNumber, magicNumber, 8) != 0 )
+	{
+		detach();
+		throwErrorMessageConcerningSegment("The shared memory segment", name, "is not (yet) a complete sedFlow monitor.");
+	}
+	memoryBarrier();
+	if( header->formatVersion != formatVersion )
+	{
+		detach();
+		throwErrorMessageConcerningSegment("The shared memory segment", name, "has been written in an unsupported format version.");
+	}
+	numberOfReaches = header->numberOfReaches;
+	numberOfProperties = header->numberOfProperties;
+	numberOfSlots = header->numberOfSlots;
+	headerSize = header->headerSize;
+	slotSize = header->slotSize;
+	if( numberOfReaches < 1 || numberOfProperties < 1 || numberOfSlots < 2 || headerSize != calculateHeaderSize(numberOfReaches, numberOfProperties) || slotSize != calculateSlotSize(numberOfReaches, numberOfProperties) || ( headerSize + (numberOfSlots * slotSize) ) > mappedSize )
+	{
+		detach();
+		throwErrorMessageConcerningSegment("The shared memory segment", name, "has an inconsistent header.");
+	}
+
+	const int* storedUserCellIDs = reinterpret_cast<const int*>(mappedMemory + sizeof(RingBufferHeader));
+	userCellIDs.assign(storedUserCellIDs, storedUserCellIDs + numberOfReaches);
+	propertyNames.clear();
+	const char* currentPropertyName = mappedMemory + sizeof(RingBufferHeader) + ( numberOfReaches * sizeof(int) );
+	for(int property = 0; property < numberOfProperties; ++property, currentPropertyName += lengthOfPropertyNames)
+		{ propertyNames.push_back( std::string( currentPropertyName, std::strlen(currentPropertyName) ) ); }
+}
+
+void SharedMemoryRingBuffer::detach()
+{
+	if( mappedMemory == NULL ) { return; }
+#if defined CURRENTLYWINDOWS
+	UnmapViewOfFile(mappedMemory);
+	CloseHandle(platformHandle->fileMapping);
+	platformHandle->fileMapping = NULL;
+#else
+	munmap(mappedMemory, mappedSize);
+	if(isWriter) { shm_unlink(name.c_str()); }
+#endif
+	mappedMemory = NULL;
+	mappedSize = 0;
+	isWriter = false;
+}
+
+void SharedMemoryRingBuffer::publish(double elapsedSeconds, double timeStepLengthInSeconds, const std::vector<double>& values)
+{
+	if( !isWriter )
+	{
+		const char *const errorMessage = "Only the creator of a shared memory ring buffer may publish records.";
+		throw(errorMessage);
+	}
+	if( static_cast<int>(values.size()) != (numberOfReaches * numberOfProperties) )
+	{
+		const char *const errorMessage = "The number of values published into a shared memory ring buffer does not match its numbers of reaches and properties.";
+		throw(errorMessage);
+	}
+
+	RingBufferHeader* header = reinterpret_cast<RingBufferHeader*>(mappedMemory);
+	unsigned long long recordNumber = header->latestRecordNumber + 1;
+	char* slot = getSlot(recordNumber);
+	SlotHeader* slotHeader = reinterpret_cast<SlotHeader*>(slot);
+
+	slotHeader->sequenceNumber = slotHeader->sequenceNumber + 1;
+	memoryBarrier();
+	slotHeader->recordNumber = recordNumber;
+	slotHeader->elapsedSeconds = elapsedSeconds;
+	slotHeader->timeStepLengthInSeconds = timeStepLengthInSeconds;
+	std::memcpy(slot + sizeof(SlotHeader), &(values[0]), values.size() * sizeof(double));
+	memoryBarrier();
+	slotHeader->sequenceNumber = slotHeader->sequenceNumber + 1;
+	memoryBarrier();
+	header->latestRecordNumber = recordNumber;
+}
+
+void SharedMemoryRingBuffer::markWriterFinished()
+{
+	if( !isWriter ) { return; }
+	memoryBarrier();
+	reinterpret_cast<RingBufferHeader*>(mappedMemory)->writerState = writerFinished;
+	memoryBarrier();
+}
+
+unsigned long long SharedMemoryRingBuffer::getLatestRecordNumber() const
+{
+	if( mappedMemory == NULL ) { return 0; }
+	unsigned long long result = reinterpret_cast<const RingBufferHeader*>(mappedMemory)->latestRecordNumber;
+	memoryBarrier();
+	return result;
+}
+
+bool SharedMemoryRingBuffer::writerHasFinished() const
+{
+	if( mappedMemory == NULL ) { return true; }
+	bool result = ( reinterpret_cast<const RingBufferHeader*>(mappedMemory)->writerState == writerFinished );
+	memoryBarrier();
+	return result;
+}
+
+bool SharedMemoryRingBuffer::readRecord(unsigned long long recordNumber, double& elapsedSeconds, double& timeStepLengthInSeconds, std::vector<double>& values) const
+{
+	if( mappedMemory == NULL || recordNumber == 0 ) { return false; }
+	const char* slot = getSlot(recordNumber);
+	const SlotHeader* slotHeader = reinterpret_cast<const SlotHeader*>(slot);
+	values.resize(numberOfReaches * numberOfProperties);
+
+	for(int attempt = 0; attempt < maximumNumberOfReadAttempts; ++attempt)
+	{
+		unsigned long long sequenceNumberBefore = slotHeader->sequenceNumber;
+		memoryBarrier();
+		if( (sequenceNumberBefore % 2) == 1 ) { continue; }
+
+		unsigned long long storedRecordNumber = slotHeader->recordNumber;
+		double storedElapsedSeconds = slotHeader->elapsedSeconds;
+		double storedTimeStepLengthInSeconds = slotHeader->timeStepLengthInSeconds;
+		std::memcpy(&(values[0]), slot + sizeof(SlotHeader), values.size() * sizeof(double));
+		memoryBarrier();
+
+		if( slotHeader->sequenceNumber == sequenceNumberBefore )
+		{
+			if( storedRecordNumber != recordNumber ) { return false; }
+			elapsedSeconds = storedElapsedSeconds;
+			timeStepLengthInSeconds = storedTimeStepLengthInSeconds;
+			return true;
+		}
+	}
+	return false;
+}
+
+}
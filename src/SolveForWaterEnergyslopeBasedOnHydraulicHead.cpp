@@ -108,6 +108,7 @@ ConstructionVariables SolveForWaterEnergyslopeBasedOnHydraulicHead::createConstr
 	doubleVector.clear();
 	doubleVector.push_back(turbulenceLossFactor);
 	result.labelledDoubles["turbulenceLossFactor"] = doubleVector;
+	addEverTreatedCellIDsToConstructionVariables(result);
 	return result;
 }
 
@@ -123,11 +124,16 @@ PowerLawRelation SolveForWaterEnergyslopeBasedOnHydraulicHead::dischargeAsPowerL
 std::pair<double,double> SolveForWaterEnergyslopeBasedOnHydraulicHead::calculateFlowDepthAndFlowVelocityUsingDischargeAsInputWithoutPostprocessingChecks(double discharge, const RiverReachProperties& riverReachProperties) const
 {
 	double reallyElapsedSeconds = (riverReachProperties.getOverallParameters())->getElapsedSeconds();
+	//The set of already treated cells is shared by all reaches, which may be treated in parallel. Thus every access is protected.
+	//The results do not depend on the order of the accesses, as long as the reaches are treated from downstream to upstream.
+	#pragma omp critical(SolveForWaterEnergyslopeBasedOnHydraulicHeadAlreadyTreatedCellIDs)
+	{
 	if( !( this->elapsedSeconds < (0.0001 + reallyElapsedSeconds) ) )//i.e. if we reached a new time step
 	{
 		(const_cast<SolveForWaterEnergyslopeBasedOnHydraulicHead*>(this))->alreadyTreatedCellIDs.clear();
 		(const_cast<SolveForWaterEnergyslopeBasedOnHydraulicHead*>(this))->elapsedSeconds = reallyElapsedSeconds;
 	}
+	}
 
 	std::pair<double,double> result (0.0,0.0);
 	if(discharge > 0.0)
@@ -135,14 +141,17 @@ std::pair<double,double> SolveForWaterEnergyslopeBasedOnHydraulicHead::calculate
 		if( riverReachProperties.isDownstreamMargin() )
 		{
 			result = usedFlowResistanceRelation->calculateFlowDepthAndFlowVelocityUsingDischargeAsInput(discharge,riverReachProperties);
-			(const_cast<SolveForWaterEnergyslopeBasedOnHydraulicHead*>(this))->alreadyTreatedCellIDs.insert( riverReachProperties.getCellID() );
+			#pragma omp critical(SolveForWaterEnergyslopeBasedOnHydraulicHeadAlreadyTreatedCellIDs)
+			{ (const_cast<SolveForWaterEnergyslopeBasedOnHydraulicHead*>(this))->alreadyTreatedCellIDs.insert( riverReachProperties.getCellID() ); }
 		}
 		else
 		{
 			const RiverReachProperties& downstreamRiverReachProperties ( (*(riverReachProperties.getDownstreamCellPointer())) );
 
-			std::set<int>::const_iterator downstreamIDAmongAlreadyTreated = this->alreadyTreatedCellIDs.find( downstreamRiverReachProperties.getCellID() );
-			if( downstreamIDAmongAlreadyTreated != alreadyTreatedCellIDs.end() )//Continue only if it makes sense.
+			bool downstreamAlreadyTreated;
+			#pragma omp critical(SolveForWaterEnergyslopeBasedOnHydraulicHeadAlreadyTreatedCellIDs)
+			{ downstreamAlreadyTreated = ( this->alreadyTreatedCellIDs.find( downstreamRiverReachProperties.getCellID() ) != alreadyTreatedCellIDs.end() ); }
+			if( downstreamAlreadyTreated )//Continue only if it makes sense.
 			{
 				double gravityAcceleration = (riverReachProperties.getOverallParameters())->getGravityAcceleration();
 				double downstreamFrictionSlope = usedFlowResistanceRelation->returnlocalFrictionSlope(downstreamRiverReachProperties);
@@ -241,7 +250,8 @@ std::pair<double,double> SolveForWaterEnergyslopeBasedOnHydraulicHead::calculate
 					const char *const badIterationErrorMessage = tmpChar;
 					throw(badIterationErrorMessage);
 				}
-				(const_cast<SolveForWaterEnergyslopeBasedOnHydraulicHead*>(this))->alreadyTreatedCellIDs.insert( riverReachProperties.getCellID() );
+				#pragma omp critical(SolveForWaterEnergyslopeBasedOnHydraulicHeadAlreadyTreatedCellIDs)
+				{ (const_cast<SolveForWaterEnergyslopeBasedOnHydraulicHead*>(this))->alreadyTreatedCellIDs.insert( riverReachProperties.getCellID() ); }
 			}
 			else
 			{
@@ -0,0 +1,403 @@
+/*
+ * StageProfiler.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "StageProfiler.h"
+#include "ExecutionTrace.h"
+
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+
+#if defined SEDFLOWPARALLEL
+#include <omp.h>
+#endif
+
+#if defined CURRENTLYWINDOWS
+//This is the Windows version
+#include <windows.h>
+#else
+//This is the Linux version
+#include <time.h>
+#endif
+
+namespace SedFlow {
+
+namespace {
+
+const char *const namesOfStages[StageProfiler::NumberOfStages] = {"calculateAndModifyChangeRates", "calculateTimeStep", "calculateAndHandDownChanges", "performAdditionalReachActions", "performAdditionalRiverSystemActions", "applyChanges", "updateRegularProperties", "updateAdditionalRiverReachProperties", "output"};
+
+// Keeps the accumulators of different threads apart, so that they do not share cache lines.
+const int paddingOfAccumulators = 16;
+
+// The numbers of types correspond to the last entries of the enumerations in CombinerVariables.
+const int numberOfTypesOfFlowMethods = CombinerVariables::sedimentFlowMethods + 1;
+const int numberOfTypesOfAdditionalRiverReachPropertyAndMethod = CombinerVariables::ScourChain + 1;
+const int numberOfTypesOfAdditionalRiverSystemPropertyAndMethod = 0;
+const int numberOfTypesOfOutputMethod = CombinerVariables::OutputRegularRiverReachPropertiesDeltaEncoded + 1;
+
+template<typename EnumType>
+int appendSectionNames(int numberOfTypes, std::string (*typeToString)(EnumType), std::vector<std::string>& sectionNames)
+{
+	int firstSection = sectionNames.size();
+	for(int currentType = 0; currentType < numberOfTypes; ++currentType)
+		{ sectionNames.push_back( typeToString(static_cast<EnumType>(currentType)) ); }
+	return firstSection;
+}
+
+}
+
+bool StageProfiler::enabled = false;
+bool StageProfiler::measuring = false;
+bool StageProfiler::profiling = false;
+bool StageProfiler::tracing = false;
+long StageProfiler::firstTracedTimeStep = 0;
+long StageProfiler::endOfTracedTimeSteps = 0;
+int StageProfiler::currentStage = -1;
+double StageProfiler::startWallTimeOfCurrentStage = 0.0;
+double StageProfiler::startCPUTimeOfCurrentStage = 0.0;
+double StageProfiler::startWallTimeOfProfiling = 0.0;
+double StageProfiler::wallTimeOfLastCompletedTimeStep = 0.0;
+int StageProfiler::firstSectionForFlowMethods = 0;
+int StageProfiler::firstSectionForAdditionalRiverReachMethods = 0;
+int StageProfiler::firstSectionForAdditionalRiverSystemMethods = 0;
+int StageProfiler::firstSectionForOutputMethods = 0;
+std::vector<std::string> StageProfiler::sectionNames;
+std::vector<double> StageProfiler::wallSecondsPerStage;
+std::vector<double> StageProfiler::cpuSecondsPerStage;
+std::vector< std::vector<double> > StageProfiler::wallSecondsPerThreadAndSection;
+std::vector< std::vector<long> > StageProfiler::callsPerThreadAndSection;
+long StageProfiler::numberOfCompletedTimeSteps = 0;
+AllocationTracker::Snapshot StageProfiler::allocationsAtStartOfCurrentStage;
+AllocationTracker::Snapshot StageProfiler::allocationsAtLastCompletedTimeStep;
+std::vector<long long> StageProfiler::allocationsPerStage;
+std::vector<long long> StageProfiler::bytesPerStage;
+long long StageProfiler::maximumAllocationsPerTimeStep = 0;
+long long StageProfiler::maximumBytesPerTimeStep = 0;
+long StageProfiler::numberOfTimeStepsWithoutAllocations = 0;
+std::ofstream StageProfiler::csvFile;
+int StageProfiler::csvInterval = 0;
+std::vector<double> StageProfiler::wallSecondsPerStageAtLastCSVLine;
+std::vector<double> StageProfiler::cpuSecondsPerStageAtLastCSVLine;
+std::vector<double> StageProfiler::wallSecondsPerSectionAtLastCSVLine;
+std::vector<long> StageProfiler::callsPerSectionAtLastCSVLine;
+
+double StageProfiler::currentWallTime()
+{
+#if defined SEDFLOWPARALLEL
+	return omp_get_wtime();
+#elif defined CURRENTLYWINDOWS
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return ( static_cast<double>(counter.QuadPart) / static_cast<double>(frequency.QuadPart) );
+#else
+	timespec currentTime;
+	clock_gettime(CLOCK_MONOTONIC, &currentTime);
+	return ( static_cast<double>(currentTime.tv_sec) + (1.0e-9 * static_cast<double>(currentTime.tv_nsec)) );
+#endif
+}
+
+// The CPU time of the complete process, i.e. summed over all threads.
+double StageProfiler::currentCPUTime()
+{
+#if defined CURRENTLYWINDOWS
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+	unsigned long long kernelTicks = ( static_cast<unsigned long long>(kernelTime.dwHighDateTime) << 32 ) | kernelTime.dwLowDateTime;
+	unsigned long long userTicks = ( static_cast<unsigned long long>(userTime.dwHighDateTime) << 32 ) | userTime.dwLowDateTime;
+	return ( 1.0e-7 * static_cast<double>(kernelTicks + userTicks) );
+#else
+	timespec currentTime;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &currentTime);
+	return ( static_cast<double>(currentTime.tv_sec) + (1.0e-9 * static_cast<double>(currentTime.tv_nsec)) );
+#endif
+}
+
+void StageProfiler::enable(const std::string& csvFileName, int csvInterval)
+{
+	if( !enabled ) { initialise(); }
+	int numberOfStageSections = NumberOfStages * sectionNames.size();
+	StageProfiler::csvInterval = 0;
+	if( !csvFileName.empty() && csvInterval > 0 )
+	{
+		csvFile.open(csvFileName.c_str(), std::ios::out | std::ios::trunc);
+		if( !csvFile.is_open() )
+		{
+			std::ostringstream oStringStream;
+			oStringStream << "The profile file " << csvFileName << " could not be opened.";
+			char* errorMessage = new char [oStringStream.str().size()+1];
+			std::strcpy(errorMessage, oStringStream.str().c_str());
+			throw(errorMessage);
+		}
+		csvFile << "timeStep,elapsedSeconds,stage,implementation,wallSeconds,cpuSeconds,calls" << std::endl;
+		csvFile << std::setprecision(9);
+		StageProfiler::csvInterval = csvInterval;
+		wallSecondsPerStageAtLastCSVLine = wallSecondsPerStage;
+		cpuSecondsPerStageAtLastCSVLine = cpuSecondsPerStage;
+		wallSecondsPerSectionAtLastCSVLine.assign(numberOfStageSections + paddingOfAccumulators, 0.0);
+		callsPerSectionAtLastCSVLine.assign(numberOfStageSections + paddingOfAccumulators, 0);
+	}
+
+	profiling = true;
+	measuring = true;
+}
+
+void StageProfiler::enableTracing(const std::string& traceFileName, long firstTimeStep, long numberOfTimeSteps)
+{
+	if( !enabled ) { initialise(); }
+	ExecutionTrace::enable(traceFileName, wallSecondsPerThreadAndSection.size(), startWallTimeOfProfiling);
+	firstTracedTimeStep = std::max(firstTimeStep, 0L);
+	endOfTracedTimeSteps = firstTracedTimeStep + std::max(numberOfTimeSteps, 0L);
+	updateTracing();
+}
+
+void StageProfiler::initialise()
+{
+	sectionNames.clear();
+	firstSectionForFlowMethods = appendSectionNames(numberOfTypesOfFlowMethods, &CombinerVariables::typeOfFlowMethodsToString, sectionNames);
+	firstSectionForAdditionalRiverReachMethods = appendSectionNames(numberOfTypesOfAdditionalRiverReachPropertyAndMethod, &CombinerVariables::typeOfAdditionalRiverReachPropertyAndMethodToString, sectionNames);
+	firstSectionForAdditionalRiverSystemMethods = appendSectionNames(numberOfTypesOfAdditionalRiverSystemPropertyAndMethod, &CombinerVariables::typeOfAdditionalRiverSystemPropertyAndMethodToString, sectionNames);
+	firstSectionForOutputMethods = appendSectionNames(numberOfTypesOfOutputMethod, &CombinerVariables::typeOfOutputMethodToString, sectionNames);
+
+	int numberOfThreads = 1;
+#if defined SEDFLOWPARALLEL
+	numberOfThreads = omp_get_max_threads();
+#endif
+	int numberOfStageSections = NumberOfStages * sectionNames.size();
+	wallSecondsPerStage.assign(NumberOfStages, 0.0);
+	cpuSecondsPerStage.assign(NumberOfStages, 0.0);
+	wallSecondsPerThreadAndSection.assign(numberOfThreads, std::vector<double>(numberOfStageSections + paddingOfAccumulators, 0.0));
+	callsPerThreadAndSection.assign(numberOfThreads, std::vector<long>(numberOfStageSections + paddingOfAccumulators, 0));
+	numberOfCompletedTimeSteps = 0;
+	currentStage = -1;
+	allocationsPerStage.assign(NumberOfStages, 0);
+	bytesPerStage.assign(NumberOfStages, 0);
+	maximumAllocationsPerTimeStep = 0;
+	maximumBytesPerTimeStep = 0;
+	numberOfTimeStepsWithoutAllocations = 0;
+	allocationsAtLastCompletedTimeStep = AllocationTracker::takeSnapshot();
+
+	enabled = true;
+	startWallTimeOfProfiling = currentWallTime();
+	wallTimeOfLastCompletedTimeStep = startWallTimeOfProfiling;
+}
+
+// Tracing is switched on and off between the time steps only, so that the trace contains complete time steps.
+void StageProfiler::updateTracing()
+{
+	tracing = ExecutionTrace::isEnabled() && numberOfCompletedTimeSteps >= firstTracedTimeStep && numberOfCompletedTimeSteps < endOfTracedTimeSteps;
+	measuring = profiling || tracing;
+}
+
+void StageProfiler::switchStage(int stage)
+{
+	double wallTime = currentWallTime();
+	double cpuTime = currentCPUTime();
+	int previousStage = currentStage;
+	if( currentStage >= 0 )
+	{
+		wallSecondsPerStage[currentStage] += wallTime - startWallTimeOfCurrentStage;
+		cpuSecondsPerStage[currentStage] += cpuTime - startCPUTimeOfCurrentStage;
+		if( tracing ) { ExecutionTrace::record(0, namesOfStages[currentStage], "stage", startWallTimeOfCurrentStage, wallTime); }
+	}
+	currentStage = stage;
+	startWallTimeOfCurrentStage = wallTime;
+	startCPUTimeOfCurrentStage = cpuTime;
+	if( AllocationTracker::isAvailable() )
+	{
+		AllocationTracker::Snapshot allocations = AllocationTracker::takeSnapshot();
+		if( previousStage >= 0 )
+		{
+			allocationsPerStage[previousStage] += allocations.allocations - allocationsAtStartOfCurrentStage.allocations;
+			bytesPerStage[previousStage] += allocations.bytes - allocationsAtStartOfCurrentStage.bytes;
+		}
+		allocationsAtStartOfCurrentStage = allocations;
+	}
+}
+
+void StageProfiler::addToSection(int section, double startTime)
+{
+	if( currentStage < 0 ) { return; }
+	double endTime = currentWallTime();
+	int thread = 0;
+#if defined SEDFLOWPARALLEL
+	thread = omp_get_thread_num();
+	if( thread >= static_cast<int>(wallSecondsPerThreadAndSection.size()) ) { return; }
+#endif
+	int index = ( currentStage * sectionNames.size() ) + section;
+	wallSecondsPerThreadAndSection[thread][index] += endTime - startTime;
+	callsPerThreadAndSection[thread][index] += 1;
+	if( tracing ) { ExecutionTrace::record(thread, sectionNames[section].c_str(), namesOfStages[currentStage], startTime, endTime); }
+}
+
+void StageProfiler::completeTimeStepInternally(double elapsedSeconds)
+{
+	if( measuring ) { switchStage(-1); }
+	else { startWallTimeOfCurrentStage = currentWallTime(); }
+	++numberOfCompletedTimeSteps;
+	wallTimeOfLastCompletedTimeStep = startWallTimeOfCurrentStage;
+	if( AllocationTracker::isAvailable() )
+	{
+		AllocationTracker::Snapshot allocations = AllocationTracker::takeSnapshot();
+		long long allocationsOfTimeStep = allocations.allocations - allocationsAtLastCompletedTimeStep.allocations;
+		maximumAllocationsPerTimeStep = std::max(maximumAllocationsPerTimeStep, allocationsOfTimeStep);
+		maximumBytesPerTimeStep = std::max(maximumBytesPerTimeStep, (allocations.bytes - allocationsAtLastCompletedTimeStep.bytes));
+		if( allocationsOfTimeStep == 0 ) { ++numberOfTimeStepsWithoutAllocations; }
+		allocationsAtLastCompletedTimeStep = allocations;
+	}
+	if( csvInterval > 0 && (numberOfCompletedTimeSteps % csvInterval) == 0 ) { writeCSVLine(elapsedSeconds); }
+	updateTracing();
+}
+
+void StageProfiler::finish(std::ostream& outputStream)
+{
+	if( !enabled ) { return; }
+	if( currentStage >= 0 ) { switchStage(-1); }
+	if( profiling ) { printSummary(outputStream); }
+	if( ExecutionTrace::isEnabled() ) { ExecutionTrace::writeTraceFile(outputStream); }
+	tracing = false;
+	measuring = false;
+}
+
+std::vector<double> StageProfiler::sumOverThreads(const std::vector< std::vector<double> >& perThreadValues)
+{
+	std::vector<double> result = perThreadValues.front();
+	for(std::vector< std::vector<double> >::const_iterator currentThread = perThreadValues.begin() + 1; currentThread < perThreadValues.end(); ++currentThread)
+		{ std::transform(result.begin(), result.end(), currentThread->begin(), result.begin(), std::plus<double>()); }
+	return result;
+}
+
+std::vector<long> StageProfiler::sumOverThreads(const std::vector< std::vector<long> >& perThreadValues)
+{
+	std::vector<long> result = perThreadValues.front();
+	for(std::vector< std::vector<long> >::const_iterator currentThread = perThreadValues.begin() + 1; currentThread < perThreadValues.end(); ++currentThread)
+		{ std::transform(result.begin(), result.end(), currentThread->begin(), result.begin(), std::plus<long>()); }
+	return result;
+}
+
+// Each line covers the stages or sections, which have been active since the previous line.
+// The implementation "total" stands for the complete stage. The CPU time is only measured for complete stages.
+void StageProfiler::writeCSVLine(double elapsedSeconds)
+{
+	std::vector<double> wallSecondsPerSection = sumOverThreads(wallSecondsPerThreadAndSection);
+	std::vector<long> callsPerSection = sumOverThreads(callsPerThreadAndSection);
+	int numberOfSections = sectionNames.size();
+	for(int stage = 0; stage < NumberOfStages; ++stage)
+	{
+		csvFile << numberOfCompletedTimeSteps << ',' << elapsedSeconds << ',' << namesOfStages[stage] << ",total," << (wallSecondsPerStage[stage] - wallSecondsPerStageAtLastCSVLine[stage]) << ',' << (cpuSecondsPerStage[stage] - cpuSecondsPerStageAtLastCSVLine[stage]) << ',' << csvInterval << '\n';
+		for(int section = 0; section < numberOfSections; ++section)
+		{
+			int index = (stage * numberOfSections) + section;
+			long calls = callsPerSection[index] - callsPerSectionAtLastCSVLine[index];
+			if( calls == 0 ) { continue; }
+			csvFile << numberOfCompletedTimeSteps << ',' << elapsedSeconds << ',' << namesOfStages[stage] << ',' << sectionNames[section] << ',' << (wallSecondsPerSection[index] - wallSecondsPerSectionAtLastCSVLine[index]) << ",," << calls << '\n';
+		}
+	}
+	csvFile.flush();
+	wallSecondsPerStageAtLastCSVLine = wallSecondsPerStage;
+	cpuSecondsPerStageAtLastCSVLine = cpuSecondsPerStage;
+	wallSecondsPerSectionAtLastCSVLine = wallSecondsPerSection;
+	callsPerSectionAtLastCSVLine = callsPerSection;
+}
+
+// The times of the sections are summed over the threads. Thus within parallel stages they may exceed the wall clock time of the stage,
+// while the column "max thread" shows the busiest thread. The remainder of a stage is spent in code shared by all implementations.
+void StageProfiler::printSummary(std::ostream& outputStream)
+{
+	if( !profiling ) { return; }
+	if( currentStage >= 0 ) { switchStage(-1); }
+	if( csvFile.is_open() ) { csvFile.close(); }
+
+	std::vector<double> wallSecondsPerSection = sumOverThreads(wallSecondsPerThreadAndSection);
+	std::vector<long> callsPerSection = sumOverThreads(callsPerThreadAndSection);
+	int numberOfSections = sectionNames.size();
+	double totalWallSeconds = wallTimeOfLastCompletedTimeStep - startWallTimeOfProfiling;
+	double totalStageWallSeconds = 0.0;
+	double totalStageCPUSeconds = 0.0;
+	for(int stage = 0; stage < NumberOfStages; ++stage)
+	{
+		totalStageWallSeconds += wallSecondsPerStage[stage];
+		totalStageCPUSeconds += cpuSecondsPerStage[stage];
+	}
+	double perStepFactor = ( numberOfCompletedTimeSteps > 0 ) ? ( 1.0e6 / numberOfCompletedTimeSteps ) : 0.0;
+	double shareFactor = ( totalWallSeconds > 0.0 ) ? ( 100.0 / totalWallSeconds ) : 0.0;
+
+	std::ios_base::fmtflags previousFlags = outputStream.flags();
+	std::streamsize previousPrecision = outputStream.precision();
+	outputStream << std::endl << "Profile of " << numberOfCompletedTimeSteps << " time steps using " << wallSecondsPerThreadAndSection.size() << " thread(s):" << std::endl;
+	outputStream << std::left << std::setw(44) << "Stage / implementation" << std::right << std::setw(12) << "wall [s]" << std::setw(12) << "CPU [s]" << std::setw(10) << "share [%]" << std::setw(14) << "per step [us]" << std::setw(14) << "calls" << std::setw(16) << "max thread [s]" << std::endl;
+	outputStream << std::fixed;
+	for(int stage = 0; stage < NumberOfStages; ++stage)
+	{
+		outputStream << std::left << std::setw(44) << namesOfStages[stage] << std::right << std::setprecision(3) << std::setw(12) << wallSecondsPerStage[stage] << std::setw(12) << cpuSecondsPerStage[stage] << std::setprecision(1) << std::setw(10) << (wallSecondsPerStage[stage] * shareFactor) << std::setprecision(2) << std::setw(14) << (wallSecondsPerStage[stage] * perStepFactor) << std::endl;
+		for(int section = 0; section < numberOfSections; ++section)
+		{
+			int index = (stage * numberOfSections) + section;
+			if( callsPerSection[index] == 0 ) { continue; }
+			double maximumWallSecondsOfSingleThread = 0.0;
+			for(std::vector< std::vector<double> >::const_iterator currentThread = wallSecondsPerThreadAndSection.begin(); currentThread < wallSecondsPerThreadAndSection.end(); ++currentThread)
+				{ maximumWallSecondsOfSingleThread = std::max(maximumWallSecondsOfSingleThread, (*currentThread)[index]); }
+			outputStream << "  " << std::left << std::setw(42) << sectionNames[section] << std::right << std::setprecision(3) << std::setw(12) << wallSecondsPerSection[index] << std::setw(12) << "" << std::setprecision(1) << std::setw(10) << (wallSecondsPerSection[index] * shareFactor) << std::setprecision(2) << std::setw(14) << (wallSecondsPerSection[index] * perStepFactor) << std::setw(14) << callsPerSection[index] << std::setprecision(3) << std::setw(16) << maximumWallSecondsOfSingleThread << std::endl;
+		}
+	}
+	outputStream << std::left << std::setw(44) << "not attributed to a stage" << std::right << std::setprecision(3) << std::setw(12) << (totalWallSeconds - totalStageWallSeconds) << std::setw(12) << "" << std::setprecision(1) << std::setw(10) << ((totalWallSeconds - totalStageWallSeconds) * shareFactor) << std::setprecision(2) << std::setw(14) << ((totalWallSeconds - totalStageWallSeconds) * perStepFactor) << std::endl;
+	outputStream << std::left << std::setw(44) << "total" << std::right << std::setprecision(3) << std::setw(12) << totalWallSeconds << std::setw(12) << totalStageCPUSeconds << std::setprecision(1) << std::setw(10) << 100.0 << std::setprecision(2) << std::setw(14) << (totalWallSeconds * perStepFactor) << std::endl << std::endl;
+	outputStream.flags(previousFlags);
+	outputStream.precision(previousPrecision);
+	if( AllocationTracker::isAvailable() ) { printAllocationSummary(outputStream); }
+}
+
+// The allocations are counted for the complete process. Thus they include e.g. the background thread of the asynchronous output.
+void StageProfiler::printAllocationSummary(std::ostream& outputStream)
+{
+	long long totalAllocations = allocationsAtLastCompletedTimeStep.allocations;
+	long long totalBytes = allocationsAtLastCompletedTimeStep.bytes;
+	long long totalStageAllocations = 0;
+	long long totalStageBytes = 0;
+	for(int stage = 0; stage < NumberOfStages; ++stage)
+	{
+		totalStageAllocations += allocationsPerStage[stage];
+		totalStageBytes += bytesPerStage[stage];
+	}
+	double perStepFactor = ( numberOfCompletedTimeSteps > 0 ) ? ( 1.0 / numberOfCompletedTimeSteps ) : 0.0;
+
+	std::ios_base::fmtflags previousFlags = outputStream.flags();
+	std::streamsize previousPrecision = outputStream.precision();
+	outputStream << "Heap allocations of " << numberOfCompletedTimeSteps << " time steps:" << std::endl;
+	outputStream << std::left << std::setw(44) << "Stage" << std::right << std::setw(16) << "allocations" << std::setw(16) << "bytes" << std::setw(16) << "per step" << std::setw(18) << "bytes per step" << std::endl;
+	outputStream << std::fixed << std::setprecision(1);
+	for(int stage = 0; stage < NumberOfStages; ++stage)
+		{ outputStream << std::left << std::setw(44) << namesOfStages[stage] << std::right << std::setw(16) << allocationsPerStage[stage] << std::setw(16) << bytesPerStage[stage] << std::setw(16) << (allocationsPerStage[stage] * perStepFactor) << std::setw(18) << (bytesPerStage[stage] * perStepFactor) << std::endl; }
+	outputStream << std::left << std::setw(44) << "total of stages" << std::right << std::setw(16) << totalStageAllocations << std::setw(16) << totalStageBytes << std::setw(16) << (totalStageAllocations * perStepFactor) << std::setw(18) << (totalStageBytes * perStepFactor) << std::endl;
+	outputStream << "Maximum per time step: " << maximumAllocationsPerTimeStep << " allocations, " << maximumBytesPerTimeStep << " bytes." << std::endl;
+	outputStream << "Time steps without allocations: " << numberOfTimeStepsWithoutAllocations << " of " << numberOfCompletedTimeSteps << "." << std::endl;
+	outputStream << "Since the start of the process: " << totalAllocations << " allocations of together " << totalBytes << " bytes." << std::endl << std::endl;
+	outputStream.flags(previousFlags);
+	outputStream.precision(previousPrecision);
+}
+
+}
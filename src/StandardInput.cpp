@@ -37,10 +37,15 @@
 #include <limits>
 #include <math.h>
 #include <set>
+#include <exception>
 
 #include "StringTools.h"
+#include "TabDelimitedSpreadsheet.h"
+#include "TabDelimitedSpreadsheetStream.h"
+#include "StreamingTimeSeriesSource.h"
 
 #include "SedFlowBuilders.h"
+#include "SetupCache.h"
 #include "StratigraphyWithThresholdBasedUpdate.h"
 
 namespace SedFlow {
@@ -75,9 +80,36 @@ ConstructionVariables StandardInput::convertUserInputXMLIntoConstructionVariable
 
 	ConstructionVariables overallParameters = createOverallParameters(rootNode,path);
 	ConstructionVariables overallMethods = createOverallMethods(rootNode);
-	std::pair<ConstructionVariables,RiverSystemInformation> riverSystemPropertiesAndRiverSystemInformation = createRiverSystemPropertiesAndRiverSystemInformation(rootNode, path, overallParameters, overallMethods);
-	ConstructionVariables riverSystemProperties = riverSystemPropertiesAndRiverSystemInformation.first;
-	RiverSystemInformation riverSystemInformation = riverSystemPropertiesAndRiverSystemInformation.second;
+
+	ConstructionVariables riverSystemProperties;
+	RiverSystemInformation riverSystemInformation;
+	unsigned long long setupCacheKey = 0;
+	ConstructionVariables cachedRiverSystem;
+	if( SetupCache::isEnabled() )
+	{
+		setupCacheKey = SetupCache::calculateKey(collectInputXMLForRiverSystemProperties(rootNode), path);
+	}
+	if( SetupCache::isEnabled() && SetupCache::load(setupCacheKey, path, cachedRiverSystem) )
+	{
+		riverSystemProperties = cachedRiverSystem.labelledObjects["riverSystemProperties"].at(0);
+		riverSystemInformation = convertConstructionVariablesIntoRiverSystemInformation( cachedRiverSystem.labelledObjects["riverSystemInformation"].at(0) );
+	}
+	else
+	{
+		std::pair<ConstructionVariables,RiverSystemInformation> riverSystemPropertiesAndRiverSystemInformation = createRiverSystemPropertiesAndRiverSystemInformation(rootNode, path, overallParameters, overallMethods);
+		riverSystemProperties = riverSystemPropertiesAndRiverSystemInformation.first;
+		riverSystemInformation = riverSystemPropertiesAndRiverSystemInformation.second;
+
+		if( SetupCache::isEnabled() )
+		{
+			cachedRiverSystem.interfaceOrCombinerType = CombinerVariables::UserInputReader;
+			cachedRiverSystem.realisationType = CombinerVariables::typeOfUserInputReadersToString(CombinerVariables::StandardInput);
+			cachedRiverSystem.labelledObjects["riverSystemProperties"] = std::vector<ConstructionVariables>(1,riverSystemProperties);
+			cachedRiverSystem.labelledObjects["riverSystemInformation"] = std::vector<ConstructionVariables>(1,convertRiverSystemInformationIntoConstructionVariables(riverSystemInformation));
+			SetupCache::store(setupCacheKey, path, cachedRiverSystem);
+		}
+	}
+
 	ConstructionVariables riverSystemMethods = createRiverSystemMethods(rootNode, path, riverSystemInformation);
 	ConstructionVariables outputMethods = createOutputMethods(rootNode, path, riverSystemInformation);
 
@@ -241,7 +273,8 @@ ConstructionVariables StandardInput::createOverallParameters(pugi::xml_node root
 	pugi::xml_node elapsedSecondsNode = overallParametersNode.child("elapsedSeconds");
 	pugi::xml_node finishSecondsNode = overallParametersNode.child("finishSeconds");
 
-	std::vector<double> elapsedSeconds;
+	double minimumElapsedSeconds = 0.0;
+	double maximumElapsedSeconds = 0.0;
 	if( ( (elapsedSecondsNode == 0) || (finishSecondsNode == 0) ) )
 	{
 		tmpFileName.clear();
@@ -249,19 +282,37 @@ ConstructionVariables StandardInput::createOverallParameters(pugi::xml_node root
 		tmpFileName.append("DischargeAndOtherInputs/Branch");
 		tmpFileName.append(firstBranchID);
 		tmpFileName.append("Discharge.txt");
-		currentSpreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(tmpFileName);
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("ElapsedSeconds");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
+		// Only the extreme values are needed. Thus the spreadsheet is read row by row without storing the time series.
+		TabDelimitedSpreadsheetStream dischargeSpreadsheet (tmpFileName);
+		if( !(dischargeSpreadsheet.hasColumn("ElapsedSeconds")) )
 		{
 			const char *const elapsedSecondsErrorMessage = "The column ElapsedSeconds is needed for the Discharge spreadsheets within StandardInput input reader.";
 			throw(elapsedSecondsErrorMessage);
 		}
-		elapsedSeconds = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
+		int elapsedSecondsColumnIndex = dischargeSpreadsheet.getColumnIndex("ElapsedSeconds");
+		if( !(dischargeSpreadsheet.readNextRow()) )
+		{
+			std::string noSufficientRowErrorMessageString = "The following file does not contain any row with the minimum number of entries defined by the header line:\n";
+			noSufficientRowErrorMessageString.append(tmpFileName);
+			noSufficientRowErrorMessageString.append("\n");
+			char* noSufficientRowErrorMessageNotConst = new char [noSufficientRowErrorMessageString.size()+1];
+			std::strcpy (noSufficientRowErrorMessageNotConst,noSufficientRowErrorMessageString.c_str());
+			const char *const noSufficientRowErrorMessage = noSufficientRowErrorMessageNotConst;
+			throw(noSufficientRowErrorMessage);
+		}
+		minimumElapsedSeconds = dischargeSpreadsheet.getDouble(elapsedSecondsColumnIndex);
+		maximumElapsedSeconds = minimumElapsedSeconds;
+		while( dischargeSpreadsheet.readNextRow() )
+		{
+			tmpDouble = dischargeSpreadsheet.getDouble(elapsedSecondsColumnIndex);
+			if( tmpDouble < minimumElapsedSeconds ) { minimumElapsedSeconds = tmpDouble; }
+			if( maximumElapsedSeconds < tmpDouble ) { maximumElapsedSeconds = tmpDouble; }
+		}
 	}
 
 	if(elapsedSecondsNode == 0)
 	{
-		tmpDouble = *(std::min_element(elapsedSeconds.begin(),elapsedSeconds.end()));
+		tmpDouble = minimumElapsedSeconds;
 	}
 	else
 	{
@@ -276,7 +327,7 @@ ConstructionVariables StandardInput::createOverallParameters(pugi::xml_node root
 
 	if(finishSecondsNode == 0)
 	{
-		tmpDouble = *(std::max_element(elapsedSeconds.begin(),elapsedSeconds.end()));
+		tmpDouble = maximumElapsedSeconds;
 	}
 	else
 	{
@@ -352,10 +403,8 @@ std::pair<ConstructionVariables, RiverSystemInformation> StandardInput::createRi
 
 	std::vector<ConstructionVariables> emptyConstructionVariablesVector;
 	std::vector<ConstructionVariables> tmpConstructionVariablesVector;
-	std::vector<double> tmpDoubleVector;
 
 	std::istringstream iStringStream;
-	std::ostringstream oStringStream;
 
 	pugi::xml_node overallParametersNode = rootNode.child("overallParameters");
 	if ( !overallParametersNode )
@@ -500,69 +549,49 @@ std::pair<ConstructionVariables, RiverSystemInformation> StandardInput::createRi
 	for(std::vector<RiverBranchForStandardInput>::iterator currentRiverBranch = riverBranches.begin(); currentRiverBranch < riverBranches.end(); ++currentRiverBranch)
 	{
 		if( !(checkIfIntVectorContainsValue(downstreamBranchIDs,currentRiverBranch->branchID)) ) { currentRiverBranch->upstreamMargin = true; }
-		currentRiverBranch->topmostCellID = currentTopmostCellID;
-		mapFromRiverBranchIDToUpmostCellID[ currentRiverBranch->branchID ] = currentRiverBranch->topmostCellID;
-		//Adjust numberOfCells
-		currentFileName.clear();
-		currentFileName = longitudinalProfilePath;
-		currentFileName.append("Branch");
-		oStringStream.str("");
-		oStringStream.clear();
-		oStringStream << currentRiverBranch->branchID << std::flush;
-		currentFileName.append(oStringStream.str());
-		currentFileName.append("Profile.txt");
-		currentSpreadsheetReadOut.clear();
-		currentSpreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(currentFileName);
-		currentRiverBranch->numberOfCells = (currentSpreadsheetReadOut.begin())->second.size();
-		currentTopmostCellID += currentRiverBranch->numberOfCells;
-		//Adjust topmostKilometrage
-		currentFileName.clear();
-		currentFileName = longitudinalProfilePath;
-		currentFileName.append("Branch");
-		oStringStream.str("");
-		oStringStream.clear();
-		oStringStream << currentRiverBranch->branchID << std::flush;
-		currentFileName.append(oStringStream.str());
-		currentFileName.append("Profile.txt");
-		currentSpreadsheetReadOut.clear();
-		currentSpreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(currentFileName);
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("KilometrageUpstreamDirected");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
+	}
+
+	// The spreadsheets of the single branches are independent of each other. Thus they are read and converted in parallel,
+	// while everything depending on the order of the branches is done afterwards in a serial loop.
+	// Thus the result is the same for any number of threads.
+	int numberOfRiverBranches = riverBranches.size();
+	std::vector<LongitudinalProfileForStandardInput> longitudinalProfiles (numberOfRiverBranches);
+	std::vector<double> initialDischargesOfUpstreamMargins (numberOfRiverBranches, 0.0);
+	std::vector<const char*> errorMessagesOfRiverBranches (numberOfRiverBranches, static_cast<const char*>(NULL));
+	#pragma omp parallel for schedule(dynamic) default(shared)
+	for(int i = 0; i < numberOfRiverBranches; ++i)
+	{
+		try
 		{
-			const char *const kilometrageUpstreamDirectedErrorMessage = "The column KilometrageUpstreamDirected is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
-			throw(kilometrageUpstreamDirectedErrorMessage);
+			longitudinalProfiles[i] = createLongitudinalProfileFromSpreadsheet( createBranchFileName(longitudinalProfilePath,riverBranches[i].branchID,"Profile.txt"), thicknessInputsIncludingPoreVolume, poreVolumeFraction );
+			if( riverBranches[i].upstreamMargin ) { initialDischargesOfUpstreamMargins[i] = readInitialDischargeFromSpreadsheet( createBranchFileName(dischargePath,riverBranches[i].branchID,"Discharge.txt") ); }
 		}
-		currentRiverBranch->topmostKilometrage = *( (StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second )).begin() );
+		catch (const char *const msg) { errorMessagesOfRiverBranches[i] = msg; }
+		catch (std::exception& e) { errorMessagesOfRiverBranches[i] = createErrorMessageCopy(e.what()); }
+		catch (...) { errorMessagesOfRiverBranches[i] = "Unknown error while reading the spreadsheets of a river branch within StandardInput input reader."; }
+	}
+	throwFirstErrorMessage(errorMessagesOfRiverBranches);
+
+	for(int i = 0; i < numberOfRiverBranches; ++i)
+	{
+		RiverBranchForStandardInput& currentRiverBranch = riverBranches[i];
+		currentRiverBranch.topmostCellID = currentTopmostCellID;
+		mapFromRiverBranchIDToUpmostCellID[ currentRiverBranch.branchID ] = currentRiverBranch.topmostCellID;
+		//Adjust numberOfCells and topmostKilometrage
+		currentRiverBranch.numberOfCells = longitudinalProfiles[i].kilometers.size();
+		currentTopmostCellID += currentRiverBranch.numberOfCells;
+		currentRiverBranch.topmostKilometrage = longitudinalProfiles[i].kilometers.at(0);
 		//Update mapFromBranchIdToInitialDischarge
-		if( currentRiverBranch->upstreamMargin )
-		{
-			currentFileName.clear();
-			currentFileName = dischargePath;
-			currentFileName.append("Branch");
-			oStringStream.str("");
-			oStringStream.clear();
-			oStringStream << currentRiverBranch->branchID << std::flush;
-			currentFileName.append(oStringStream.str());
-			currentFileName.append("Discharge.txt");
-			currentSpreadsheetReadOut.clear();
-			currentSpreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(currentFileName);
-			iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("DischargeInM3PerS");
-			if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
-			{
-				const char *const dischargeErrorMessage = "The column DischargeInM3PerS is needed within discharge spreadsheets for StandardInput input reader.";
-				throw(dischargeErrorMessage);
-			}
-			mapFromBranchIdToInitialDischarge[currentRiverBranch->branchID] = *((StringTools::stringVectorToDoubleVector(iteratorForSpreadsheetReadOut->second)).begin());
-		}
-		if( !(currentRiverBranch->downstreamMargin) )
+		if( currentRiverBranch.upstreamMargin ) { mapFromBranchIdToInitialDischarge[currentRiverBranch.branchID] = initialDischargesOfUpstreamMargins[i]; }
+		if( !(currentRiverBranch.downstreamMargin) )
 		{
-			iteratorForMapFromBranchIdToInitialDischarge = mapFromBranchIdToInitialDischarge.find( currentRiverBranch->branchID );
+			iteratorForMapFromBranchIdToInitialDischarge = mapFromBranchIdToInitialDischarge.find( currentRiverBranch.branchID );
 			currentBranchInitialDischarge = iteratorForMapFromBranchIdToInitialDischarge->second;
-			iteratorForMapFromBranchIdToInitialDischarge = mapFromBranchIdToInitialDischarge.find( currentRiverBranch->downstreamBranchID );
+			iteratorForMapFromBranchIdToInitialDischarge = mapFromBranchIdToInitialDischarge.find( currentRiverBranch.downstreamBranchID );
 			if( iteratorForMapFromBranchIdToInitialDischarge == mapFromBranchIdToInitialDischarge.end() )
 			{
-				mapFromBranchIdToInitialDischarge[currentRiverBranch->downstreamBranchID] = 0.0;
-				iteratorForMapFromBranchIdToInitialDischarge = mapFromBranchIdToInitialDischarge.find( currentRiverBranch->downstreamBranchID );
+				mapFromBranchIdToInitialDischarge[currentRiverBranch.downstreamBranchID] = 0.0;
+				iteratorForMapFromBranchIdToInitialDischarge = mapFromBranchIdToInitialDischarge.find( currentRiverBranch.downstreamBranchID );
 			}
 			iteratorForMapFromBranchIdToInitialDischarge->second += currentBranchInitialDischarge;
 		}
@@ -649,286 +678,211 @@ std::pair<ConstructionVariables, RiverSystemInformation> StandardInput::createRi
 	std::vector<double> fractionalGrainDiametersOfFirstReach;
 	std::vector<CombinerVariables::TypesOfGrains> grainTypesOfFirstReach;
 	std::string currentGrainTypeAsString;
-	bool firstReach = true;
-	//TODO Adjust this value to a reasonable 1, whenever the Problem in the RegularRiverSystemProperties is solved.
-	int currentCellID = 1001;
-	int currentDownstreamCellID;
-	int currentBranchID;
-	double currentLength = 4.0;
-	bool currentSillOccurence;
-	double currentSillTopEdgeElevation;
-	double currentPoleniFactor;
-	std::pair<int,double> tmpSillMapKey;
-	std::map< std::pair<int,double>, std::pair<double,double> >::const_iterator sillMapIterator;
-	std::vector<std::string> currentKilometersAsString;
-	std::vector<std::string>::const_iterator currentStringKilometersEntry;
-	std::vector<double> currentKilometers;
-	std::vector<double> currentElevations;
-	std::vector<double> currentChannelWidths;
-	std::vector<double> currentAlluviumThicknesses;
-	std::vector<double> currentBedrockRoughnessEquivalentRepresentativeGrainDiameters;
-	std::vector<std::string> currentStrataGrainSizeDistributions;
-	std::vector<std::string>::const_iterator currentStrataGrainSizeDistributionsEntry;
-	std::vector<std::string> currentSurfaceLayerGrainSizeDistributions;
-	std::vector<std::string>::const_iterator currentSurfaceLayerGrainSizeDistributionsEntry;
 	std::map<std::string,ConstructionVariables> mapFromGrainSizeDistributionNameToConstructionVariables;
-	std::map<std::string,ConstructionVariables>::const_iterator grainSizeDistributionMapIterator;
-	bool bedrockRoughnessGiven;
 	std::map<std::string,double> mapFromGrainSizeDistributionNameToD84;
-	std::map<std::string,double>::const_iterator D84MapIterator;
 	std::map<std::pair<int,std::string>,int> mapFromBranchIDAndKilometrageToUserCellID;
 	std::pair<int,std::string> currentKeyForMapFromBranchIDAndKilometrageToUserCellID;
-	currentFileName.clear();
-	currentFileName = path;
-	currentFileName.append("Output/ReachIDExplanations.txt");
-	std::ofstream outputFileForCellIDsBranchIDsAndKilometrage;
-	currentFileNameAsCharPointer = new char [currentFileName.size()+1];
-	std::strcpy(currentFileNameAsCharPointer, currentFileName.c_str());
-	outputFileForCellIDsBranchIDsAndKilometrage.open(currentFileNameAsCharPointer, std::ios::out | std::ios::trunc);
-	delete[] currentFileNameAsCharPointer;
-	outputFileForCellIDsBranchIDsAndKilometrage << "ReachID\tBranchID\tKilometrage" << std::endl;
 
-	for(std::vector<RiverBranchForStandardInput>::const_iterator currentRiverBranch = riverBranches.begin(); currentRiverBranch < riverBranches.end(); ++currentRiverBranch)
+	//Collect the grain size distributions in the order of their first occurence.
+	std::vector<std::string> grainSizeDistributionNames;
+	std::set<std::string> alreadyCollectedGrainSizeDistributionNames;
+	for(std::vector<LongitudinalProfileForStandardInput>::const_iterator currentLongitudinalProfile = longitudinalProfiles.begin(); currentLongitudinalProfile < longitudinalProfiles.end(); ++currentLongitudinalProfile)
+	{
+		for(std::vector<std::string>::const_iterator currentStrataGrainSizeDistributionsEntry = currentLongitudinalProfile->strataGrainSizeDistributions.begin(), currentSurfaceLayerGrainSizeDistributionsEntry = currentLongitudinalProfile->surfaceLayerGrainSizeDistributions.begin(); currentStrataGrainSizeDistributionsEntry < currentLongitudinalProfile->strataGrainSizeDistributions.end(); ++currentStrataGrainSizeDistributionsEntry, ++currentSurfaceLayerGrainSizeDistributionsEntry)
+		{
+			if( alreadyCollectedGrainSizeDistributionNames.insert(*currentStrataGrainSizeDistributionsEntry).second ) { grainSizeDistributionNames.push_back(*currentStrataGrainSizeDistributionsEntry); }
+			if( alreadyCollectedGrainSizeDistributionNames.insert(*currentSurfaceLayerGrainSizeDistributionsEntry).second ) { grainSizeDistributionNames.push_back(*currentSurfaceLayerGrainSizeDistributionsEntry); }
+		}
+	}
+
+	//The strata grain size distribution of the first reach defines the grain types.
+	if( !(grainSizeDistributionNames.empty()) )
 	{
-		currentBranchID = currentRiverBranch->branchID;
 		currentFileName.clear();
-		currentFileName = longitudinalProfilePath;
-		currentFileName.append("Branch");
-		oStringStream.str("");
-		oStringStream.clear();
-		oStringStream << currentBranchID << std::flush;
-		currentFileName.append(oStringStream.str());
-		currentFileName.append("Profile.txt");
+		currentFileName = grainSizeDistributionsPath;
+		currentFileName.append(grainSizeDistributionNames.front());
+		currentFileName.append(".txt");
 		currentSpreadsheetReadOut.clear();
 		currentSpreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(currentFileName);
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("KilometrageUpstreamDirected");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
-		{
-			const char *const kilometrageUpstreamDirectedErrorMessage = "The column KilometrageUpstreamDirected is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
-			throw(kilometrageUpstreamDirectedErrorMessage);
-		}
-		currentKilometersAsString = iteratorForSpreadsheetReadOut->second;
-		currentKilometers = StringTools::stringVectorToDoubleVector(currentKilometersAsString);
-		for(std::vector<double>::const_iterator currentKilometersEntry = currentKilometers.begin(), nextKilometersEntry = (currentKilometersEntry + 1); nextKilometersEntry < currentKilometers.end(); ++currentKilometersEntry,++nextKilometersEntry)
+		for(iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.begin(); iteratorForSpreadsheetReadOut != currentSpreadsheetReadOut.end(); ++iteratorForSpreadsheetReadOut)
 		{
-			if ( *currentKilometersEntry <= *nextKilometersEntry )
+			currentGrainTypeAsString.clear();
+			currentGrainTypeAsString = iteratorForSpreadsheetReadOut->first;
+			if( currentGrainTypeAsString != "GrainDiameterInCM" )
 			{
-				const char *const longitudinalProfileErrorMessage = "River reaches in LongitudinalProfile spreadsheets need to be sorted from upstream to downstream, i.e. kilometrage going from large to small values.";
-				throw(longitudinalProfileErrorMessage);
+				grainTypesOfFirstReach.push_back( CombinerVariables::stringToTypeOfGrains( currentGrainTypeAsString ) );
 			}
 		}
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("ElevationInM");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
-		{
-			const char *const elevationErrorMessage = "The column ElevationInM is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
-			throw(elevationErrorMessage);
-		}
-		currentElevations = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("ChannelWidthInM");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
-		{
-			const char *const channelWidthErrorMessage = "The column ChannelWidthInM is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
-			throw(channelWidthErrorMessage);
-		}
-		currentChannelWidths = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("AlluviumThicknessInM");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
-		{
-			currentAlluviumThicknesses = std::vector<double>(currentElevations.size(),4000.0);
-		}
-		else
-		{
-			currentAlluviumThicknesses = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
-		}
-		if(thicknessInputsIncludingPoreVolume)
-			{ std::transform(currentAlluviumThicknesses.begin(),currentAlluviumThicknesses.end(),currentAlluviumThicknesses.begin(),std::bind1st(std::multiplies<double>(),(1-poreVolumeFraction))); }
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("BedrockRoughnessEquivalentRepresentativeGrainDiameterInCM");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
-		{
-			bedrockRoughnessGiven = false;
-			currentBedrockRoughnessEquivalentRepresentativeGrainDiameters = std::vector<double>(currentElevations.size(),0.04);
-		}
-		else
-		{
-			bedrockRoughnessGiven = true;
-			currentBedrockRoughnessEquivalentRepresentativeGrainDiameters = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
-			//Convert cm into m.
-			std::transform(currentBedrockRoughnessEquivalentRepresentativeGrainDiameters.begin(),currentBedrockRoughnessEquivalentRepresentativeGrainDiameters.end(),currentBedrockRoughnessEquivalentRepresentativeGrainDiameters.begin(),std::bind1st(std::multiplies<double>(),0.01));
-		}
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("StrataGrainSizeDistribution");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
+	}
+
+	int numberOfGrainSizeDistributions = grainSizeDistributionNames.size();
+	std::vector< std::pair<std::vector<double>,ConstructionVariables> > fractionalGrainDiametersAndGrainsConstructionVariables (numberOfGrainSizeDistributions);
+	std::vector<const char*> errorMessagesOfGrainSizeDistributions (numberOfGrainSizeDistributions, static_cast<const char*>(NULL));
+	#pragma omp parallel for schedule(dynamic) default(shared)
+	for(int i = 0; i < numberOfGrainSizeDistributions; ++i)
+	{
+		try
 		{
-			const char *const strataGrainSizeDistributionErrorMessage = "The column StrataGrainSizeDistribution is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
-			throw(strataGrainSizeDistributionErrorMessage);
+			std::string grainSizeDistributionFileName = grainSizeDistributionsPath;
+			grainSizeDistributionFileName.append(grainSizeDistributionNames[i]);
+			grainSizeDistributionFileName.append(".txt");
+			fractionalGrainDiametersAndGrainsConstructionVariables[i] = createFractionalGrainDiametersAndGrainsConstructionVariablesFromSpreadsheet(grainSizeDistributionFileName,inputUpperBoundaryInsteadOfMeanGrainDiameter,useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters,lowerDiameterBoundaryForFinestFractionInCM,grainTypesOfFirstReach);
 		}
-		currentStrataGrainSizeDistributions = iteratorForSpreadsheetReadOut->second;
-		iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("SurfaceLayerGrainSizeDistribution");
-		if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
+		catch (const char *const msg) { errorMessagesOfGrainSizeDistributions[i] = msg; }
+		catch (std::exception& e) { errorMessagesOfGrainSizeDistributions[i] = createErrorMessageCopy(e.what()); }
+		catch (...) { errorMessagesOfGrainSizeDistributions[i] = "Unknown error while reading a grain size distribution within StandardInput input reader."; }
+	}
+	throwFirstErrorMessage(errorMessagesOfGrainSizeDistributions);
+
+	for(int i = 0; i < numberOfGrainSizeDistributions; ++i)
+	{
+		const std::vector<double>& currentFractionalGrainDiameters = fractionalGrainDiametersAndGrainsConstructionVariables[i].first;
+		if(i == 0)
 		{
-			currentSurfaceLayerGrainSizeDistributions = currentStrataGrainSizeDistributions;
+			fractionalGrainDiametersOfFirstReach = currentFractionalGrainDiameters;
+			for(std::vector<double>::const_iterator currentGrainSize = fractionalGrainDiametersOfFirstReach.begin(), nextGrainSize = (currentGrainSize + 1); nextGrainSize < fractionalGrainDiametersOfFirstReach.end(); ++currentGrainSize,++nextGrainSize)
+			{
+				if ( *currentGrainSize >= *nextGrainSize )
+				{
+					const char *const sortedGrainSizesErrorMessage = "Grain sizes in corresponding spreadsheets need to be sorted from small to large.";
+					throw(sortedGrainSizesErrorMessage);
+				}
+			}
 		}
 		else
 		{
-			currentSurfaceLayerGrainSizeDistributions = iteratorForSpreadsheetReadOut->second;
-		}
-
-		currentStringKilometersEntry = currentKilometersAsString.begin();
-		currentStrataGrainSizeDistributionsEntry = currentStrataGrainSizeDistributions.begin();
-		currentSurfaceLayerGrainSizeDistributionsEntry = currentSurfaceLayerGrainSizeDistributions.begin();
-		for(std::vector<double>::const_iterator currentKilometersEntry = currentKilometers.begin(), currentElevationEntry = currentElevations.begin(), currentChannelWidthEntry = currentChannelWidths.begin(), currentAlluviumThicknessEntry = currentAlluviumThicknesses.begin(), currentBedrockRoughnessEquivalentRepresentativeGrainDiameterEntry = currentBedrockRoughnessEquivalentRepresentativeGrainDiameters.begin(); currentKilometersEntry < currentKilometers.end(); ++currentKilometersEntry, ++currentStrataGrainSizeDistributionsEntry, ++currentSurfaceLayerGrainSizeDistributionsEntry, ++currentStringKilometersEntry, ++currentElevationEntry, ++currentChannelWidthEntry, ++currentAlluviumThicknessEntry, ++currentBedrockRoughnessEquivalentRepresentativeGrainDiameterEntry)
-		{
-			currentKeyForMapFromBranchIDAndKilometrageToUserCellID = std::make_pair(currentBranchID,*currentStringKilometersEntry);
-			mapFromBranchIDAndKilometrageToUserCellID[currentKeyForMapFromBranchIDAndKilometrageToUserCellID] = currentCellID;
-
-			//TODO Remove this bugfix subtraction by 1000, whenever the Problem in the RegularRiverSystemProperties is solved.
-			outputFileForCellIDsBranchIDsAndKilometrage << (currentCellID-1000) << "\t" << currentBranchID << "\t" << *currentStringKilometersEntry << std::endl;
-
-			if( currentElevationEntry != (currentElevations.end()-1) || currentRiverBranch == (riverBranches.end()-1) ) { currentDownstreamCellID = currentCellID + 1; }
-			else { currentDownstreamCellID = RiverBranchForStandardInput::getTopmostCellIDofCertainBranch(riverBranches,currentRiverBranch->downstreamBranchID); }
-
-			if( currentKilometersEntry != (currentKilometers.end()-1) ) { currentLength = *currentKilometersEntry - *(currentKilometersEntry+1); }
-			else
+			if( fractionalGrainDiametersOfFirstReach.size() != currentFractionalGrainDiameters.size() )
 			{
-				if( currentRiverBranch != (riverBranches.end()-1) ) { currentLength = *currentKilometersEntry - RiverBranchForStandardInput::getTopmostKilometrageofCertainBranch(riverBranches,currentRiverBranch->downstreamBranchID); }
-				else { currentLength = *currentKilometersEntry - kilometrageOfSimulationOutlet; }
+				const char *const grainSizesNumberErrorMessage = "The number of treated grain sizes needs to be the same in all corresponding spreadsheets.";
+				throw(grainSizesNumberErrorMessage);
 			}
-			//Translate currentLength from km to m
-			currentLength *= 1000.0;
-
-			tmpSillMapKey = std::make_pair(currentBranchID,*currentKilometersEntry);
-			sillMapIterator = mapFromSillLocationsToTopEdgeElevationsANDPoleniFactors.find(tmpSillMapKey);
-			if( sillMapIterator == mapFromSillLocationsToTopEdgeElevationsANDPoleniFactors.end() )
+			for(std::vector<double>::const_iterator currentFirstReachGrainSize = fractionalGrainDiametersOfFirstReach.begin(), currentGrainSize = currentFractionalGrainDiameters.begin(); currentFirstReachGrainSize < fractionalGrainDiametersOfFirstReach.end(); ++currentFirstReachGrainSize, ++currentGrainSize)
 			{
-				currentSillOccurence = false;
-				currentSillTopEdgeElevation = -9999.0;
-				currentPoleniFactor = -9999.0;
+				if ( *currentFirstReachGrainSize != *currentGrainSize )
+				{
+					const char *const sameGrainSizesFractionsErrorMessage = "The treated grain sizes need to be exactly the same in all corresponding spreadsheets.";
+					throw(sameGrainSizesFractionsErrorMessage);
+				}
 			}
-			else
+		}
+		mapFromGrainSizeDistributionNameToConstructionVariables[grainSizeDistributionNames[i]] = fractionalGrainDiametersAndGrainsConstructionVariables[i].second;
+	}
+
+	//Without given bedrock roughness the D84 of the surface layer is used instead.
+	for(std::vector<LongitudinalProfileForStandardInput>::const_iterator currentLongitudinalProfile = longitudinalProfiles.begin(); currentLongitudinalProfile < longitudinalProfiles.end(); ++currentLongitudinalProfile)
+	{
+		if( currentLongitudinalProfile->bedrockRoughnessGiven ) { continue; }
+		for(std::vector<std::string>::const_iterator currentSurfaceLayerGrainSizeDistributionsEntry = currentLongitudinalProfile->surfaceLayerGrainSizeDistributions.begin(); currentSurfaceLayerGrainSizeDistributionsEntry < currentLongitudinalProfile->surfaceLayerGrainSizeDistributions.end(); ++currentSurfaceLayerGrainSizeDistributionsEntry)
+		{
+			if( mapFromGrainSizeDistributionNameToD84.find(*currentSurfaceLayerGrainSizeDistributionsEntry) == mapFromGrainSizeDistributionNameToD84.end() )
 			{
-				currentSillOccurence = true;
-				currentSillTopEdgeElevation = (sillMapIterator->second).first;
-				if(dropHeightInsteadOfTopEdgeElevation) { currentSillTopEdgeElevation += *currentElevationEntry; }
-				currentPoleniFactor = (sillMapIterator->second).second;
+				HighestOrderStructuresPointers tmpHighestOrderStructuresPointers;
+				Grains* tmpArmourGrainsPointer = static_cast<Grains*>( SedFlowBuilders::generalBuilder(mapFromGrainSizeDistributionNameToConstructionVariables[*currentSurfaceLayerGrainSizeDistributionsEntry],tmpHighestOrderStructuresPointers) );
+				Grains armourLayerGrains = Grains(*tmpArmourGrainsPointer);
+				delete tmpArmourGrainsPointer;
+				mapFromGrainSizeDistributionNameToD84[*currentSurfaceLayerGrainSizeDistributionsEntry] = armourLayerGrains.getPercentileGrainDiameter(fractionalGrainDiametersOfFirstReach,84.0);
 			}
+		}
+	}
 
-			grainSizeDistributionMapIterator = mapFromGrainSizeDistributionNameToConstructionVariables.find(*currentStrataGrainSizeDistributionsEntry);
-			if( grainSizeDistributionMapIterator == mapFromGrainSizeDistributionNameToConstructionVariables.end() )
+	std::vector< std::vector<ConstructionVariables> > cellPropertiesOfRiverBranches (numberOfRiverBranches);
+	#pragma omp parallel for schedule(dynamic) default(shared)
+	for(int i = 0; i < numberOfRiverBranches; ++i)
+	{
+		try
+		{
+			const RiverBranchForStandardInput& currentRiverBranch = riverBranches[i];
+			const LongitudinalProfileForStandardInput& currentLongitudinalProfile = longitudinalProfiles[i];
+			int currentBranchID = currentRiverBranch.branchID;
+			int currentCellID = currentRiverBranch.topmostCellID;
+			int currentDownstreamCellID;
+			double currentLength;
+			bool currentSillOccurence;
+			double currentSillTopEdgeElevation;
+			double currentPoleniFactor;
+			std::map< std::pair<int,double>, std::pair<double,double> >::const_iterator sillMapIterator;
+			std::vector<double> tmpDoubleVector;
+			std::vector<ConstructionVariables>& currentCellProperties = cellPropertiesOfRiverBranches[i];
+			currentCellProperties.reserve(currentLongitudinalProfile.kilometers.size());
+
+			for(unsigned int j = 0; j < currentLongitudinalProfile.kilometers.size(); ++j)
 			{
-				currentFileName.clear();
-				currentFileName = grainSizeDistributionsPath;
-				currentFileName.append(*currentStrataGrainSizeDistributionsEntry);
-				currentFileName.append(".txt");
-				if(firstReach)
-				{
-					currentSpreadsheetReadOut.clear();
-					currentSpreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(currentFileName);
-					for(iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.begin(); iteratorForSpreadsheetReadOut != currentSpreadsheetReadOut.end(); ++iteratorForSpreadsheetReadOut)
-					{
-						currentGrainTypeAsString.clear();
-						currentGrainTypeAsString = iteratorForSpreadsheetReadOut->first;
-						if( currentGrainTypeAsString != "GrainDiameterInCM" )
-						{
-							grainTypesOfFirstReach.push_back( CombinerVariables::stringToTypeOfGrains( currentGrainTypeAsString ) );
-						}
-					}
-				}
-				std::pair<std::vector<double>,ConstructionVariables> strataGrainsFractionalGrainDiametersAndGrainsConstructionVariables = createFractionalGrainDiametersAndGrainsConstructionVariablesFromSpreadsheet(currentFileName,inputUpperBoundaryInsteadOfMeanGrainDiameter,useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters,lowerDiameterBoundaryForFinestFractionInCM,grainTypesOfFirstReach);
-				std::vector<double> strataGrainsFractionalGrainDiameters = strataGrainsFractionalGrainDiametersAndGrainsConstructionVariables.first;
-				if(firstReach)
-				{
-					fractionalGrainDiametersOfFirstReach = strataGrainsFractionalGrainDiameters;
-					for(std::vector<double>::const_iterator currentGrainSize = fractionalGrainDiametersOfFirstReach.begin(), nextGrainSize = (currentGrainSize + 1); nextGrainSize < fractionalGrainDiametersOfFirstReach.end(); ++currentGrainSize,++nextGrainSize)
-					{
-						if ( *currentGrainSize >= *nextGrainSize )
-						{
-							const char *const sortedGrainSizesErrorMessage = "Grain sizes in corresponding spreadsheets need to be sorted from small to large.";
-							throw(sortedGrainSizesErrorMessage);
-						}
-					}
-					firstReach = false;
-				}
+				if( j != (currentLongitudinalProfile.kilometers.size()-1) || i == (numberOfRiverBranches-1) ) { currentDownstreamCellID = currentCellID + 1; }
+				else { currentDownstreamCellID = RiverBranchForStandardInput::getTopmostCellIDofCertainBranch(riverBranches,currentRiverBranch.downstreamBranchID); }
+
+				if( j != (currentLongitudinalProfile.kilometers.size()-1) ) { currentLength = currentLongitudinalProfile.kilometers[j] - currentLongitudinalProfile.kilometers[j+1]; }
 				else
 				{
-					if( fractionalGrainDiametersOfFirstReach.size() != strataGrainsFractionalGrainDiameters.size() )
-					{
-						const char *const grainSizesNumberErrorMessage = "The number of treated grain sizes needs to be the same in all corresponding spreadsheets.";
-						throw(grainSizesNumberErrorMessage);
-					}
-					for(std::vector<double>::const_iterator currentFirstReachGrainSize = fractionalGrainDiametersOfFirstReach.begin(), currentStrataGrainSize = strataGrainsFractionalGrainDiameters.begin(); currentFirstReachGrainSize < fractionalGrainDiametersOfFirstReach.end(); ++currentFirstReachGrainSize, ++currentStrataGrainSize)
-					{
-						if ( *currentFirstReachGrainSize != *currentStrataGrainSize )
-						{
-							const char *const sameGrainSizesFractionsErrorMessage = "The treated grain sizes need to be exactly the same in all corresponding spreadsheets.";
-							throw(sameGrainSizesFractionsErrorMessage);
-						}
-					}
+					if( i != (numberOfRiverBranches-1) ) { currentLength = currentLongitudinalProfile.kilometers[j] - RiverBranchForStandardInput::getTopmostKilometrageofCertainBranch(riverBranches,currentRiverBranch.downstreamBranchID); }
+					else { currentLength = currentLongitudinalProfile.kilometers[j] - kilometrageOfSimulationOutlet; }
 				}
-				mapFromGrainSizeDistributionNameToConstructionVariables[*currentStrataGrainSizeDistributionsEntry] = strataGrainsFractionalGrainDiametersAndGrainsConstructionVariables.second;
-				grainSizeDistributionMapIterator = mapFromGrainSizeDistributionNameToConstructionVariables.find(*currentStrataGrainSizeDistributionsEntry);
-			}
-			ConstructionVariables strataGrains = grainSizeDistributionMapIterator->second;
+				//Translate currentLength from km to m
+				currentLength *= 1000.0;
 
-			grainSizeDistributionMapIterator = mapFromGrainSizeDistributionNameToConstructionVariables.find(*currentSurfaceLayerGrainSizeDistributionsEntry);
-			if( grainSizeDistributionMapIterator == mapFromGrainSizeDistributionNameToConstructionVariables.end() )
-			{
-				currentFileName.clear();
-				currentFileName = grainSizeDistributionsPath;
-				currentFileName.append(*currentSurfaceLayerGrainSizeDistributionsEntry);
-				currentFileName.append(".txt");
-				std::pair<std::vector<double>,ConstructionVariables> armourGrainsFractionalGrainDiametersAndGrainsConstructionVariables = createFractionalGrainDiametersAndGrainsConstructionVariablesFromSpreadsheet(currentFileName,inputUpperBoundaryInsteadOfMeanGrainDiameter,useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters,lowerDiameterBoundaryForFinestFractionInCM,grainTypesOfFirstReach);
-				std::vector<double> armourGrainsFractionalGrainDiameters = armourGrainsFractionalGrainDiametersAndGrainsConstructionVariables.first;
-				if( fractionalGrainDiametersOfFirstReach.size() != armourGrainsFractionalGrainDiameters.size() )
+				sillMapIterator = mapFromSillLocationsToTopEdgeElevationsANDPoleniFactors.find( std::make_pair(currentBranchID,currentLongitudinalProfile.kilometers[j]) );
+				if( sillMapIterator == mapFromSillLocationsToTopEdgeElevationsANDPoleniFactors.end() )
 				{
-					const char *const grainSizesNumberErrorMessage = "The number of treated grain sizes needs to be the same in all corresponding spreadsheets.";
-					throw(grainSizesNumberErrorMessage);
+					currentSillOccurence = false;
+					currentSillTopEdgeElevation = -9999.0;
+					currentPoleniFactor = -9999.0;
 				}
-				for(std::vector<double>::const_iterator currentFirstReachGrainSize = fractionalGrainDiametersOfFirstReach.begin(), currentArmourGrainSize = armourGrainsFractionalGrainDiameters.begin(); currentFirstReachGrainSize < fractionalGrainDiametersOfFirstReach.end(); ++currentFirstReachGrainSize, ++currentArmourGrainSize)
+				else
 				{
-					if ( *currentFirstReachGrainSize != *currentArmourGrainSize )
-					{
-						const char *const sameGrainSizesFractionsErrorMessage = "The treated grain sizes need to be exactly the same in all corresponding spreadsheets.";
-						throw(sameGrainSizesFractionsErrorMessage);
-					}
+					currentSillOccurence = true;
+					currentSillTopEdgeElevation = (sillMapIterator->second).first;
+					if(dropHeightInsteadOfTopEdgeElevation) { currentSillTopEdgeElevation += currentLongitudinalProfile.elevations[j]; }
+					currentPoleniFactor = (sillMapIterator->second).second;
 				}
-				mapFromGrainSizeDistributionNameToConstructionVariables[*currentSurfaceLayerGrainSizeDistributionsEntry] = armourGrainsFractionalGrainDiametersAndGrainsConstructionVariables.second;
-				grainSizeDistributionMapIterator = mapFromGrainSizeDistributionNameToConstructionVariables.find(*currentSurfaceLayerGrainSizeDistributionsEntry);
-			}
-			ConstructionVariables armourGrains = grainSizeDistributionMapIterator->second;
 
-			double currentBedrockRoughnessEquivalentRepresentativeGrainDiameter;
-			if(bedrockRoughnessGiven)
-			{
-				currentBedrockRoughnessEquivalentRepresentativeGrainDiameter = *currentBedrockRoughnessEquivalentRepresentativeGrainDiameterEntry;
-			}
-			else
-			{
-				D84MapIterator = mapFromGrainSizeDistributionNameToD84.find(*currentSurfaceLayerGrainSizeDistributionsEntry);
-				if( D84MapIterator == mapFromGrainSizeDistributionNameToD84.end() )
-				{
-					HighestOrderStructuresPointers tmpHighestOrderStructuresPointers;
-					Grains* tmpArmourGrainsPointer = static_cast<Grains*>( SedFlowBuilders::generalBuilder(armourGrains,tmpHighestOrderStructuresPointers) );
-					Grains armourLayerGrains = Grains(*tmpArmourGrainsPointer);
-					delete tmpArmourGrainsPointer;
-					mapFromGrainSizeDistributionNameToD84[*currentSurfaceLayerGrainSizeDistributionsEntry] = armourLayerGrains.getPercentileGrainDiameter(fractionalGrainDiametersOfFirstReach,84.0);
-					D84MapIterator = mapFromGrainSizeDistributionNameToD84.find(*currentSurfaceLayerGrainSizeDistributionsEntry);
-				}
-				currentBedrockRoughnessEquivalentRepresentativeGrainDiameter = D84MapIterator->second;
+				const ConstructionVariables& strataGrains = mapFromGrainSizeDistributionNameToConstructionVariables.find(currentLongitudinalProfile.strataGrainSizeDistributions[j])->second;
+				const ConstructionVariables& armourGrains = mapFromGrainSizeDistributionNameToConstructionVariables.find(currentLongitudinalProfile.surfaceLayerGrainSizeDistributions[j])->second;
+
+				double currentBedrockRoughnessEquivalentRepresentativeGrainDiameter;
+				if(currentLongitudinalProfile.bedrockRoughnessGiven) { currentBedrockRoughnessEquivalentRepresentativeGrainDiameter = currentLongitudinalProfile.bedrockRoughnessEquivalentRepresentativeGrainDiameters[j]; }
+				else { currentBedrockRoughnessEquivalentRepresentativeGrainDiameter = mapFromGrainSizeDistributionNameToD84.find(currentLongitudinalProfile.surfaceLayerGrainSizeDistributions[j])->second; }
+
+				ConstructionVariables currentSillProperties;
+				currentSillProperties.interfaceOrCombinerType = CombinerVariables::SillProperties;
+				currentSillProperties.realisationType = CombinerVariables::typeOfSillPropertiesToString( CombinerVariables::PoleniSill );
+				tmpDoubleVector.clear();
+				tmpDoubleVector.push_back(currentLongitudinalProfile.channelWidths[j]);
+				currentSillProperties.labelledDoubles["overfallWidth"] = tmpDoubleVector;
+				tmpDoubleVector.clear();
+				tmpDoubleVector.push_back(currentPoleniFactor);
+				currentSillProperties.labelledDoubles["poleniFactor"] = tmpDoubleVector;
+
+				currentCellProperties.push_back( createInfinitelyDeepRectangularRiverReachProperties(currentCellID,currentDownstreamCellID,currentLongitudinalProfile.elevations[j],currentLongitudinalProfile.channelWidths[j],currentLength,currentBedrockRoughnessEquivalentRepresentativeGrainDiameter,currentSillOccurence,currentSillTopEdgeElevation,currentRiverBranch.initialDischarge,currentLongitudinalProfile.alluviumThicknesses[j],upstreamOfSillsWedgeShapedInsteadOfParallelUpdate,armourGrains,strataGrains,strataSorting,currentSillProperties,useInitialGrainSizesForConstantLayerThickness,fractionalGrainDiametersOfFirstReach,numberOfLayers) );
+				++currentCellID;
 			}
+		}
+		catch (const char *const msg) { errorMessagesOfRiverBranches[i] = msg; }
+		catch (std::exception& e) { errorMessagesOfRiverBranches[i] = createErrorMessageCopy(e.what()); }
+		catch (...) { errorMessagesOfRiverBranches[i] = "Unknown error while creating the reaches of a river branch within StandardInput input reader."; }
+	}
+	throwFirstErrorMessage(errorMessagesOfRiverBranches);
 
-			ConstructionVariables currentSillProperties;
-			currentSillProperties.interfaceOrCombinerType = CombinerVariables::SillProperties;
-			currentSillProperties.realisationType = CombinerVariables::typeOfSillPropertiesToString( CombinerVariables::PoleniSill );
-			tmpDoubleVector.clear();
-			tmpDoubleVector.push_back(*currentChannelWidthEntry);
-			currentSillProperties.labelledDoubles["overfallWidth"] = tmpDoubleVector;
-			tmpDoubleVector.clear();
-			tmpDoubleVector.push_back(currentPoleniFactor);
-			currentSillProperties.labelledDoubles["poleniFactor"] = tmpDoubleVector;
+	currentFileName.clear();
+	currentFileName = path;
+	currentFileName.append("Output/ReachIDExplanations.txt");
+	std::ofstream outputFileForCellIDsBranchIDsAndKilometrage;
+	currentFileNameAsCharPointer = new char [currentFileName.size()+1];
+	std::strcpy(currentFileNameAsCharPointer, currentFileName.c_str());
+	outputFileForCellIDsBranchIDsAndKilometrage.open(currentFileNameAsCharPointer, std::ios::out | std::ios::trunc);
+	delete[] currentFileNameAsCharPointer;
+	outputFileForCellIDsBranchIDsAndKilometrage << "ReachID\tBranchID\tKilometrage" << std::endl;
+
+	for(int i = 0; i < numberOfRiverBranches; ++i)
+	{
+		int currentCellID = riverBranches[i].topmostCellID;
+		for(std::vector<std::string>::const_iterator currentStringKilometersEntry = longitudinalProfiles[i].kilometersAsString.begin(); currentStringKilometersEntry < longitudinalProfiles[i].kilometersAsString.end(); ++currentStringKilometersEntry, ++currentCellID)
+		{
+			currentKeyForMapFromBranchIDAndKilometrageToUserCellID = std::make_pair(riverBranches[i].branchID,*currentStringKilometersEntry);
+			mapFromBranchIDAndKilometrageToUserCellID[currentKeyForMapFromBranchIDAndKilometrageToUserCellID] = currentCellID;
 
-			ConstructionVariables currentRiverReachProperties = createInfinitelyDeepRectangularRiverReachProperties(currentCellID,currentDownstreamCellID,*currentElevationEntry,*currentChannelWidthEntry,currentLength,currentBedrockRoughnessEquivalentRepresentativeGrainDiameter,currentSillOccurence,currentSillTopEdgeElevation,currentRiverBranch->initialDischarge,*currentAlluviumThicknessEntry,upstreamOfSillsWedgeShapedInsteadOfParallelUpdate,armourGrains,strataGrains,strataSorting,currentSillProperties,useInitialGrainSizesForConstantLayerThickness,fractionalGrainDiametersOfFirstReach,numberOfLayers);
-			cellProperties.push_back( currentRiverReachProperties );
-			++currentCellID;
+			//TODO Remove this bugfix subtraction by 1000, whenever the Problem in the RegularRiverSystemProperties is solved.
+			outputFileForCellIDsBranchIDsAndKilometrage << (currentCellID-1000) << "\t" << riverBranches[i].branchID << "\t" << *currentStringKilometersEntry << std::endl;
 		}
+		cellProperties.insert(cellProperties.end(), cellPropertiesOfRiverBranches[i].begin(), cellPropertiesOfRiverBranches[i].end());
 	}
 
 	outputFileForCellIDsBranchIDsAndKilometrage.close();
@@ -980,6 +934,224 @@ std::pair<ConstructionVariables, RiverSystemInformation> StandardInput::createRi
 	return result;
 }
 
+std::string StandardInput::collectInputXMLForRiverSystemProperties(pugi::xml_node rootNode)
+{
+	std::ostringstream oStringStream;
+	// The overallParameters are used for the initial hydraulics in total.
+	rootNode.child("overallParameters").print(oStringStream);
+
+	// Of the riverSystemMethods only the overallMethods and those used for the set-up of the reaches are considered.
+	// Thus e.g. the parameters of the bedload transport equations may be calibrated without converting the spreadsheets again.
+	pugi::xml_node riverSystemMethodsNode = rootNode.child("riverSystemMethods");
+	const char* const relevantRiverSystemMethods[] = {"waterFlowRouting", "flowResistance", "bedSlopeCalculationMethod", "waterEnergySlopeCalculationMethod", "sedimentEnergySlopeCalculationMethod", "bedloadVelocityCalculationMethod", "upstreamOfSillsWedgeShapedInsteadOfParallelUpdate", "strataSorting"};
+	for(int i = 0; i < 8; ++i)
+	{
+		oStringStream << relevantRiverSystemMethods[i] << std::endl;
+		riverSystemMethodsNode.child(relevantRiverSystemMethods[i]).print(oStringStream);
+	}
+	// The strataSorting might use the thresholdCalculationMethod of the bedload transport equations.
+	oStringStream << "thresholdCalculationMethod" << std::endl;
+	riverSystemMethodsNode.child("bedloadTransportEquations").child("thresholdCalculationMethod").print(oStringStream);
+
+	oStringStream << std::flush;
+	return oStringStream.str();
+}
+
+ConstructionVariables StandardInput::convertRiverSystemInformationIntoConstructionVariables(const RiverSystemInformation& riverSystemInformation)
+{
+	ConstructionVariables result;
+	result.interfaceOrCombinerType = CombinerVariables::UserInputReader;
+	result.realisationType = CombinerVariables::typeOfUserInputReadersToString(CombinerVariables::StandardInput);
+
+	for(std::vector<RiverBranchForStandardInput>::const_iterator currentBranch = riverSystemInformation.riverBranches.begin(); currentBranch < riverSystemInformation.riverBranches.end(); ++currentBranch)
+	{
+		result.labelledInts["branchID"].push_back(currentBranch->branchID);
+		result.labelledInts["downstreamBranchID"].push_back(currentBranch->downstreamBranchID);
+		result.labelledInts["numberOfCells"].push_back(currentBranch->numberOfCells);
+		result.labelledInts["topmostCellID"].push_back(currentBranch->topmostCellID);
+		result.labelledDoubles["topmostKilometrage"].push_back(currentBranch->topmostKilometrage);
+		result.labelledDoubles["initialDischarge"].push_back(currentBranch->initialDischarge);
+		result.labelledBools["upstreamMargin"].push_back(currentBranch->upstreamMargin);
+		result.labelledBools["downstreamMargin"].push_back(currentBranch->downstreamMargin);
+	}
+
+	for(std::map<std::pair<int,std::string>,int>::const_iterator currentEntry = riverSystemInformation.mapFromBranchIDAndKilometrageToUserCellID.begin(); currentEntry != riverSystemInformation.mapFromBranchIDAndKilometrageToUserCellID.end(); ++currentEntry)
+	{
+		result.labelledInts["mapBranchID"].push_back(currentEntry->first.first);
+		result.labelledStrings["mapKilometrage"].push_back(currentEntry->first.second);
+		result.labelledInts["mapUserCellID"].push_back(currentEntry->second);
+	}
+
+	for(std::vector<CombinerVariables::TypesOfGrains>::const_iterator currentTypeOfGrains = riverSystemInformation.usedTypesOfGrains.begin(); currentTypeOfGrains < riverSystemInformation.usedTypesOfGrains.end(); ++currentTypeOfGrains)
+	{
+		result.labelledStrings["usedTypesOfGrains"].push_back( CombinerVariables::typeOfGrainsToString(*currentTypeOfGrains) );
+	}
+	result.labelledDoubles["usedFractionalGrainDiameters"] = riverSystemInformation.usedFractionalGrainDiameters;
+
+	return result;
+}
+
+RiverSystemInformation StandardInput::convertConstructionVariablesIntoRiverSystemInformation(const ConstructionVariables& constructionVariables)
+{
+	// Missing entries correspond to empty vectors, as std::map::operator[] is not available for const maps.
+	ConstructionVariables source = constructionVariables;
+	RiverSystemInformation result;
+
+	std::vector<int>& branchIDs = source.labelledInts["branchID"];
+	for(int i = 0; i < static_cast<int>(branchIDs.size()); ++i)
+	{
+		RiverBranchForStandardInput currentBranch (branchIDs.at(i), source.labelledInts["downstreamBranchID"].at(i));
+		currentBranch.numberOfCells = source.labelledInts["numberOfCells"].at(i);
+		currentBranch.topmostCellID = source.labelledInts["topmostCellID"].at(i);
+		currentBranch.topmostKilometrage = source.labelledDoubles["topmostKilometrage"].at(i);
+		currentBranch.initialDischarge = source.labelledDoubles["initialDischarge"].at(i);
+		currentBranch.upstreamMargin = source.labelledBools["upstreamMargin"].at(i);
+		currentBranch.downstreamMargin = source.labelledBools["downstreamMargin"].at(i);
+		result.riverBranches.push_back(currentBranch);
+	}
+
+	std::vector<int>& mapBranchIDs = source.labelledInts["mapBranchID"];
+	for(int i = 0; i < static_cast<int>(mapBranchIDs.size()); ++i)
+	{
+		result.mapFromBranchIDAndKilometrageToUserCellID[ std::make_pair(mapBranchIDs.at(i), source.labelledStrings["mapKilometrage"].at(i)) ] = source.labelledInts["mapUserCellID"].at(i);
+	}
+
+	std::vector<std::string>& usedTypesOfGrains = source.labelledStrings["usedTypesOfGrains"];
+	for(std::vector<std::string>::const_iterator currentTypeOfGrains = usedTypesOfGrains.begin(); currentTypeOfGrains < usedTypesOfGrains.end(); ++currentTypeOfGrains)
+	{
+		result.usedTypesOfGrains.push_back( CombinerVariables::stringToTypeOfGrains(*currentTypeOfGrains) );
+	}
+	result.usedFractionalGrainDiameters = source.labelledDoubles["usedFractionalGrainDiameters"];
+
+	return result;
+}
+
+std::string StandardInput::createBranchFileName(const std::string& folder, int branchID, const char* suffix)
+{
+	std::ostringstream oStringStream;
+	oStringStream << folder << "Branch" << branchID << suffix << std::flush;
+	return oStringStream.str();
+}
+
+double StandardInput::readInitialDischargeFromSpreadsheet(const std::string& fileName)
+{
+	// Only the first value is needed. Thus the spreadsheet is not read completely.
+	TabDelimitedSpreadsheetStream dischargeSpreadsheet (fileName);
+	if( !(dischargeSpreadsheet.hasColumn("DischargeInM3PerS")) )
+	{
+		const char *const dischargeErrorMessage = "The column DischargeInM3PerS is needed within discharge spreadsheets for StandardInput input reader.";
+		throw(dischargeErrorMessage);
+	}
+	int dischargeColumnIndex = dischargeSpreadsheet.getColumnIndex("DischargeInM3PerS");
+	if( !(dischargeSpreadsheet.readNextRow()) )
+	{
+		std::string noSufficientRowErrorMessageString = "The following file does not contain any row with the minimum number of entries defined by the header line:\n";
+		noSufficientRowErrorMessageString.append(fileName);
+		noSufficientRowErrorMessageString.append("\n");
+		throw( createErrorMessageCopy(noSufficientRowErrorMessageString.c_str()) );
+	}
+	return dischargeSpreadsheet.getDouble(dischargeColumnIndex);
+}
+
+LongitudinalProfileForStandardInput StandardInput::createLongitudinalProfileFromSpreadsheet(const std::string& fileName, bool thicknessInputsIncludingPoreVolume, double poreVolumeFraction)
+{
+	LongitudinalProfileForStandardInput result;
+	std::map<std::string,std::vector<std::string> > spreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(fileName);
+	std::map<std::string,std::vector<std::string> >::const_iterator iteratorForSpreadsheetReadOut;
+
+	iteratorForSpreadsheetReadOut = spreadsheetReadOut.find("KilometrageUpstreamDirected");
+	if(iteratorForSpreadsheetReadOut == spreadsheetReadOut.end())
+	{
+		const char *const kilometrageUpstreamDirectedErrorMessage = "The column KilometrageUpstreamDirected is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
+		throw(kilometrageUpstreamDirectedErrorMessage);
+	}
+	result.kilometersAsString = iteratorForSpreadsheetReadOut->second;
+	result.kilometers = StringTools::stringVectorToDoubleVector(result.kilometersAsString);
+	for(std::vector<double>::const_iterator currentKilometersEntry = result.kilometers.begin(), nextKilometersEntry = (currentKilometersEntry + 1); nextKilometersEntry < result.kilometers.end(); ++currentKilometersEntry,++nextKilometersEntry)
+	{
+		if ( *currentKilometersEntry <= *nextKilometersEntry )
+		{
+			const char *const longitudinalProfileErrorMessage = "River reaches in LongitudinalProfile spreadsheets need to be sorted from upstream to downstream, i.e. kilometrage going from large to small values.";
+			throw(longitudinalProfileErrorMessage);
+		}
+	}
+	iteratorForSpreadsheetReadOut = spreadsheetReadOut.find("ElevationInM");
+	if(iteratorForSpreadsheetReadOut == spreadsheetReadOut.end())
+	{
+		const char *const elevationErrorMessage = "The column ElevationInM is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
+		throw(elevationErrorMessage);
+	}
+	result.elevations = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
+	iteratorForSpreadsheetReadOut = spreadsheetReadOut.find("ChannelWidthInM");
+	if(iteratorForSpreadsheetReadOut == spreadsheetReadOut.end())
+	{
+		const char *const channelWidthErrorMessage = "The column ChannelWidthInM is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
+		throw(channelWidthErrorMessage);
+	}
+	result.channelWidths = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
+	iteratorForSpreadsheetReadOut = spreadsheetReadOut.find("AlluviumThicknessInM");
+	if(iteratorForSpreadsheetReadOut == spreadsheetReadOut.end())
+	{
+		result.alluviumThicknesses = std::vector<double>(result.elevations.size(),4000.0);
+	}
+	else
+	{
+		result.alluviumThicknesses = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
+	}
+	if(thicknessInputsIncludingPoreVolume)
+		{ std::transform(result.alluviumThicknesses.begin(),result.alluviumThicknesses.end(),result.alluviumThicknesses.begin(),std::bind1st(std::multiplies<double>(),(1-poreVolumeFraction))); }
+	iteratorForSpreadsheetReadOut = spreadsheetReadOut.find("BedrockRoughnessEquivalentRepresentativeGrainDiameterInCM");
+	if(iteratorForSpreadsheetReadOut == spreadsheetReadOut.end())
+	{
+		result.bedrockRoughnessGiven = false;
+		result.bedrockRoughnessEquivalentRepresentativeGrainDiameters = std::vector<double>(result.elevations.size(),0.04);
+	}
+	else
+	{
+		result.bedrockRoughnessGiven = true;
+		result.bedrockRoughnessEquivalentRepresentativeGrainDiameters = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
+		//Convert cm into m.
+		std::transform(result.bedrockRoughnessEquivalentRepresentativeGrainDiameters.begin(),result.bedrockRoughnessEquivalentRepresentativeGrainDiameters.end(),result.bedrockRoughnessEquivalentRepresentativeGrainDiameters.begin(),std::bind1st(std::multiplies<double>(),0.01));
+	}
+	iteratorForSpreadsheetReadOut = spreadsheetReadOut.find("StrataGrainSizeDistribution");
+	if(iteratorForSpreadsheetReadOut == spreadsheetReadOut.end())
+	{
+		const char *const strataGrainSizeDistributionErrorMessage = "The column StrataGrainSizeDistribution is needed for the LongitudinalProfile spreadsheets within StandardInput input reader.";
+		throw(strataGrainSizeDistributionErrorMessage);
+	}
+	result.strataGrainSizeDistributions = iteratorForSpreadsheetReadOut->second;
+	iteratorForSpreadsheetReadOut = spreadsheetReadOut.find("SurfaceLayerGrainSizeDistribution");
+	if(iteratorForSpreadsheetReadOut == spreadsheetReadOut.end())
+	{
+		result.surfaceLayerGrainSizeDistributions = result.strataGrainSizeDistributions;
+	}
+	else
+	{
+		result.surfaceLayerGrainSizeDistributions = iteratorForSpreadsheetReadOut->second;
+	}
+
+	return result;
+}
+
+const char* StandardInput::createErrorMessageCopy(const char* errorMessage)
+{
+	char* tmpChar = new char [std::strlen(errorMessage)+1];
+	std::strcpy(tmpChar, errorMessage);
+	return tmpChar;
+}
+
+void StandardInput::throwFirstErrorMessage(const std::vector<const char*>& errorMessages)
+{
+	for(std::vector<const char*>::const_iterator currentErrorMessage = errorMessages.begin(); currentErrorMessage < errorMessages.end(); ++currentErrorMessage)
+	{
+		if( *currentErrorMessage != NULL )
+		{
+			const char *const errorMessage = *currentErrorMessage;
+			throw(errorMessage);
+		}
+	}
+}
+
 ConstructionVariables StandardInput::createRiverSystemMethods(pugi::xml_node rootNode, std::string path, const RiverSystemInformation& riverSystemInformation)const
 {
 	ConstructionVariables result;
@@ -1063,6 +1235,29 @@ ConstructionVariables StandardInput::createRiverSystemMethods(pugi::xml_node roo
 		iStringStream >> poreVolumeFraction;
 	}
 
+	// Read the discharge and sediment input time series window by window during the simulation instead of completely at the start.
+	pugi::xml_node streamingTimeSeriesInputNode = riverSystemMethodsNode.child("streamingTimeSeriesInput");
+	bool streamingTimeSeriesInput = false;
+	if ( streamingTimeSeriesInputNode )
+	{
+		tmpString.clear();
+		tmpString = StringTools::trimStringCopy(streamingTimeSeriesInputNode.child_value());
+
+		streamingTimeSeriesInput = StringTools::stringToBool(tmpString);
+	}
+
+	pugi::xml_node numberOfEntriesPerStreamingWindowNode = riverSystemMethodsNode.child("numberOfEntriesPerStreamingWindow");
+	int numberOfEntriesPerStreamingWindow = 64;
+	if ( numberOfEntriesPerStreamingWindowNode )
+	{
+		tmpString.clear();
+		tmpString = StringTools::trimStringCopy(numberOfEntriesPerStreamingWindowNode.child_value());
+
+		iStringStream.clear();
+		iStringStream.str( tmpString );
+		iStringStream >> numberOfEntriesPerStreamingWindow;
+	}
+
 	////////////////////////////////////// Create additionalRiverSystemMethods ///////////////////////////////////////////////////
 	ConstructionVariables additionalRiverSystemMethods;
 	additionalRiverSystemMethods.interfaceOrCombinerType = CombinerVariables::AdditionalRiverSystemMethods;
@@ -1127,7 +1322,7 @@ ConstructionVariables StandardInput::createRiverSystemMethods(pugi::xml_node roo
 			inputPropertyTimeSeriesLinearlyInterpolatedForWaterFlowMethods.interfaceOrCombinerType = CombinerVariables::ChangeRateModifiersType;
 			inputPropertyTimeSeriesLinearlyInterpolatedForWaterFlowMethods.realisationType = CombinerVariables::typeOfChangeRateModifiersToString(CombinerVariables::InputPropertyTimeSeriesLinearlyInterpolated);
 
-			std::vector<ConstructionVariables> dischargeTimeSeries = createDischargeTimeSeriesFromSpreadsheets(dischargeAndOtherInputsPath,riverSystemInformation);
+			std::vector<ConstructionVariables> dischargeTimeSeries = createDischargeTimeSeriesFromSpreadsheets(dischargeAndOtherInputsPath,riverSystemInformation,streamingTimeSeriesInput,numberOfEntriesPerStreamingWindow);
 			tmpConstructionVariablesVector.clear();
 			tmpConstructionVariablesVector = dischargeTimeSeries;
 			inputPropertyTimeSeriesLinearlyInterpolatedForWaterFlowMethods.labelledObjects["timeSeriesInputs"] = tmpConstructionVariablesVector;
@@ -1150,7 +1345,7 @@ ConstructionVariables StandardInput::createRiverSystemMethods(pugi::xml_node roo
 			inputPropertyTimeSeriesLinearlyInterpolatedForSedimentFlowMethods.interfaceOrCombinerType = CombinerVariables::ChangeRateModifiersType;
 			inputPropertyTimeSeriesLinearlyInterpolatedForSedimentFlowMethods.realisationType = CombinerVariables::typeOfChangeRateModifiersToString(CombinerVariables::InputPropertyTimeSeriesLinearlyInterpolated);
 
-			std::vector<ConstructionVariables> sedimentInputTimeSeries = createSedimentInputTimeSeriesFromSpreadsheets(path,riverSystemInformation,inputUpperBoundaryInsteadOfMeanGrainDiameter,useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters,lowerDiameterBoundaryForFinestFractionInCM,poreVolumeFraction);
+			std::vector<ConstructionVariables> sedimentInputTimeSeries = createSedimentInputTimeSeriesFromSpreadsheets(path,riverSystemInformation,inputUpperBoundaryInsteadOfMeanGrainDiameter,useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters,lowerDiameterBoundaryForFinestFractionInCM,poreVolumeFraction,streamingTimeSeriesInput,numberOfEntriesPerStreamingWindow);
 			tmpConstructionVariablesVector.clear();
 			tmpConstructionVariablesVector = sedimentInputTimeSeries;
 			inputPropertyTimeSeriesLinearlyInterpolatedForSedimentFlowMethods.labelledObjects["timeSeriesInputs"] = tmpConstructionVariablesVector;
@@ -1289,6 +1484,11 @@ ConstructionVariables StandardInput::createOutputMethods(pugi::xml_node rootNode
 	bool createStandardOutputs = true;
 	StandardOutputCharacteristics standardOutputCharacteristics;
 	standardOutputCharacteristics.forVisualInterpretation = false;
+	standardOutputCharacteristics.binaryOutput = false;
+	standardOutputCharacteristics.netCDFOutput = false;
+	standardOutputCharacteristics.deltaEncodedOutput = false;
+	standardOutputCharacteristics.numberOfRowsPerChunk = 64;
+	standardOutputCharacteristics.changeTolerance = 0.0;
 	standardOutputCharacteristics.outputInterval = 3600.0;
 	standardOutputCharacteristics.precisionForOutput = 4;
 	standardOutputCharacteristics.writeLineEachTimeStep = false;
@@ -1297,6 +1497,10 @@ ConstructionVariables StandardInput::createOutputMethods(pugi::xml_node rootNode
 	standardOutputCharacteristics.printUpstreamMargins = false;
 	standardOutputCharacteristics.printDownstreamMargin = false;
 	standardOutputCharacteristics.useSecondaryOutputInterval = false;
+	standardOutputCharacteristics.flushPolicy = CombinerVariables::typeOfOutputFlushPolicyToString(CombinerVariables::FlushAfterWallSeconds);
+	standardOutputCharacteristics.numberOfLinesBetweenFlushes = 100;
+	standardOutputCharacteristics.wallSecondsBetweenFlushes = 10.0;
+	standardOutputCharacteristics.aggregationForOutput = CombinerVariables::typeOfOutputAggregationToString(CombinerVariables::InstantaneousValue);
 	std::vector<std::string> standardOutputProperties;
 	standardOutputProperties.reserve(6);
 	standardOutputProperties.push_back(CombinerVariables::typeOfRegularRiverReachPropertiesToString(CombinerVariables::elevation));
@@ -1328,6 +1532,48 @@ ConstructionVariables StandardInput::createOutputMethods(pugi::xml_node rootNode
 			standardOutputCharacteristics.forVisualInterpretation = StringTools::stringToBool(tmpString);
 		}
 
+		currentStandardNode = outputMethodsNode.child("binaryOutputStandard");
+		if(currentStandardNode)
+		{
+			tmpString.clear();
+			tmpString = StringTools::trimStringCopy(currentStandardNode.child_value());
+			standardOutputCharacteristics.binaryOutput = StringTools::stringToBool(tmpString);
+		}
+
+		currentStandardNode = outputMethodsNode.child("netCDFOutputStandard");
+		if(currentStandardNode)
+		{
+			tmpString.clear();
+			tmpString = StringTools::trimStringCopy(currentStandardNode.child_value());
+			standardOutputCharacteristics.netCDFOutput = StringTools::stringToBool(tmpString);
+		}
+
+		currentStandardNode = outputMethodsNode.child("deltaEncodedOutputStandard");
+		if(currentStandardNode)
+		{
+			tmpString.clear();
+			tmpString = StringTools::trimStringCopy(currentStandardNode.child_value());
+			standardOutputCharacteristics.deltaEncodedOutput = StringTools::stringToBool(tmpString);
+		}
+
+		currentStandardNode = outputMethodsNode.child("numberOfRowsPerChunkStandard");
+		if(currentStandardNode)
+		{
+			iStringStream.str("");
+			iStringStream.clear();
+			iStringStream.str( StringTools::trimStringCopy(currentStandardNode.child_value()) );
+			iStringStream >> standardOutputCharacteristics.numberOfRowsPerChunk;
+		}
+
+		currentStandardNode = outputMethodsNode.child("changeToleranceStandard");
+		if(currentStandardNode)
+		{
+			iStringStream.str("");
+			iStringStream.clear();
+			iStringStream.str( StringTools::trimStringCopy(currentStandardNode.child_value()) );
+			iStringStream >> standardOutputCharacteristics.changeTolerance;
+		}
+
 		currentStandardNode = outputMethodsNode.child("explicitTimesForOutputStandard");
 		if(currentStandardNode)
 		{
@@ -1414,6 +1660,36 @@ ConstructionVariables StandardInput::createOutputMethods(pugi::xml_node rootNode
 			standardOutputCharacteristics.writeLineEachTimeStep = StringTools::stringToBool(tmpString);
 		}
 
+		currentStandardNode = outputMethodsNode.child("flushPolicyStandard");
+		if(currentStandardNode)
+		{
+			standardOutputCharacteristics.flushPolicy = StringTools::trimStringCopy(currentStandardNode.child_value());
+		}
+
+		currentStandardNode = outputMethodsNode.child("numberOfLinesBetweenFlushesStandard");
+		if(currentStandardNode)
+		{
+			iStringStream.str("");
+			iStringStream.clear();
+			iStringStream.str( StringTools::trimStringCopy(currentStandardNode.child_value()) );
+			iStringStream >> standardOutputCharacteristics.numberOfLinesBetweenFlushes;
+		}
+
+		currentStandardNode = outputMethodsNode.child("wallSecondsBetweenFlushesStandard");
+		if(currentStandardNode)
+		{
+			iStringStream.str("");
+			iStringStream.clear();
+			iStringStream.str( StringTools::trimStringCopy(currentStandardNode.child_value()) );
+			iStringStream >> standardOutputCharacteristics.wallSecondsBetweenFlushes;
+		}
+
+		currentStandardNode = outputMethodsNode.child("aggregationForOutputStandard");
+		if(currentStandardNode)
+		{
+			standardOutputCharacteristics.aggregationForOutput = StringTools::trimStringCopy(currentStandardNode.child_value());
+		}
+
 		currentStandardNode = outputMethodsNode.child("outputTimeStepLengthStandard");
 		if(currentStandardNode)
 		{
@@ -1616,6 +1892,89 @@ ConstructionVariables StandardInput::createOutputMethods(pugi::xml_node rootNode
 
 		constitutingOutputMethodTypes.push_back(outputVerbatimTranslationOfConstructionVariablesToXML);
 		}
+
+		////////////////////// Create OutputBinaryCheckpoint //////////////////////
+
+		pugi::xml_node binaryCheckpointNode = outputMethodsNode.child("binaryCheckpoint");
+		if ( binaryCheckpointNode )
+		{
+		ConstructionVariables outputBinaryCheckpoint;
+
+		outputBinaryCheckpoint.interfaceOrCombinerType = CombinerVariables::OutputMethodType;
+		outputBinaryCheckpoint.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputBinaryCheckpoint);
+
+		stringVectorForLabelledStrings.push_back(path);
+		outputBinaryCheckpoint.labelledStrings["path"] = stringVectorForLabelledStrings;
+		stringVectorForLabelledStrings.clear();
+
+		pugi::xml_node alternativePathForCheckpointsNode = binaryCheckpointNode.child("alternativePathForCheckpoints");
+		if ( alternativePathForCheckpointsNode )
+		{
+			std::string alternativePathForCheckpoints = StringTools::trimStringCopy(alternativePathForCheckpointsNode.child_value());
+			StringTools::ensureForwardSlashesAndMakeStringEndWithOneSlash(alternativePathForCheckpoints);
+			stringVectorForLabelledStrings.push_back(alternativePathForCheckpoints);
+			outputBinaryCheckpoint.labelledStrings["path"] = stringVectorForLabelledStrings;
+			stringVectorForLabelledStrings.clear();
+		}
+
+		stringVectorForLabelledStrings.push_back("Checkpoint.bin");
+		pugi::xml_node alternativeCheckpointFileNameNode = binaryCheckpointNode.child("name");
+		if ( alternativeCheckpointFileNameNode ) { stringVectorForLabelledStrings.back() = StringTools::trimStringCopy(alternativeCheckpointFileNameNode.child_value()); }
+		outputBinaryCheckpoint.labelledStrings["outputFiles"] = stringVectorForLabelledStrings;
+		stringVectorForLabelledStrings.clear();
+
+		addDoubleVectorToConstructionVariables(outputBinaryCheckpoint,binaryCheckpointNode,"explicitTimesForOutput",standardOutputCharacteristics.explicitTimesForOutput);
+		addDoubleToConstructionVariables(outputBinaryCheckpoint,binaryCheckpointNode,"outputInterval",standardOutputCharacteristics.outputInterval);
+		addIntToConstructionVariables(outputBinaryCheckpoint,binaryCheckpointNode,"precisionForOutput",standardOutputCharacteristics.precisionForOutput);
+
+		boolVectorForLabelledBools.push_back(false);
+		outputBinaryCheckpoint.labelledBools["writeLineEachTimeStep"] = boolVectorForLabelledBools;
+		boolVectorForLabelledBools.clear();
+
+		constitutingOutputMethodTypes.push_back(outputBinaryCheckpoint);
+		}
+
+		////////////////////// Create OutputSharedMemoryMonitor //////////////////////
+
+		pugi::xml_node sharedMemoryMonitorNode = outputMethodsNode.child("sharedMemoryMonitor");
+		if ( sharedMemoryMonitorNode )
+		{
+		ConstructionVariables outputSharedMemoryMonitor;
+
+		outputSharedMemoryMonitor.interfaceOrCombinerType = CombinerVariables::OutputMethodType;
+		outputSharedMemoryMonitor.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputSharedMemoryMonitor);
+
+		stringVectorForLabelledStrings.push_back(path);
+		outputSharedMemoryMonitor.labelledStrings["path"] = stringVectorForLabelledStrings;
+		stringVectorForLabelledStrings.clear();
+
+		stringVectorForLabelledStrings.push_back("sedFlowMonitor");
+		pugi::xml_node sharedMemoryNameNode = sharedMemoryMonitorNode.child("name");
+		if ( sharedMemoryNameNode ) { stringVectorForLabelledStrings.back() = StringTools::trimStringCopy(sharedMemoryNameNode.child_value()); }
+		outputSharedMemoryMonitor.labelledStrings["outputFiles"] = stringVectorForLabelledStrings;
+		stringVectorForLabelledStrings.clear();
+
+		if( !(addStringVectorToConstructionVariables(outputSharedMemoryMonitor,sharedMemoryMonitorNode,"regularRiverReachPropertiesForOutput")) )
+		{
+			const char *const regularRiverReachPropertiesForOutputErrorMessage = "The node regularRiverReachPropertiesForOutput is needed for the sharedMemoryMonitor in StandardInput.";
+			throw(regularRiverReachPropertiesForOutputErrorMessage);
+		}
+		outputSharedMemoryMonitor.labelledInts["reachIDsForOutput"] = standardOutputCharacteristics.reachIDsForOutput;
+		addReachIDVectorToConstructionVariables(outputSharedMemoryMonitor,sharedMemoryMonitorNode,"reachIDsForOutput",riverSystemInformation);
+		addIntToConstructionVariables(outputSharedMemoryMonitor,sharedMemoryMonitorNode,"numberOfTimeStepsBetweenPublications",10);
+		addIntToConstructionVariables(outputSharedMemoryMonitor,sharedMemoryMonitorNode,"numberOfSlots",64);
+
+		// The publications are scheduled by the number of time steps. Thus only the standard values are used for the output times.
+		addDoubleVectorToConstructionVariables(outputSharedMemoryMonitor,pugi::xml_node(),"explicitTimesForOutput",std::vector<double>());
+		addDoubleToConstructionVariables(outputSharedMemoryMonitor,pugi::xml_node(),"outputInterval",standardOutputCharacteristics.outputInterval);
+		addIntToConstructionVariables(outputSharedMemoryMonitor,pugi::xml_node(),"precisionForOutput",standardOutputCharacteristics.precisionForOutput);
+
+		boolVectorForLabelledBools.push_back(false);
+		outputSharedMemoryMonitor.labelledBools["writeLineEachTimeStep"] = boolVectorForLabelledBools;
+		boolVectorForLabelledBools.clear();
+
+		constitutingOutputMethodTypes.push_back(outputSharedMemoryMonitor);
+		}
 	}
 
 	////////////////////// Create standard outputs //////////////////////
@@ -1712,6 +2071,8 @@ ConstructionVariables StandardInput::createOutputMethods(pugi::xml_node rootNode
 
 	//////////////////////// Compose the outputMethods ConstructionVariables ////////////////////////////////
 	result.labelledObjects["constitutingOutputMethodTypes"] = constitutingOutputMethodTypes;
+	addBoolToConstructionVariables(result,outputMethodsNode,"asynchronousOutput",false);
+	addIntToConstructionVariables(result,outputMethodsNode,"asynchronousOutputQueueLength",16);
 
 	return result;
 }
@@ -2351,7 +2712,7 @@ ConstructionVariables StandardInput::createRiverReachMethodsWithCertainCellID (p
 	return riverReachMethods;
 }
 
-std::vector<ConstructionVariables> StandardInput::createDischargeTimeSeriesFromSpreadsheets (std::string path, const RiverSystemInformation& riverSystemInformation)
+std::vector<ConstructionVariables> StandardInput::createDischargeTimeSeriesFromSpreadsheets (std::string path, const RiverSystemInformation& riverSystemInformation, bool streamingTimeSeriesInput, int numberOfEntriesPerStreamingWindow)
 {
 	StringTools::ensureForwardSlashesAndMakeStringEndWithOneSlash(path);
 	std::vector<ConstructionVariables> result;
@@ -2359,8 +2720,6 @@ std::vector<ConstructionVariables> StandardInput::createDischargeTimeSeriesFromS
 	int currentUpmostCellID;
 	std::string currentFileName;
 	std::ostringstream oStringStream;
-	std::map<std::string,std::vector<std::string> > currentSpreadsheetReadOut;
-	std::map<std::string,std::vector<std::string> >::const_iterator iteratorForSpreadsheetReadOut;
 	std::vector<double> currentElapsedSeconds;
 	std::vector<double>	currentDischargeValues;
 	std::vector<int> tmpIntVector;
@@ -2387,26 +2746,52 @@ std::vector<ConstructionVariables> StandardInput::createDischargeTimeSeriesFromS
 			oStringStream << currentRiverBranchID << std::flush;
 			currentFileName.append(oStringStream.str());
 			currentFileName.append("Discharge.txt");
-			currentSpreadsheetReadOut.clear();
-			currentSpreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(currentFileName);
-			iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("ElapsedSeconds");
-			if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
+
+			ConstructionVariables currentTimeSeries;
+			if( streamingTimeSeriesInput )
 			{
-				const char *const elapsedSecondsErrorMessage = "The column ElapsedSeconds is needed within discharge spreadsheets for StandardInput input reader.";
-				throw(elapsedSecondsErrorMessage);
+				// Only the first window is read here. The following windows are read during the simulation.
+				StreamingTimeSeriesSource dischargeSource (currentFileName,"ElapsedSeconds","DischargeInM3PerS",1.0,numberOfEntriesPerStreamingWindow);
+				const std::vector<std::string>& headerEntries = dischargeSource.getHeaderEntries();
+				if( std::find(headerEntries.begin(),headerEntries.end(),"ElapsedSeconds") == headerEntries.end() )
+				{
+					const char *const elapsedSecondsErrorMessage = "The column ElapsedSeconds is needed within discharge spreadsheets for StandardInput input reader.";
+					throw(elapsedSecondsErrorMessage);
+				}
+				if( std::find(headerEntries.begin(),headerEntries.end(),"DischargeInM3PerS") == headerEntries.end() )
+				{
+					const char *const dischargeErrorMessage = "The column DischargeInM3PerS is needed within discharge spreadsheets for StandardInput input reader.";
+					throw(dischargeErrorMessage);
+				}
+				std::vector<TimeSeriesEntry> firstWindow;
+				dischargeSource.appendNextWindow(firstWindow);
+				currentElapsedSeconds.clear();
+				currentDischargeValues.clear();
+				for(std::vector<TimeSeriesEntry>::const_iterator currentEntry = firstWindow.begin(); currentEntry < firstWindow.end(); ++currentEntry)
+				{
+					currentElapsedSeconds.push_back( currentEntry->elapsedSeconds );
+					currentDischargeValues.push_back( currentEntry->doubleValue );
+				}
+				if( !(dischargeSource.isExhausted()) ) { dischargeSource.addToConstructionVariables(currentTimeSeries); }
 			}
-			currentElapsedSeconds.clear();
-			currentElapsedSeconds = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
-			iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("DischargeInM3PerS");
-			if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
+			else
 			{
-				const char *const dischargeErrorMessage = "The column DischargeInM3PerS is needed within discharge spreadsheets for StandardInput input reader.";
-				throw(dischargeErrorMessage);
+				TabDelimitedSpreadsheet dischargeSpreadsheet (currentFileName);
+				if( !(dischargeSpreadsheet.hasColumn("ElapsedSeconds")) )
+				{
+					const char *const elapsedSecondsErrorMessage = "The column ElapsedSeconds is needed within discharge spreadsheets for StandardInput input reader.";
+					throw(elapsedSecondsErrorMessage);
+				}
+				currentElapsedSeconds = dischargeSpreadsheet.getDoubleColumn("ElapsedSeconds");
+				if( !(dischargeSpreadsheet.hasColumn("DischargeInM3PerS")) )
+				{
+					const char *const dischargeErrorMessage = "The column DischargeInM3PerS is needed within discharge spreadsheets for StandardInput input reader.";
+					throw(dischargeErrorMessage);
+				}
+				currentDischargeValues = dischargeSpreadsheet.getDoubleColumn("DischargeInM3PerS");
 			}
-			currentDischargeValues.clear();
-			currentDischargeValues = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
 
-			ConstructionVariables currentTimeSeries;
+
 			currentTimeSeries.interfaceOrCombinerType = CombinerVariables::TimeSeries;
 			tmpIntVector.clear();
 			//TODO Remove this bugfix subtraction by 1000, whenever the Problem in the RegularRiverSystemProperties is solved.
@@ -2439,7 +2824,7 @@ std::vector<ConstructionVariables> StandardInput::createDischargeTimeSeriesFromS
 	return result;
 }
 
-std::vector<ConstructionVariables> StandardInput::createSedimentInputTimeSeriesFromSpreadsheets (std::string path, const RiverSystemInformation& riverSystemInformation, bool inputUpperBoundaryInsteadOfMeanGrainDiameter, bool useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters, double lowerDiameterBoundaryForFinestFractionInCM, double poreVolumeFraction)
+std::vector<ConstructionVariables> StandardInput::createSedimentInputTimeSeriesFromSpreadsheets (std::string path, const RiverSystemInformation& riverSystemInformation, bool inputUpperBoundaryInsteadOfMeanGrainDiameter, bool useArithmeticMeanInsteadOfGeometricMeanForFractionGrainDiameters, double lowerDiameterBoundaryForFinestFractionInCM, double poreVolumeFraction, bool streamingTimeSeriesInput, int numberOfEntriesPerStreamingWindow)
 {
 	std::vector<ConstructionVariables> result;
 
@@ -2585,30 +2970,82 @@ std::vector<ConstructionVariables> StandardInput::createSedimentInputTimeSeriesF
 			currentFileName = dischargeAndOtherInputsPath;
 			currentFileName.append(*currentSedimentInputTimeSeries);
 			currentFileName.append(".txt");
-			currentSpreadsheetReadOut.clear();
-			currentSpreadsheetReadOut = StringTools::tabDelimitedSpreadsheetFileToStringMap(currentFileName);
-			iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("ElapsedSeconds");
-			if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
-			{
-				const char *const elapsedSecondsErrorMessage = "The column ElapsedSeconds is needed within sediment input weighting factor time series spreadsheets for StandardInput input reader.";
-				throw(elapsedSecondsErrorMessage);
-			}
-			currentElapsedSeconds.clear();
-			currentElapsedSeconds = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
-			iteratorForSpreadsheetReadOut = currentSpreadsheetReadOut.find("SedimentInputInM3PerS");
-			if(iteratorForSpreadsheetReadOut == currentSpreadsheetReadOut.end())
+
+			ConstructionVariables currentTimeSeries;
+			timeSeriesEntriesVector.clear();
+			if( streamingTimeSeriesInput )
 			{
-				const char *const SedimentInputInMCubicPerSErrorMessage = "The column SedimentInputInM3PerS is needed within sediment input weighting factor time series spreadsheets for StandardInput input reader.";
-				throw(SedimentInputInMCubicPerSErrorMessage);
+				// Only the first window is read here. The following windows are read during the simulation.
+				double valueFactor = (*currentBoolInputIncludingPoreVolume) ? conversionFactorFromPorousToSolidVolume : 1.0;
+				StreamingTimeSeriesSource sedimentInputSource (currentFileName,"ElapsedSeconds","SedimentInputInM3PerS",valueFactor,currentGrainsBase,numberOfEntriesPerStreamingWindow);
+				const std::vector<std::string>& headerEntries = sedimentInputSource.getHeaderEntries();
+				if( std::find(headerEntries.begin(),headerEntries.end(),"ElapsedSeconds") == headerEntries.end() )
+				{
+					const char *const elapsedSecondsErrorMessage = "The column ElapsedSeconds is needed within sediment input weighting factor time series spreadsheets for StandardInput input reader.";
+					throw(elapsedSecondsErrorMessage);
+				}
+				if( std::find(headerEntries.begin(),headerEntries.end(),"SedimentInputInM3PerS") == headerEntries.end() )
+				{
+					const char *const SedimentInputInMCubicPerSErrorMessage = "The column SedimentInputInM3PerS is needed within sediment input weighting factor time series spreadsheets for StandardInput input reader.";
+					throw(SedimentInputInMCubicPerSErrorMessage);
+				}
+				std::vector<TimeSeriesEntry> firstWindow;
+				sedimentInputSource.appendNextWindow(firstWindow);
+				for(std::vector<TimeSeriesEntry>::const_iterator currentEntry = firstWindow.begin(); currentEntry < firstWindow.end(); ++currentEntry)
+				{
+					ConstructionVariables currentTimeSeriesEntry;
+					currentTimeSeriesEntry.interfaceOrCombinerType = CombinerVariables::TimeSeriesEntry;
+					tmpDoubleVector.clear();
+					tmpDoubleVector.push_back( currentEntry->elapsedSeconds );
+					currentTimeSeriesEntry.labelledDoubles["elapsedSeconds"] = tmpDoubleVector;
+
+					tmpConstructionVariablesVector.clear();
+					tmpConstructionVariablesVector.push_back( currentEntry->grainsValue.createConstructionVariables() );
+					currentTimeSeriesEntry.labelledObjects["grainsValue"] = tmpConstructionVariablesVector;
+
+					timeSeriesEntriesVector.push_back( currentTimeSeriesEntry );
+				}
+				if( !(sedimentInputSource.isExhausted()) ) { sedimentInputSource.addToConstructionVariables(currentTimeSeries); }
 			}
-			currentSedimentInputs.clear();
-			currentSedimentInputs = StringTools::stringVectorToDoubleVector( iteratorForSpreadsheetReadOut->second );
-			if( *currentBoolInputIncludingPoreVolume )
+			else
 			{
-				std::transform(currentSedimentInputs.begin(),currentSedimentInputs.end(),currentSedimentInputs.begin(),std::bind1st(std::multiplies<double>(),conversionFactorFromPorousToSolidVolume));
+				TabDelimitedSpreadsheet sedimentInputSpreadsheet (currentFileName);
+				if( !(sedimentInputSpreadsheet.hasColumn("ElapsedSeconds")) )
+				{
+					const char *const elapsedSecondsErrorMessage = "The column ElapsedSeconds is needed within sediment input weighting factor time series spreadsheets for StandardInput input reader.";
+					throw(elapsedSecondsErrorMessage);
+				}
+				currentElapsedSeconds = sedimentInputSpreadsheet.getDoubleColumn("ElapsedSeconds");
+				if( !(sedimentInputSpreadsheet.hasColumn("SedimentInputInM3PerS")) )
+				{
+					const char *const SedimentInputInMCubicPerSErrorMessage = "The column SedimentInputInM3PerS is needed within sediment input weighting factor time series spreadsheets for StandardInput input reader.";
+					throw(SedimentInputInMCubicPerSErrorMessage);
+				}
+				currentSedimentInputs = sedimentInputSpreadsheet.getDoubleColumn("SedimentInputInM3PerS");
+				if( *currentBoolInputIncludingPoreVolume )
+				{
+					std::transform(currentSedimentInputs.begin(),currentSedimentInputs.end(),currentSedimentInputs.begin(),std::bind1st(std::multiplies<double>(),conversionFactorFromPorousToSolidVolume));
+				}
+
+				for(std::vector<double>::const_iterator currentElapsedSecondsEntry = currentElapsedSeconds.begin(), currentSedimentInputEntry = currentSedimentInputs.begin(); currentElapsedSecondsEntry < currentElapsedSeconds.end(); ++currentElapsedSecondsEntry, ++currentSedimentInputEntry)
+				{
+					ConstructionVariables currentTimeSeriesEntry;
+					currentTimeSeriesEntry.interfaceOrCombinerType = CombinerVariables::TimeSeriesEntry;
+					tmpDoubleVector.clear();
+					tmpDoubleVector.push_back( *currentElapsedSecondsEntry );
+					currentTimeSeriesEntry.labelledDoubles["elapsedSeconds"] = tmpDoubleVector;
+
+					Grains grainsObjectForCurrentGrainsEntry = currentGrainsBase * (*currentSedimentInputEntry);
+					ConstructionVariables currentGrainsEntry = grainsObjectForCurrentGrainsEntry.createConstructionVariables();
+
+					tmpConstructionVariablesVector.clear();
+					tmpConstructionVariablesVector.push_back( currentGrainsEntry );
+					currentTimeSeriesEntry.labelledObjects["grainsValue"] = tmpConstructionVariablesVector;
+
+					timeSeriesEntriesVector.push_back( currentTimeSeriesEntry );
+				}
 			}
 
-			ConstructionVariables currentTimeSeries;
 			currentTimeSeries.interfaceOrCombinerType = CombinerVariables::TimeSeries;
 			tmpIntVector.clear();
 			//TODO Remove this bugfix subtraction by 1000, whenever the Problem in the RegularRiverSystemProperties is solved.
@@ -2622,25 +3059,6 @@ std::vector<ConstructionVariables> StandardInput::createSedimentInputTimeSeriesF
 			tmpBoolVector.push_back( true );
 			currentTimeSeries.labelledBools["finalInsteadOfInitialAdding"] = tmpBoolVector;
 			currentTimeSeries.labelledStrings["property"] = propertyStringVector;
-
-			timeSeriesEntriesVector.clear();
-			for(std::vector<double>::const_iterator currentElapsedSecondsEntry = currentElapsedSeconds.begin(), currentSedimentInputEntry = currentSedimentInputs.begin(); currentElapsedSecondsEntry < currentElapsedSeconds.end(); ++currentElapsedSecondsEntry, ++currentSedimentInputEntry)
-			{
-				ConstructionVariables currentTimeSeriesEntry;
-				currentTimeSeriesEntry.interfaceOrCombinerType = CombinerVariables::TimeSeriesEntry;
-				tmpDoubleVector.clear();
-				tmpDoubleVector.push_back( *currentElapsedSecondsEntry );
-				currentTimeSeriesEntry.labelledDoubles["elapsedSeconds"] = tmpDoubleVector;
-
-				Grains grainsObjectForCurrentGrainsEntry = currentGrainsBase * (*currentSedimentInputEntry);
-				ConstructionVariables currentGrainsEntry = grainsObjectForCurrentGrainsEntry.createConstructionVariables();
-
-				tmpConstructionVariablesVector.clear();
-				tmpConstructionVariablesVector.push_back( currentGrainsEntry );
-				currentTimeSeriesEntry.labelledObjects["grainsValue"] = tmpConstructionVariablesVector;
-
-				timeSeriesEntriesVector.push_back( currentTimeSeriesEntry );
-			}
 			currentTimeSeries.labelledObjects["timeSeries"] = timeSeriesEntriesVector;
 
 			result.push_back(currentTimeSeries);
@@ -3434,8 +3852,48 @@ ConstructionVariables StandardInput::createSingleRegularOutputMethod(pugi::xml_n
 		forVisualInterpretation = StringTools::stringToBool(tmpString);
 	}
 
-	if(forVisualInterpretation)
+	// The binary output is an alternative to the regular text output. Outputs for visual interpretation are always written as text.
+	bool binaryOutput = standardOutputCharacteristics.binaryOutput;
+
+	pugi::xml_node binaryOutputNode = rootNode.child("binaryOutput");
+	if ( binaryOutputNode )
+	{
+		tmpString.clear();
+		tmpString = StringTools::trimStringCopy(binaryOutputNode.child_value());
+		binaryOutput = StringTools::stringToBool(tmpString);
+	}
+	// The NetCDF output is a further alternative, which takes precedence over the binary output.
+	bool netCDFOutput = standardOutputCharacteristics.netCDFOutput;
+
+	pugi::xml_node netCDFOutputNode = rootNode.child("netCDFOutput");
+	if ( netCDFOutputNode )
+	{
+		tmpString.clear();
+		tmpString = StringTools::trimStringCopy(netCDFOutputNode.child_value());
+		netCDFOutput = StringTools::stringToBool(tmpString);
+	}
+	// The delta encoded output only writes the changed layers and is mainly intended for the strata. It takes precedence over all other outputs.
+	bool deltaEncodedOutput = standardOutputCharacteristics.deltaEncodedOutput;
+
+	pugi::xml_node deltaEncodedOutputNode = rootNode.child("deltaEncodedOutput");
+	if ( deltaEncodedOutputNode )
+	{
+		tmpString.clear();
+		tmpString = StringTools::trimStringCopy(deltaEncodedOutputNode.child_value());
+		deltaEncodedOutput = StringTools::stringToBool(tmpString);
+	}
+	forVisualInterpretation = forVisualInterpretation && !deltaEncodedOutput;
+	netCDFOutput = netCDFOutput && !forVisualInterpretation && !deltaEncodedOutput;
+	binaryOutput = binaryOutput && !forVisualInterpretation && !netCDFOutput && !deltaEncodedOutput;
+
+	if(deltaEncodedOutput)
+	{ result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputRegularRiverReachPropertiesDeltaEncoded); }
+	else if(forVisualInterpretation)
 	{ result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputRegularRiverReachPropertiesForVisualInterpretation); }
+	else if(netCDFOutput)
+	{ result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputRegularRiverReachPropertiesNetCDF); }
+	else if(binaryOutput)
+	{ result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputRegularRiverReachPropertiesBinary); }
 	else
 	{ result.realisationType = CombinerVariables::typeOfOutputMethodToString(CombinerVariables::OutputRegularRiverReachProperties); }
 
@@ -3463,6 +3921,21 @@ ConstructionVariables StandardInput::createSingleRegularOutputMethod(pugi::xml_n
 	stringVectorForLabelledStrings.clear();
 
 	std::vector<std::string> regularRiverReachPropertiesForOutput = (result.labelledStrings.find("regularRiverReachPropertiesForOutput"))->second;
+
+	// The standard aggregation is not applied to the strata, as their number of layers may change.
+	if( !(addStringVectorToConstructionVariables(result,rootNode,"aggregationsForOutput")) )
+	{
+		for(std::vector<std::string>::const_iterator currentProperty = regularRiverReachPropertiesForOutput.begin(); currentProperty < regularRiverReachPropertiesForOutput.end(); ++currentProperty)
+		{
+			if( *currentProperty == CombinerVariables::typeOfRegularRiverReachPropertiesToString(CombinerVariables::strataPerUnitBedSurface) || *currentProperty == CombinerVariables::typeOfRegularRiverReachPropertiesToString(CombinerVariables::strataPerUnitBedSurfaceIncludingPoreVolume) )
+				{ stringVectorForLabelledStrings.push_back( CombinerVariables::typeOfOutputAggregationToString(CombinerVariables::InstantaneousValue) ); }
+			else
+				{ stringVectorForLabelledStrings.push_back(standardOutputCharacteristics.aggregationForOutput); }
+		}
+		result.labelledStrings["aggregationsForOutput"] = stringVectorForLabelledStrings;
+		stringVectorForLabelledStrings.clear();
+	}
+
 	if(regularRiverReachPropertiesForOutput.size() == 1)
 	{
 		tmpString.clear();
@@ -3483,6 +3956,29 @@ ConstructionVariables StandardInput::createSingleRegularOutputMethod(pugi::xml_n
 		stringVectorForLabelledStrings.clear();
 	}
 
+	if(binaryOutput)
+	{
+		std::string& binaryFileName = result.labelledStrings["outputFiles"].at(0);
+		if( binaryFileName.size() > 4 && binaryFileName.compare(binaryFileName.size()-4,4,".txt") == 0 ) { binaryFileName.erase(binaryFileName.size()-4); }
+		binaryFileName.append(".sfb");
+		addIntToConstructionVariables(result,rootNode,"numberOfRowsPerChunk",standardOutputCharacteristics.numberOfRowsPerChunk);
+	}
+
+	if(netCDFOutput)
+	{
+		std::string& netCDFFileName = result.labelledStrings["outputFiles"].at(0);
+		if( netCDFFileName.size() > 4 && netCDFFileName.compare(netCDFFileName.size()-4,4,".txt") == 0 ) { netCDFFileName.erase(netCDFFileName.size()-4); }
+		netCDFFileName.append(".nc");
+	}
+
+	if(deltaEncodedOutput)
+	{
+		std::string& deltaEncodedFileName = result.labelledStrings["outputFiles"].at(0);
+		if( deltaEncodedFileName.size() > 4 && deltaEncodedFileName.compare(deltaEncodedFileName.size()-4,4,".txt") == 0 ) { deltaEncodedFileName.erase(deltaEncodedFileName.size()-4); }
+		deltaEncodedFileName.append(".sfd");
+		addDoubleToConstructionVariables(result,rootNode,"changeTolerance",standardOutputCharacteristics.changeTolerance);
+	}
+
 	addDoubleVectorToConstructionVariables(result,rootNode,"explicitTimesForOutput",standardOutputCharacteristics.explicitTimesForOutput);
 	addDoubleToConstructionVariables(result,rootNode,"outputInterval",standardOutputCharacteristics.outputInterval);
 	addIntToConstructionVariables(result,rootNode,"precisionForOutput",standardOutputCharacteristics.precisionForOutput);
@@ -3503,6 +3999,9 @@ ConstructionVariables StandardInput::createSingleRegularOutputMethod(pugi::xml_n
 	addBoolToConstructionVariables(result,rootNode,"outputInitialValues",standardOutputCharacteristics.outputInitialValues);
 	addBoolToConstructionVariables(result,rootNode,"printUpstreamMargins",standardOutputCharacteristics.printUpstreamMargins);
 	addBoolToConstructionVariables(result,rootNode,"printDownstreamMargin",standardOutputCharacteristics.printDownstreamMargin);
+	addStringToConstructionVariables(result,rootNode,"flushPolicy",standardOutputCharacteristics.flushPolicy);
+	addIntToConstructionVariables(result,rootNode,"numberOfLinesBetweenFlushes",standardOutputCharacteristics.numberOfLinesBetweenFlushes);
+	addDoubleToConstructionVariables(result,rootNode,"wallSecondsBetweenFlushes",standardOutputCharacteristics.wallSecondsBetweenFlushes);
 
 	pugi::xml_node secondaryOutputIntervalNode = rootNode.child("SecondaryOutputInterval");
 	bool useSecondaryOutputInterval = ( standardOutputCharacteristics.useSecondaryOutputInterval || (secondaryOutputIntervalNode != 0) );
@@ -3601,6 +4100,10 @@ ConstructionVariables StandardInput::createSingleOutputAccumulatedBedloadTranspo
 	addBoolToConstructionVariables(outputAccumulatedBedloadTransport,rootNode,"outputIncludingPoreVolume",true);
 	addBoolToConstructionVariables(outputAccumulatedBedloadTransport,rootNode,"outputDetailedFractional",false);
 
+	addStringToConstructionVariables(outputAccumulatedBedloadTransport,rootNode,"flushPolicy",standardOutputCharacteristics.flushPolicy);
+	addIntToConstructionVariables(outputAccumulatedBedloadTransport,rootNode,"numberOfLinesBetweenFlushes",standardOutputCharacteristics.numberOfLinesBetweenFlushes);
+	addDoubleToConstructionVariables(outputAccumulatedBedloadTransport,rootNode,"wallSecondsBetweenFlushes",standardOutputCharacteristics.wallSecondsBetweenFlushes);
+
 	return outputAccumulatedBedloadTransport;
 }
 
@@ -30,9 +30,13 @@
 #include "StochasticThresholdForInitiationOfBedloadMotion.h"
 
 #include "CorrectionForBedloadWeightAtSteepSlopes.h"
+#include "CounterBasedRandomNumbers.h"
 
 namespace SedFlow {
 
+#if !defined SEDFLOWDETERMINISTIC
+double StochasticThresholdForInitiationOfBedloadMotion::numberOfDrawnRandomNumbers = 0.0;
+#endif
 
 StochasticThresholdForInitiationOfBedloadMotion::StochasticThresholdForInitiationOfBedloadMotion(double minimumThresholdValue, double miu, double beta, int seed, double weightForCurrent, double weightForPrevious, double weightForPrePrevious, bool correctionForBedloadWeightAtSteepCounterSlopes, std::vector<double> widthsForSpecialValues, std::vector<double> miuSpecialValues, std::vector<double> betaSpecialValues):
 	minimumThresholdValue(minimumThresholdValue),
@@ -47,7 +51,10 @@ StochasticThresholdForInitiationOfBedloadMotion::StochasticThresholdForInitiatio
 	miuSpecialValues(miuSpecialValues),
 	betaSpecialValues(betaSpecialValues)
 {
+	#if !defined SEDFLOWDETERMINISTIC
 	srand(this->seed);
+	numberOfDrawnRandomNumbers = 0.0;
+	#endif
 	double weightSum = this->weightForCurrent + this->weightForPrevious + this->weightForPrePrevious;
 	this->weightForCurrent /= weightSum;
 	this->weightForPrevious /= weightSum;
@@ -71,7 +78,7 @@ StochasticThresholdForInitiationOfBedloadMotion::StochasticThresholdForInitiatio
 	}
 }
 
-StochasticThresholdForInitiationOfBedloadMotion::StochasticThresholdForInitiationOfBedloadMotion(double minimumThresholdValue, double miu, double beta, int seed, double weightForCurrent, double weightForPrevious, double weightForPrePrevious, bool correctionForBedloadWeightAtSteepCounterSlopes, std::map<double,std::vector<double> > mapFromWidthToValues, std::vector<double> widthsForSpecialValues, std::vector<double> miuSpecialValues, std::vector<double> betaSpecialValues, std::map<double,std::pair<double,double> > mapFromWidthToSpecialValues):
+StochasticThresholdForInitiationOfBedloadMotion::StochasticThresholdForInitiationOfBedloadMotion(double minimumThresholdValue, double miu, double beta, int seed, double weightForCurrent, double weightForPrevious, double weightForPrePrevious, bool correctionForBedloadWeightAtSteepCounterSlopes, std::map<std::pair<int,double>,std::vector<double> > mapFromCellIDAndWidthToValues, std::vector<double> widthsForSpecialValues, std::vector<double> miuSpecialValues, std::vector<double> betaSpecialValues, std::map<double,std::pair<double,double> > mapFromWidthToSpecialValues):
 	minimumThresholdValue(minimumThresholdValue),
 	miu(miu),
 	beta(beta),
@@ -80,7 +87,7 @@ StochasticThresholdForInitiationOfBedloadMotion::StochasticThresholdForInitiatio
 	weightForPrevious(weightForPrevious),
 	weightForPrePrevious(weightForPrePrevious),
 	correctionForBedloadWeightAtSteepCounterSlopes(correctionForBedloadWeightAtSteepCounterSlopes),
-	mapFromWidthToValues(mapFromWidthToValues),
+	mapFromCellIDAndWidthToValues(mapFromCellIDAndWidthToValues),
 	widthsForSpecialValues(widthsForSpecialValues),
 	miuSpecialValues(miuSpecialValues),
 	betaSpecialValues(betaSpecialValues),
@@ -91,7 +98,7 @@ StochasticThresholdForInitiationOfBedloadMotion::~StochasticThresholdForInitiati
 
 CalcThresholdForInitiationOfBedloadMotion* StochasticThresholdForInitiationOfBedloadMotion::createCalcThresholdForInitiationOfBedloadMotionPointerCopy() const
 {
-	CalcThresholdForInitiationOfBedloadMotion* result = new StochasticThresholdForInitiationOfBedloadMotion(minimumThresholdValue,miu,beta,seed,weightForCurrent,weightForPrevious,weightForPrePrevious,correctionForBedloadWeightAtSteepCounterSlopes,mapFromWidthToValues,widthsForSpecialValues,miuSpecialValues,betaSpecialValues,mapFromWidthToSpecialValues);
+	CalcThresholdForInitiationOfBedloadMotion* result = new StochasticThresholdForInitiationOfBedloadMotion(minimumThresholdValue,miu,beta,seed,weightForCurrent,weightForPrevious,weightForPrePrevious,correctionForBedloadWeightAtSteepCounterSlopes,mapFromCellIDAndWidthToValues,widthsForSpecialValues,miuSpecialValues,betaSpecialValues,mapFromWidthToSpecialValues);
 	return result;
 }
 
@@ -133,20 +140,84 @@ ConstructionVariables StochasticThresholdForInitiationOfBedloadMotion::createCon
 	doubleVector.clear();
 	doubleVector = betaSpecialValues;
 	result.labelledDoubles["betaSpecialValues"] = doubleVector;
+	intVector.clear();
+	std::vector<double> activeWidths;
+	doubleVector.clear();
+	for(std::map<std::pair<int,double>,std::vector<double> >::const_iterator currentValues = mapFromCellIDAndWidthToValues.begin(); currentValues != mapFromCellIDAndWidthToValues.end(); ++currentValues)
+	{
+		intVector.push_back(currentValues->first.first);
+		activeWidths.push_back(currentValues->first.second);
+		doubleVector.insert(doubleVector.end(), currentValues->second.begin(), currentValues->second.end());
+	}
+	result.labelledInts["cellIDsOfValues"] = intVector;
+	result.labelledDoubles["activeWidthsOfValues"] = activeWidths;
+	result.labelledDoubles["valuesOneAfterAnother"] = doubleVector;
+	#if !defined SEDFLOWDETERMINISTIC
+	doubleVector.clear();
+	doubleVector.push_back(numberOfDrawnRandomNumbers);
+	result.labelledDoubles["numberOfDrawnRandomNumbers"] = doubleVector;
+	#endif
 	return result;
 }
 
+void StochasticThresholdForInitiationOfBedloadMotion::setValuesForCellIDsAndWidths(const std::vector<int>& cellIDs, const std::vector<double>& activeWidths, const std::vector<double>& valuesOneAfterAnother)
+{
+	const std::vector<double>::size_type numberOfValuesPerEntry = 7;
+	if( (cellIDs.size() != activeWidths.size()) || (valuesOneAfterAnother.size() != (numberOfValuesPerEntry * cellIDs.size())) )
+	{
+		const char *const sizeErrorMessage = "The variables cellIDsOfValues, activeWidthsOfValues and valuesOneAfterAnother do not match for StochasticThresholdForInitiationOfBedloadMotion.";
+		throw(sizeErrorMessage);
+	}
+	mapFromCellIDAndWidthToValues.clear();
+	std::vector<double>::const_iterator currentValuesBegin = valuesOneAfterAnother.begin();
+	for(std::vector<int>::size_type i = 0; i < cellIDs.size(); ++i, currentValuesBegin += numberOfValuesPerEntry)
+		{ mapFromCellIDAndWidthToValues[ std::make_pair(cellIDs[i],activeWidths[i]) ] = std::vector<double>(currentValuesBegin, (currentValuesBegin + numberOfValuesPerEntry)); }
+}
+
+void StochasticThresholdForInitiationOfBedloadMotion::setNumberOfDrawnRandomNumbers(double numberOfDrawnRandomNumbers)
+{
+	#if defined SEDFLOWDETERMINISTIC
+	(void)numberOfDrawnRandomNumbers;
+	#else
+	srand(this->seed);
+	for(double i = 0.0; i < numberOfDrawnRandomNumbers; i += 1.0) { rand(); }
+	StochasticThresholdForInitiationOfBedloadMotion::numberOfDrawnRandomNumbers = numberOfDrawnRandomNumbers;
+	#endif
+}
+
 double StochasticThresholdForInitiationOfBedloadMotion::calculate (const RegularRiverReachProperties& regularRiverReachProperties) const
 {
-	return ( (const_cast<StochasticThresholdForInitiationOfBedloadMotion*>(this))->calculateNotConst(regularRiverReachProperties) );
+	#if defined SEDFLOWDETERMINISTIC
+	(void)regularRiverReachProperties;
+	const char *const missingCellIDErrorMessage = "In the deterministic mode the StochasticThresholdForInitiationOfBedloadMotion needs the cellID of the reach, as each reach draws from its own random stream.";
+	throw(missingCellIDErrorMessage);
+	#else
+	return this->calculate(regularRiverReachProperties,-1);
+	#endif
 }
 
-double StochasticThresholdForInitiationOfBedloadMotion::calculateNotConst (const RegularRiverReachProperties& regularRiverReachProperties)
+double StochasticThresholdForInitiationOfBedloadMotion::calculate (const RegularRiverReachProperties& regularRiverReachProperties, int cellID) const
+{
+	return ( (const_cast<StochasticThresholdForInitiationOfBedloadMotion*>(this))->calculateNotConst(regularRiverReachProperties,cellID) );
+}
+
+double StochasticThresholdForInitiationOfBedloadMotion::calculateNotConst (const RegularRiverReachProperties& regularRiverReachProperties, int cellID)
 {
 	double result = std::numeric_limits<double>::quiet_NaN();
 
-	std::map<double,std::vector<double> >::iterator currentValues = mapFromWidthToValues.find(regularRiverReachProperties.activeWidth);
-	if(currentValues == mapFromWidthToValues.end())
+	#if defined SEDFLOWDETERMINISTIC
+	const std::pair<int,double> currentKey (cellID,regularRiverReachProperties.activeWidth);
+	#else
+	//All reaches with the same active width share their values and draw from the sequence of rand().
+	(void)cellID;
+	const std::pair<int,double> currentKey (-1,regularRiverReachProperties.activeWidth);
+	#endif
+	std::map<std::pair<int,double>,std::vector<double> >::iterator currentValues;
+	//Only the structure of the map is shared between the threads. Each entry is used by a single reach only.
+	#pragma omp critical(StochasticThresholdForInitiationOfBedloadMotionValues)
+	{
+	currentValues = mapFromCellIDAndWidthToValues.find(currentKey);
+	if(currentValues == mapFromCellIDAndWidthToValues.end())
 	{
 		double currentMiu (miu);
 		double currentBeta (beta);
@@ -158,12 +229,13 @@ double StochasticThresholdForInitiationOfBedloadMotion::calculateNotConst (const
 			currentBeta = currentSpecialValues->second.second;
 		}
 
-		std::vector<double> tmpValues (6,currentMiu); //miu, currentValue, previousValue, prePreviousValue
+		std::vector<double> tmpValues (7,currentMiu); //miu, currentValue, previousValue, prePreviousValue
 		tmpValues.at(0) = std::numeric_limits<double>::quiet_NaN(); //discharge
 		tmpValues.at(2) = currentBeta; //beta
+		tmpValues.at(6) = 0.0; //number of drawn random numbers
 
-		mapFromWidthToValues[regularRiverReachProperties.activeWidth] = tmpValues;
-		currentValues = mapFromWidthToValues.find(regularRiverReachProperties.activeWidth);
+		currentValues = mapFromCellIDAndWidthToValues.insert( std::make_pair(currentKey,tmpValues) ).first;
+	}
 	}
 
 	/*
@@ -177,7 +249,14 @@ double StochasticThresholdForInitiationOfBedloadMotion::calculateNotConst (const
 		currentValues->second.at(5) = currentValues->second.at(4); // prePreviousValue = previousValue
 		currentValues->second.at(4) = currentValues->second.at(3); // previousValue = currentValue
 
+		#if defined SEDFLOWDETERMINISTIC
+		double randomNumber = CounterBasedRandomNumbers::uniformWithinOpenUnitInterval(seed, cellID, regularRiverReachProperties.activeWidth, static_cast<unsigned long long>(currentValues->second.at(6))); //Uniform Distribution
+		currentValues->second.at(6) += 1.0;
+		#else
 		double randomNumber = (1.0+rand()) / (2.0+RAND_MAX); //Uniform Distribution
+		#pragma omp atomic
+		numberOfDrawnRandomNumbers += 1.0;
+		#endif
 		randomNumber = currentValues->second.at(1) - (currentValues->second.at(2) * log( (-1.0) * log(randomNumber) ) ); //Gumbel Distribution
 
 		result = (randomNumber * weightForCurrent) + (currentValues->second.at(4) * weightForPrevious) + (currentValues->second.at(5) * weightForPrePrevious);
@@ -0,0 +1,204 @@
+/*
+ * StreamingTimeSeriesSource.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#include "StreamingTimeSeriesSource.h"
+
+#include <sstream>
+#include <cstring>
+
+#include "TabDelimitedSpreadsheetStream.h"
+
+namespace SedFlow {
+
+StreamingTimeSeriesSource::StreamingTimeSeriesSource(const std::string& fileName, const std::string& elapsedSecondsColumn, const std::string& valueColumn, double valueFactor, int numberOfEntriesPerWindow):
+	fileName(fileName),
+	elapsedSecondsColumn(elapsedSecondsColumn),
+	valueColumn(valueColumn),
+	valueFactor(valueFactor),
+	grainsValues(false),
+	numberOfEntriesPerWindow(numberOfEntriesPerWindow),
+	offsetOfNextRow(-1),
+	exhausted(false),
+	spreadsheetStream(NULL),
+	elapsedSecondsColumnIndex(-1),
+	valueColumnIndex(-1)
+{
+	if( numberOfEntriesPerWindow < 1 )
+	{
+		const char *const numberOfEntriesPerWindowErrorMessage = "The number of entries per window of a StreamingTimeSeriesSource needs to be positive.";
+		throw(numberOfEntriesPerWindowErrorMessage);
+	}
+}
+
+StreamingTimeSeriesSource::StreamingTimeSeriesSource(const std::string& fileName, const std::string& elapsedSecondsColumn, const std::string& valueColumn, double valueFactor, const Grains& grainsBase, int numberOfEntriesPerWindow):
+	fileName(fileName),
+	elapsedSecondsColumn(elapsedSecondsColumn),
+	valueColumn(valueColumn),
+	valueFactor(valueFactor),
+	grainsValues(true),
+	grainsBase(grainsBase),
+	numberOfEntriesPerWindow(numberOfEntriesPerWindow),
+	offsetOfNextRow(-1),
+	exhausted(false),
+	spreadsheetStream(NULL),
+	elapsedSecondsColumnIndex(-1),
+	valueColumnIndex(-1)
+{
+	if( numberOfEntriesPerWindow < 1 )
+	{
+		const char *const numberOfEntriesPerWindowErrorMessage = "The number of entries per window of a StreamingTimeSeriesSource needs to be positive.";
+		throw(numberOfEntriesPerWindowErrorMessage);
+	}
+}
+
+StreamingTimeSeriesSource::StreamingTimeSeriesSource(const StreamingTimeSeriesSource& toCopy):
+	fileName(toCopy.fileName),
+	elapsedSecondsColumn(toCopy.elapsedSecondsColumn),
+	valueColumn(toCopy.valueColumn),
+	valueFactor(toCopy.valueFactor),
+	grainsValues(toCopy.grainsValues),
+	grainsBase(toCopy.grainsBase),
+	numberOfEntriesPerWindow(toCopy.numberOfEntriesPerWindow),
+	offsetOfNextRow(toCopy.offsetOfNextRow),
+	exhausted(toCopy.exhausted),
+	spreadsheetStream(NULL),
+	elapsedSecondsColumnIndex(-1),
+	valueColumnIndex(-1)
+{}
+
+StreamingTimeSeriesSource::~StreamingTimeSeriesSource()
+{
+	delete spreadsheetStream;
+}
+
+StreamingTimeSeriesSource& StreamingTimeSeriesSource::operator = (const StreamingTimeSeriesSource& toBeAssigned)
+{
+	if (this != &toBeAssigned)
+	{
+		this->fileName = toBeAssigned.fileName;
+		this->elapsedSecondsColumn = toBeAssigned.elapsedSecondsColumn;
+		this->valueColumn = toBeAssigned.valueColumn;
+		this->valueFactor = toBeAssigned.valueFactor;
+		this->grainsValues = toBeAssigned.grainsValues;
+		this->grainsBase = toBeAssigned.grainsBase;
+		this->numberOfEntriesPerWindow = toBeAssigned.numberOfEntriesPerWindow;
+		this->offsetOfNextRow = toBeAssigned.offsetOfNextRow;
+		this->exhausted = toBeAssigned.exhausted;
+		delete this->spreadsheetStream;
+		this->spreadsheetStream = NULL;
+		this->elapsedSecondsColumnIndex = -1;
+		this->valueColumnIndex = -1;
+	}
+	return *this;
+}
+
+void StreamingTimeSeriesSource::openSpreadsheetStream()
+{
+	spreadsheetStream = new TabDelimitedSpreadsheetStream(fileName);
+	if( offsetOfNextRow >= 0 ) { spreadsheetStream->seekToOffset(offsetOfNextRow); }
+}
+
+const std::vector<std::string>& StreamingTimeSeriesSource::getHeaderEntries()
+{
+	if( spreadsheetStream == NULL ) { openSpreadsheetStream(); }
+	return spreadsheetStream->getHeaderEntries();
+}
+
+void StreamingTimeSeriesSource::appendNextWindow(std::vector<TimeSeriesEntry>& target)
+{
+	if( exhausted ) { return; }
+	if( spreadsheetStream == NULL ) { openSpreadsheetStream(); }
+	if( elapsedSecondsColumnIndex < 0 )
+	{
+		elapsedSecondsColumnIndex = spreadsheetStream->getColumnIndex(elapsedSecondsColumn);
+		valueColumnIndex = spreadsheetStream->getColumnIndex(valueColumn);
+	}
+
+	double elapsedSeconds;
+	double value;
+	for(int i = 0; i < numberOfEntriesPerWindow; ++i)
+	{
+		if( !(spreadsheetStream->readNextRow()) )
+		{
+			exhausted = true;
+			break;
+		}
+		elapsedSeconds = spreadsheetStream->getDouble(elapsedSecondsColumnIndex);
+		if( !target.empty() && elapsedSeconds < target.back().elapsedSeconds )
+		{
+			std::string unsortedErrorMessageString = "For streaming input the following time series needs to be sorted by ascending ";
+			unsortedErrorMessageString.append(elapsedSecondsColumn);
+			unsortedErrorMessageString.append(":\n");
+			unsortedErrorMessageString.append(fileName);
+			unsortedErrorMessageString.append("\n");
+			char* unsortedErrorMessageNotConst = new char [unsortedErrorMessageString.size()+1];
+			std::strcpy (unsortedErrorMessageNotConst,unsortedErrorMessageString.c_str());
+			const char *const unsortedErrorMessage = unsortedErrorMessageNotConst;
+			throw(unsortedErrorMessage);
+		}
+		value = spreadsheetStream->getDouble(valueColumnIndex) * valueFactor;
+		if( grainsValues ) { target.push_back( TimeSeriesEntry(elapsedSeconds, grainsBase * value) ); }
+		else { target.push_back( TimeSeriesEntry(elapsedSeconds, value) ); }
+	}
+	offsetOfNextRow = spreadsheetStream->getOffsetOfNextRow();
+
+	if( exhausted )
+	{
+		delete spreadsheetStream;
+		spreadsheetStream = NULL;
+	}
+}
+
+void StreamingTimeSeriesSource::addToConstructionVariables(ConstructionVariables& target) const
+{
+	std::vector<std::string> stringVector;
+	stringVector.push_back(fileName);
+	target.labelledStrings["streamingSourceFile"] = stringVector;
+	stringVector.clear();
+	stringVector.push_back(elapsedSecondsColumn);
+	target.labelledStrings["elapsedSecondsColumn"] = stringVector;
+	stringVector.clear();
+	stringVector.push_back(valueColumn);
+	target.labelledStrings["valueColumn"] = stringVector;
+	// The offset is stored as string, as it may exceed the range of int.
+	std::ostringstream oStringStream;
+	oStringStream << offsetOfNextRow;
+	stringVector.clear();
+	stringVector.push_back(oStringStream.str());
+	target.labelledStrings["streamingSourceOffset"] = stringVector;
+	std::vector<double> doubleVector;
+	doubleVector.push_back(valueFactor);
+	target.labelledDoubles["valueFactor"] = doubleVector;
+	std::vector<int> intVector;
+	intVector.push_back(numberOfEntriesPerWindow);
+	target.labelledInts["numberOfEntriesPerStreamingWindow"] = intVector;
+	if( grainsValues )
+	{
+		std::vector<ConstructionVariables> constructionVariablesVector;
+		constructionVariablesVector.push_back( grainsBase.createConstructionVariables() );
+		target.labelledObjects["streamingGrainsBase"] = constructionVariablesVector;
+	}
+}
+
+}
@@ -23,6 +23,7 @@
  */
 
 #include "StringTools.h"
+#include "TabDelimitedSpreadsheet.h"
 
 #include <algorithm>
 #include <ctype.h>
@@ -42,6 +43,13 @@
 #include <limits.h> /* PATH_MAX */
 #endif
 
+#if defined CURRENTLYWINDOWS
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
 
 namespace SedFlow {
 
@@ -240,88 +248,46 @@ bool StringTools::fileExists(const std::string& fileName)
 
 std::map<std::string,std::vector<std::string> > StringTools::tabDelimitedSpreadsheetFileToStringMap(const std::string& tabDelimitedSpreadsheetFileName)
 {
-	const char rowDelim = '\n';
-	const char fieldDelim = '\t';
-	const char surplusRowDelim = '\r';
-
-	std::map<std::string,std::vector<std::string> > result;
-	std::vector<std::string> headerEntries;
-	std::map<std::string,std::vector<std::string> >::iterator resultMapIterator;
-	std::vector<std::string> emptyStringVector;
-	std::string tmpString;
-	int numberOfFieldDelims;
-	std::istringstream iStringStream;
-
-	char* inputFileName  = new char [tabDelimitedSpreadsheetFileName.size()+1];
-	std::strcpy (inputFileName, tabDelimitedSpreadsheetFileName.c_str());
-	std::ifstream spreadsheetFile(inputFileName);
-	delete[] inputFileName;
+	TabDelimitedSpreadsheet spreadsheet (tabDelimitedSpreadsheetFileName);
+	return spreadsheet.toStringMap();
+}
 
+std::vector<std::string> StringTools::listFilesInFolder(std::string folder)
+{
+	ensureForwardSlashesAndMakeStringEndWithOneSlash(folder);
+	std::vector<std::string> result;
 
-	if( !(spreadsheetFile) )
+#if defined CURRENTLYWINDOWS
+	//This is the Windows version
+	std::string searchPattern = folder;
+	searchPattern.append("*");
+	WIN32_FIND_DATAA findData;
+	HANDLE findHandle = FindFirstFileA(searchPattern.c_str(), &findData);
+	if( findHandle != INVALID_HANDLE_VALUE )
 	{
-		std::string fileExistErrorMessageString = "Following file cannot be found:\n";
-		fileExistErrorMessageString.append(tabDelimitedSpreadsheetFileName);
-		fileExistErrorMessageString.append("\n");
-		char* fileExistErrorMessageNotConst = new char [fileExistErrorMessageString.size()+1];
-		std::strcpy (fileExistErrorMessageNotConst,fileExistErrorMessageString.c_str());
-		const char *const fileExistErrorMessage = fileExistErrorMessageNotConst;
-		throw(fileExistErrorMessage);
+		do
+		{
+			if( (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0 ) { result.push_back(findData.cFileName); }
+		} while( FindNextFileA(findHandle, &findData) != 0 );
+		FindClose(findHandle);
 	}
-
-	std::copy(std::istreambuf_iterator<char>(spreadsheetFile), std::istreambuf_iterator<char>(), std::back_inserter(tmpString));
-	spreadsheetFile.close();
-	std::replace(tmpString.begin(),tmpString.end(),surplusRowDelim,rowDelim);
-	removeAdjacentDuplicatesOfCertainCharacter(tmpString,rowDelim);
-	std::istringstream spreadsheet;
-	spreadsheet.str(tmpString);
-	tmpString.clear();
-
-	for(bool firstLine = true; std::getline(spreadsheet,tmpString,rowDelim); )
+#else
+	//This is the Linux version
+	DIR* directory = opendir(folder.c_str());
+	if( directory != NULL )
 	{
-		removeAdjacentDuplicatesOfCertainCharacter(tmpString,fieldDelim);
-		removeSingleCertainCharacterFromBeginning(tmpString,fieldDelim);
-		removeSingleCertainCharacterFromEnd(tmpString,fieldDelim);
-		iStringStream.clear();
-		iStringStream.str( tmpString );
-		numberOfFieldDelims = countCharacter(tmpString,fieldDelim);
-		tmpString.clear();
-
-		if(firstLine)
-		{
-			for(;std::getline(iStringStream,tmpString,fieldDelim);tmpString.clear())
-			{
-				headerEntries.push_back(tmpString);
-				result[tmpString] = emptyStringVector;
-			}
-			firstLine = false;
-		}
-		else
+		struct stat fileStatus;
+		for(struct dirent* entry = readdir(directory); entry != NULL; entry = readdir(directory))
 		{
-			if( numberOfFieldDelims >= (headerEntries.size()-1) )
-			{
-				for(std::vector<std::string>::const_iterator currentHeaderEntry = headerEntries.begin(); currentHeaderEntry < headerEntries.end(); ++currentHeaderEntry)
-				{
-					resultMapIterator = result.find(*currentHeaderEntry);
-					std::getline(iStringStream,tmpString,fieldDelim);
-					resultMapIterator->second.push_back(tmpString);
-					tmpString.clear();
-				}
-			}
+			std::string fullFileName = folder;
+			fullFileName.append(entry->d_name);
+			if( stat(fullFileName.c_str(), &fileStatus) == 0 && S_ISREG(fileStatus.st_mode) ) { result.push_back(entry->d_name); }
 		}
+		closedir(directory);
 	}
+#endif
 
-	if( (result.begin())->second.size() == 0 )
-	{
-		std::string noSufficientRowErrorMessageString = "The following file does not contain any row with the minimum number of entries defined by the header line:\n";
-		noSufficientRowErrorMessageString.append(tabDelimitedSpreadsheetFileName);
-		noSufficientRowErrorMessageString.append("\n");
-		char* noSufficientRowErrorMessageNotConst = new char [noSufficientRowErrorMessageString.size()+1];
-		std::strcpy (noSufficientRowErrorMessageNotConst,noSufficientRowErrorMessageString.c_str());
-		const char *const noSufficientRowErrorMessage = noSufficientRowErrorMessageNotConst;
-		throw(noSufficientRowErrorMessage);
-	}
-
+	std::sort(result.begin(),result.end());
 	return result;
 }
 
@@ -500,6 +466,15 @@ std::string StringTools::boolTo_STRING(bool inputBool)
 	return result;
 }
 
+double StringTools::stringToDouble(std::string inputString)
+{
+	double result = 0.0;
+	trimString(inputString);
+	std::istringstream iStringStream (inputString);
+	iStringStream >> result;
+	return result;
+}
+
 std::vector<double> StringTools::stringVectorToDoubleVector(std::vector<std::string> inputStringVector)
 {
 	std::vector<double> result;
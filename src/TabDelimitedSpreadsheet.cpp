@@ -0,0 +1,371 @@
+/*
+ * TabDelimitedSpreadsheet.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "TabDelimitedSpreadsheet.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctype.h>
+
+#include "StringTools.h"
+
+#if defined CURRENTLYWINDOWS
+//This is the Windows version
+#include <windows.h>
+#else
+//This is the Linux version
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace SedFlow {
+
+struct TabDelimitedSpreadsheet::MappedFile {
+	const char* data;
+	std::size_t size;
+#if defined CURRENTLYWINDOWS
+	HANDLE fileHandle;
+	HANDLE mappingHandle;
+
+	MappedFile() : data(NULL), size(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(NULL) {}
+	bool open(const std::string& fileName)
+	{
+		fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if( fileHandle == INVALID_HANDLE_VALUE ) { return false; }
+		LARGE_INTEGER fileSize;
+		if( !GetFileSizeEx(fileHandle, &fileSize) ) { return false; }
+		size = static_cast<std::size_t>(fileSize.QuadPart);
+		// Empty files cannot be mapped.
+		if( size == 0 ) { return true; }
+		mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if( mappingHandle == NULL ) { return false; }
+		data = static_cast<const char*>( MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) );
+		return ( data != NULL );
+	}
+	~MappedFile()
+	{
+		if( data != NULL ) { UnmapViewOfFile(data); }
+		if( mappingHandle != NULL ) { CloseHandle(mappingHandle); }
+		if( fileHandle != INVALID_HANDLE_VALUE ) { CloseHandle(fileHandle); }
+	}
+#else
+	int fileDescriptor;
+
+	MappedFile() : data(NULL), size(0), fileDescriptor(-1) {}
+	bool open(const std::string& fileName)
+	{
+		fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+		if( fileDescriptor < 0 ) { return false; }
+		struct stat fileStatus;
+		if( fstat(fileDescriptor, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode) ) { return false; }
+		size = static_cast<std::size_t>(fileStatus.st_size);
+		// Empty files cannot be mapped.
+		if( size == 0 ) { return true; }
+		void* address = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if( address == MAP_FAILED ) { return false; }
+		data = static_cast<const char*>(address);
+		madvise(address, size, MADV_SEQUENTIAL);
+		return true;
+	}
+	~MappedFile()
+	{
+		if( data != NULL ) { munmap(const_cast<char*>(data), size); }
+		if( fileDescriptor >= 0 ) { close(fileDescriptor); }
+	}
+#endif
+};
+
+TabDelimitedSpreadsheet::TabDelimitedSpreadsheet(const std::string& tabDelimitedSpreadsheetFileName):
+	mappedFile(new MappedFile()),
+	fileBegin(NULL),
+	fileEnd(NULL)
+{
+	if( !(mappedFile->open(tabDelimitedSpreadsheetFileName)) )
+	{
+		delete mappedFile;
+		std::string fileExistErrorMessageString = "Following file cannot be found:\n";
+		fileExistErrorMessageString.append(tabDelimitedSpreadsheetFileName);
+		fileExistErrorMessageString.append("\n");
+		char* fileExistErrorMessageNotConst = new char [fileExistErrorMessageString.size()+1];
+		std::strcpy (fileExistErrorMessageNotConst,fileExistErrorMessageString.c_str());
+		const char *const fileExistErrorMessage = fileExistErrorMessageNotConst;
+		throw(fileExistErrorMessage);
+	}
+	fileBegin = mappedFile->data;
+	fileEnd = fileBegin + mappedFile->size;
+#if defined _DEBUG || defined DEBUG
+	checkDirectParsing();
+#endif
+
+	// The header is the first row, even if the file starts with a row delimiter.
+	const char* rowBegin = fileBegin;
+	const char* rowEnd = findRowEnd(rowBegin);
+	splitRow(rowBegin, rowEnd, headerEntries);
+
+	const int numberOfHeaderEntries = headerEntries.size();
+	for(rowBegin = rowEnd; rowBegin < fileEnd; rowBegin = rowEnd)
+	{
+		if( isRowDelimiter(*rowBegin) ) { rowEnd = rowBegin + 1; continue; }
+		rowEnd = findRowEnd(rowBegin);
+		if( isAcceptedRow(countFields(rowBegin,rowEnd),numberOfHeaderEntries) ) { rowBegins.push_back(rowBegin); }
+	}
+
+	if( rowBegins.empty() )
+	{
+		delete mappedFile;
+		std::string noSufficientRowErrorMessageString = "The following file does not contain any row with the minimum number of entries defined by the header line:\n";
+		noSufficientRowErrorMessageString.append(tabDelimitedSpreadsheetFileName);
+		noSufficientRowErrorMessageString.append("\n");
+		char* noSufficientRowErrorMessageNotConst = new char [noSufficientRowErrorMessageString.size()+1];
+		std::strcpy (noSufficientRowErrorMessageNotConst,noSufficientRowErrorMessageString.c_str());
+		const char *const noSufficientRowErrorMessage = noSufficientRowErrorMessageNotConst;
+		throw(noSufficientRowErrorMessage);
+	}
+}
+
+TabDelimitedSpreadsheet::~TabDelimitedSpreadsheet()
+{
+	delete mappedFile;
+}
+
+const char* TabDelimitedSpreadsheet::findRowEnd(const char* rowBegin) const
+{
+	const char* current = rowBegin;
+	while( current < fileEnd && !isRowDelimiter(*current) ) { ++current; }
+	return current;
+}
+
+bool TabDelimitedSpreadsheet::hasColumn(const std::string& header) const
+{
+	return ( std::find(headerEntries.begin(),headerEntries.end(),header) != headerEntries.end() );
+}
+
+std::vector<int> TabDelimitedSpreadsheet::getColumnIndices(const std::string& header) const
+{
+	std::vector<int> result;
+	for(std::vector<std::string>::const_iterator currentHeaderEntry = headerEntries.begin(); currentHeaderEntry < headerEntries.end(); ++currentHeaderEntry)
+	{
+		if( *currentHeaderEntry == header ) { result.push_back( currentHeaderEntry - headerEntries.begin() ); }
+	}
+	if( result.empty() )
+	{
+		std::string missingColumnErrorMessageString = "The following column is missing in a tab delimited spreadsheet:\n";
+		missingColumnErrorMessageString.append(header);
+		missingColumnErrorMessageString.append("\n");
+		char* missingColumnErrorMessageNotConst = new char [missingColumnErrorMessageString.size()+1];
+		std::strcpy (missingColumnErrorMessageNotConst,missingColumnErrorMessageString.c_str());
+		const char *const missingColumnErrorMessage = missingColumnErrorMessageNotConst;
+		throw(missingColumnErrorMessage);
+	}
+	return result;
+}
+
+void TabDelimitedSpreadsheet::splitRow(const char* rowBegin, const char* rowEnd, std::vector<std::string>& fields)
+{
+	for(const char* current = rowBegin; current < rowEnd; )
+	{
+		if( *current == '\t' ) { ++current; continue; }
+		const char* fieldBegin = current;
+		while( current < rowEnd && *current != '\t' ) { ++current; }
+		fields.push_back( std::string(fieldBegin,current) );
+	}
+}
+
+int TabDelimitedSpreadsheet::countFields(const char* rowBegin, const char* rowEnd)
+{
+	int result = 0;
+	for(const char* current = rowBegin; current < rowEnd; ++current)
+	{
+		if( *current != '\t' && ( current == rowBegin || *(current-1) == '\t' ) ) { ++result; }
+	}
+	return result;
+}
+
+void TabDelimitedSpreadsheet::locateField(const char* rowBegin, const char* rowEnd, int fieldIndex, const char*& fieldBegin, const char*& fieldEnd)
+{
+	const char* current = rowBegin;
+	for(int currentFieldIndex = 0; ; ++currentFieldIndex)
+	{
+		while( current < rowEnd && *current == '\t' ) { ++current; }
+		if( current == rowEnd || isRowDelimiter(*current) )
+		{
+			fieldBegin = current;
+			fieldEnd = current;
+			return;
+		}
+		fieldBegin = current;
+		while( current < rowEnd && *current != '\t' && !isRowDelimiter(*current) ) { ++current; }
+		if( currentFieldIndex == fieldIndex )
+		{
+			fieldEnd = current;
+			return;
+		}
+	}
+}
+
+bool TabDelimitedSpreadsheet::parseDoubleDirectly(const char* fieldBegin, const char* fieldEnd, double& result)
+{
+	// Powers of ten and integers up to 2^53 are exact doubles. Thus a single multiplication or division is correctly rounded,
+	// which gives the same result as the conversion by std::istream.
+	static const double exactPowersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	static const int maximumExactPowerOfTen = 22;
+	static const unsigned long long maximumExactMantissa = 9007199254740992ULL;
+
+	const char* current = fieldBegin;
+	while( current < fieldEnd && isspace(static_cast<unsigned char>(*current)) ) { ++current; }
+	while( fieldEnd > current && isspace(static_cast<unsigned char>(*(fieldEnd-1))) ) { --fieldEnd; }
+
+	bool negative = false;
+	if( current < fieldEnd && ( *current == '-' || *current == '+' ) )
+	{
+		negative = ( *current == '-' );
+		++current;
+	}
+
+	unsigned long long mantissa = 0;
+	int numberOfDigits = 0;
+	int decimalExponent = 0;
+	for(; current < fieldEnd && isdigit(static_cast<unsigned char>(*current)); ++current, ++numberOfDigits)
+	{
+		mantissa = ( mantissa * 10 ) + ( *current - '0' );
+		if( mantissa > maximumExactMantissa ) { return false; }
+	}
+	if( current < fieldEnd && *current == '.' )
+	{
+		for(++current; current < fieldEnd && isdigit(static_cast<unsigned char>(*current)); ++current, ++numberOfDigits, --decimalExponent)
+		{
+			mantissa = ( mantissa * 10 ) + ( *current - '0' );
+			if( mantissa > maximumExactMantissa ) { return false; }
+		}
+	}
+	if( numberOfDigits == 0 ) { return false; }
+
+	if( current < fieldEnd && ( *current == 'e' || *current == 'E' ) )
+	{
+		++current;
+		bool negativeExponent = false;
+		if( current < fieldEnd && ( *current == '-' || *current == '+' ) )
+		{
+			negativeExponent = ( *current == '-' );
+			++current;
+		}
+		if( current == fieldEnd || !isdigit(static_cast<unsigned char>(*current)) ) { return false; }
+		int explicitExponent = 0;
+		for(; current < fieldEnd && isdigit(static_cast<unsigned char>(*current)); ++current)
+		{
+			if( explicitExponent > 10000 ) { return false; }
+			explicitExponent = ( explicitExponent * 10 ) + ( *current - '0' );
+		}
+		decimalExponent += negativeExponent ? -explicitExponent : explicitExponent;
+	}
+	if( current != fieldEnd ) { return false; }
+	if( decimalExponent > maximumExactPowerOfTen || decimalExponent < -maximumExactPowerOfTen ) { return false; }
+
+	double value = static_cast<double>(mantissa);
+	if( decimalExponent >= 0 ) { value *= exactPowersOfTen[decimalExponent]; }
+	else { value /= exactPowersOfTen[-decimalExponent]; }
+	result = negative ? -value : value;
+	return true;
+}
+
+double TabDelimitedSpreadsheet::parseDouble(const char* fieldBegin, const char* fieldEnd)
+{
+	double result;
+	if( !parseDoubleDirectly(fieldBegin, fieldEnd, result) ) { result = StringTools::stringToDouble( std::string(fieldBegin,fieldEnd) ); }
+#if defined _DEBUG || defined DEBUG
+	else if( result != StringTools::stringToDouble( std::string(fieldBegin,fieldEnd) ) )
+	{
+		std::string errorMessageString = "The direct conversion differs from the stream conversion for the spreadsheet entry: ";
+		errorMessageString.append(fieldBegin,fieldEnd);
+		char* errorMessageNotConst = new char [errorMessageString.size()+1];
+		std::strcpy (errorMessageNotConst,errorMessageString.c_str());
+		const char *const errorMessage = errorMessageNotConst;
+		throw(errorMessage);
+	}
+#endif
+	return result;
+}
+
+#if defined _DEBUG || defined DEBUG
+void TabDelimitedSpreadsheet::checkDirectParsing()
+{
+	// Entries with mantissas around 2^53, which have been rounded twice by earlier versions of parseDoubleDirectly.
+	static const char* const criticalEntries[] = { "90071992547409.93", "9007199254740995e-3", "9007199254740997e-10", "9007199254740992", "9007199254740993", "900719925474099.2", "0.1", "-1.5e-22" };
+	for(unsigned int i = 0; i < ( sizeof(criticalEntries) / sizeof(criticalEntries[0]) ); ++i)
+	{
+		parseDouble(criticalEntries[i], criticalEntries[i] + std::strlen(criticalEntries[i]));
+	}
+}
+#endif
+
+std::vector<double> TabDelimitedSpreadsheet::getDoubleColumn(const std::string& header) const
+{
+	std::vector<int> columnIndices = getColumnIndices(header);
+	std::vector<double> result;
+	result.reserve( rowBegins.size() * columnIndices.size() );
+	const char* fieldBegin;
+	const char* fieldEnd;
+	for(std::vector<const char*>::const_iterator currentRowBegin = rowBegins.begin(); currentRowBegin < rowBegins.end(); ++currentRowBegin)
+	{
+		for(std::vector<int>::const_iterator currentColumnIndex = columnIndices.begin(); currentColumnIndex < columnIndices.end(); ++currentColumnIndex)
+		{
+			locateField(*currentRowBegin, fileEnd, *currentColumnIndex, fieldBegin, fieldEnd);
+			result.push_back( parseDouble(fieldBegin, fieldEnd) );
+		}
+	}
+	return result;
+}
+
+std::vector<std::string> TabDelimitedSpreadsheet::getStringColumn(const std::string& header) const
+{
+	std::vector<int> columnIndices = getColumnIndices(header);
+	std::vector<std::string> result;
+	result.reserve( rowBegins.size() * columnIndices.size() );
+	const char* fieldBegin;
+	const char* fieldEnd;
+	for(std::vector<const char*>::const_iterator currentRowBegin = rowBegins.begin(); currentRowBegin < rowBegins.end(); ++currentRowBegin)
+	{
+		for(std::vector<int>::const_iterator currentColumnIndex = columnIndices.begin(); currentColumnIndex < columnIndices.end(); ++currentColumnIndex)
+		{
+			locateField(*currentRowBegin, fileEnd, *currentColumnIndex, fieldBegin, fieldEnd);
+			result.push_back( std::string(fieldBegin,fieldEnd) );
+		}
+	}
+	return result;
+}
+
+std::map<std::string,std::vector<std::string> > TabDelimitedSpreadsheet::toStringMap() const
+{
+	std::map<std::string,std::vector<std::string> > result;
+	for(std::vector<std::string>::const_iterator currentHeaderEntry = headerEntries.begin(); currentHeaderEntry < headerEntries.end(); ++currentHeaderEntry)
+	{
+		if( result.find(*currentHeaderEntry) == result.end() ) { result[*currentHeaderEntry] = getStringColumn(*currentHeaderEntry); }
+	}
+	return result;
+}
+
+}
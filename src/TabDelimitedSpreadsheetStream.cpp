@@ -0,0 +1,161 @@
+/*
+ * TabDelimitedSpreadsheetStream.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+#include "TabDelimitedSpreadsheetStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "TabDelimitedSpreadsheet.h"
+
+namespace SedFlow {
+
+TabDelimitedSpreadsheetStream::TabDelimitedSpreadsheetStream(const std::string& tabDelimitedSpreadsheetFileName):
+	fileName(tabDelimitedSpreadsheetFileName),
+	fileStream(tabDelimitedSpreadsheetFileName.c_str(), std::ios_base::in | std::ios_base::binary),
+	offsetOfCurrentLine(0),
+	offsetOfNextLine(0),
+	positionInCurrentLine(1),
+	currentRowBegin(NULL),
+	currentRowEnd(NULL)
+{
+	if( !fileStream.is_open() )
+	{
+		std::string fileExistErrorMessageString = "Following file cannot be found:\n";
+		fileExistErrorMessageString.append(tabDelimitedSpreadsheetFileName);
+		fileExistErrorMessageString.append("\n");
+		char* fileExistErrorMessageNotConst = new char [fileExistErrorMessageString.size()+1];
+		std::strcpy (fileExistErrorMessageNotConst,fileExistErrorMessageString.c_str());
+		const char *const fileExistErrorMessage = fileExistErrorMessageNotConst;
+		throw(fileExistErrorMessage);
+	}
+
+	// The header is the first row, even if the file starts with a row delimiter.
+	if( readNextLine() )
+	{
+		std::string::size_type headerEnd = std::min( currentLine.find('\r'), currentLine.size() );
+		TabDelimitedSpreadsheet::splitRow(currentLine.data(), currentLine.data() + headerEnd, headerEntries);
+		positionInCurrentLine = headerEnd + 1;
+	}
+}
+
+TabDelimitedSpreadsheetStream::~TabDelimitedSpreadsheetStream(){}
+
+bool TabDelimitedSpreadsheetStream::readNextLine()
+{
+	offsetOfCurrentLine = offsetOfNextLine;
+	if( !std::getline(fileStream, currentLine) ) { return false; }
+	// The last line of a file does not need to end with '\n'. In this case there is nothing left to be read afterwards.
+	offsetOfNextLine = offsetOfCurrentLine + static_cast<std::streamoff>(currentLine.size()) + 1;
+	positionInCurrentLine = 0;
+	return true;
+}
+
+bool TabDelimitedSpreadsheetStream::readNextNonEmptyRow()
+{
+	for(;;)
+	{
+		if( positionInCurrentLine > currentLine.size() )
+		{
+			if( !readNextLine() ) { return false; }
+		}
+		std::string::size_type rowBeginPosition = positionInCurrentLine;
+		std::string::size_type rowEndPosition = std::min( currentLine.find('\r',rowBeginPosition), currentLine.size() );
+		positionInCurrentLine = rowEndPosition + 1;
+		if( rowEndPosition > rowBeginPosition )
+		{
+			currentRowBegin = currentLine.data() + rowBeginPosition;
+			currentRowEnd = currentLine.data() + rowEndPosition;
+			return true;
+		}
+	}
+}
+
+bool TabDelimitedSpreadsheetStream::readNextRow()
+{
+	const int numberOfHeaderEntries = headerEntries.size();
+	while( readNextNonEmptyRow() )
+	{
+		if( TabDelimitedSpreadsheet::isAcceptedRow(TabDelimitedSpreadsheet::countFields(currentRowBegin,currentRowEnd),numberOfHeaderEntries) ) { return true; }
+	}
+	currentRowBegin = NULL;
+	currentRowEnd = NULL;
+	return false;
+}
+
+bool TabDelimitedSpreadsheetStream::hasColumn(const std::string& header) const
+{
+	return ( std::find(headerEntries.begin(),headerEntries.end(),header) != headerEntries.end() );
+}
+
+int TabDelimitedSpreadsheetStream::getColumnIndex(const std::string& header) const
+{
+	std::vector<std::string>::const_iterator headerEntry = std::find(headerEntries.begin(),headerEntries.end(),header);
+	if( headerEntry == headerEntries.end() )
+	{
+		std::string missingColumnErrorMessageString = "The following column is missing in a tab delimited spreadsheet:\n";
+		missingColumnErrorMessageString.append(header);
+		missingColumnErrorMessageString.append("\n");
+		char* missingColumnErrorMessageNotConst = new char [missingColumnErrorMessageString.size()+1];
+		std::strcpy (missingColumnErrorMessageNotConst,missingColumnErrorMessageString.c_str());
+		const char *const missingColumnErrorMessage = missingColumnErrorMessageNotConst;
+		throw(missingColumnErrorMessage);
+	}
+	return ( headerEntry - headerEntries.begin() );
+}
+
+std::string TabDelimitedSpreadsheetStream::getString(int columnIndex) const
+{
+	const char* fieldBegin;
+	const char* fieldEnd;
+	TabDelimitedSpreadsheet::locateField(currentRowBegin, currentRowEnd, columnIndex, fieldBegin, fieldEnd);
+	return std::string(fieldBegin,fieldEnd);
+}
+
+double TabDelimitedSpreadsheetStream::getDouble(int columnIndex) const
+{
+	const char* fieldBegin;
+	const char* fieldEnd;
+	TabDelimitedSpreadsheet::locateField(currentRowBegin, currentRowEnd, columnIndex, fieldBegin, fieldEnd);
+	return TabDelimitedSpreadsheet::parseDouble(fieldBegin, fieldEnd);
+}
+
+std::streamoff TabDelimitedSpreadsheetStream::getOffsetOfNextRow() const
+{
+	if( positionInCurrentLine > currentLine.size() ) { return offsetOfNextLine; }
+	return ( offsetOfCurrentLine + static_cast<std::streamoff>(positionInCurrentLine) );
+}
+
+void TabDelimitedSpreadsheetStream::seekToOffset(std::streamoff offset)
+{
+	fileStream.clear();
+	fileStream.seekg(offset);
+	offsetOfNextLine = offset;
+	currentLine.clear();
+	positionInCurrentLine = 1;
+	currentRowBegin = NULL;
+	currentRowEnd = NULL;
+}
+
+}
@@ -28,11 +28,49 @@
 
 namespace SedFlow {
 
-TimeSeries::~TimeSeries(){}
+TimeSeries::~TimeSeries()
+{
+	delete streamingSource;
+}
+
+TimeSeries::TimeSeries(const TimeSeries& toCopy):
+	cellID(toCopy.cellID),
+	userCellID(toCopy.userCellID),
+	margin(toCopy.margin),
+	streamingSource(NULL),
+	cursor(toCopy.cursor),
+	property(toCopy.property),
+	actualTimeSeries(toCopy.actualTimeSeries),
+	surplusInsteadOfAbsoluteValues(toCopy.surplusInsteadOfAbsoluteValues),
+	finalInsteadOfInitialAdding(toCopy.finalInsteadOfInitialAdding)
+{
+	if( toCopy.streamingSource != NULL ) { this->streamingSource = new StreamingTimeSeriesSource(*(toCopy.streamingSource)); }
+}
+
+TimeSeries& TimeSeries::operator = (const TimeSeries& toBeAssigned)
+{
+	if (this != &toBeAssigned)
+	{
+		this->cellID = toBeAssigned.cellID;
+		this->userCellID = toBeAssigned.userCellID;
+		this->margin = toBeAssigned.margin;
+		delete this->streamingSource;
+		this->streamingSource = NULL;
+		if( toBeAssigned.streamingSource != NULL ) { this->streamingSource = new StreamingTimeSeriesSource(*(toBeAssigned.streamingSource)); }
+		this->cursor = toBeAssigned.cursor;
+		this->property = toBeAssigned.property;
+		this->actualTimeSeries = toBeAssigned.actualTimeSeries;
+		this->surplusInsteadOfAbsoluteValues = toBeAssigned.surplusInsteadOfAbsoluteValues;
+		this->finalInsteadOfInitialAdding = toBeAssigned.finalInsteadOfInitialAdding;
+	}
+	return *this;
+}
 
 TimeSeries::TimeSeries(int userCellID, bool margin, CombinerVariables::TypesOfRegularRiverReachProperties property, const std::vector<TimeSeriesEntry>& timeSeries, const RegularRiverSystemProperties& regularRiverSystemProperties):
 	userCellID(userCellID),
 	margin(margin),
+	streamingSource(NULL),
+	cursor(0),
 	property(property),
 	actualTimeSeries(timeSeries),
 	surplusInsteadOfAbsoluteValues(false),
@@ -71,6 +109,8 @@ TimeSeries::TimeSeries(int userCellID, bool margin, CombinerVariables::TypesOfRe
 TimeSeries::TimeSeries(int userCellID, bool margin, CombinerVariables::TypesOfRegularRiverReachProperties property, const std::vector<TimeSeriesEntry>& timeSeries, bool surplusInsteadOfAbsoluteValues, bool finalInsteadOfInitialAdding, const RegularRiverSystemProperties& regularRiverSystemProperties):
 	userCellID(userCellID),
 	margin(margin),
+	streamingSource(NULL),
+	cursor(0),
 	property(property),
 	actualTimeSeries(timeSeries),
 	surplusInsteadOfAbsoluteValues(surplusInsteadOfAbsoluteValues),
@@ -126,12 +166,37 @@ ConstructionVariables TimeSeries::createConstructionVariables() const
 	stringVector.push_back( CombinerVariables::typeOfRegularRiverReachPropertiesToString(property) );
 	result.labelledStrings["property"] = stringVector;
 	std::vector<ConstructionVariables> constructionVariablesVector;
-	for(std::vector<TimeSeriesEntry>::const_iterator iterator = this->actualTimeSeries.begin(); iterator < this->actualTimeSeries.end(); ++iterator)
+	// The entries before the cursor have already been passed.
+	for(std::vector<TimeSeriesEntry>::const_iterator iterator = this->actualTimeSeries.begin() + std::min(this->cursor,this->actualTimeSeries.size()); iterator < this->actualTimeSeries.end(); ++iterator)
 			{ constructionVariablesVector.push_back( iterator->createConstructionVariables() ); }
 	result.labelledObjects["timeSeries"] = constructionVariablesVector;
+	if( this->streamingSource != NULL && !(this->streamingSource->isExhausted()) ) { this->streamingSource->addToConstructionVariables(result); }
 	return result;
 }
 
+void TimeSeries::setStreamingSource(const StreamingTimeSeriesSource& streamingSource)
+{
+	delete this->streamingSource;
+	this->streamingSource = new StreamingTimeSeriesSource(streamingSource);
+}
+
+void TimeSeries::readStreamingWindowsBeyond(double elapsedSeconds)
+{
+	if( !(streamingSource->isExhausted()) && ( (actualTimeSeries.size() - cursor) < 2 || actualTimeSeries.back().elapsedSeconds <= elapsedSeconds ) )
+	{
+		// Only the entries from the cursor onwards are kept, so that the buffer does not grow with the length of the time series.
+		actualTimeSeries.erase(actualTimeSeries.begin(), actualTimeSeries.begin() + std::min(cursor,actualTimeSeries.size()));
+		cursor = 0;
+	}
+	while( !(streamingSource->isExhausted()) && ( actualTimeSeries.size() < 2 || actualTimeSeries.back().elapsedSeconds <= elapsedSeconds ) )
+		{ streamingSource->appendNextWindow(actualTimeSeries); }
+	if( streamingSource->isExhausted() )
+	{
+		delete streamingSource;
+		streamingSource = NULL;
+	}
+}
+
 void TimeSeries::setCellID(int cellID, const RegularRiverSystemProperties& regularRiverSystemProperties)
 {
 	const RiverReachProperties* localCell = &(regularRiverSystemProperties.cellProperties.at(cellID));
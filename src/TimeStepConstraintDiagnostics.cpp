@@ -0,0 +1,189 @@
+/*
+ * TimeStepConstraintDiagnostics.cpp
+ *
+ *   Copyright (C) 2014 Swiss Federal Research Institute WSL (http://www.wsl.ch)
+ *   Developed by F.U.M. Heimann
+ *   Published by the Swiss Federal Research Institute WSL
+ *   
+ *   This program is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU General Public License version 3
+ *   as published by the Free Software Foundation.
+ *   
+ *   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+ *   See the GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see http://www.gnu.org/licenses
+ *   
+ *   This software is part of the model sedFlow,
+ *   which is intended for the simulation of bedload dynamics in mountain streams.
+ *   
+ *   For details on sedFlow see http://www.wsl.ch/sedFlow
+ */
+
+
+#include "TimeStepConstraintDiagnostics.h"
+#include "RiverReachProperties.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <utility>
+#include <functional>
+
+#if defined SEDFLOWPARALLEL
+#include <omp.h>
+#endif
+
+namespace SedFlow {
+
+bool TimeStepConstraintDiagnostics::enabled = false;
+double TimeStepConstraintDiagnostics::thresholdForPrintingTimeSteps = 0.0;
+const int TimeStepConstraintDiagnostics::maximumNumberOfPrintedTimeSteps = 1000;
+int TimeStepConstraintDiagnostics::numberOfPrintedTimeSteps = 0;
+std::vector<TimeStepConstraintDiagnostics::Candidate> TimeStepConstraintDiagnostics::shortestCandidatePerThread;
+long TimeStepConstraintDiagnostics::numberOfTimeSteps = 0;
+std::vector<long> TimeStepConstraintDiagnostics::timeStepsPerConstraint;
+std::vector<double> TimeStepConstraintDiagnostics::secondsPerConstraint;
+std::map< int, std::vector<long> > TimeStepConstraintDiagnostics::timeStepsPerReachAndConstraint;
+
+void TimeStepConstraintDiagnostics::enable(double thresholdForPrintingTimeSteps)
+{
+	int numberOfThreads = 1;
+#if defined SEDFLOWPARALLEL
+	numberOfThreads = omp_get_max_threads();
+#endif
+	shortestCandidatePerThread.resize(numberOfThreads);
+	resetCandidates();
+	TimeStepConstraintDiagnostics::thresholdForPrintingTimeSteps = thresholdForPrintingTimeSteps;
+	numberOfPrintedTimeSteps = 0;
+	numberOfTimeSteps = 0;
+	timeStepsPerConstraint.assign(NumberOfConstraints, 0);
+	secondsPerConstraint.assign(NumberOfConstraints, 0.0);
+	timeStepsPerReachAndConstraint.clear();
+	enabled = true;
+}
+
+void TimeStepConstraintDiagnostics::resetCandidates()
+{
+	for(std::vector<Candidate>::iterator currentCandidate = shortestCandidatePerThread.begin(); currentCandidate < shortestCandidatePerThread.end(); ++currentCandidate)
+	{
+		currentCandidate->timeStep = std::numeric_limits<double>::max();
+		currentCandidate->constraint = Unconstrained;
+		currentCandidate->riverReachProperties = NULL;
+	}
+}
+
+void TimeStepConstraintDiagnostics::proposeInternally(double timeStep, Constraints constraint, const RiverReachProperties* riverReachProperties)
+{
+	int thread = 0;
+#if defined SEDFLOWPARALLEL
+	thread = omp_get_thread_num();
+	if( thread >= static_cast<int>(shortestCandidatePerThread.size()) ) { return; }
+#endif
+	Candidate& shortestCandidate = shortestCandidatePerThread[thread];
+	if( timeStep < shortestCandidate.timeStep )
+	{
+		shortestCandidate.timeStep = timeStep;
+		shortestCandidate.constraint = constraint;
+		shortestCandidate.riverReachProperties = riverReachProperties;
+	}
+}
+
+int TimeStepConstraintDiagnostics::getUserCellID(const RiverReachProperties* riverReachProperties)
+{
+	if( riverReachProperties == NULL ) { return -1; }
+	if( riverReachProperties->isUpstreamMargin() ) { return riverReachProperties->getDownstreamUserCellID(); }
+	return riverReachProperties->getUserCellID();
+}
+
+void TimeStepConstraintDiagnostics::completeTimeStepInternally(double timeStepLength, double elapsedSeconds)
+{
+	const Candidate* shortestCandidate = &(shortestCandidatePerThread.front());
+	for(std::vector<Candidate>::const_iterator currentCandidate = shortestCandidatePerThread.begin() + 1; currentCandidate < shortestCandidatePerThread.end(); ++currentCandidate)
+		{ if( currentCandidate->timeStep < shortestCandidate->timeStep ) { shortestCandidate = &(*currentCandidate); } }
+
+	int userCellID = getUserCellID(shortestCandidate->riverReachProperties);
+	++numberOfTimeSteps;
+	timeStepsPerConstraint[shortestCandidate->constraint] += 1;
+	secondsPerConstraint[shortestCandidate->constraint] += timeStepLength;
+	std::vector<long>& timeStepsPerConstraintOfReach = timeStepsPerReachAndConstraint[userCellID];
+	if( timeStepsPerConstraintOfReach.empty() ) { timeStepsPerConstraintOfReach.assign(NumberOfConstraints, 0); }
+	timeStepsPerConstraintOfReach[shortestCandidate->constraint] += 1;
+
+	if( shortestCandidate->timeStep < thresholdForPrintingTimeSteps && numberOfPrintedTimeSteps < maximumNumberOfPrintedTimeSteps )
+	{
+		std::cout << "Time step of " << shortestCandidate->timeStep << " seconds at ";
+		if( userCellID < 0 ) { std::cout << "no specific reach"; }
+		else { std::cout << "reach " << userCellID; }
+		std::cout << " due to " << constraintToString(static_cast<Constraints>(shortestCandidate->constraint)) << " after " << elapsedSeconds << " seconds." << std::endl;
+		++numberOfPrintedTimeSteps;
+		if( numberOfPrintedTimeSteps == maximumNumberOfPrintedTimeSteps ) { std::cout << "Number of time step length outputs reached its maximum of " << maximumNumberOfPrintedTimeSteps << ". Further short time steps are only counted." << std::endl; }
+	}
+
+	resetCandidates();
+}
+
+const char* TimeStepConstraintDiagnostics::constraintToString(Constraints constraint)
+{
+	switch(constraint)
+	{
+	case WaterCourantFriedrichsLewy: return "water flow Courant-Friedrichs-Lewy";
+	case WaterNotEmptyingCell: return "water flow not emptying complete cell";
+	case WaterMaximumTimeStep: return "water flow maximum time step";
+	case SedimentCourantFriedrichsLewy: return "sediment flow Courant-Friedrichs-Lewy";
+	case SedimentActiveLayerErosion: return "sediment flow not eroding more than active layer";
+	case SedimentBedSlopeChange: return "sediment flow maximum relative bed slope change";
+	case Unconstrained: return "unconstrained";
+	default:
+		const char *const errorMessage = "Invalid time step constraint";
+		throw(errorMessage);
+	}
+}
+
+void TimeStepConstraintDiagnostics::printSummary(std::ostream& outputStream, int numberOfReportedReaches)
+{
+	if( !enabled ) { return; }
+	double shareFactor = ( numberOfTimeSteps > 0 ) ? ( 100.0 / numberOfTimeSteps ) : 0.0;
+
+	std::ios_base::fmtflags previousFlags = outputStream.flags();
+	std::streamsize previousPrecision = outputStream.precision();
+	outputStream << std::endl << "Constraints limiting the length of " << numberOfTimeSteps << " time steps:" << std::endl;
+	outputStream << std::left << std::setw(52) << "Constraint" << std::right << std::setw(14) << "time steps" << std::setw(10) << "share [%]" << std::setw(18) << "mean length [s]" << std::endl;
+	outputStream << std::fixed;
+	for(int constraint = 0; constraint < NumberOfConstraints; ++constraint)
+	{
+		if( timeStepsPerConstraint[constraint] == 0 ) { continue; }
+		outputStream << std::left << std::setw(52) << constraintToString(static_cast<Constraints>(constraint)) << std::right << std::setw(14) << timeStepsPerConstraint[constraint] << std::setprecision(1) << std::setw(10) << (timeStepsPerConstraint[constraint] * shareFactor) << std::setprecision(4) << std::setw(18) << (secondsPerConstraint[constraint] / timeStepsPerConstraint[constraint]) << std::endl;
+	}
+
+	std::vector< std::pair<long,int> > timeStepsAndReaches;
+	timeStepsAndReaches.reserve( timeStepsPerReachAndConstraint.size() );
+	for(std::map< int, std::vector<long> >::const_iterator currentReach = timeStepsPerReachAndConstraint.begin(); currentReach != timeStepsPerReachAndConstraint.end(); ++currentReach)
+	{
+		long timeStepsOfReach = 0;
+		for(std::vector<long>::const_iterator currentConstraint = currentReach->second.begin(); currentConstraint < currentReach->second.end(); ++currentConstraint) { timeStepsOfReach += *currentConstraint; }
+		timeStepsAndReaches.push_back( std::make_pair(timeStepsOfReach, currentReach->first) );
+	}
+	std::sort(timeStepsAndReaches.begin(), timeStepsAndReaches.end(), std::greater< std::pair<long,int> >());
+
+	outputStream << std::endl << "Reaches limiting the length of the time steps (" << std::min(numberOfReportedReaches, static_cast<int>(timeStepsAndReaches.size())) << " of " << timeStepsAndReaches.size() << "):" << std::endl;
+	outputStream << std::left << std::setw(12) << "Reach" << std::right << std::setw(14) << "time steps" << std::setw(10) << "share [%]" << std::setw(16) << "cumulated [%]" << "  main constraint" << std::endl;
+	long cumulatedTimeSteps = 0;
+	for(int i = 0; i < std::min(numberOfReportedReaches, static_cast<int>(timeStepsAndReaches.size())); ++i)
+	{
+		const std::vector<long>& timeStepsPerConstraintOfReach = timeStepsPerReachAndConstraint[timeStepsAndReaches[i].second];
+		int mainConstraint = std::max_element(timeStepsPerConstraintOfReach.begin(), timeStepsPerConstraintOfReach.end()) - timeStepsPerConstraintOfReach.begin();
+		cumulatedTimeSteps += timeStepsAndReaches[i].first;
+		outputStream << std::left << std::setw(12);
+		if( timeStepsAndReaches[i].second < 0 ) { outputStream << "none"; }
+		else { outputStream << timeStepsAndReaches[i].second; }
+		outputStream << std::right << std::setw(14) << timeStepsAndReaches[i].first << std::setprecision(1) << std::setw(10) << (timeStepsAndReaches[i].first * shareFactor) << std::setw(16) << (cumulatedTimeSteps * shareFactor) << "  " << constraintToString(static_cast<Constraints>(mainConstraint)) << std::endl;
+	}
+	outputStream << std::endl;
+	outputStream.flags(previousFlags);
+	outputStream.precision(previousPrecision);
+}
+
+}
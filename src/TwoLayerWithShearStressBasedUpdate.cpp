@@ -128,9 +128,50 @@ ConstructionVariables TwoLayerWithShearStressBasedUpdate::createConstructionVari
 	doubleVector.clear();
 	doubleVector.push_back(predefinedBaseDataForSublayerInfluence.thetaCriticalForSublayer);
 	result.labelledDoubles["thetaCriticalForSublayer"] = doubleVector;
+	std::vector<int> intVector;
+	constructionVariablesVector.clear();
+	for(std::map<int,Grains>::const_iterator currentEntry = mapFromCellIDToSublayerComposition.begin(); currentEntry != mapFromCellIDToSublayerComposition.end(); ++currentEntry)
+	{
+		intVector.push_back(currentEntry->first);
+		constructionVariablesVector.push_back( currentEntry->second.createConstructionVariables() );
+	}
+	result.labelledInts["cellIDsOfSublayerCompositions"] = intVector;
+	result.labelledObjects["sublayerCompositions"] = constructionVariablesVector;
+	intVector.clear();
+	doubleVector.clear();
+	for(std::map<int,TwoLayerWithShearStressBasedUpdate_BaseDataForSublayerInfluence>::const_iterator currentEntry = mapFromCellIDToBaseDataForSublayerInfluence.begin(); currentEntry != mapFromCellIDToBaseDataForSublayerInfluence.end(); ++currentEntry)
+	{
+		intVector.push_back(currentEntry->first);
+		doubleVector.push_back(currentEntry->second.medianDiameterForActiveLayer);
+		doubleVector.push_back(currentEntry->second.thetaCriticalForSublayer);
+		doubleVector.push_back(currentEntry->second.oneOverDifferenceBetweenThetaCriticalForActiveAndSublayer);
+	}
+	result.labelledInts["cellIDsOfBaseDataForSublayerInfluence"] = intVector;
+	result.labelledDoubles["baseDataForSublayerInfluenceOneAfterAnother"] = doubleVector;
 	return result;
 }
 
+void TwoLayerWithShearStressBasedUpdate::setStoredSublayerData(const std::vector<int>& cellIDsOfSublayerCompositions, const std::vector<Grains>& sublayerCompositions, const std::vector<int>& cellIDsOfBaseDataForSublayerInfluence, const std::vector<double>& baseDataForSublayerInfluenceOneAfterAnother)
+{
+	if( (cellIDsOfSublayerCompositions.size() != sublayerCompositions.size()) || (baseDataForSublayerInfluenceOneAfterAnother.size() != (3 * cellIDsOfBaseDataForSublayerInfluence.size())) )
+	{
+		const char *const sizeErrorMessage = "The stored sublayer compositions or break up conditions do not match their cellIDs for TwoLayerWithShearStressBasedUpdate.";
+		throw(sizeErrorMessage);
+	}
+	mapFromCellIDToSublayerComposition.clear();
+	for(std::vector<int>::size_type i = 0; i < cellIDsOfSublayerCompositions.size(); ++i)
+		{ mapFromCellIDToSublayerComposition[ cellIDsOfSublayerCompositions[i] ] = sublayerCompositions[i]; }
+	mapFromCellIDToBaseDataForSublayerInfluence.clear();
+	TwoLayerWithShearStressBasedUpdate_BaseDataForSublayerInfluence baseData;
+	for(std::vector<int>::size_type i = 0; i < cellIDsOfBaseDataForSublayerInfluence.size(); ++i)
+	{
+		baseData.medianDiameterForActiveLayer = baseDataForSublayerInfluenceOneAfterAnother[3*i];
+		baseData.thetaCriticalForSublayer = baseDataForSublayerInfluenceOneAfterAnother[(3*i)+1];
+		baseData.oneOverDifferenceBetweenThetaCriticalForActiveAndSublayer = baseDataForSublayerInfluenceOneAfterAnother[(3*i)+2];
+		mapFromCellIDToBaseDataForSublayerInfluence[ cellIDsOfBaseDataForSublayerInfluence[i] ] = baseData;
+	}
+}
+
 void TwoLayerWithShearStressBasedUpdate::sortMaterialUpward (std::vector<Grains>& strata, double activeThickness, double sublayerThickness, const RegularRiverReachProperties& regularRiverReachProperties, int cellID)
 {
 	double sublayerInfluence;
@@ -153,7 +194,7 @@ void TwoLayerWithShearStressBasedUpdate::sortMaterialUpward (std::vector<Grains>
 			tempBaseData.medianDiameterForActiveLayer = (strata.front()).getPercentileGrainDiameter(fractionalGrainDiameters,50.0);
 			double meanDiameterForSublayer = (strata.back()).getArithmeticMeanGrainDiameter(fractionalGrainDiameters);
 			meanDiameterForSublayer = std::min(meanDiameterForSublayer,meanDiameterForActiveLayer);
-			tempBaseData.thetaCriticalForSublayer = this->thresholdCalculationMethod->calculate(regularRiverReachProperties);
+			tempBaseData.thetaCriticalForSublayer = this->thresholdCalculationMethod->calculate(regularRiverReachProperties,cellID);
 			double thetaCriticalForActiveLayer = pow( (meanDiameterForActiveLayer / meanDiameterForSublayer), (2.0/3.0) ) * tempBaseData.thetaCriticalForSublayer;
 			tempBaseData.oneOverDifferenceBetweenThetaCriticalForActiveAndSublayer = 1.0 / ( thetaCriticalForActiveLayer - tempBaseData.thetaCriticalForSublayer );
 
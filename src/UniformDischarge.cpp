@@ -63,6 +63,7 @@ void UniformDischarge::applyChange (RiverReachProperties& riverReachProperties)
 		}
 		riverReachProperties.regularRiverReachProperties.waterVolumeChange = newDischarge - riverReachProperties.regularRiverReachProperties.discharge;
 		riverReachProperties.regularRiverReachProperties.discharge = newDischarge;
+		riverReachProperties.markAsModified();
 	}
 }
 
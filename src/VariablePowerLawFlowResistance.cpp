@@ -98,6 +98,7 @@ ConstructionVariables VariablePowerLawFlowResistance::createConstructionVariable
 	std::vector<std::string> stringVector;
 	stringVector.push_back(getTypeOfNumericRootFinderAsString());
 	result.labelledStrings["typeOfNumericRootFinder"] = stringVector;
+	addEverTreatedCellIDsToConstructionVariables(result);
 	return result;
 }
 
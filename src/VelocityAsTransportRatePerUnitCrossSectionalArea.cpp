@@ -55,23 +55,39 @@ ConstructionVariables VelocityAsTransportRatePerUnitCrossSectionalArea::createCo
 	std::vector<ConstructionVariables> constructionVariablesVector;
 	constructionVariablesVector.push_back( estimateThicknessOfMovingSedimentLayer->createConstructionVariables() );
 	result.labelledObjects["estimateThicknessOfMovingSedimentLayer"] = constructionVariablesVector;
+	std::vector<int> intVector;
+	std::vector<double> doubleVector;
+	for(std::map<int,double>::const_iterator currentEntry = mapFromCellIDToPreviousErosionRate.begin(); currentEntry != mapFromCellIDToPreviousErosionRate.end(); ++currentEntry)
+	{
+		intVector.push_back(currentEntry->first);
+		doubleVector.push_back(currentEntry->second);
+	}
+	result.labelledInts["cellIDsOfPreviousErosionRates"] = intVector;
+	result.labelledDoubles["previousErosionRates"] = doubleVector;
 	return result;
 }
 
 double VelocityAsTransportRatePerUnitCrossSectionalArea::calculate (const RiverReachProperties& riverReachProperties) const
 {
 	double currentErosionRateOverallVolume = riverReachProperties.regularRiverReachProperties.erosionRate.getOverallVolume();
+	double previousErosionRate = 0.0;
+	bool previousErosionRateAvailable;
+	//The map is shared by all reaches, which may be treated in parallel. Each reach only reads and writes its own entry.
+	#pragma omp critical(VelocityAsTransportRatePerUnitCrossSectionalAreaPreviousErosionRates)
+	{
 	std::map<int,double>::const_iterator previousErosionRateIterator = mapFromCellIDToPreviousErosionRate.find(riverReachProperties.getCellID());
-	if( previousErosionRateIterator != mapFromCellIDToPreviousErosionRate.end() )
+	previousErosionRateAvailable = ( previousErosionRateIterator != mapFromCellIDToPreviousErosionRate.end() );
+	if( previousErosionRateAvailable ) { previousErosionRate = previousErosionRateIterator->second; }
+	const_cast<VelocityAsTransportRatePerUnitCrossSectionalArea*>(this)->mapFromCellIDToPreviousErosionRate[riverReachProperties.getCellID()] = riverReachProperties.regularRiverReachProperties.erosionRate.getOverallVolume();
+	}
+	if( previousErosionRateAvailable )
 	{
-		double previousErosionRate = previousErosionRateIterator->second;
 		if(previousErosionRate > 0.0)
 		{
 			double ratioOfSupplyToCapacity = riverReachProperties.regularRiverReachProperties.erosion.getOverallVolume() / (previousErosionRate * ((riverReachProperties.getOverallParameters())->getCurrentTimeStepLengthInSeconds()) );
 			currentErosionRateOverallVolume *= ratioOfSupplyToCapacity;
 		}
 	}
-	const_cast<VelocityAsTransportRatePerUnitCrossSectionalArea*>(this)->mapFromCellIDToPreviousErosionRate[riverReachProperties.getCellID()] = riverReachProperties.regularRiverReachProperties.erosionRate.getOverallVolume();
 	return ( currentErosionRateOverallVolume / ( riverReachProperties.geometricalChannelBehaviour->alluviumChannel->convertActiveWidthIntoActivePerimeter(riverReachProperties.regularRiverReachProperties.activeWidth) * estimateThicknessOfMovingSedimentLayer->estimate(riverReachProperties)) );
 }
 
@@ -27,8 +27,12 @@
 
 #include "SedFlowCore.h"
 #include "ConsoleTools.h"
+#include "StageProfiler.h"
+#include "TimeStepConstraintDiagnostics.h"
+#include "RootFinderDiagnostics.h"
 #include <stdexcept>
 #include <cstring>
+#include <cstdlib>
 #include <string.h>
 
 #define myStringify(s) myStringifySubsidiary(s)
@@ -77,7 +81,44 @@ int main (int argc, char* argv[])
 	std::cout << "For details on sedFlow see http://www.wsl.ch/sedFlow" << std::endl;
 	std::cout << std::endl;
 
-	bool licenseAlreadyAccepted = ((argc > 2) && ((std::strcmp(argv[2],"acceptLicense") == 0) || (std::strcmp(argv[2],"AcceptLicense") == 0)));
+	// Options preceding the input file:
+	// "--restart" continues a simulation from the checkpoint given instead of the input file, which has been written by OutputBinaryCheckpoint.
+	// "--setupCache cacheFolder" takes the river system converted from the spreadsheets from the SetupCache in the cache folder or stores it there.
+	// "--profile" prints the times spent in the stages of the time steps at the end of the simulation.
+	// "--profileCSV profileFile N" does the same and in addition appends the times of every N time steps to the profile file.
+	// "--trace traceFile first N" records the N time steps starting with the (zero-based) time step first per thread and writes them as Chrome Trace Event JSON to the trace file.
+	// "--timeStepDiagnostics" prints at the end of the simulation, which constraints and reaches limited the lengths of the time steps.
+	// "--timeStepThreshold seconds" does the same and in addition prints each time step shorter than the given threshold.
+	// "--rootFinderDiagnostics" prints at the end of the simulation the convergence statistics of the numeric root finders per call site.
+	// "--rootFinderReplay replayFile" does the same and in addition writes the inputs of failed root searches to the replay file.
+	bool restartFromCheckpoint = false;
+	std::string setupCacheFolder;
+	bool profile = false;
+	std::string profileCSVFile;
+	int profileCSVInterval = 0;
+	std::string traceFile;
+	long firstTracedTimeStep = 0;
+	long numberOfTracedTimeSteps = 0;
+	bool timeStepDiagnostics = false;
+	double timeStepThreshold = 0.0;
+	bool rootFinderDiagnostics = false;
+	std::string rootFinderReplayFile;
+	int inputFileArgument = 1;
+	while(argc > inputFileArgument)
+	{
+		if(std::strcmp(argv[inputFileArgument],"--restart") == 0) { restartFromCheckpoint = true; inputFileArgument += 1; }
+		else if((std::strcmp(argv[inputFileArgument],"--setupCache") == 0) && (argc > (inputFileArgument+1))) { setupCacheFolder = argv[inputFileArgument+1]; inputFileArgument += 2; }
+		else if(std::strcmp(argv[inputFileArgument],"--profile") == 0) { profile = true; inputFileArgument += 1; }
+		else if((std::strcmp(argv[inputFileArgument],"--profileCSV") == 0) && (argc > (inputFileArgument+2))) { profile = true; profileCSVFile = argv[inputFileArgument+1]; profileCSVInterval = std::atoi(argv[inputFileArgument+2]); inputFileArgument += 3; }
+		else if((std::strcmp(argv[inputFileArgument],"--trace") == 0) && (argc > (inputFileArgument+3))) { traceFile = argv[inputFileArgument+1]; firstTracedTimeStep = std::atol(argv[inputFileArgument+2]); numberOfTracedTimeSteps = std::atol(argv[inputFileArgument+3]); inputFileArgument += 4; }
+		else if(std::strcmp(argv[inputFileArgument],"--timeStepDiagnostics") == 0) { timeStepDiagnostics = true; inputFileArgument += 1; }
+		else if((std::strcmp(argv[inputFileArgument],"--timeStepThreshold") == 0) && (argc > (inputFileArgument+1))) { timeStepDiagnostics = true; timeStepThreshold = std::atof(argv[inputFileArgument+1]); inputFileArgument += 2; }
+		else if(std::strcmp(argv[inputFileArgument],"--rootFinderDiagnostics") == 0) { rootFinderDiagnostics = true; inputFileArgument += 1; }
+		else if((std::strcmp(argv[inputFileArgument],"--rootFinderReplay") == 0) && (argc > (inputFileArgument+1))) { rootFinderDiagnostics = true; rootFinderReplayFile = argv[inputFileArgument+1]; inputFileArgument += 2; }
+		else { break; }
+	}
+
+	bool licenseAlreadyAccepted = ((argc > (inputFileArgument+1)) && ((std::strcmp(argv[inputFileArgument+1],"acceptLicense") == 0) || (std::strcmp(argv[inputFileArgument+1],"AcceptLicense") == 0)));
 	if(!licenseAlreadyAccepted)
 	{
 		std::cout << "By continuing the user accepts the license terms mentioned above." << std::endl;
@@ -88,15 +129,16 @@ int main (int argc, char* argv[])
 	std::cout << "The license terms have been accepted by the user." << std::endl;
 	std::cout << std::endl;
 
-	char* inputXMLfile;
-	bool newHasBeenCalledForInputXMLfile = false;
-	if (argc > 1)
+	char* inputFile;
+	bool newHasBeenCalledForInputFile = false;
+	if (argc > inputFileArgument)
 	{
-		inputXMLfile = argv[1];
+		inputFile = argv[inputFileArgument];
 	}
 	else
 	{
-		std::cout << "Please enter an input file including its path:" << std::endl;
+		if(restartFromCheckpoint) { std::cout << "Please enter a checkpoint file including its path:" << std::endl; }
+		else { std::cout << "Please enter an input file including its path:" << std::endl; }
 		// Clears any possible error states, which might prevent the read in
 		std::cin.clear();
 		// Ignores as many chars as are available in buffer (i.e. ignores complete buffer)
@@ -104,17 +146,22 @@ int main (int argc, char* argv[])
 		//Finally read in the file name.
 		std::string fileNameAsString;
 		std::getline(std::cin,fileNameAsString);
-		inputXMLfile = new char [fileNameAsString.size()+1];
-		newHasBeenCalledForInputXMLfile = true;
-		std::strcpy(inputXMLfile, fileNameAsString.c_str());
+		inputFile = new char [fileNameAsString.size()+1];
+		newHasBeenCalledForInputFile = true;
+		std::strcpy(inputFile, fileNameAsString.c_str());
 	}
 
 	int i;
 	try{
 
+		if(restartFromCheckpoint) { std::cout << std::endl << "Restarting from checkpoint..." << std::endl; }
 		std::cout << std::endl << "Processing..." << std::endl << std::endl;
-		i = SedFlow::SedFlowCore::runSimulation(inputXMLfile);
-		if(newHasBeenCalledForInputXMLfile) { delete[] inputXMLfile; }
+		if(profile) { SedFlow::StageProfiler::enable(profileCSVFile, profileCSVInterval); }
+		if(!traceFile.empty()) { SedFlow::StageProfiler::enableTracing(traceFile, firstTracedTimeStep, numberOfTracedTimeSteps); }
+		if(timeStepDiagnostics) { SedFlow::TimeStepConstraintDiagnostics::enable(timeStepThreshold); }
+		if(rootFinderDiagnostics) { SedFlow::RootFinderDiagnostics::enable(rootFinderReplayFile); }
+		i = SedFlow::SedFlowCore::runSimulation(inputFile, restartFromCheckpoint, setupCacheFolder);
+		if(newHasBeenCalledForInputFile) { delete[] inputFile; }
 
 	} catch (std::out_of_range& oor) {
 		std::cerr << "Out of Range error: " << oor.what() << std::endl;